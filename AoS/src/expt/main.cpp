@@ -60,11 +60,6 @@ int main() {
                 fullPathStream.str(std::string());
 
                 for (const unsigned int order : KernelInfos::selectedOrders) {
-                    // enlargement
-                    const auto extendedImage = ImageProcessing::extendEdge(*img, (order - 1) / 2);
-                    std::cout << "Image "  << imageName << " enlarged to " <<
-                        extendedImage->getWidth() << "x" << extendedImage->getHeight() << std::endl;
-
                     for (const auto kernelType : KernelInfos::selectedTypes) {
                         // create kernel
                         std::unique_ptr<Kernel> kernel;
@@ -85,7 +80,8 @@ int main() {
                         const std::chrono::duration<double> wall_clock_time_start = timer->now();
                         std::unique_ptr<Image> outputImage;
                         for (unsigned int rep = 0; rep < numReps; rep++)
-                            outputImage = ImageProcessing::convolution(*extendedImage, *kernel);
+                            outputImage = ImageProcessing::convolution(*img, *kernel,
+                                ImageProcessing::EdgePolicy::extend);
                         const std::chrono::duration<double> wall_clock_time_end = timer->now();
                         const std::chrono::duration<double> wall_clock_time_duration = wall_clock_time_end - wall_clock_time_start;
                         std::cout << "Image processed " << numReps << " times in " << wall_clock_time_duration.count() << " seconds [Wall Clock]" <<
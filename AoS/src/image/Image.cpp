@@ -1,7 +1,12 @@
+#include <stdexcept>
+
 #include "Image.h"
 
-Image::Image(const unsigned int w, const unsigned int h, const std::vector<std::vector<Pixel>>& data):
-    width(w), height(h), data(data) {}
+Image::Image(const unsigned int w, const unsigned int h, std::vector<Pixel> data):
+    width(w), height(h), data(std::move(data)) {
+    if (this->data.size() != static_cast<std::size_t>(w) * h)
+        throw std::invalid_argument("Pixel data must contain width * height pixels.");
+}
 
 Image::~Image() = default;
 
@@ -13,6 +18,10 @@ unsigned int Image::getHeight() const {
     return height;
 }
 
-std::vector<std::vector<Pixel>> Image::getData() const {
+std::vector<Pixel> Image::getData() const {
     return data;
-}
\ No newline at end of file
+}
+
+Span<const Pixel> Image::viewData() const {
+    return {data.data(), data.size()};
+}
@@ -1,13 +1,16 @@
 #ifndef IMAGE_H
 #define IMAGE_H
+#include <cstddef>
 #include <vector>
 
 #include "Pixel.h"
+#include "view/Span.h"
 
 
 /**
  * Represents an image composed of pixel data in a two-dimensional structure.
- * The image is defined by its width, height, and pixel information.
+ * The image is defined by its width, height, and pixel information, stored row by row in a single
+ * contiguous buffer.
  *
  * This class is immutable once constructed.
  */
@@ -18,10 +21,12 @@ public:
      *
      * @param w The width of the image in pixels.
      * @param h The height of the image in pixels.
-     * @param data A 2D vector containing pixel information for the image. The outer vector corresponds
-     *             to rows, and the inner vectors represent columns of pixels in the image.
+     * @param data A vector containing pixel information for the image, row by row: the pixel in the given
+     *             row and column is at index row * w + column. It is taken by value, so that temporary or
+     *             moved pixels are moved into the image instead of copied.
+     * @throw std::invalid_argument If the number of pixels is not w * h.
      */
-    Image(unsigned int w, unsigned int h, const std::vector<std::vector<Pixel>>& data);
+    Image(unsigned int w, unsigned int h, std::vector<Pixel> data);
 
     /**
      * Default destructor.
@@ -45,10 +50,38 @@ public:
     /**
      * Retrieves the pixel data of the image.
      *
-     * @return A 2D vector containing the image's pixel data. Each inner vector represents a row of
-     *         pixels, while its elements correspond to the columns of the image.
+     * @return A vector containing the image's pixel data row by row, so that the pixel in the given row
+     *         and column is at index row * width + column.
      */
-    [[nodiscard]] std::vector<std::vector<Pixel>> getData() const;
+    [[nodiscard]] std::vector<Pixel> getData() const;
+
+    /**
+     * Retrieves a read-only view of the pixel data of the image, without copying them.
+     *
+     * @return A view of the width * height pixels, row by row, valid as long as the image.
+     */
+    [[nodiscard]] Span<const Pixel> viewData() const;
+
+    /**
+     * Retrieves a read-only view of a row of pixels of the image, without copying them.
+     *
+     * @param row The index of the row, which must be less than the height.
+     * @return A view of the width pixels of the row, valid as long as the image.
+     */
+    [[nodiscard]] Span<const Pixel> viewRow(const unsigned int row) const {
+        return {data.data() + static_cast<std::size_t>(row) * width, width};
+    }
+
+    /**
+     * Retrieves the pixel in the given row and column of the image.
+     *
+     * @param row The index of the row, which must be less than the height.
+     * @param column The index of the column, which must be less than the width.
+     * @return A reference to the pixel, valid as long as the image.
+     */
+    [[nodiscard]] const Pixel& at(const unsigned int row, const unsigned int column) const {
+        return data[static_cast<std::size_t>(row) * width + column];
+    }
 
 private:
     /**
@@ -66,12 +99,12 @@ private:
     unsigned int height;
 
     /**
-     * Stores the pixel data for the image as a 2D vector of Pixel objects.
+     * Stores the pixel data for the image as a single vector of Pixel objects.
      *
-     * Each outer vector represents a row of pixels, while each inner vector contains
-     * the pixels for a specific column within that row.
+     * Rows are stored one after another, so that consecutive rows are width pixels apart and the
+     * whole image is a single allocation.
      */
-    std::vector<std::vector<Pixel>> data;
+    std::vector<Pixel> data;
 };
 
 
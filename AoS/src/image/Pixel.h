@@ -6,7 +6,8 @@
 /**
  * A class representing a single RGB pixel.
  *
- * This class is immutable once constructed.
+ * This class is immutable once constructed. Its members are defined in the header, so that they are inlined
+ * in the convolution loops, which access the channels of each pixel many times.
  */
 class Pixel final {
 public:
@@ -17,33 +18,39 @@ public:
      * @param g The green color component, represented as an 8-bit unsigned integer (range: 0-255).
      * @param b The blue color component, represented as an 8-bit unsigned integer (range: 0-255).
      */
-    explicit Pixel(uint8_t r=0, uint8_t g=0, uint8_t b=0);
+    explicit Pixel(const uint8_t r=0, const uint8_t g=0, const uint8_t b=0): r(r), g(g), b(b) {}
 
     /**
      * Default destructor.
      */
-    ~Pixel();
+    ~Pixel() = default;
 
     /**
      * Retrieves the red component of the pixel.
      *
      * @return The red color value of the pixel as an 8-bit unsigned integer.
      */
-    [[nodiscard]] uint8_t getR() const;
+    [[nodiscard]] uint8_t getR() const {
+        return r;
+    }
 
     /**
      * Retrieves the green color component of the Pixel object.
      *
      * @return The value of the green component as an unsigned 8-bit integer.
      */
-    [[nodiscard]] uint8_t getG() const;
+    [[nodiscard]] uint8_t getG() const {
+        return g;
+    }
 
     /**
      * Retrieves the blue color value of the Pixel.
      *
      * @return The blue component of the Pixel as an 8-bit unsigned integer.
      */
-    [[nodiscard]] uint8_t getB() const;
+    [[nodiscard]] uint8_t getB() const {
+        return b;
+    }
 
 private:
     /**
@@ -21,34 +21,31 @@ std::unique_ptr<Image> STBImageReader::loadRGBImage(const std::filesystem::path
     }
 
     // conversion
-    std::vector pixels(height, std::vector<Pixel>(width));
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            const unsigned int idx = (y * width + x) * RGB_CHANNELS;
-            pixels[y][x] = Pixel(imgData[idx], imgData[idx + 1], imgData[idx + 2]);
-        }
+    const std::size_t numPixels = static_cast<std::size_t>(width) * height;
+    std::vector<Pixel> pixels(numPixels);
+    for (std::size_t k = 0; k < numPixels; ++k) {
+        const std::size_t idx = k * RGB_CHANNELS;
+        pixels[k] = Pixel(imgData[idx], imgData[idx + 1], imgData[idx + 2]);
     }
 
     stbi_image_free(imgData);
-    return std::make_unique<Image>(width, height, pixels);
+    return std::make_unique<Image>(width, height, std::move(pixels));
 }
 
 void STBImageReader::saveJPGImage(const Image &img, const std::filesystem::path &filePath) {
     const unsigned int width = img.getWidth();
     const unsigned int height = img.getHeight();
 
-    std::vector<uint8_t> flatData(width * height * RGB_CHANNELS);
+    const auto pixels = img.viewData();
+    std::vector<uint8_t> flatData(pixels.size() * RGB_CHANNELS);
 
     // retrieve data
-    const auto pixels = img.getData();
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            const unsigned int idx = (y * width + x) * RGB_CHANNELS;
-            Pixel pixel = pixels[y][x];
-            flatData[idx] = pixel.getR();
-            flatData[idx + 1] = pixel.getG();
-            flatData[idx + 2] = pixel.getB();
-        }
+    for (std::size_t k = 0; k < pixels.size(); ++k) {
+        const std::size_t idx = k * RGB_CHANNELS;
+        const Pixel& pixel = pixels[k];
+        flatData[idx] = pixel.getR();
+        flatData[idx + 1] = pixel.getG();
+        flatData[idx + 2] = pixel.getB();
     }
 
     // save
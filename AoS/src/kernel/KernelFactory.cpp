@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 #include "KernelFactory.h"
 
@@ -6,36 +7,82 @@ void checkOrderValidity(const unsigned int order) {
         throw std::invalid_argument("Kernel order must be odd.");
 }
 
-std::unique_ptr<Kernel> createKernel(const std::string& name, unsigned int order, const std::vector<float> &weights) {
-    return std::make_unique<Kernel>(name, order, weights);
+std::unique_ptr<Kernel> createKernel(std::string name, const unsigned int order, std::vector<float> weights) {
+    return std::make_unique<Kernel>(std::move(name), order, std::move(weights));
 }
 
 std::unique_ptr<Kernel> KernelFactory::createBoxBlurKernel(const unsigned int order) {
     checkOrderValidity(order);
 
-    const unsigned int num_of_values = order * order;
-    const float mean =  1 / static_cast<float>(num_of_values);
+    std::vector<float> weights(order * order);
+    fillBoxBlurWeights(weights, order);
 
-    return createKernel("boxBlur", order, std::vector(num_of_values, mean));
+    return createKernel("boxBlur", order, std::move(weights));
 }
 
 std::unique_ptr<Kernel> KernelFactory::createEdgeDetectionKernel(const unsigned int order) {
     checkOrderValidity(order);
 
-    std::vector<float> weights(order * order, -1);
-    unsigned int coreWeight = order * order - 1;
+    std::vector<float> weights(order * order);
+    fillEdgeDetectionWeights(weights, order);
 
-    const unsigned int corePoint = order / 2;
-    for (unsigned int k = 1; k < corePoint; k++) {
-        const unsigned int difference = 1 << k - 1;
-        for (unsigned int j = k; j < order - k; j++) {
-            for (unsigned int i = k; i < order - k; i++) {
-                weights[j * order + i] -= static_cast<float>(difference);
+    return createKernel("edgeDetection", order, std::move(weights));
+}
+
+std::unique_ptr<Kernel> KernelFactory::createSharpenKernel(const unsigned int order) {
+    checkOrderValidity(order);
+
+    std::vector<float> weights(order * order);
+    fillSharpenWeights(weights, order);
+
+    return createKernel("sharpen", order, std::move(weights));
+}
+
+std::unique_ptr<Kernel> KernelFactory::createComposedKernel(const Kernel &first, const Kernel &second) {
+    const unsigned int firstOrder = first.getOrder();
+    const unsigned int secondOrder = second.getOrder();
+    const auto firstWeights = first.viewWeights();
+    const auto secondWeights = second.viewWeights();
+    const unsigned int order = firstOrder + secondOrder - 1;
+
+    // products are accumulated in double precision, so that the composition does not depend on their order
+    std::vector<double> sums(order * order, 0.0);
+    for (unsigned int j1 = 0; j1 < firstOrder; j1++) {
+        for (unsigned int i1 = 0; i1 < firstOrder; i1++) {
+            const double firstWeight = firstWeights[j1 * firstOrder + i1];
+            for (unsigned int j2 = 0; j2 < secondOrder; j2++) {
+                for (unsigned int i2 = 0; i2 < secondOrder; i2++) {
+                    sums[(j1 + j2) * order + i1 + i2] += firstWeight * secondWeights[j2 * secondOrder + i2];
+                }
             }
         }
-        coreWeight += difference * ((order - 2*k)*(order - 2*k) - 1);
     }
-    weights[corePoint * order + corePoint] = static_cast<float>(coreWeight);
 
-    return createKernel("edgeDetection", order, weights);
-}
\ No newline at end of file
+    return createKernel(first.getName() + "_" + second.getName(), order, std::vector<float>(sums.begin(), sums.end()));
+}
+
+std::unique_ptr<Kernel> KernelFactory::createScaledKernel(const Kernel &kernel, const float factor) {
+    std::vector<float> weights = kernel.getWeights();
+    for (float &weight : weights)
+        weight *= factor;
+
+    return createKernel(kernel.getName(), kernel.getOrder(), std::move(weights));
+}
+
+std::unique_ptr<Kernel> KernelFactory::createSumKernel(const Kernel &first, const Kernel &second) {
+    const unsigned int order = std::max(first.getOrder(), second.getOrder());
+
+    std::vector<float> weights(order * order, 0.0f);
+    for (const Kernel* kernel : {&first, &second}) {
+        const unsigned int kernelOrder = kernel->getOrder();
+        const auto kernelWeights = kernel->viewWeights();
+        const unsigned int offset = (order - kernelOrder) / 2;
+        for (unsigned int j = 0; j < kernelOrder; j++) {
+            for (unsigned int i = 0; i < kernelOrder; i++) {
+                weights[(j + offset) * order + i + offset] += kernelWeights[j * kernelOrder + i];
+            }
+        }
+    }
+
+    return createKernel(first.getName() + "+" + second.getName(), order, std::move(weights));
+}
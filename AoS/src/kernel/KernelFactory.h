@@ -1,5 +1,6 @@
 #ifndef KERNELFACTORY_H
 #define KERNELFACTORY_H
+#include <array>
 #include <memory>
 
 #include "Kernel.h"
@@ -41,6 +42,151 @@ public:
      * @throws std::invalid_argument if the provided order is even.
      */
     static std::unique_ptr<Kernel> createEdgeDetectionKernel(unsigned int order);
+
+    /**
+     * Creates a sharpen kernel for image processing.
+     *
+     * Non-zero weights form a diamond: the weights at Manhattan distance d from the center, with 0 < d <= order / 2,
+     * are -(order / 2 - d + 1), while the central one makes the weights sum to one; e.g. the 3x3 kernel has
+     * central weight 5 and -1 at its four sides. Almost half of the weights are zero.
+     *
+     * @param order The size of the square kernel. It must be a positive odd integer.
+     * @return A unique pointer to a Kernel object configured for sharpening.
+     * @throws std::invalid_argument if the provided order is even.
+     */
+    static std::unique_ptr<Kernel> createSharpenKernel(unsigned int order);
+
+    /**
+     * Creates the kernel equivalent to applying two kernels one after the other, i.e. the full 2D convolution
+     * of their weights matrices, whose order is the sum of their orders minus one.
+     *
+     * Convolving an image with the returned kernel gives, up to the rounding and clamping of the intermediate
+     * image, the same result of convolving it with the first kernel and then with the second one.
+     *
+     * @param first The kernel applied first.
+     * @param second The kernel applied second.
+     * @return A unique pointer to a Kernel object named after both kernels.
+     */
+    static std::unique_ptr<Kernel> createComposedKernel(const Kernel& first, const Kernel& second);
+
+    /**
+     * Creates a kernel whose weights are those of the given kernel multiplied by a factor.
+     *
+     * @param kernel The kernel to scale.
+     * @param factor The factor multiplying each weight.
+     * @return A unique pointer to a Kernel object with the same name and order of the given kernel.
+     */
+    static std::unique_ptr<Kernel> createScaledKernel(const Kernel& kernel, float factor);
+
+    /**
+     * Creates the kernel whose response is the sum of the responses of two kernels, i.e. the sum of their
+     * weights matrices once the smaller one is centered into the larger one.
+     *
+     * @param first The first kernel to add.
+     * @param second The second kernel to add.
+     * @return A unique pointer to a Kernel object named after both kernels, whose order is the larger one.
+     */
+    static std::unique_ptr<Kernel> createSumKernel(const Kernel& first, const Kernel& second);
+
+    /**
+     * Computes the weights of a box blur kernel at compile time, e.g. for engines specialized on a kernel.
+     *
+     * @tparam Order The size of the square kernel. It must be a positive odd integer.
+     * @return The weights, stored by rows, equal to those of the kernel returned by @ref createBoxBlurKernel.
+     */
+    template<unsigned int Order>
+    static constexpr std::array<float, Order * Order> boxBlurWeights() {
+        static_assert(Order % 2 == 1, "Kernel order must be odd.");
+        std::array<float, Order * Order> weights{};
+        fillBoxBlurWeights(weights, Order);
+        return weights;
+    }
+
+    /**
+     * Computes the weights of an edge detection kernel at compile time, e.g. for engines specialized on a kernel.
+     *
+     * @tparam Order The size of the square kernel. It must be a positive odd integer.
+     * @return The weights, stored by rows, equal to those of the kernel returned by @ref createEdgeDetectionKernel.
+     */
+    template<unsigned int Order>
+    static constexpr std::array<float, Order * Order> edgeDetectionWeights() {
+        static_assert(Order % 2 == 1, "Kernel order must be odd.");
+        std::array<float, Order * Order> weights{};
+        fillEdgeDetectionWeights(weights, Order);
+        return weights;
+    }
+
+    /**
+     * Computes the weights of a sharpen kernel at compile time, e.g. for engines specialized on a kernel.
+     *
+     * @tparam Order The size of the square kernel. It must be a positive odd integer.
+     * @return The weights, stored by rows, equal to those of the kernel returned by @ref createSharpenKernel.
+     */
+    template<unsigned int Order>
+    static constexpr std::array<float, Order * Order> sharpenWeights() {
+        static_assert(Order % 2 == 1, "Kernel order must be odd.");
+        std::array<float, Order * Order> weights{};
+        fillSharpenWeights(weights, Order);
+        return weights;
+    }
+
+private:
+    /**
+     * Fills the given weights, either a std::vector or a std::array of order * order floats, with those of
+     * a box blur kernel. Being constexpr, the same code serves the factory and the compile-time tables.
+     */
+    template<typename Weights>
+    static constexpr void fillBoxBlurWeights(Weights& weights, const unsigned int order) {
+        const float mean = 1 / static_cast<float>(order * order);
+        for (auto& weight : weights)
+            weight = mean;
+    }
+
+    /**
+     * Fills the given weights, either a std::vector or a std::array of order * order floats, with those of
+     * an edge detection kernel. Being constexpr, the same code serves the factory and the compile-time tables.
+     */
+    template<typename Weights>
+    static constexpr void fillEdgeDetectionWeights(Weights& weights, const unsigned int order) {
+        for (auto& weight : weights)
+            weight = -1;
+        unsigned int coreWeight = order * order - 1;
+
+        const unsigned int corePoint = order / 2;
+        for (unsigned int k = 1; k < corePoint; k++) {
+            const unsigned int difference = 1 << (k - 1);
+            for (unsigned int j = k; j < order - k; j++) {
+                for (unsigned int i = k; i < order - k; i++) {
+                    weights[j * order + i] -= static_cast<float>(difference);
+                }
+            }
+            coreWeight += difference * ((order - 2*k)*(order - 2*k) - 1);
+        }
+        weights[corePoint * order + corePoint] = static_cast<float>(coreWeight);
+    }
+
+    /**
+     * Fills the given weights, either a std::vector or a std::array of order * order floats, with those of
+     * a sharpen kernel. Being constexpr, the same code serves the factory and the compile-time tables.
+     */
+    template<typename Weights>
+    static constexpr void fillSharpenWeights(Weights& weights, const unsigned int order) {
+        const unsigned int corePoint = order / 2;
+        float coreWeight = 1;
+        for (unsigned int j = 0; j < order; j++) {
+            for (unsigned int i = 0; i < order; i++) {
+                const unsigned int distance = (j > corePoint ? j - corePoint : corePoint - j) +
+                    (i > corePoint ? i - corePoint : corePoint - i);
+                if (distance == 0 || distance > corePoint) {
+                    weights[j * order + i] = 0;
+                } else {
+                    weights[j * order + i] = -static_cast<float>(corePoint - distance + 1);
+                    coreWeight -= weights[j * order + i];
+                }
+            }
+        }
+        weights[corePoint * order + corePoint] = coreWeight;
+    }
 };
 
 
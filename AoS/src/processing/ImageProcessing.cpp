@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include "ImageProcessing.h"
 
 #define MIN_VALUE 0
 #define MAX_VALUE 255
+#define SEPARABILITY_EPSILON 1e-6f
 
 uint8_t getChannelAsUint8(const float channel) {
     if (channel < MIN_VALUE)
@@ -11,92 +15,305 @@ uint8_t getChannelAsUint8(const float channel) {
     return static_cast<uint8_t>(channel);
 }
 
-std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel) {
+bool decomposeSeparable(const Kernel &kernel, std::vector<float> &verticalWeights,
+    std::vector<float> &horizontalWeights) {
     const unsigned int order = kernel.getOrder();
-    const auto kernelWeights = kernel.getWeights();
+    const auto kernelWeights = kernel.viewWeights();
+
+    // the weight with the greatest magnitude is used as pivot to keep the decomposition well-conditioned
+    unsigned int pivot = 0;
+    for (unsigned int k = 1; k < order * order; k++) {
+        if (std::fabs(kernelWeights[k]) > std::fabs(kernelWeights[pivot]))
+            pivot = k;
+    }
+    const float pivotWeight = kernelWeights[pivot];
+    const unsigned int pivotRow = pivot / order;
+    const unsigned int pivotColumn = pivot % order;
+
+    verticalWeights.resize(order);
+    horizontalWeights.resize(order);
+    for (unsigned int k = 0; k < order; k++) {
+        verticalWeights[k] = kernelWeights[k * order + pivotColumn];
+        horizontalWeights[k] = pivotWeight != 0 ? kernelWeights[pivotRow * order + k] / pivotWeight : 0;
+    }
+
+    // rank-one check
+    const float tolerance = SEPARABILITY_EPSILON * std::fabs(pivotWeight);
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            if (std::fabs(verticalWeights[j] * horizontalWeights[i] - kernelWeights[j * order + i]) > tolerance)
+                return false;
+        }
+    }
+    return true;
+}
+
+void convolveSeparable(const Image &image, const std::vector<float> &verticalWeights,
+    const std::vector<float> &horizontalWeights, Pixel *output, const unsigned int outputStride) {
+    const auto order = static_cast<unsigned int>(verticalWeights.size());
 
-    const auto originalData = image.getData();
+    const unsigned int width = image.getWidth();
+    const auto originalData = image.viewData();
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = width - (order - 1);
+
+    std::vector<float> rowReds(width);
+    std::vector<float> rowGreens(width);
+    std::vector<float> rowBlues(width);
+    for (unsigned int y = 0; y < outputHeight; y++) {
+        Pixel* outputRow = output + static_cast<std::size_t>(y) * outputStride;
+
+        // vertical pass
+        std::fill(rowReds.begin(), rowReds.end(), 0.0f);
+        std::fill(rowGreens.begin(), rowGreens.end(), 0.0f);
+        std::fill(rowBlues.begin(), rowBlues.end(), 0.0f);
+        for (unsigned int j = 0; j < order; j++) {
+            const float kernelWeight = verticalWeights[j];
+            const Pixel* originalRow = originalData.data() + static_cast<std::size_t>(y + j) * width;
+            for (unsigned int x = 0; x < width; x++) {
+                const Pixel originalPixel = originalRow[x];
+                rowReds[x] += static_cast<float>(originalPixel.getR()) * kernelWeight;
+                rowGreens[x] += static_cast<float>(originalPixel.getG()) * kernelWeight;
+                rowBlues[x] += static_cast<float>(originalPixel.getB()) * kernelWeight;
+            }
+        }
+
+        // horizontal pass
+        for (unsigned int x = 0; x < outputWidth; x++) {
+            float channelRed = 0;
+            float channelGreen = 0;
+            float channelBlue = 0;
+
+            for (unsigned int i = 0; i < order; i++) {
+                const float kernelWeight = horizontalWeights[i];
+                channelRed += rowReds[x + i] * kernelWeight;
+                channelGreen += rowGreens[x + i] * kernelWeight;
+                channelBlue += rowBlues[x + i] * kernelWeight;
+            }
+            outputRow[x] = Pixel(getChannelAsUint8(channelRed),
+                getChannelAsUint8(channelGreen), getChannelAsUint8(channelBlue));
+        }
+    }
+}
+
+std::unique_ptr<Image> applySeparableConvolution(const Image &image, const std::vector<float> &verticalWeights,
+    const std::vector<float> &horizontalWeights) {
+    const auto order = static_cast<unsigned int>(verticalWeights.size());
     const unsigned int outputHeight = image.getHeight() - (order - 1);
     const unsigned int outputWidth = image.getWidth() - (order - 1);
 
-    std::vector pixels(outputHeight, std::vector<Pixel>(outputWidth));
+    std::vector<Pixel> pixels(static_cast<std::size_t>(outputWidth) * outputHeight);
+    convolveSeparable(image, verticalWeights, horizontalWeights, pixels.data(), outputWidth);
+    return std::make_unique<Image>(outputWidth, outputHeight, std::move(pixels));
+}
+
+void convolveDirect(const Image &image, const Kernel &kernel, Pixel *output, const unsigned int outputStride) {
+    const unsigned int order = kernel.getOrder();
+    const auto kernelWeights = kernel.viewWeights();
+
+    const unsigned int width = image.getWidth();
+    const auto originalData = image.viewData();
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = width - (order - 1);
+
     for (unsigned int y = 0; y < outputHeight; y++) {
+        Pixel* outputRow = output + static_cast<std::size_t>(y) * outputStride;
         for (unsigned int x = 0; x < outputWidth; x++) {
             float channelRed = 0;
             float channelGreen = 0;
             float channelBlue = 0;
 
             for (unsigned int j = 0; j < order; j++) {
+                const Pixel* originalRow = originalData.data() + static_cast<std::size_t>(y + j) * width + x;
                 for (unsigned int i = 0; i < order; i++) {
-                    Pixel originalPixel = originalData[y + j][x + i];
+                    const Pixel originalPixel = originalRow[i];
                     const float kernelWeight = kernelWeights[j * order + i];
                     channelRed += static_cast<float>(originalPixel.getR()) * kernelWeight;
                     channelGreen += static_cast<float>(originalPixel.getG()) * kernelWeight;
                     channelBlue += static_cast<float>(originalPixel.getB()) * kernelWeight;
                 }
             }
-            pixels[y][x] = Pixel(getChannelAsUint8(channelRed),
+            outputRow[x] = Pixel(getChannelAsUint8(channelRed),
                 getChannelAsUint8(channelGreen), getChannelAsUint8(channelBlue));
         }
     }
+}
+
+// writes the cropped convolution into an output whose rows are the given stride apart, so that callers
+// placing it inside a larger image do not build a temporary one
+void convolveInto(const Image &image, const Kernel &kernel, Pixel *output, const unsigned int outputStride) {
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    if (kernel.getOrder() > 1 && decomposeSeparable(kernel, verticalWeights, horizontalWeights))
+        convolveSeparable(image, verticalWeights, horizontalWeights, output, outputStride);
+    else
+        convolveDirect(image, kernel, output, outputStride);
+}
+
+std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = image.getWidth() - (order - 1);
+
+    std::vector<Pixel> pixels(static_cast<std::size_t>(outputWidth) * outputHeight);
+    convolveInto(image, kernel, pixels.data(), outputWidth);
+    return std::make_unique<Image>(outputWidth, outputHeight, std::move(pixels));
+}
+
+unsigned int resolveEdgeCoordinate(const int coordinate, const unsigned int size,
+    const ImageProcessing::EdgePolicy edgePolicy) {
+    const int signedSize = static_cast<int>(size);
+    if (coordinate >= 0 && coordinate < signedSize)
+        return static_cast<unsigned int>(coordinate);
+
+    switch (edgePolicy) {
+        case ImageProcessing::EdgePolicy::extend:
+            return coordinate < 0 ? 0 : size - 1;
+        case ImageProcessing::EdgePolicy::wrap:
+            return static_cast<unsigned int>((coordinate % signedSize + signedSize) % signedSize);
+        case ImageProcessing::EdgePolicy::mirror: {
+            if (size == 1)
+                return 0;
+            // reflections repeat with a period of twice the distance between the edge pixels
+            const int period = 2 * (signedSize - 1);
+            const int reflected = (coordinate % period + period) % period;
+            return static_cast<unsigned int>(reflected < signedSize ? reflected : period - reflected);
+        }
+        default:
+            // the size itself marks the coordinates of constant values
+            return size;
+    }
+}
+
+std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel,
+    const EdgePolicy edgePolicy) {
+    if (edgePolicy == EdgePolicy::crop)
+        return convolution(image, kernel);
+
+    const unsigned int order = kernel.getOrder();
+    const unsigned int radius = order / 2;
+    const unsigned int width = image.getWidth();
+    const unsigned int height = image.getHeight();
+    std::vector<Pixel> pixels(static_cast<std::size_t>(width) * height);
 
-    return std::make_unique<Image>(outputWidth, outputHeight, pixels);
+    // interior pixels are computed straight from the input image into their final position
+    if (width >= order && height >= order)
+        convolveInto(image, kernel, pixels.data() + static_cast<std::size_t>(radius) * width + radius, width);
+
+    // top and bottom rectangles span the whole width, left and right ones the rows in between
+    const unsigned int topEnd = std::min(radius, height);
+    const unsigned int bottomBegin = std::max(height - topEnd, topEnd);
+    const unsigned int leftEnd = std::min(radius, width);
+    const unsigned int rightBegin = std::max(width - leftEnd, leftEnd);
+    const unsigned int bounds[4][4] = {{0, topEnd, 0, width}, {bottomBegin, height, 0, width},
+        {topEnd, bottomBegin, 0, leftEnd}, {topEnd, bottomBegin, rightBegin, width}};
+    for (const auto &[rowBegin, rowEnd, columnBegin, columnEnd] : bounds) {
+        if (rowBegin >= rowEnd || columnBegin >= columnEnd)
+            continue;
+
+        // each rectangle is computed from a small patch whose outer pixels are resolved by the policy
+        const unsigned int patchWidth = columnEnd - columnBegin + order - 1;
+        const unsigned int patchHeight = rowEnd - rowBegin + order - 1;
+        std::vector<Pixel> patch(static_cast<std::size_t>(patchWidth) * patchHeight);
+        for (unsigned int j = 0; j < patchHeight; j++) {
+            const unsigned int row = resolveEdgeCoordinate(static_cast<int>(rowBegin + j) - static_cast<int>(radius),
+                height, edgePolicy);
+            for (unsigned int i = 0; i < patchWidth; i++) {
+                const unsigned int column = resolveEdgeCoordinate(
+                    static_cast<int>(columnBegin + i) - static_cast<int>(radius), width, edgePolicy);
+                if (row != height && column != width)
+                    patch[static_cast<std::size_t>(j) * patchWidth + i] = image.at(row, column);
+            }
+        }
+
+        convolveInto(Image(patchWidth, patchHeight, std::move(patch)), kernel,
+            pixels.data() + static_cast<std::size_t>(rowBegin) * width + columnBegin, width);
+    }
+
+    return std::make_unique<Image>(width, height, std::move(pixels));
+}
+
+std::unique_ptr<Image> ImageProcessing::separableConvolution(const Image &image, const Kernel &kernel) {
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    if (!decomposeSeparable(kernel, verticalWeights, horizontalWeights))
+        throw std::invalid_argument("Kernel must be separable.");
+    return applySeparableConvolution(image, verticalWeights, horizontalWeights);
+}
+
+bool ImageProcessing::isSeparable(const Kernel &kernel) {
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    return decomposeSeparable(kernel, verticalWeights, horizontalWeights);
+}
+
+std::unique_ptr<Image> ImageProcessing::directConvolution(const Image &image, const Kernel &kernel) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = image.getWidth() - (order - 1);
+
+    std::vector<Pixel> pixels(static_cast<std::size_t>(outputWidth) * outputHeight);
+    convolveDirect(image, kernel, pixels.data(), outputWidth);
+    return std::make_unique<Image>(outputWidth, outputHeight, std::move(pixels));
 }
 
 
 std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const unsigned int padding) {
-    const auto originalData = image.getData();
     const unsigned int height = image.getHeight();
     const unsigned int width = image.getWidth();
 
     const unsigned int extendedHeight = height + 2 * padding;
     const unsigned int extendedWidth = width + 2 * padding;
 
-    std::vector pixels(extendedHeight, std::vector<Pixel>(extendedWidth));
+    std::vector<Pixel> pixels(static_cast<std::size_t>(extendedWidth) * extendedHeight);
+    const auto pixel = [&pixels, extendedWidth](const unsigned int row, const unsigned int column) -> Pixel& {
+        return pixels[static_cast<std::size_t>(row) * extendedWidth + column];
+    };
+
     // copy image main data
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            pixels[j + padding][i + padding] = originalData[j][i];
+            pixel(j + padding, i + padding) = image.at(j, i);
         }
     }
 
     // fill left internal new columns
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            pixels[j + padding][i] = originalData[j][0];
+            pixel(j + padding, i) = image.at(j, 0);
         }
     }
 
     // fill right internal new columns
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            pixels[j + padding][padding + width + i] = originalData[j][width - 1];
+            pixel(j + padding, padding + width + i) = image.at(j, width - 1);
         }
     }
 
     // fill top internal new rows
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            pixels[j][padding + i] = originalData[0][i];
+            pixel(j, padding + i) = image.at(0, i);
         }
     }
 
     // fill bottom internal new rows
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            pixels[padding + height + j][padding + i] = originalData[height - 1][i];
+            pixel(padding + height + j, padding + i) = image.at(height - 1, i);
         }
     }
 
     // fill corners
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            pixels[j][i] = originalData[0][0];                                                              // top-left
-            pixels[extendedHeight - 1 - j][i] = originalData[height - 1][0];                                // bottom-left
-            pixels[j][extendedWidth - 1 - i] = originalData[0][width - 1];                                  // top-right
-            pixels[extendedHeight - 1 - j][extendedWidth - 1 - i] = originalData[height - 1][width - 1];    // bottom-right
+            pixel(j, i) = image.at(0, 0);                                                              // top-left
+            pixel(extendedHeight - 1 - j, i) = image.at(height - 1, 0);                                // bottom-left
+            pixel(j, extendedWidth - 1 - i) = image.at(0, width - 1);                                  // top-right
+            pixel(extendedHeight - 1 - j, extendedWidth - 1 - i) = image.at(height - 1, width - 1);    // bottom-right
         }
     }
 
-    return std::make_unique<Image>(extendedWidth, extendedHeight, pixels);
+    return std::make_unique<Image>(extendedWidth, extendedHeight, std::move(pixels));
 }
\ No newline at end of file
@@ -10,12 +10,61 @@
  * Namespace for operations involving images.
  */
 namespace ImageProcessing {
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref separableConvolution
+     * and the one returned by @ref directConvolution with the same separable kernel.
+     *
+     * Both engines accumulate in single precision but sum the products in a different order, so the
+     * truncation to 8-bit unsigned integer may differ by one intensity level.
+     */
+    constexpr unsigned int SEPARABLE_TOLERANCE = 1;
+
+    /**
+     * Policies resolving the input values that a convolution reads outside the image near its edges.
+     *
+     * Given the row abcdefgh of an image, the values read on its left side are:
+     * - extend:   aaaa|abcdefgh
+     * - constant: 0000|abcdefgh
+     * - wrap:     efgh|abcdefgh
+     * - mirror:   edcb|abcdefgh
+     */
+    enum class EdgePolicy {
+        /**
+         * The nearest edge pixel is replicated, as in @ref extendEdge.
+         */
+        extend,
+
+        /**
+         * Pixels outside the image are black, i.e. all their channel values are zero.
+         */
+        constant,
+
+        /**
+         * The image repeats periodically, i.e. pixels outside an edge are read from the opposite one.
+         */
+        wrap,
+
+        /**
+         * The image is reflected around its edge pixels, which are not repeated.
+         */
+        mirror,
+
+        /**
+         * No pixel is read outside the image, thus the output image is cropped as in @ref convolution.
+         */
+        crop
+    };
+
     /**
      * Applies a convolution operation on the given image using the specified kernel.
      *
      * This operation reduces the size of the transformed image relative to the input image
      * by a number of pixels equal to the kernel order.
-     * To obtain an image without cropping, use @ref extendEdge before performing this operation.
+     * To obtain an image without cropping, pass an EdgePolicy, or use @ref extendEdge before performing
+     * this operation.
+     *
+     * The fastest available engine is picked automatically: separable kernels are processed by
+     * @ref separableConvolution, while the others by @ref directConvolution.
      *
      * @param image The input image on which the convolution operation will be performed.
      * @param kernel The kernel used for the convolution.
@@ -23,6 +72,57 @@ namespace ImageProcessing {
      */
     std::unique_ptr<Image> convolution(const Image& image, const Kernel& kernel);
 
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, resolving the values
+     * read outside the image by the given edge policy, so that the transformed image keeps the input sizes
+     * (unless the policy is EdgePolicy::crop).
+     *
+     * No padded copy of the image is made: the interior output pixels, whose neighborhood lies inside the image,
+     * are computed straight from the input by @ref convolution, while the output pixels along the edges are
+     * computed from small patches whose outer pixels are resolved by the policy.
+     * With EdgePolicy::extend, the result is the one of @ref convolution applied to the image returned
+     * by @ref extendEdge with half the kernel order as padding.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param edgePolicy The policy resolving the values outside the image.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> convolution(const Image& image, const Kernel& kernel, EdgePolicy edgePolicy);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel,
+     * by means of the full 2D sum of products for each output pixel, i.e. in O(K^2) per pixel.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> directConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified separable kernel,
+     * i.e. a kernel whose weights are the outer product of a vertical and a horizontal 1D kernel.
+     *
+     * Each output row is computed by a vertical 1D pass, which accumulates the involved input rows
+     * into a row buffer, followed by a horizontal 1D pass over that buffer, i.e. in O(K) per pixel.
+     * The result matches the one of @ref directConvolution within @ref SEPARABLE_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The separable kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the kernel is not separable.
+     */
+    std::unique_ptr<Image> separableConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Checks whether the given kernel is separable, i.e. whether its weights matrix has rank one.
+     *
+     * @param kernel The kernel to check.
+     * @return True if the kernel can be processed by @ref separableConvolution, false otherwise.
+     */
+    bool isSeparable(const Kernel& kernel);
+
     /**
      * Extends the edges of the given image by padding a specified number of pixels around it.
      * The edge pixels are replicated outward to fill the padding region.
@@ -0,0 +1,94 @@
+#ifndef SPAN_H
+#define SPAN_H
+#include <cstddef>
+
+
+/**
+ * Represents a non-owning view of a contiguous sequence of values, i.e. a pointer to its first value
+ * and its size, like the C++20 std::span.
+ *
+ * Views are cheap to copy and never allocate, but they must not outlive the viewed sequence.
+ *
+ * @tparam T The type of the viewed values, const-qualified for read-only views.
+ */
+template<typename T>
+class Span {
+public:
+    /**
+     * Constructs a view of the given sequence.
+     *
+     * @param data A pointer to the first value of the sequence.
+     * @param size The number of values in the sequence.
+     */
+    constexpr Span(T* data, const std::size_t size) noexcept: values(data), numValues(size) {}
+
+    /**
+     * Retrieves a pointer to the first viewed value.
+     *
+     * @return A pointer to the first value, valid as long as the viewed sequence.
+     */
+    [[nodiscard]] constexpr T* data() const noexcept {
+        return values;
+    }
+
+    /**
+     * Retrieves the number of viewed values.
+     *
+     * @return The size of the viewed sequence.
+     */
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return numValues;
+    }
+
+    /**
+     * Checks whether the view is empty.
+     *
+     * @return True if no value is viewed, false otherwise.
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return numValues == 0;
+    }
+
+    /**
+     * Retrieves the viewed value at the given position, without bounds checking.
+     *
+     * @param index The position of the value, less than the size.
+     * @return A reference to the value.
+     */
+    constexpr T& operator[](const std::size_t index) const noexcept {
+        return values[index];
+    }
+
+    /**
+     * Retrieves an iterator to the first viewed value.
+     *
+     * @return A pointer to the first value.
+     */
+    [[nodiscard]] constexpr T* begin() const noexcept {
+        return values;
+    }
+
+    /**
+     * Retrieves an iterator past the last viewed value.
+     *
+     * @return A pointer past the last value.
+     */
+    [[nodiscard]] constexpr T* end() const noexcept {
+        return values + numValues;
+    }
+
+private:
+    /**
+     * Points to the first viewed value.
+     */
+    T* values;
+
+    /**
+     * Represents the number of viewed values.
+     */
+    std::size_t numValues;
+};
+
+
+
+#endif //SPAN_H
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#include "image/Image.h"
+#include "image/reader/STBImageReader.h"
+#include "kernel/KernelFactory.h"
+#include "processing/ImageProcessing.h"
+
+namespace {
+    /**
+     * Counts the allocations made through the global operator new, i.e. by every standard allocator,
+     * whose size is at least the given threshold.
+     */
+    std::atomic<std::size_t> numAllocations{0};
+    std::atomic<std::size_t> countingThreshold{0};
+}
+
+// the replacements below pair operator new with malloc and operator delete with free, which GCC would flag as
+// mismatched once it inlines them into their callers
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(const std::size_t size) {
+    if (size >= countingThreshold.load(std::memory_order_relaxed))
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size > 0 ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+class AllocationTest : public ::testing::Test {
+protected:
+    const unsigned int height = 48;
+    const unsigned int width = 64;
+    Image* imageToProcess = nullptr;
+
+    void SetUp() override {
+        std::vector<Pixel> pixels(width * height);
+        for (unsigned int k = 0; k < width * height; k++) {
+            pixels[k] = Pixel(static_cast<uint8_t>(k * 37 % 256), static_cast<uint8_t>(k * 91 % 256),
+                static_cast<uint8_t>(k * 13 % 256));
+        }
+        imageToProcess = new Image(width, height, std::move(pixels));
+    }
+
+    void TearDown() override {
+        delete imageToProcess;
+        imageToProcess = nullptr;
+    }
+
+    /**
+     * Starts counting the allocations of at least the given size.
+     */
+    static void startCounting(const std::size_t threshold) {
+        numAllocations = 0;
+        countingThreshold = threshold;
+    }
+
+    /**
+     * Stops counting the allocations.
+     *
+     * @return The number of allocations counted since the last start.
+     */
+    static std::size_t stopCounting() {
+        countingThreshold = 0;
+        return numAllocations;
+    }
+};
+
+
+TEST_F(AllocationTest, testImageConstructorWhenPixelsAreMoved) {
+    std::vector<Pixel> pixels(width * height);
+    const Pixel* pixelsData = pixels.data();
+
+    startCounting(1);
+    const Image image(width, height, std::move(pixels));
+    EXPECT_EQ(stopCounting(), 0);
+
+    EXPECT_EQ(image.viewData().data(), pixelsData);
+}
+
+TEST_F(AllocationTest, testKernelConstructorWhenWeightsAreMoved) {
+    std::string name = "kernelWithNameLongerThanTheSmallStringBuffer";
+    std::vector<float> weights(25, 0.04f);
+    const float* weightsData = weights.data();
+
+    startCounting(1);
+    const Kernel kernel(std::move(name), 5, std::move(weights));
+    EXPECT_EQ(stopCounting(), 0);
+
+    EXPECT_EQ(kernel.viewWeights().data(), weightsData);
+}
+
+TEST_F(AllocationTest, testKernelFactoryAllocatesOnlyWeights) {
+    constexpr unsigned int order = 7;
+
+    startCounting(order * order * sizeof(float));
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createEdgeDetectionKernel(order);
+    EXPECT_EQ(stopCounting(), 1);
+}
+
+TEST_F(AllocationTest, testConvolutionAllocatesOnlyOutputPixels) {
+    const std::size_t outputSize = (width - 2) * (height - 2) * sizeof(Pixel);
+
+    for (const auto &kernel : {KernelFactory::createBoxBlurKernel(3), KernelFactory::createEdgeDetectionKernel(3)}) {
+        startCounting(outputSize);
+        const std::unique_ptr<Image> outputImage = ImageProcessing::convolution(*imageToProcess, *kernel);
+        EXPECT_EQ(stopCounting(), 1);
+    }
+}
+
+TEST_F(AllocationTest, testReaderAllocatesOnlyPixels) {
+    std::stringstream filePathStream;
+    filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "allocationTestImage.jpg";
+    const std::string filePath = filePathStream.str();
+    STBImageReader imageReader;
+
+    // a single interleaved buffer is needed to save the pixels
+    startCounting(width * height);
+    imageReader.saveJPGImage(*imageToProcess, filePath);
+    EXPECT_EQ(stopCounting(), 1);
+
+    // the buffer decoded by stb is allocated by malloc, thus only the pixels are counted
+    startCounting(width * height);
+    const std::unique_ptr<Image> loadedImage = imageReader.loadRGBImage(filePath);
+    EXPECT_EQ(stopCounting(), 1);
+    EXPECT_EQ(loadedImage->getWidth(), width);
+    EXPECT_EQ(loadedImage->getHeight(), height);
+}
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
 #include <array>
 
 #include "image/Image.h"
 #include "kernel/Kernel.h"
+#include "kernel/KernelFactory.h"
 #include "processing/ImageProcessing.h"
 
 class ImageProcessingTest : public ::testing::Test {
@@ -36,7 +38,10 @@ protected:
         rgb24 = Pixel(90, 36, 217);
         const std::vector row2 = {rgb20, rgb21, rgb22, rgb23, rgb24};
 
-        imageToProcess = new Image(width, height, std::vector{row0, row1, row2});
+        std::vector<Pixel> pixels;
+        for (const auto &row : {row0, row1, row2})
+            pixels.insert(pixels.end(), row.begin(), row.end());
+        imageToProcess = new Image(width, height, std::move(pixels));
     }
 
     void TearDown() override {
@@ -62,12 +67,11 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreInRange) {
 
     EXPECT_EQ(imageProcessed->getHeight(), heightConvoluted);
     EXPECT_EQ(imageProcessed->getWidth(), widthConvoluted);
-    ASSERT_EQ(imageProcessed->getData().size(), heightConvoluted);
-    ASSERT_EQ(imageProcessed->getData()[0].size(), widthConvoluted);
+    ASSERT_EQ(imageProcessed->getData().size(), heightConvoluted * widthConvoluted);
     for (unsigned int i = 0; i < widthConvoluted; i++) {
-        EXPECT_EQ(imageProcessed->getData()[0][i].getR(), redsConvoluted[i]);
-        EXPECT_EQ(imageProcessed->getData()[0][i].getG(), greensConvoluted[i]);
-        EXPECT_EQ(imageProcessed->getData()[0][i].getB(), bluesConvoluted[i]);
+        EXPECT_EQ(imageProcessed->at(0, i).getR(), redsConvoluted[i]);
+        EXPECT_EQ(imageProcessed->at(0, i).getG(), greensConvoluted[i]);
+        EXPECT_EQ(imageProcessed->at(0, i).getB(), bluesConvoluted[i]);
     }
 }
 
@@ -76,11 +80,10 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreNegative) {
     std::vector<uint8_t> reds;
     std::vector<uint8_t> greens;
     std::vector<uint8_t> blues;
-    for (auto row : imageToProcess->getData()) {
-        std::transform(row.begin(), row.end(), std::back_inserter(reds), [](const Pixel& pixel){return pixel.getR();});
-        std::transform(row.begin(), row.end(), std::back_inserter(greens), [](const Pixel& pixel){return pixel.getG();});
-        std::transform(row.begin(), row.end(), std::back_inserter(blues), [](const Pixel& pixel){return pixel.getB();});
-    }
+    const auto pixels = imageToProcess->getData();
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(reds), [](const Pixel& pixel){return pixel.getR();});
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(greens), [](const Pixel& pixel){return pixel.getG();});
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(blues), [](const Pixel& pixel){return pixel.getB();});
     ASSERT_THAT(reds, testing::Contains(testing::Not(0)));
     ASSERT_THAT(greens, testing::Contains(testing::Not(0)));
     ASSERT_THAT(blues, testing::Contains(testing::Not(0)));
@@ -93,9 +96,9 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreNegative) {
     const std::unique_ptr<Image> imageProcessed = ImageProcessing::convolution(*imageToProcess, negativeKernel);
 
     for (unsigned int i = 0; i < 3; i++) {
-        EXPECT_EQ(imageProcessed->getData()[0][i].getR(), 0);
-        ASSERT_EQ(imageProcessed->getData()[0][i].getG(), 0);
-        ASSERT_EQ(imageProcessed->getData()[0][i].getB(), 0);
+        EXPECT_EQ(imageProcessed->at(0, i).getR(), 0);
+        ASSERT_EQ(imageProcessed->at(0, i).getG(), 0);
+        ASSERT_EQ(imageProcessed->at(0, i).getB(), 0);
     }
 }
 
@@ -104,11 +107,10 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreOutOfRange) {
     std::vector<uint8_t> reds;
     std::vector<uint8_t> greens;
     std::vector<uint8_t> blues;
-    for (auto row : imageToProcess->getData()) {
-        std::transform(row.begin(), row.end(), std::back_inserter(reds), [](const Pixel& pixel){return pixel.getR();});
-        std::transform(row.begin(), row.end(), std::back_inserter(greens), [](const Pixel& pixel){return pixel.getG();});
-        std::transform(row.begin(), row.end(), std::back_inserter(blues), [](const Pixel& pixel){return pixel.getB();});
-    }
+    const auto pixels = imageToProcess->getData();
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(reds), [](const Pixel& pixel){return pixel.getR();});
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(greens), [](const Pixel& pixel){return pixel.getG();});
+    std::transform(pixels.begin(), pixels.end(), std::back_inserter(blues), [](const Pixel& pixel){return pixel.getB();});
     ASSERT_THAT(reds, testing::Contains(testing::Not(0)));
     ASSERT_THAT(greens, testing::Contains(testing::Not(0)));
     ASSERT_THAT(blues, testing::Contains(testing::Not(0)));
@@ -121,12 +123,151 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreOutOfRange) {
     const std::unique_ptr<Image> imageProcessed = ImageProcessing::convolution(*imageToProcess, outOfRangeKernel);
 
     for (unsigned int i = 0; i < 3; i++) {
-        EXPECT_EQ(imageProcessed->getData()[0][i].getR(), 255);
-        EXPECT_EQ(imageProcessed->getData()[0][i].getG(), 255);
-        EXPECT_EQ(imageProcessed->getData()[0][i].getB(), 255);
+        EXPECT_EQ(imageProcessed->at(0, i).getR(), 255);
+        EXPECT_EQ(imageProcessed->at(0, i).getG(), 255);
+        EXPECT_EQ(imageProcessed->at(0, i).getB(), 255);
+    }
+}
+
+TEST_F(ImageProcessingTest, testIsSeparableWhenKernelIsRankOne) {
+    constexpr unsigned int order = 3;
+    const Kernel rankOneKernel("rankOneKernel", order, std::vector<float> {    1, 2, 1,
+                                                                                  2, 4, 2,
+                                                                                  1, 2, 1     });
+
+    EXPECT_TRUE(ImageProcessing::isSeparable(rankOneKernel));
+    EXPECT_TRUE(ImageProcessing::isSeparable(*KernelFactory::createBoxBlurKernel(order)));
+}
+
+TEST_F(ImageProcessingTest, testIsSeparableWhenKernelIsNotRankOne) {
+    constexpr unsigned int order = 3;
+
+    EXPECT_FALSE(ImageProcessing::isSeparable(*KernelFactory::createEdgeDetectionKernel(order)));
+}
+
+TEST_F(ImageProcessingTest, testSeparableConvolutionMatchesDirectConvolution) {
+    constexpr unsigned int largeHeight = 19;
+    constexpr unsigned int largeWidth = 23;
+    std::vector<Pixel> largePixels(largeWidth * largeHeight);
+    for (unsigned int k = 0; k < largeWidth * largeHeight; k++)
+        largePixels[k] = Pixel(k * 37 % 256, k * 91 % 256, k * 13 % 256);
+    const Image largeImage(largeWidth, largeHeight, largePixels);
+    constexpr unsigned int order = 5;
+    const std::vector<float> profile = {1, 4, 6, 4, 1};
+    std::vector<float> weights(order * order);
+    for (unsigned int j = 0; j < order; j++)
+        for (unsigned int i = 0; i < order; i++)
+            weights[j * order + i] = profile[j] * profile[i] / 256;
+    const Kernel gaussianKernel("gaussianKernel", order, weights);
+    const std::unique_ptr<Kernel> boxBlurKernel = KernelFactory::createBoxBlurKernel(order);
+
+    for (const Kernel* kernel : {&gaussianKernel, static_cast<const Kernel*>(boxBlurKernel.get())}) {
+        const std::unique_ptr<Image> separableImage = ImageProcessing::separableConvolution(largeImage, *kernel);
+        const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(largeImage, *kernel);
+
+        EXPECT_EQ(separableImage->getHeight(), directImage->getHeight());
+        EXPECT_EQ(separableImage->getWidth(), directImage->getWidth());
+        ASSERT_EQ(separableImage->getData().size(), directImage->getData().size());
+        for (unsigned int y = 0; y < directImage->getHeight(); y++) {
+            for (unsigned int x = 0; x < directImage->getWidth(); x++) {
+                const Pixel separablePixel = separableImage->at(y, x);
+                const Pixel directPixel = directImage->at(y, x);
+                EXPECT_NEAR(separablePixel.getR(), directPixel.getR(), ImageProcessing::SEPARABLE_TOLERANCE);
+                EXPECT_NEAR(separablePixel.getG(), directPixel.getG(), ImageProcessing::SEPARABLE_TOLERANCE);
+                EXPECT_NEAR(separablePixel.getB(), directPixel.getB(), ImageProcessing::SEPARABLE_TOLERANCE);
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testSeparableConvolutionWhenKernelIsNotSeparable) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    EXPECT_THROW(ImageProcessing::separableConvolution(*imageToProcess, *kernel), std::invalid_argument);
+}
+
+
+/**
+ * Builds the padded image that the given edge policy resolves virtually, by reflecting, wrapping
+ * or clamping each coordinate on its own.
+ */
+std::unique_ptr<Image> padImage(const Image& image, const unsigned int padding,
+    const ImageProcessing::EdgePolicy edgePolicy) {
+    const int width = static_cast<int>(image.getWidth());
+    const int height = static_cast<int>(image.getHeight());
+    const auto resolve = [edgePolicy](int coordinate, const int size) {
+        if (edgePolicy == ImageProcessing::EdgePolicy::extend)
+            return std::min(std::max(coordinate, 0), size - 1);
+        if (edgePolicy == ImageProcessing::EdgePolicy::wrap)
+            return ((coordinate % size) + size) % size;
+        if (edgePolicy == ImageProcessing::EdgePolicy::mirror) {
+            while (size > 1 && (coordinate < 0 || coordinate >= size))
+                coordinate = coordinate < 0 ? -coordinate : 2 * (size - 1) - coordinate;
+            return size > 1 ? coordinate : 0;
+        }
+        return coordinate >= 0 && coordinate < size ? coordinate : -1;
+    };
+
+    const unsigned int paddedWidth = width + 2 * padding;
+    const unsigned int paddedHeight = height + 2 * padding;
+    std::vector<Pixel> paddedPixels(paddedWidth * paddedHeight);
+    for (unsigned int y = 0; y < paddedHeight; y++) {
+        for (unsigned int x = 0; x < paddedWidth; x++) {
+            const int row = resolve(static_cast<int>(y) - static_cast<int>(padding), height);
+            const int column = resolve(static_cast<int>(x) - static_cast<int>(padding), width);
+            if (row >= 0 && column >= 0)
+                paddedPixels[y * paddedWidth + x] = image.at(row, column);
+        }
     }
+    return std::make_unique<Image>(paddedWidth, paddedHeight, std::move(paddedPixels));
 }
 
+TEST_F(ImageProcessingTest, testConvolutionWithEdgePolicyMatchesPaddedConvolution) {
+    constexpr unsigned int largeHeight = 19;
+    constexpr unsigned int largeWidth = 23;
+    std::vector<Pixel> largePixels(largeWidth * largeHeight);
+    for (unsigned int k = 0; k < largeWidth * largeHeight; k++)
+        largePixels[k] = Pixel(k * 37 % 256, k * 91 % 256, k * 13 % 256);
+    const Image largeImage(largeWidth, largeHeight, largePixels);
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::extend,
+        ImageProcessing::EdgePolicy::constant, ImageProcessing::EdgePolicy::wrap, ImageProcessing::EdgePolicy::mirror}) {
+        // the 5x3 image is smaller than the 5x5 kernels, so that it has no interior at all
+        for (const Image* image : {static_cast<const Image*>(imageToProcess), &largeImage}) {
+            for (const unsigned int order : {3, 5, 9}) {
+                const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+                const std::unique_ptr<Image> edgeImage = ImageProcessing::convolution(*image, *kernel, edgePolicy);
+                const std::unique_ptr<Image> paddedImage = padImage(*image, order / 2, edgePolicy);
+                const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*paddedImage, *kernel);
+
+                // sums are computed in the same order as for the padded image
+                EXPECT_EQ(edgeImage->getHeight(), image->getHeight());
+                EXPECT_EQ(edgeImage->getWidth(), image->getWidth());
+                ASSERT_EQ(edgeImage->getData().size(), directImage->getData().size());
+                for (unsigned int y = 0; y < directImage->getHeight(); y++) {
+                    for (unsigned int x = 0; x < directImage->getWidth(); x++) {
+                        EXPECT_EQ(edgeImage->at(y, x).getR(), directImage->at(y, x).getR());
+                        EXPECT_EQ(edgeImage->at(y, x).getG(), directImage->at(y, x).getG());
+                        EXPECT_EQ(edgeImage->at(y, x).getB(), directImage->at(y, x).getB());
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testConvolutionWithCropPolicy) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    const std::unique_ptr<Image> edgeImage =
+        ImageProcessing::convolution(*imageToProcess, *kernel, ImageProcessing::EdgePolicy::crop);
+
+    EXPECT_EQ(edgeImage->getWidth(), width - (order - 1));
+    EXPECT_EQ(edgeImage->getHeight(), height - (order - 1));
+}
 
 TEST_F(ImageProcessingTest, testExtendEdgeWithPositivePadding) {
     constexpr unsigned int padding = 1;
@@ -143,13 +284,12 @@ TEST_F(ImageProcessingTest, testExtendEdgeWithPositivePadding) {
 
     EXPECT_EQ(imageProcessed->getHeight(), heightExtended);
     EXPECT_EQ(imageProcessed->getWidth(), widthExtended);
-    ASSERT_EQ(imageProcessed->getData().size(), heightExtended);
-    ASSERT_EQ(imageProcessed->getData()[0].size(), widthExtended);
+    ASSERT_EQ(imageProcessed->getData().size(), heightExtended * widthExtended);
     for (unsigned int j = 0; j < heightExtended; j++) {
         for (unsigned int i = 0; i < widthExtended; i++) {
-            EXPECT_EQ(imageProcessed->getData()[j][i].getR(), pixelsProcessed[j][i].getR());
-            EXPECT_EQ(imageProcessed->getData()[j][i].getG(), pixelsProcessed[j][i].getG());
-            EXPECT_EQ(imageProcessed->getData()[j][i].getB(), pixelsProcessed[j][i].getB());
+            EXPECT_EQ(imageProcessed->at(j, i).getR(), pixelsProcessed[j][i].getR());
+            EXPECT_EQ(imageProcessed->at(j, i).getG(), pixelsProcessed[j][i].getG());
+            EXPECT_EQ(imageProcessed->at(j, i).getB(), pixelsProcessed[j][i].getB());
         }
     }
 }
@@ -167,13 +307,12 @@ TEST_F(ImageProcessingTest, testExtendEdgeWithZeroPadding) {
 
     EXPECT_EQ(imageProcessed->getHeight(), heightExtended);
     EXPECT_EQ(imageProcessed->getWidth(), widthExtended);
-    ASSERT_EQ(imageProcessed->getData().size(), heightExtended);
-    ASSERT_EQ(imageProcessed->getData()[0].size(), widthExtended);
+    ASSERT_EQ(imageProcessed->getData().size(), heightExtended * widthExtended);
     for (unsigned int j = 0; j < heightExtended; j++) {
         for (unsigned int i = 0; i < widthExtended; i++) {
-            EXPECT_EQ(imageProcessed->getData()[j][i].getR(), pixelsProcessed[j][i].getR());
-            EXPECT_EQ(imageProcessed->getData()[j][i].getG(), pixelsProcessed[j][i].getG());
-            EXPECT_EQ(imageProcessed->getData()[j][i].getB(), pixelsProcessed[j][i].getB());
+            EXPECT_EQ(imageProcessed->at(j, i).getR(), pixelsProcessed[j][i].getR());
+            EXPECT_EQ(imageProcessed->at(j, i).getG(), pixelsProcessed[j][i].getG());
+            EXPECT_EQ(imageProcessed->at(j, i).getB(), pixelsProcessed[j][i].getB());
         }
     }
     EXPECT_NE(imageToProcess, imageProcessed.get());
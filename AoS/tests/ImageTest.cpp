@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <stdexcept>
+
 #include "image/Image.h"
 
 
@@ -23,19 +25,69 @@ TEST(ImageTest, testConstructor) {
     const Pixel rgb23(10, 4, 65);
     const Pixel rgb24(90, 36, 217);
     const std::vector row2 = {rgb20, rgb21, rgb22, rgb23, rgb24};
-    const std::vector pixels = {row0, row1, row2};
+    std::vector<Pixel> pixels;
+    for (const auto &row : {row0, row1, row2})
+        pixels.insert(pixels.end(), row.begin(), row.end());
 
     Image image(width, height, pixels);
 
     EXPECT_EQ(image.getWidth(), width);
     EXPECT_EQ(image.getHeight(), height);
-    ASSERT_EQ(image.getData().size(), height);
-    ASSERT_EQ(image.getData()[0].size(), width);
+    ASSERT_EQ(image.getData().size(), width * height);
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            EXPECT_EQ(image.getData()[y * width + x].getR(), pixels[y * width + x].getR());
+            EXPECT_EQ(image.getData()[y * width + x].getG(), pixels[y * width + x].getG());
+            EXPECT_EQ(image.getData()[y * width + x].getB(), pixels[y * width + x].getB());
+        }
+    }
+}
+
+TEST(ImageTest, testConstructorWhenSizesDiffer) {
+    const std::vector pixels(6, Pixel());
+
+    EXPECT_THROW(Image(4, 2, pixels), std::invalid_argument);
+    EXPECT_THROW(Image(2, 4, pixels), std::invalid_argument);
+}
+
+TEST(ImageTest, testViewData) {
+    constexpr unsigned int height = 2;
+    constexpr unsigned int width = 2;
+    const std::vector pixels = {Pixel(120, 0, 130), Pixel(23, 58, 135),
+                                Pixel(1, 17, 225), Pixel(19, 89, 139)};
+
+    const Image image(width, height, pixels);
+    const auto view = image.viewData();
+
+    // the view refers to the pixels stored by the image, thus it is not a copy
+    EXPECT_EQ(view.data(), &image.at(0, 0));
+    EXPECT_EQ(view.data() + width * height - 1, &image.at(height - 1, width - 1));
+    ASSERT_EQ(view.size(), width * height);
+    for (unsigned int k = 0; k < width * height; k++) {
+        EXPECT_EQ(view[k].getR(), pixels[k].getR());
+        EXPECT_EQ(view[k].getG(), pixels[k].getG());
+        EXPECT_EQ(view[k].getB(), pixels[k].getB());
+    }
+}
+
+TEST(ImageTest, testRowIndexing) {
+    constexpr unsigned int height = 2;
+    constexpr unsigned int width = 3;
+    const std::vector pixels = {Pixel(120, 0, 130), Pixel(23, 58, 135), Pixel(44, 30, 20),
+                                Pixel(1, 17, 225), Pixel(19, 89, 139), Pixel(67, 12, 29)};
+
+    const Image image(width, height, pixels);
+
+    // rows are contiguous and width pixels apart
     for (unsigned int y = 0; y < height; y++) {
+        const auto row = image.viewRow(y);
+        ASSERT_EQ(row.size(), width);
+        EXPECT_EQ(row.data(), image.viewData().data() + y * width);
         for (unsigned int x = 0; x < width; x++) {
-            EXPECT_EQ(image.getData()[y][x].getR(), pixels[y][x].getR());
-            EXPECT_EQ(image.getData()[y][x].getG(), pixels[y][x].getG());
-            EXPECT_EQ(image.getData()[y][x].getB(), pixels[y][x].getB());
+            EXPECT_EQ(&image.at(y, x), row.data() + x);
+            EXPECT_EQ(image.at(y, x).getR(), pixels[y * width + x].getR());
+            EXPECT_EQ(image.at(y, x).getG(), pixels[y * width + x].getG());
+            EXPECT_EQ(image.at(y, x).getB(), pixels[y * width + x].getB());
         }
     }
-}
\ No newline at end of file
+}
@@ -98,4 +98,142 @@ TEST_P(EdgeDetectionKernelCreatorTest, testCreateEdgeDetectionKernel) {
 TEST_F(EdgeDetectionKernelCreatorTest, testCreateEdgeDetectionKernelWithEvenOrder) {
     constexpr unsigned int order = 4;
     EXPECT_THROW(KernelFactory::createEdgeDetectionKernel(order), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST(CompileTimeKernelWeightsTest, testBoxBlurWeights) {
+    constexpr auto weights = KernelFactory::boxBlurWeights<5>();
+    static_assert(weights.size() == 25);
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createBoxBlurKernel(5);
+
+    EXPECT_EQ(std::vector<float>(weights.begin(), weights.end()), kernel->getWeights());
+}
+
+TEST(CompileTimeKernelWeightsTest, testEdgeDetectionWeights) {
+    constexpr auto weights = KernelFactory::edgeDetectionWeights<5>();
+    static_assert(weights[0] == -1 && weights[6] == -2 && weights[12] == 32);
+    constexpr auto largeWeights = KernelFactory::edgeDetectionWeights<25>();
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createEdgeDetectionKernel(5);
+    const std::unique_ptr<Kernel> largeKernel = KernelFactory::createEdgeDetectionKernel(25);
+
+    EXPECT_EQ(std::vector<float>(weights.begin(), weights.end()), kernel->getWeights());
+    EXPECT_EQ(std::vector<float>(largeWeights.begin(), largeWeights.end()), largeKernel->getWeights());
+}
+
+
+class SharpenKernelFactoryTest :
+    public ::testing::TestWithParam<std::pair<unsigned int, std::vector<float>>> {
+protected:
+    std::string sharpenName = "sharpen";
+};
+
+INSTANTIATE_TEST_SUITE_P(, SharpenKernelFactoryTest,
+                         testing::Values(
+                             std::make_pair(1, std::vector<float>{1}),
+                             std::make_pair(3, std::vector<float>{
+                                 0, -1, 0,
+                                 -1, 5, -1,
+                                 0, -1, 0}),
+                             std::make_pair(5, std::vector<float>{
+                                 0, 0, -1, 0, 0,
+                                 0, -1, -2, -1, 0,
+                                 -1, -2, 17, -2, -1,
+                                 0, -1, -2, -1, 0,
+                                 0, 0, -1, 0, 0})),
+                        [](const testing::TestParamInfo<SharpenKernelFactoryTest::ParamType>& info) {
+                            std::stringstream suffixStream;
+                            suffixStream << "WhenOrderIs" << info.param.first;
+                            return suffixStream.str();
+                        });
+
+
+TEST_P(SharpenKernelFactoryTest, testCreateSharpenKernel) {
+    const unsigned int order = GetParam().first;
+    const std::vector<float> weights = GetParam().second;
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createSharpenKernel(order);
+
+    ASSERT_NE(kernel, nullptr);
+    EXPECT_EQ(kernel->getName(), sharpenName);
+    EXPECT_EQ(kernel->getOrder(), order);
+    ASSERT_EQ(kernel->getWeights().size(), order * order);
+    for (unsigned int i = 0; i < order * order; i++) {
+        EXPECT_EQ(kernel->getWeights()[i], weights[i]);
+    }
+}
+
+
+TEST_F(SharpenKernelFactoryTest, testCreateSharpenKernelWithEvenOrder) {
+    constexpr unsigned int order = 4;
+    EXPECT_THROW(KernelFactory::createSharpenKernel(order), std::invalid_argument);
+}
+
+TEST(CompileTimeKernelWeightsTest, testSharpenWeights) {
+    constexpr auto weights = KernelFactory::sharpenWeights<3>();
+    static_assert(weights[0] == 0 && weights[1] == -1 && weights[4] == 5);
+    constexpr auto largeWeights = KernelFactory::sharpenWeights<25>();
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createSharpenKernel(3);
+    const std::unique_ptr<Kernel> largeKernel = KernelFactory::createSharpenKernel(25);
+
+    EXPECT_EQ(std::vector<float>(weights.begin(), weights.end()), kernel->getWeights());
+    EXPECT_EQ(std::vector<float>(largeWeights.begin(), largeWeights.end()), largeKernel->getWeights());
+}
+
+TEST(KernelAlgebraTest, testCreateComposedKernel) {
+    const Kernel first("first", 3, std::vector<float>{0, 0, 0,
+                                                      1, 2, 0,
+                                                      0, 0, 0});
+    const Kernel second("second", 3, std::vector<float>{0, 1, 0,
+                                                        0, 0, 0,
+                                                        0, 3, 0});
+    const std::vector<float> weights = {0, 0, 0, 0, 0,
+                                        0, 1, 2, 0, 0,
+                                        0, 0, 0, 0, 0,
+                                        0, 3, 6, 0, 0,
+                                        0, 0, 0, 0, 0};
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createComposedKernel(first, second);
+
+    ASSERT_NE(kernel, nullptr);
+    EXPECT_EQ(kernel->getName(), "first_second");
+    EXPECT_EQ(kernel->getOrder(), 5);
+    EXPECT_EQ(kernel->getWeights(), weights);
+}
+
+TEST(KernelAlgebraTest, testCreateComposedKernelOfBoxBlurs) {
+    const auto boxBlur = KernelFactory::createBoxBlurKernel(3);
+    const std::vector<float> binomial = {1, 2, 3, 2, 1};
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createComposedKernel(*boxBlur, *boxBlur);
+
+    ASSERT_EQ(kernel->getOrder(), 5);
+    ASSERT_EQ(kernel->getWeights().size(), 25);
+    for (unsigned int j = 0; j < 5; j++) {
+        for (unsigned int i = 0; i < 5; i++) {
+            EXPECT_FLOAT_EQ(kernel->getWeights()[j * 5 + i], binomial[j] * binomial[i] / 81);
+        }
+    }
+}
+
+TEST(KernelAlgebraTest, testCreateScaledKernel) {
+    const auto sharpen = KernelFactory::createSharpenKernel(3);
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createScaledKernel(*sharpen, 0.5f);
+
+    EXPECT_EQ(kernel->getName(), sharpen->getName());
+    EXPECT_EQ(kernel->getOrder(), 3);
+    EXPECT_EQ(kernel->getWeights(), (std::vector<float>{0, -0.5, 0, -0.5, 2.5, -0.5, 0, -0.5, 0}));
+}
+
+TEST(KernelAlgebraTest, testCreateSumKernel) {
+    const Kernel identity("identity", 1, std::vector<float>{1});
+    const auto sharpen = KernelFactory::createSharpenKernel(3);
+
+    const std::unique_ptr<Kernel> kernel = KernelFactory::createSumKernel(*sharpen, identity);
+
+    EXPECT_EQ(kernel->getName(), "sharpen+identity");
+    EXPECT_EQ(kernel->getOrder(), 3);
+    EXPECT_EQ(kernel->getWeights(), (std::vector<float>{0, -1, 0, -1, 6, -1, 0, -1, 0}));
+}
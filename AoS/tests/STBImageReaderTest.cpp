@@ -38,7 +38,9 @@ TEST_F(STBImageReaderTest, testLoadRGBImageWhenImageExists) {
     const Pixel rgb23(10, 4, 64);
     const Pixel rgb24(90, 36, 217);
     const std::vector row2 = {rgb20, rgb21, rgb22, rgb23, rgb24};
-    const std::vector pixels = {row0, row1, row2};
+    std::vector<Pixel> pixels;
+    for (const auto &row : {row0, row1, row2})
+        pixels.insert(pixels.end(), row.begin(), row.end());
 
     std::stringstream inputFilePathStream;
     inputFilePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
@@ -49,13 +51,12 @@ TEST_F(STBImageReaderTest, testLoadRGBImageWhenImageExists) {
     ASSERT_NE(img, nullptr);
     EXPECT_EQ(img->getHeight(), height);
     EXPECT_EQ(img->getWidth(), width);
-    ASSERT_EQ(img->getData().size(), height);
-    ASSERT_EQ(img->getData()[0].size(), width);
+    ASSERT_EQ(img->getData().size(), width * height);
     for (unsigned int y = 0; y < height; ++y) {
         for (unsigned int x = 0; x < width; ++x) {
-            EXPECT_EQ(img->getData()[y][x].getR(), pixels[y][x].getR());
-            EXPECT_EQ(img->getData()[y][x].getG(), pixels[y][x].getG());
-            EXPECT_EQ(img->getData()[y][x].getB(), pixels[y][x].getB());
+            EXPECT_EQ(img->at(y, x).getR(), pixels[y * width + x].getR());
+            EXPECT_EQ(img->at(y, x).getG(), pixels[y * width + x].getG());
+            EXPECT_EQ(img->at(y, x).getB(), pixels[y * width + x].getB());
         }
     }
 }
@@ -71,8 +72,7 @@ TEST_F(STBImageReaderTest, testLoadRGBImageWhenImageDoesntExist) {
 TEST_F(STBImageReaderTest, testSaveJPGImageWhenPathExists) {
     constexpr unsigned int height = 3;
     constexpr unsigned int width = 5;
-    const std::vector aRow(width, Pixel());
-    const std::vector somePixels(height, aRow);
+    const std::vector somePixels(width * height, Pixel());
     const Image testImage(width, height, somePixels);
 
     std::stringstream outputFilePathStream;
@@ -90,8 +90,7 @@ TEST_F(STBImageReaderTest, testSaveJPGImageWhenPathExists) {
 TEST_F(STBImageReaderTest, testSaveJPGImageWhenPathDoesntExist) {
     constexpr unsigned int height = 3;
     constexpr unsigned int width = 5;
-    const std::vector aRow(width, Pixel());
-    const std::vector somePixels(height, aRow);
+    const std::vector somePixels(width * height, Pixel());
     const Image testImage(width, height, somePixels);
 
     const std::string outputFilePath = "this/path/doesnt/exist/testImage.jpg";
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+
+#include "timer/HighResolutionTimer.h"
+#include "image/Image.h"
+#include "kernel/Kernel.h"
+#include "image/reader/STBImageReader.h"
+#include "processing/ImageProcessing.h"
+#include "processing/cache/CacheTopology.h"
+#include "processing/fft/FftConvolution.h"
+#include "processing/simd/InstructionSet.h"
+#include "kernel/KernelFactory.h"
+#include "timer/SteadyTimer.h"
+#include "timer/Timer.h"
+
+
+/**
+ * Measures the execution time of the vectorized and FFT convolution engines for increasing kernel orders,
+ * in order to derive the cost constants used by ImageProcessing::isFftFaster.
+ */
+int main() {
+    constexpr unsigned int selectedOrders[] = {3, 5, 7, 9, 13, 19, 25, 31, 41, 51, 75, 101};
+    const std::string imageName = "4K-1";
+    const std::string cvsName = "kip_sequential_SoA_crossover.csv";
+
+    try {
+        // setup timer
+        std::unique_ptr<Timer> timer;
+        if constexpr (std::chrono::high_resolution_clock::is_steady)
+            timer = std::make_unique<HighResolutionTimer>();
+        else
+            timer = std::make_unique<SteadyTimer>();
+        const InstructionSet instructionSet = InstructionSets::detect();
+        std::cout << "Vectorized convolution uses " << InstructionSets::getName(instructionSet) <<
+            " instructions." << std::endl;
+        std::cout << "Cache topology: " << CacheTopology::detect().toString() << std::endl << std::endl;
+
+        // setup csv
+        std::ofstream csvFile(cvsName);
+        csvFile << "KernelDimension,VectorizedTime_s,FftTime_s,TapCost_ns,FftOperationCost_ns,FftEstimatedFaster" << "\n";
+
+        // load img
+        STBImageReader imageReader{};
+        std::stringstream fullPathStream;
+        fullPathStream << IMAGES_INPUT_DIRPATH << imageName << ".jpg";
+        const auto img = imageReader.loadRGBImage(fullPathStream.str());
+        std::cout << "Image " << imageName << " (" << img->getWidth() << "x" << img->getHeight() <<
+            ") loaded from: " << fullPathStream.str() << std::endl << std::endl;
+
+        for (const unsigned int order : selectedOrders) {
+            const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+            const unsigned int outputWidth = img->getWidth() - (order - 1);
+            const unsigned int outputHeight = img->getHeight() - (order - 1);
+            const double numValues = 3.0 * outputWidth * outputHeight;
+
+            const std::chrono::duration<double> vectorizedStart = timer->now();
+            ImageProcessing::vectorizedConvolution(*img, *kernel, instructionSet);
+            const std::chrono::duration<double> vectorizedTime = timer->now() - vectorizedStart;
+
+            // the first call computes the kernel spectrum, which is then cached
+            ImageProcessing::fftConvolution(*img, *kernel);
+            const std::chrono::duration<double> fftStart = timer->now();
+            ImageProcessing::fftConvolution(*img, *kernel);
+            const std::chrono::duration<double> fftTime = timer->now() - fftStart;
+
+            const unsigned int tileSize = FftConvolution::chooseTileSize(order);
+            const unsigned int validSize = tileSize - (order - 1);
+            const double numTileValues = 3.0 * validSize * validSize *
+                ((outputWidth + validSize - 1) / validSize) * ((outputHeight + validSize - 1) / validSize);
+            const double tapCost = vectorizedTime.count() * 1e9 / (numValues * order * order);
+            const double fftOperationCost = fftTime.count() * 1e9 /
+                (numTileValues * FftConvolution::estimateOperationsPerValue(order, tileSize));
+            std::cout << "Order " << order << ": vectorized " << vectorizedTime.count() << " s, FFT " <<
+                fftTime.count() << " s (tile " << tileSize << ")" << std::endl;
+
+            csvFile << order << ","
+                    << vectorizedTime.count() << ","
+                    << fftTime.count() << ","
+                    << tapCost << ","
+                    << fftOperationCost << ","
+                    << ImageProcessing::isFftFaster(order, outputWidth, outputHeight)
+                    << "\n";
+        }
+        csvFile.close();
+        std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "stb_image.h"
+#include "timer/HighResolutionTimer.h"
+#include "image/ImageBuffer.h"
+#include "image/reader/JpegDecoder.h"
+#include "image/reader/RawImageReader.h"
+#include "processing/parallel/ThreadPool.h"
+#include "processing/simd/ChannelLayout.h"
+#include "timer/SteadyTimer.h"
+#include "timer/Timer.h"
+
+
+/**
+ * Measures the decode-only throughput of the input JPEG images, comparing the interleaved path of stb followed
+ * by the split into planes with the planar decoder, sequential and parallel, and checks that all of them produce
+ * the same planes.
+ *
+ * The planes are also saved in the raw planar format, whose loads are timed together with a pass reading every
+ * value, since mapped pages are only read when they are first touched.
+ */
+int main() {
+    constexpr unsigned int numReps = 5;
+    const std::string cvsName = "kip_sequential_SoA_decode.csv";
+
+    try {
+        // setup timer
+        std::unique_ptr<Timer> timer;
+        if constexpr (std::chrono::high_resolution_clock::is_steady)
+            timer = std::make_unique<HighResolutionTimer>();
+        else
+            timer = std::make_unique<SteadyTimer>();
+
+        // setup csv
+        std::ofstream csvFile(cvsName);
+        csvFile << "ImageName,ImageDimension,NumReps,InterleavedTime_s,PlanarTime_s,Speedup,NumThreads,ParallelTime_s,"
+                   "RawTime_s,Identical" << "\n";
+
+        std::vector<std::filesystem::path> filePaths;
+        for (const auto& entry : std::filesystem::directory_iterator(IMAGES_INPUT_DIRPATH)) {
+            if (entry.path().extension() == ".jpg")
+                filePaths.push_back(entry.path());
+        }
+        std::sort(filePaths.begin(), filePaths.end());
+
+        RawImageReader rawImageReader{};
+        ThreadPool threadPool;
+        std::filesystem::create_directories(IMAGES_OUTPUT_DIRPATH);
+        for (const std::filesystem::path& filePath : filePaths) {
+            int width = 0, height = 0, channels = 0;
+            if (!stbi_info(filePath.generic_string().c_str(), &width, &height, &channels))
+                continue;
+            ImageBuffer interleavedBuffer(width, height);
+            ImageBuffer planarBuffer(width, height);
+            ImageBuffer parallelBuffer(width, height);
+
+            // interleaved decoding by stb, then split into planes
+            const std::chrono::duration<double> interleavedStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                unsigned char* pixels = stbi_load(filePath.generic_string().c_str(), &width, &height, &channels, 3);
+                if (!pixels)
+                    throw std::runtime_error("Image loading fails.");
+                const MutableImageView planes = interleavedBuffer.view();
+                ChannelLayout::deinterleave(pixels, width, height, planes.reds, planes.greens, planes.blues,
+                    planes.stride);
+                stbi_image_free(pixels);
+            }
+            const double interleavedTime = (timer->now() - interleavedStart).count() / numReps;
+
+            // planar decoding
+            const std::chrono::duration<double> planarStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                JpegDecoder decoder(filePath);
+                decoder.readRows(planarBuffer.view());
+            }
+            const double planarTime = (timer->now() - planarStart).count() / numReps;
+
+            // parallel planar decoding
+            const std::chrono::duration<double> parallelStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                JpegDecoder decoder(filePath, threadPool);
+                decoder.readRows(parallelBuffer.view());
+            }
+            const double parallelTime = (timer->now() - parallelStart).count() / numReps;
+
+            // raw planar loading, with the file already in the page cache after it is written
+            const std::string rawPath = std::string(IMAGES_OUTPUT_DIRPATH) + filePath.stem().string() + ".kip";
+            rawImageReader.saveJPGImage(Image(ImageBuffer{planarBuffer}), rawPath);
+            // the sum keeps the reading pass from being optimized away
+            unsigned long checksum = 0;
+            const std::chrono::duration<double> rawStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                const auto img = rawImageReader.loadRGBImage(rawPath);
+                for (const Span<const uint8_t> plane : {img->viewReds(), img->viewGreens(), img->viewBlues()}) {
+                    for (const uint8_t value : plane)
+                        checksum += value;
+                }
+            }
+            const double rawTime = (timer->now() - rawStart).count() / numReps;
+            const auto rawImg = rawImageReader.loadRGBImage(rawPath);
+            std::filesystem::remove(rawPath);
+
+            const bool isIdentical = std::equal(interleavedBuffer.viewReds().begin(),
+                    interleavedBuffer.viewReds().end(), planarBuffer.viewReds().begin()) &&
+                std::equal(interleavedBuffer.viewGreens().begin(), interleavedBuffer.viewGreens().end(),
+                    planarBuffer.viewGreens().begin()) &&
+                std::equal(interleavedBuffer.viewBlues().begin(), interleavedBuffer.viewBlues().end(),
+                    planarBuffer.viewBlues().begin()) &&
+                std::equal(rawImg->viewReds().begin(), rawImg->viewReds().end(), planarBuffer.viewReds().begin()) &&
+                std::equal(rawImg->viewGreens().begin(), rawImg->viewGreens().end(),
+                    planarBuffer.viewGreens().begin()) &&
+                std::equal(rawImg->viewBlues().begin(), rawImg->viewBlues().end(), planarBuffer.viewBlues().begin()) &&
+                std::equal(parallelBuffer.viewReds().begin(), parallelBuffer.viewReds().end(),
+                    planarBuffer.viewReds().begin()) &&
+                std::equal(parallelBuffer.viewGreens().begin(), parallelBuffer.viewGreens().end(),
+                    planarBuffer.viewGreens().begin()) &&
+                std::equal(parallelBuffer.viewBlues().begin(), parallelBuffer.viewBlues().end(),
+                    planarBuffer.viewBlues().begin());
+            const double numMegapixels = static_cast<double>(width) * height / 1e6;
+            std::cout << filePath.filename().string() << " (" << width << "x" << height << "): interleaved " <<
+                numMegapixels / interleavedTime << " MP/s, planar " << numMegapixels / planarTime << " MP/s, parallel " <<
+                numMegapixels / parallelTime << " MP/s on " << threadPool.getNumThreads() << " threads, raw " << numMegapixels / rawTime << " MP/s (checksum " << checksum << "), " <<
+                (isIdentical ? "identical" : "DIFFERENT") << " planes" << std::endl;
+
+            csvFile << filePath.stem().string() << ","
+                    << width << "x" << height << ","
+                    << numReps << ","
+                    << interleavedTime << ","
+                    << planarTime << ","
+                    << interleavedTime / planarTime << ","
+                    << threadPool.getNumThreads() << ","
+                    << parallelTime << ","
+                    << rawTime << ","
+                    << isIdentical
+                    << "\n";
+        }
+        csvFile.close();
+        std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "timer/HighResolutionTimer.h"
+#include "image/ImageBuffer.h"
+#include "image/reader/JpegDecoder.h"
+#include "image/reader/JpegEncoder.h"
+#include "processing/parallel/ThreadPool.h"
+#include "processing/simd/ChannelLayout.h"
+#include "timer/SteadyTimer.h"
+#include "timer/Timer.h"
+
+#define JPG_QUALITY 100
+
+/**
+ * Decodes the given file with stb into interleaved pixels.
+ */
+std::vector<uint8_t> decodeFile(const std::string& filePath) {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 3);
+    if (!data)
+        throw std::runtime_error("Image loading fails.");
+    std::vector<uint8_t> pixels(data, data + static_cast<std::size_t>(width) * height * 3);
+    stbi_image_free(data);
+    return pixels;
+}
+
+/**
+ * Measures the encode-only throughput of the input JPEG images at the quality of the image reader, comparing
+ * the interleaving followed by stb encoding with the planar encoder, both sequential and parallel, and checks
+ * that the three files decode to the same pixels.
+ */
+int main() {
+    constexpr unsigned int numReps = 5;
+    const std::string cvsName = "kip_sequential_SoA_encode.csv";
+
+    try {
+        // setup timer
+        std::unique_ptr<Timer> timer;
+        if constexpr (std::chrono::high_resolution_clock::is_steady)
+            timer = std::make_unique<HighResolutionTimer>();
+        else
+            timer = std::make_unique<SteadyTimer>();
+
+        // setup csv
+        std::ofstream csvFile(cvsName);
+        csvFile << "ImageName,ImageDimension,NumReps,NumThreads,StbTime_s,SequentialTime_s,ParallelTime_s,Speedup,"
+                   "Identical" << "\n";
+
+        std::vector<std::filesystem::path> filePaths;
+        for (const auto& entry : std::filesystem::directory_iterator(IMAGES_INPUT_DIRPATH)) {
+            if (entry.path().extension() == ".jpg")
+                filePaths.push_back(entry.path());
+        }
+        std::sort(filePaths.begin(), filePaths.end());
+
+        ThreadPool threadPool;
+        std::filesystem::create_directories(IMAGES_OUTPUT_DIRPATH);
+        for (const std::filesystem::path& filePath : filePaths) {
+            if (!JpegDecoder::isJpeg(filePath))
+                continue;
+            JpegDecoder decoder(filePath);
+            const unsigned int width = decoder.getWidth();
+            const unsigned int height = decoder.getHeight();
+            ImageBuffer buffer(width, height);
+            decoder.readRows(buffer.view());
+            const MutableImageView planes = buffer.view();
+            const ImageView input{width, height, planes.stride, planes.reds, planes.greens, planes.blues};
+            const std::string outputPath = std::string(IMAGES_OUTPUT_DIRPATH) + filePath.stem().string();
+            const std::string stbPath = outputPath + "_stb.jpg";
+            const std::string sequentialPath = outputPath + "_sequential.jpg";
+            const std::string parallelPath = outputPath + "_parallel.jpg";
+
+            // interleaving, then stb encoding
+            const std::chrono::duration<double> stbStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * 3);
+                ChannelLayout::interleave(planes.reds, planes.greens, planes.blues, planes.stride, width, height,
+                    pixels.data());
+                if (!stbi_write_jpg(stbPath.c_str(), static_cast<int>(width), static_cast<int>(height), 3,
+                    pixels.data(), JPG_QUALITY))
+                    throw std::runtime_error("Image saving fails.");
+            }
+            const double stbTime = (timer->now() - stbStart).count() / numReps;
+
+            // sequential planar encoding
+            const std::chrono::duration<double> sequentialStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                JpegEncoder encoder(sequentialPath, width, height, JPG_QUALITY);
+                encoder.writeRows(input);
+            }
+            const double sequentialTime = (timer->now() - sequentialStart).count() / numReps;
+
+            // parallel planar encoding, with restart intervals
+            const std::chrono::duration<double> parallelStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                JpegEncoder encoder(parallelPath, width, height, JPG_QUALITY, threadPool);
+                encoder.writeRows(input);
+            }
+            const double parallelTime = (timer->now() - parallelStart).count() / numReps;
+
+            const std::vector<uint8_t> stbPixels = decodeFile(stbPath);
+            const bool isIdentical = decodeFile(sequentialPath) == stbPixels && decodeFile(parallelPath) == stbPixels;
+            for (const std::string& path : {stbPath, sequentialPath, parallelPath})
+                std::filesystem::remove(path);
+            const double numMegapixels = static_cast<double>(width) * height / 1e6;
+            std::cout << filePath.filename().string() << " (" << width << "x" << height << "): stb " <<
+                numMegapixels / stbTime << " MP/s, sequential " << numMegapixels / sequentialTime <<
+                " MP/s, parallel " << numMegapixels / parallelTime << " MP/s on " << threadPool.getNumThreads() <<
+                " threads, " << (isIdentical ? "identical" : "DIFFERENT") << " pixels" << std::endl;
+
+            csvFile << filePath.stem().string() << ","
+                    << width << "x" << height << ","
+                    << numReps << ","
+                    << threadPool.getNumThreads() << ","
+                    << stbTime << ","
+                    << sequentialTime << ","
+                    << parallelTime << ","
+                    << stbTime / parallelTime << ","
+                    << isIdentical
+                    << "\n";
+        }
+        csvFile.close();
+        std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "timer/HighResolutionTimer.h"
+#include "image/ImageBuffer.h"
+#include "processing/simd/ChannelLayout.h"
+#include "processing/simd/InstructionSet.h"
+#include "timer/SteadyTimer.h"
+#include "timer/Timer.h"
+
+
+/**
+ * Measures the throughput of the conversions between interleaved pixels and channel planes, i.e. the ones
+ * performed by the reader after decoding and before encoding, for each supported instruction set.
+ */
+int main() {
+    constexpr unsigned int width = 7680;
+    constexpr unsigned int height = 4320;
+    constexpr unsigned int numReps = 20;
+    constexpr InstructionSet instructionSets[] = {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2};
+    const std::string cvsName = "kip_sequential_SoA_layout.csv";
+
+    try {
+        // setup timer
+        std::unique_ptr<Timer> timer;
+        if constexpr (std::chrono::high_resolution_clock::is_steady)
+            timer = std::make_unique<HighResolutionTimer>();
+        else
+            timer = std::make_unique<SteadyTimer>();
+
+        // setup csv
+        std::ofstream csvFile(cvsName);
+        csvFile << "Conversion,InstructionSet,NumReps,TimePerRep_s,Throughput_GBps" << "\n";
+
+        std::vector<uint8_t> interleaved(static_cast<std::size_t>(width) * height * 3);
+        for (std::size_t k = 0; k < interleaved.size(); k++)
+            interleaved[k] = static_cast<uint8_t>(k * 37 % 251);
+        ImageBuffer buffer(width, height);
+        const MutableImageView planes = buffer.view();
+        // each conversion reads and writes every value once
+        const double numBytes = 2.0 * static_cast<double>(interleaved.size());
+        std::cout << "Image " << width << "x" << height << " converted " << numReps << " times." << std::endl;
+
+        for (const InstructionSet instructionSet : instructionSets) {
+            if (!InstructionSets::isSupported(instructionSet))
+                continue;
+            const ChannelLayout::Deinterleave::Function deinterleave =
+                ChannelLayout::Deinterleave::select(instructionSet);
+            const ChannelLayout::Interleave::Function interleave = ChannelLayout::Interleave::select(instructionSet);
+
+            const std::chrono::duration<double> deinterleaveStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                for (unsigned int y = 0; y < height; y++) {
+                    const std::size_t pos = static_cast<std::size_t>(y) * planes.stride;
+                    deinterleave(interleaved.data() + static_cast<std::size_t>(y) * width * 3, planes.reds + pos,
+                        planes.greens + pos, planes.blues + pos, width);
+                }
+            }
+            const double deinterleaveTime = (timer->now() - deinterleaveStart).count() / numReps;
+
+            const std::chrono::duration<double> interleaveStart = timer->now();
+            for (unsigned int rep = 0; rep < numReps; rep++) {
+                for (unsigned int y = 0; y < height; y++) {
+                    const std::size_t pos = static_cast<std::size_t>(y) * planes.stride;
+                    interleave(planes.reds + pos, planes.greens + pos, planes.blues + pos,
+                        interleaved.data() + static_cast<std::size_t>(y) * width * 3, width);
+                }
+            }
+            const double interleaveTime = (timer->now() - interleaveStart).count() / numReps;
+
+            const std::string name = InstructionSets::getName(instructionSet);
+            std::cout << name << ": deinterleave " << numBytes / deinterleaveTime / 1e9 << " GB/s, interleave " <<
+                numBytes / interleaveTime / 1e9 << " GB/s" << std::endl;
+            csvFile << "deinterleave," << name << "," << numReps << "," << deinterleaveTime << ","
+                    << numBytes / deinterleaveTime / 1e9 << "\n";
+            csvFile << "interleave," << name << "," << numReps << "," << interleaveTime << ","
+                    << numBytes / interleaveTime / 1e9 << "\n";
+        }
+        csvFile.close();
+        std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -5,9 +5,14 @@
 
 #include "timer/HighResolutionTimer.h"
 #include "image/Image.h"
+#include "image/ImageBuffer.h"
+#include "image/ImageView.h"
+#include "image/PlanePool.h"
 #include "kernel/Kernel.h"
 #include "image/reader/STBImageReader.h"
 #include "processing/ImageProcessing.h"
+#include "processing/cache/CacheTopology.h"
+#include "processing/simd/InstructionSet.h"
 #include "kernel/KernelFactory.h"
 #include "timer/SteadyTimer.h"
 #include "timer/Timer.h"
@@ -39,11 +44,18 @@ int main() {
             timer = std::make_unique<HighResolutionTimer>();
         else
             timer = std::make_unique<SteadyTimer>();
+        std::cout << "Vectorized convolution uses " << InstructionSets::getName(InstructionSets::detect()) <<
+            " instructions." << std::endl;
+        std::cout << "Cache topology: " << CacheTopology::detect().toString() << std::endl << std::endl;
 
         // setup csv
         std::ofstream csvFile(cvsName);
         csvFile << "ImageName,ImageDimension,KernelName,KernelDimension,NumReps,TotalTime_s,TimePerRep_s" << "\n";
 
+        // planes allocated by the reader and by each repetition are recycled instead of faulted in again
+        PlanePool planePool;
+        const PlanePool::Scope planePoolScope(planePool);
+
         // setup image reader
         STBImageReader imageReader{};
         std::stringstream fullPathStream;
@@ -59,12 +71,11 @@ int main() {
                     ") loaded from: " << fullPathStream.str() << std::endl;
                 fullPathStream.str(std::string());
 
-                for (const unsigned int order : KernelInfos::selectedOrders) {
-                    // enlargement
-                    const auto extendedImage = ImageProcessing::extendEdge(*img, (order - 1) / 2);
-                    std::cout << "Image "  << imageName << " enlarged to " <<
-                        extendedImage->getWidth() << "x" << extendedImage->getHeight() << std::endl;
+                // output planes are allocated once, so that repetitions do not measure memory allocation
+                ImageBuffer outputBuffer(img->getWidth(), img->getHeight());
+                const MutableImageView outputView = outputBuffer.view();
 
+                for (const unsigned int order : KernelInfos::selectedOrders) {
                     for (const auto kernelType : KernelInfos::selectedTypes) {
                         // create kernel
                         std::unique_ptr<Kernel> kernel;
@@ -83,9 +94,8 @@ int main() {
 
                         // transform
                         const std::chrono::duration<double> wall_clock_time_start = timer->now();
-                        std::unique_ptr<Image> outputImage;
                         for (unsigned int rep = 0; rep < numReps; rep++)
-                            outputImage = ImageProcessing::convolution(*extendedImage, *kernel);
+                            ImageProcessing::convolution(*img, *kernel, ImageProcessing::EdgePolicy::extend, outputView);
                         const std::chrono::duration<double> wall_clock_time_end = timer->now();
                         const std::chrono::duration<double> wall_clock_time_duration = wall_clock_time_end - wall_clock_time_start;
                         std::cout << "Image processed " << numReps << " times in " << wall_clock_time_duration.count() << " seconds [Wall Clock]" <<
@@ -94,8 +104,9 @@ int main() {
                         // save
                         fullPathStream << IMAGES_OUTPUT_DIRPATH << imageName <<
                             "_" << kernel->getName() << kernel->getOrder() << ".jpg";
-                        imageReader.saveJPGImage(*outputImage, fullPathStream.str());
-                        std::cout << "Image " << outputImage->getWidth() << "x" << outputImage->getHeight() <<
+                        const Image outputImage(ImageBuffer{outputBuffer});
+                        imageReader.saveJPGImage(outputImage, fullPathStream.str());
+                        std::cout << "Image " << outputImage.getWidth() << "x" << outputImage.getHeight() <<
                             " saved at: " << fullPathStream.str() << std::endl << std::endl;
                         fullPathStream.str(std::string());
 
@@ -122,6 +133,7 @@ int main() {
             }
         }
         csvFile.close();
+        std::cout << "Plane pool: " << planePool.toString() << std::endl;
         std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
 
     } catch (const std::exception& ex) {
@@ -27,18 +27,13 @@ int main() {
             ") loaded from: " << fullPathStream.str() << std::endl;
         fullPathStream.str(std::string());
 
-        // enlargement
-        const auto extendedImage = ImageProcessing::extendEdge(*img, (order - 1) / 2);
-        std::cout << "Image "  << imageName << " enlarged to " <<
-            extendedImage->getWidth() << "x" << extendedImage->getHeight() << std::endl;
-
         // create kernel
         const auto kernel = KernelFactory::createBoxBlurKernel(order);
         std::cout << "Kernel \"" << kernel->getName() << "\" " << kernel->getOrder() << "x" << kernel->getOrder() <<
             " created." << std::endl;
 
         // transform
-        const auto outputImage = ImageProcessing::convolution(*extendedImage, *kernel);
+        const auto outputImage = ImageProcessing::convolution(*img, *kernel, ImageProcessing::EdgePolicy::extend);
 
         // save
         fullPathStream << IMAGES_OUTPUT_DIRPATH << imageName <<
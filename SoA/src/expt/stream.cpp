@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "timer/HighResolutionTimer.h"
+#include "image/reader/STBImageReader.h"
+#include "kernel/KernelFactory.h"
+#include "processing/ImageProcessing.h"
+#include "timer/SteadyTimer.h"
+#include "timer/Timer.h"
+
+
+/**
+ * Retrieves the peak resident memory of the process in megabytes, or zero where it is not available.
+ */
+double getPeakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1 << 20);
+#else
+    return static_cast<double>(usage.ru_maxrss) / (1 << 10);
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Measures the time and the peak memory of a blur of the input JPEG images, streamed from the decoder to the encoder
+ * a strip at a time, then loading, convolving and saving whole images as main does.
+ *
+ * Since the peak memory of a process never decreases, all the images are streamed before any whole image is loaded.
+ */
+int main() {
+    constexpr unsigned int order = 13;
+    const std::string cvsName = "kip_sequential_SoA_stream.csv";
+
+    try {
+        // setup timer
+        std::unique_ptr<Timer> timer;
+        if constexpr (std::chrono::high_resolution_clock::is_steady)
+            timer = std::make_unique<HighResolutionTimer>();
+        else
+            timer = std::make_unique<SteadyTimer>();
+
+        // setup csv
+        std::ofstream csvFile(cvsName);
+        csvFile << "Pipeline,ImageName,ImageDimension,KernelDimension,Time_s,PeakMemory_MB" << "\n";
+
+        std::vector<std::filesystem::path> filePaths;
+        for (const auto& entry : std::filesystem::directory_iterator(IMAGES_INPUT_DIRPATH)) {
+            if (entry.path().extension() == ".jpg")
+                filePaths.push_back(entry.path());
+        }
+        std::sort(filePaths.begin(), filePaths.end());
+
+        STBImageReader imageReader{};
+        const auto kernel = KernelFactory::createBoxBlurKernel(order);
+        const std::vector<Kernel> kernels = {*kernel};
+        std::filesystem::create_directories(IMAGES_OUTPUT_DIRPATH);
+        std::cout << "Peak memory before processing: " << getPeakMemory() << " MB" << std::endl;
+
+        for (const bool isStreamed : {true, false}) {
+            const std::string pipeline = isStreamed ? "streamed" : "whole";
+            for (const std::filesystem::path& filePath : filePaths) {
+                const std::string outputPath = std::string(IMAGES_OUTPUT_DIRPATH) + filePath.stem().string() + "_" +
+                    pipeline + ".jpg";
+                unsigned int width, height;
+
+                const std::chrono::duration<double> start = timer->now();
+                if (isStreamed) {
+                    const auto input = imageReader.openRGBImage(filePath);
+                    width = input->getWidth();
+                    height = input->getHeight();
+                    const auto output = imageReader.createJPGImage(outputPath, width, height);
+                    ImageProcessing::streamConvolution(*input, kernels, ImageProcessing::EdgePolicy::extend, *output);
+                } else {
+                    const auto img = imageReader.loadRGBImage(filePath);
+                    width = img->getWidth();
+                    height = img->getHeight();
+                    const auto outputImage = ImageProcessing::convolution(*img, *kernel,
+                        ImageProcessing::EdgePolicy::extend);
+                    imageReader.saveJPGImage(*outputImage, outputPath);
+                }
+                const double time = (timer->now() - start).count();
+                const double peakMemory = getPeakMemory();
+
+                std::cout << pipeline << " " << filePath.filename().string() << " (" << width << "x" << height <<
+                    "): " << time << " s, peak memory " << peakMemory << " MB" << std::endl;
+                csvFile << pipeline << ","
+                        << filePath.stem().string() << ","
+                        << width << "x" << height << ","
+                        << order << ","
+                        << time << ","
+                        << peakMemory
+                        << "\n";
+            }
+        }
+        csvFile.close();
+        std::cout << "Data saved on " << CMAKE_BINARY_DIR << "/" << cvsName << std::endl;
+
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,27 +1,72 @@
 #include "Image.h"
 
+#include <cstring>
+#include <stdexcept>
+
 Image::Image(const unsigned int w, const unsigned int h, const std::vector<uint8_t>& reds,
-    const std::vector<uint8_t>& greens, const std::vector<uint8_t>& blues):
-    width(w), height(h), reds(reds), greens(greens), blues(blues) {}
+    const std::vector<uint8_t>& greens, const std::vector<uint8_t>& blues): buffer(w, h) {
+    const std::size_t size = static_cast<std::size_t>(w) * h;
+    if (reds.size() != size || greens.size() != size || blues.size() != size)
+        throw std::invalid_argument("The size of the planes differs from the size of the image.");
+    copyPlane(reds, buffer.viewReds());
+    copyPlane(greens, buffer.viewGreens());
+    copyPlane(blues, buffer.viewBlues());
+}
+
+Image::Image(ImageBuffer buffer): buffer(std::move(buffer)) {}
 
 Image::~Image() = default;
 
 unsigned int Image::getWidth() const {
-    return width;
+    return buffer.getWidth();
 }
 
 unsigned int Image::getHeight() const {
-    return height;
+    return buffer.getHeight();
+}
+
+unsigned int Image::getStride() const {
+    return buffer.getStride();
 }
 
 std::vector<uint8_t> Image::getReds() const {
-    return reds;
+    return packPlane(buffer.viewReds());
 }
 
 std::vector<uint8_t> Image::getGreens() const {
-    return greens;
+    return packPlane(buffer.viewGreens());
 }
 
 std::vector<uint8_t> Image::getBlues() const {
-    return blues;
+    return packPlane(buffer.viewBlues());
+}
+
+Span<const uint8_t> Image::viewReds() const {
+    return buffer.viewReds();
+}
+
+Span<const uint8_t> Image::viewGreens() const {
+    return buffer.viewGreens();
+}
+
+Span<const uint8_t> Image::viewBlues() const {
+    return buffer.viewBlues();
+}
+
+void Image::copyPlane(const std::vector<uint8_t> &values, const Span<uint8_t> plane) const {
+    const unsigned int width = buffer.getWidth();
+    const unsigned int stride = buffer.getStride();
+    for (unsigned int y = 0; y < buffer.getHeight(); y++)
+        std::memcpy(plane.data() + static_cast<std::size_t>(y) * stride,
+            values.data() + static_cast<std::size_t>(y) * width, width);
+}
+
+std::vector<uint8_t> Image::packPlane(const Span<const uint8_t> plane) const {
+    const unsigned int width = buffer.getWidth();
+    const unsigned int stride = buffer.getStride();
+    std::vector<uint8_t> values(static_cast<std::size_t>(width) * buffer.getHeight());
+    for (unsigned int y = 0; y < buffer.getHeight(); y++)
+        std::memcpy(values.data() + static_cast<std::size_t>(y) * width,
+            plane.data() + static_cast<std::size_t>(y) * stride, width);
+    return values;
 }
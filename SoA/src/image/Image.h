@@ -3,6 +3,9 @@
 #include <vector>
 #include <cstdint>
 
+#include "ImageBuffer.h"
+#include "view/Span.h"
+
 
 /**
  * Represents an image composed of pixel data in a two-dimensional structure.
@@ -15,14 +18,25 @@ public:
     /**
        * Constructs an Image object with the specified width, height, and pixel data.
        *
+       * Planes are copied by rows into a buffer with the default stride; use the ImageBuffer constructor
+       * to build an image without copying its planes.
+       *
        * @param w The width of the image in pixels.
        * @param h The height of the image in pixels.
        * @param reds A vector containing red component's values for the image.
        * @param greens A vector containing green component's values for the image.
        * @param blues A vector containing blue component's values for the image.
+       * @throw std::invalid_argument If the size of a plane differs from w * h.
        */
-    Image(unsigned int w, unsigned int h, const std::vector<uint8_t>& reds,
-        const std::vector<uint8_t>& greens, const std::vector<uint8_t>& blues);
+    Image(unsigned int w, unsigned int h, const std::vector<uint8_t>& reds, const std::vector<uint8_t>& greens,
+        const std::vector<uint8_t>& blues);
+
+    /**
+     * Constructs an Image object owning the planes of the given buffer, which is moved into the image.
+     *
+     * @param buffer The buffer holding the pixel data, e.g. written by a reader or by an operation.
+     */
+    explicit Image(ImageBuffer buffer);
 
     /**
      * Default destructor.
@@ -43,65 +57,76 @@ public:
      */
     [[nodiscard]] unsigned int getHeight() const;
 
+    /**
+     * Retrieves the distance between consecutive rows of the planes returned by the view accessors.
+     *
+     * @return The row stride, in values, at least the width.
+     */
+    [[nodiscard]] unsigned int getStride() const;
+
     /**
      * Retrieves the red components of the image.
      *
-     * @return The image's red channel values as a vector of 8-bit unsigned integer.
+     * @return The image's red channel values as a vector of 8-bit unsigned integer, without row padding.
      */
     [[nodiscard]] std::vector<uint8_t> getReds() const;
 
     /**
      * Retrieves the green components of the image.
      *
-     * @return The image's green channel values as a vector of 8-bit unsigned integer.
+     * @return The image's green channel values as a vector of 8-bit unsigned integer, without row padding.
      */
     [[nodiscard]] std::vector<uint8_t> getGreens() const;
 
     /**
      * Retrieves the blue components of the image.
      *
-     * @return The image's blue channel values as a vector of 8-bit unsigned integer.
+     * @return The image's blue channel values as a vector of 8-bit unsigned integer, without row padding.
      */
     [[nodiscard]] std::vector<uint8_t> getBlues() const;
 
-private:
     /**
-     * Represent the width of the image in pixels.
+     * Retrieves a read-only view of the red components of the image, without copying them.
      *
-     * The width determines the number of columns in the 2D pixel data of the image.
+     * @return A view of the image's red channel values, stored by rows getStride() values apart,
+     * valid as long as the image.
      */
-    unsigned int width;
+    [[nodiscard]] Span<const uint8_t> viewReds() const;
 
     /**
-     * Represents the height of the image in pixels.
+     * Retrieves a read-only view of the green components of the image, without copying them.
      *
-     * The height determines the number of rows in the 2D pixel data for the image.
+     * @return A view of the image's green channel values, stored by rows getStride() values apart,
+     * valid as long as the image.
      */
-    unsigned int height;
+    [[nodiscard]] Span<const uint8_t> viewGreens() const;
 
     /**
-     * Stores the red components for the whole image as a vector.
+     * Retrieves a read-only view of the blue components of the image, without copying them.
      *
-     * Each red value is stored as an 8-bit unsigned integer, allowing values
-     * between 0 and 255 to represent the intensity of the color channel.
+     * @return A view of the image's blue channel values, stored by rows getStride() values apart,
+     * valid as long as the image.
      */
-    std::vector<uint8_t> reds;
+    [[nodiscard]] Span<const uint8_t> viewBlues() const;
 
+private:
     /**
-     * Stores the green components for the whole image as a vector.
-     *
-     * Each green value is stored as an 8-bit unsigned integer, allowing values
-     * between 0 and 255 to represent the intensity of the color channel.
+     * Copies a plane stored without padding into the given plane of the buffer.
+     */
+    void copyPlane(const std::vector<uint8_t>& values, Span<uint8_t> plane) const;
+
+    /**
+     * Retrieves a copy of a plane of the buffer without its row padding.
      */
-    std::vector<uint8_t> greens;
+    [[nodiscard]] std::vector<uint8_t> packPlane(Span<const uint8_t> plane) const;
 
     /**
-     * Stores the blue components for the whole image as a vector.
+     * Stores the width, height, stride and the red, green and blue components of the image.
      *
-     * Each blue value is stored as an 8-bit unsigned integer, allowing values
+     * Each value is stored as an 8-bit unsigned integer, allowing values
      * between 0 and 255 to represent the intensity of the color channel.
      */
-    std::vector<uint8_t> blues;
+    ImageBuffer buffer;
 };
 
 
@@ -0,0 +1,124 @@
+#include "ImageBuffer.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// padding required after each row by the widest vector step, i.e. 32 output values of the AVX-512 engines
+#define MIN_ROW_PADDING 32
+// planes whose distance is a multiple of it would map onto the same cache sets
+#define ALIASING_PERIOD 4096
+
+ImageBuffer::ImageBuffer(const unsigned int w, const unsigned int h): ImageBuffer(w, h, chooseStride(w), false) {}
+
+ImageBuffer::ImageBuffer(const unsigned int w, const unsigned int h, const unsigned int s,
+    const bool isSingleAllocation): width(w), height(h), stride(s), planes{} {
+    if (stride < width) {
+        throw std::invalid_argument("The stride " + std::to_string(stride) + " is smaller than the width "
+            + std::to_string(width) + ".");
+    }
+
+    const std::size_t planeSize = getPlaneDistance(isSingleAllocation);
+    if (isSingleAllocation) {
+        allocations[0] = PlanePool::allocate(3 * planeSize);
+        for (unsigned int c = 0; c < 3; c++)
+            planes[c] = allocations[0].get() + c * planeSize;
+    } else {
+        for (unsigned int c = 0; c < 3; c++) {
+            allocations[c] = PlanePool::allocate(planeSize);
+            planes[c] = allocations[c].get();
+        }
+    }
+    for (uint8_t* plane : planes)
+        clearPadding(plane);
+}
+
+ImageBuffer::ImageBuffer(const unsigned int w, const unsigned int h, const unsigned int s, uint8_t *reds,
+    uint8_t *greens, uint8_t *blues, std::shared_ptr<void> owner): width(w), height(h), stride(s),
+    owner(std::move(owner)), planes{reds, greens, blues} {
+    if (stride < width) {
+        throw std::invalid_argument("The stride " + std::to_string(stride) + " is smaller than the width "
+            + std::to_string(width) + ".");
+    }
+}
+
+ImageBuffer::ImageBuffer(const ImageBuffer &other):
+    ImageBuffer(other.width, other.height, other.stride, other.isSingleAllocation()) {
+    const std::size_t planeSize = static_cast<std::size_t>(stride) * height;
+    for (unsigned int c = 0; c < 3; c++)
+        std::memcpy(planes[c], other.planes[c], planeSize);
+}
+
+ImageBuffer::ImageBuffer(ImageBuffer &&other) noexcept = default;
+
+ImageBuffer &ImageBuffer::operator=(ImageBuffer &&other) noexcept = default;
+
+ImageBuffer::~ImageBuffer() = default;
+
+unsigned int ImageBuffer::getWidth() const {
+    return width;
+}
+
+unsigned int ImageBuffer::getHeight() const {
+    return height;
+}
+
+unsigned int ImageBuffer::getStride() const {
+    return stride;
+}
+
+bool ImageBuffer::isSingleAllocation() const {
+    return allocations[0] && !allocations[1];
+}
+
+Span<uint8_t> ImageBuffer::viewReds() {
+    return {planes[0], static_cast<std::size_t>(stride) * height};
+}
+
+Span<uint8_t> ImageBuffer::viewGreens() {
+    return {planes[1], static_cast<std::size_t>(stride) * height};
+}
+
+Span<uint8_t> ImageBuffer::viewBlues() {
+    return {planes[2], static_cast<std::size_t>(stride) * height};
+}
+
+Span<const uint8_t> ImageBuffer::viewReds() const {
+    return {planes[0], static_cast<std::size_t>(stride) * height};
+}
+
+Span<const uint8_t> ImageBuffer::viewGreens() const {
+    return {planes[1], static_cast<std::size_t>(stride) * height};
+}
+
+Span<const uint8_t> ImageBuffer::viewBlues() const {
+    return {planes[2], static_cast<std::size_t>(stride) * height};
+}
+
+MutableImageView ImageBuffer::view() {
+    return {width, height, stride, planes[0], planes[1], planes[2]};
+}
+
+unsigned int ImageBuffer::chooseStride(const unsigned int width) {
+    unsigned int numLines = (width + MIN_ROW_PADDING + ALIGNMENT - 1) / ALIGNMENT;
+    if (numLines % 2 == 0)
+        numLines++;
+    return numLines * ALIGNMENT;
+}
+
+std::size_t ImageBuffer::getPlaneDistance(const bool isSingleAllocation) const {
+    std::size_t planeSize = static_cast<std::size_t>(stride) * height;
+    planeSize = (planeSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    // planes sharing an allocation are shifted by a line when their size would make them alias each other
+    if (isSingleAllocation && planeSize % ALIASING_PERIOD == 0)
+        planeSize += ALIGNMENT;
+    return planeSize;
+}
+
+void ImageBuffer::clearPadding(uint8_t *plane) const {
+    if (stride == width)
+        return;
+    for (unsigned int y = 0; y < height; y++)
+        std::memset(plane + static_cast<std::size_t>(y) * stride + width, 0, stride - width);
+}
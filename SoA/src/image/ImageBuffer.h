@@ -0,0 +1,222 @@
+#ifndef IMAGEBUFFER_H
+#define IMAGEBUFFER_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ImageView.h"
+#include "PlanePool.h"
+#include "view/Span.h"
+
+
+/**
+ * Represents the owned channel planes of an image, stored by rows; each plane is 64-byte aligned, and so is each row
+ * when the stride is a multiple of 64 values, as the default one.
+ *
+ * Consecutive rows are a configurable stride apart, which is at least the width of the image: the values
+ * after the width of each row are padding, so that vectorized engines can compute the last columns of
+ * each row with full vector steps, and so that rows do not map onto the same cache sets.
+ * The three planes are either allocated separately or carved out of a single allocation, taken from the
+ * installed PlanePool, if any, so that buffers allocated over and over recycle their memory.
+ */
+class ImageBuffer {
+public:
+    /**
+     * Constructs a buffer for an image of the given size, with the default stride and separately allocated planes.
+     *
+     * @param w The width of the image in pixels.
+     * @param h The height of the image in pixels.
+     */
+    ImageBuffer(unsigned int w, unsigned int h);
+
+    /**
+     * Constructs a buffer for an image of the given size and row stride.
+     *
+     * @param w The width of the image in pixels.
+     * @param h The height of the image in pixels.
+     * @param s The distance between consecutive rows of each plane, in values.
+     * @param isSingleAllocation Whether the three planes are carved out of a single allocation.
+     * @throw std::invalid_argument If the stride is smaller than the width.
+     */
+    ImageBuffer(unsigned int w, unsigned int h, unsigned int s, bool isSingleAllocation);
+
+    /**
+     * Constructs a buffer over planes that are not allocated by it, e.g. the ones of a memory-mapped file,
+     * which are kept alive by the given owner as long as the buffer.
+     *
+     * The padding after the width of each row is not cleared, so it must already be zero; read-only planes must
+     * only be read, e.g. through an Image built from the buffer.
+     *
+     * @param w The width of the image in pixels.
+     * @param h The height of the image in pixels.
+     * @param s The distance between consecutive rows of each plane, in values.
+     * @param reds The first value of the red plane, ImageBuffer::ALIGNMENT-byte aligned as the other ones.
+     * @param greens The first value of the green plane.
+     * @param blues The first value of the blue plane.
+     * @param owner The object releasing the planes once the buffer, or a buffer moved from it, is destroyed.
+     * @throw std::invalid_argument If the stride is smaller than the width.
+     */
+    ImageBuffer(unsigned int w, unsigned int h, unsigned int s, uint8_t* reds, uint8_t* greens, uint8_t* blues,
+        std::shared_ptr<void> owner);
+
+    /**
+     * Constructs a deep copy of the given buffer, with the same stride and allocation layout.
+     *
+     * @param other The buffer to copy.
+     */
+    ImageBuffer(const ImageBuffer& other);
+
+    /**
+     * Default move constructor.
+     */
+    ImageBuffer(ImageBuffer&& other) noexcept;
+
+    /**
+     * Default move assignment operator.
+     */
+    ImageBuffer& operator=(ImageBuffer&& other) noexcept;
+
+    /**
+     * Default destructor.
+     */
+    ~ImageBuffer();
+
+    /**
+     * Retrieves the width of the image.
+     *
+     * @return The width of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getWidth() const;
+
+    /**
+     * Retrieves the height of the image.
+     *
+     * @return The height of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getHeight() const;
+
+    /**
+     * Retrieves the distance between consecutive rows of each plane.
+     *
+     * @return The row stride, in values.
+     */
+    [[nodiscard]] unsigned int getStride() const;
+
+    /**
+     * Checks whether the three planes are carved out of a single allocation.
+     *
+     * @return True if the planes share a single allocation, false otherwise, e.g. if they are owned by another
+     * object.
+     */
+    [[nodiscard]] bool isSingleAllocation() const;
+
+    /**
+     * Retrieves a view of the red components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<uint8_t> viewReds();
+
+    /**
+     * Retrieves a view of the green components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<uint8_t> viewGreens();
+
+    /**
+     * Retrieves a view of the blue components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<uint8_t> viewBlues();
+
+    /**
+     * Retrieves a read-only view of the red components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<const uint8_t> viewReds() const;
+
+    /**
+     * Retrieves a read-only view of the green components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<const uint8_t> viewGreens() const;
+
+    /**
+     * Retrieves a read-only view of the blue components, stored by rows stride values apart.
+     *
+     * @return A view of stride * height values, valid as long as the buffer.
+     */
+    [[nodiscard]] Span<const uint8_t> viewBlues() const;
+
+    /**
+     * Retrieves a mutable view of the three planes, e.g. to write the result of an operation into the buffer.
+     *
+     * @return A view of the planes, valid as long as the buffer.
+     */
+    [[nodiscard]] MutableImageView view();
+
+    /**
+     * Chooses the default row stride for the given width: the smallest odd number of 64-byte lines holding
+     * the row and enough padding for the widest vector step, so that the rows are aligned and consecutive
+     * rows do not map onto the same cache sets.
+     *
+     * @param width The width of the image in pixels.
+     * @return The row stride, in values.
+     */
+    static unsigned int chooseStride(unsigned int width);
+
+    /**
+     * The alignment in bytes of each plane.
+     */
+    static constexpr unsigned int ALIGNMENT = 64;
+
+private:
+    /**
+     * Retrieves the distance between the first values of consecutive planes, i.e. the size of each plane
+     * rounded up to the alignment, and shifted by a line when planes share an allocation and would alias.
+     */
+    [[nodiscard]] std::size_t getPlaneDistance(bool isSingleAllocation) const;
+
+    /**
+     * Zeroes the padding after the width of each row of a plane, so that vectorized reads of it are defined.
+     */
+    void clearPadding(uint8_t* plane) const;
+
+    /**
+     * The width of the image in pixels.
+     */
+    unsigned int width;
+
+    /**
+     * The height of the image in pixels.
+     */
+    unsigned int height;
+
+    /**
+     * The distance between consecutive rows of each plane, in values.
+     */
+    unsigned int stride;
+
+    /**
+     * The owned allocations: either one per plane, or a single one holding all of them followed by empty ones.
+     */
+    PlanePool::Block allocations[3];
+
+    /**
+     * The owner of planes not allocated by the buffer, or null if they are.
+     */
+    std::shared_ptr<void> owner;
+
+    /**
+     * The first values of the red, green and blue planes, within the allocations.
+     */
+    uint8_t* planes[3];
+};
+
+
+
+#endif //IMAGEBUFFER_H
@@ -0,0 +1,83 @@
+#ifndef IMAGEVIEW_H
+#define IMAGEVIEW_H
+#include <cstdint>
+
+
+/**
+ * Represents a mutable, non-owning view of the channel planes of an image, e.g. of buffers preallocated
+ * by the caller to receive the result of an operation.
+ *
+ * Each plane stores height rows of width values, stride values apart; the viewed buffers must outlive the view.
+ */
+struct MutableImageView {
+    /**
+     * The width of the viewed image in pixels.
+     */
+    unsigned int width;
+
+    /**
+     * The height of the viewed image in pixels.
+     */
+    unsigned int height;
+
+    /**
+     * The distance between consecutive rows of each plane, at least the width.
+     */
+    unsigned int stride;
+
+    /**
+     * The red channel values.
+     */
+    uint8_t* reds;
+
+    /**
+     * The green channel values.
+     */
+    uint8_t* greens;
+
+    /**
+     * The blue channel values.
+     */
+    uint8_t* blues;
+};
+
+/**
+ * Represents a read-only, non-owning view of the channel planes of an image, e.g. of the rows handed to an encoder.
+ *
+ * Each plane stores height rows of width values, stride values apart; the viewed buffers must outlive the view.
+ */
+struct ImageView {
+    /**
+     * The width of the viewed image in pixels.
+     */
+    unsigned int width;
+
+    /**
+     * The height of the viewed image in pixels.
+     */
+    unsigned int height;
+
+    /**
+     * The distance between consecutive rows of each plane, at least the width.
+     */
+    unsigned int stride;
+
+    /**
+     * The red channel values.
+     */
+    const uint8_t* reds;
+
+    /**
+     * The green channel values.
+     */
+    const uint8_t* greens;
+
+    /**
+     * The blue channel values.
+     */
+    const uint8_t* blues;
+};
+
+
+
+#endif //IMAGEVIEW_H
@@ -0,0 +1,215 @@
+#include "PlanePool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "ImageBuffer.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#define DEFAULT_MAX_CACHED_SIZE (1024 * 1024 * 1024)
+// granularity of the page faults taken when pre-faulting a block
+#define BASE_PAGE_SIZE 4096
+// number of size classes between two consecutive powers of two
+#define CLASSES_PER_DOUBLING 4
+#define MEBIBYTE (1024 * 1024)
+
+namespace {
+    /**
+     * The pool installed by the innermost scope, or null if none is installed.
+     */
+    std::atomic<PlanePool*> installedPool{nullptr};
+}
+
+struct PlanePool::Shelves {
+    /**
+     * Protects the cached blocks and the statistics.
+     */
+    std::mutex mutex;
+
+    /**
+     * The cached blocks, grouped by size class.
+     */
+    std::unordered_map<std::size_t, std::vector<uint8_t*>> cachedBlocks;
+
+    /**
+     * The usage statistics.
+     */
+    Statistics statistics{};
+
+    /**
+     * The maximum size in bytes of the cached blocks.
+     */
+    std::size_t maxCachedSize;
+
+    /**
+     * Whether blocks of at least a huge page are advised to be backed by transparent huge pages.
+     */
+    bool useHugePages;
+
+    /**
+     * Whether blocks of at least a huge page are touched when they are allocated from the system.
+     */
+    bool preFault;
+
+    /**
+     * Whether the pool has been destroyed, in which case freed blocks are released to the system.
+     */
+    bool isClosed = false;
+
+    Shelves(const std::size_t maxCachedSize, const bool useHugePages, const bool preFault):
+        maxCachedSize(maxCachedSize), useHugePages(useHugePages), preFault(preFault) {}
+
+    ~Shelves() {
+        for (const auto& [size, blocks] : cachedBlocks) {
+            for (uint8_t* block : blocks)
+                freeBlock(block, size);
+        }
+    }
+
+    [[nodiscard]] bool isHuge(const std::size_t size) const {
+        return useHugePages && size >= HUGE_PAGE_SIZE;
+    }
+
+    /**
+     * Allocates a block from the system, advising and pre-faulting it if it is large enough.
+     */
+    uint8_t* allocateBlock(const std::size_t size) {
+        if (!isHuge(size))
+            return static_cast<uint8_t*>(::operator new(size, std::align_val_t(ImageBuffer::ALIGNMENT)));
+
+        auto* block = static_cast<uint8_t*>(::operator new(size, std::align_val_t(HUGE_PAGE_SIZE)));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // a failure only means that the block is backed by regular pages
+        madvise(block, size, MADV_HUGEPAGE);
+#endif
+        if (preFault) {
+            for (std::size_t offset = 0; offset < size; offset += BASE_PAGE_SIZE)
+                block[offset] = 0;
+        }
+        std::lock_guard lock(mutex);
+        statistics.hugePageSize += size;
+        return block;
+    }
+
+    /**
+     * Releases a block to the system; the mutex must not be held if the block is huge.
+     */
+    void freeBlock(uint8_t* block, const std::size_t size) {
+        if (!isHuge(size)) {
+            ::operator delete(block, std::align_val_t(ImageBuffer::ALIGNMENT));
+            return;
+        }
+        ::operator delete(block, std::align_val_t(HUGE_PAGE_SIZE));
+        std::lock_guard lock(mutex);
+        statistics.hugePageSize -= size;
+    }
+};
+
+void PlanePool::Releaser::operator()(uint8_t* block) const {
+    if (!shelves) {
+        ::operator delete(block, std::align_val_t(ImageBuffer::ALIGNMENT));
+        return;
+    }
+
+    {
+        std::lock_guard lock(shelves->mutex);
+        if (!shelves->isClosed && shelves->statistics.cachedSize + size <= shelves->maxCachedSize) {
+            shelves->cachedBlocks[size].push_back(block);
+            shelves->statistics.cachedSize += size;
+            return;
+        }
+        if (!shelves->isClosed)
+            shelves->statistics.numEvictions++;
+    }
+    shelves->freeBlock(block, size);
+}
+
+PlanePool::Scope::Scope(PlanePool& pool): previous(installedPool.exchange(&pool)) {}
+
+PlanePool::Scope::~Scope() {
+    installedPool.store(previous);
+}
+
+PlanePool::PlanePool(): PlanePool(DEFAULT_MAX_CACHED_SIZE, true, true) {}
+
+PlanePool::PlanePool(const std::size_t maxCachedSize, const bool useHugePages, const bool preFault):
+    shelves(std::make_shared<Shelves>(maxCachedSize, useHugePages, preFault)) {}
+
+PlanePool::~PlanePool() {
+    {
+        std::lock_guard lock(shelves->mutex);
+        shelves->isClosed = true;
+    }
+    trim();
+}
+
+PlanePool::Block PlanePool::acquire(const std::size_t size) {
+    Releaser releaser;
+    releaser.shelves = shelves;
+    releaser.size = getSizeClass(size);
+    {
+        std::lock_guard lock(shelves->mutex);
+        const auto shelf = shelves->cachedBlocks.find(releaser.size);
+        if (shelf != shelves->cachedBlocks.end() && !shelf->second.empty()) {
+            uint8_t* block = shelf->second.back();
+            shelf->second.pop_back();
+            shelves->statistics.cachedSize -= releaser.size;
+            shelves->statistics.numHits++;
+            return {block, std::move(releaser)};
+        }
+        shelves->statistics.numMisses++;
+    }
+    uint8_t* block = shelves->allocateBlock(releaser.size);
+    return {block, std::move(releaser)};
+}
+
+void PlanePool::trim() {
+    std::unordered_map<std::size_t, std::vector<uint8_t*>> blocksToFree;
+    {
+        std::lock_guard lock(shelves->mutex);
+        blocksToFree.swap(shelves->cachedBlocks);
+        shelves->statistics.cachedSize = 0;
+    }
+    for (const auto& [size, blocks] : blocksToFree) {
+        for (uint8_t* block : blocks)
+            shelves->freeBlock(block, size);
+    }
+}
+
+PlanePool::Statistics PlanePool::getStatistics() const {
+    std::lock_guard lock(shelves->mutex);
+    return shelves->statistics;
+}
+
+std::string PlanePool::toString() const {
+    const Statistics statistics = getStatistics();
+    std::stringstream description;
+    description << statistics.numHits << " hits, " << statistics.numMisses << " misses, " <<
+        statistics.numEvictions << " evictions, " << statistics.cachedSize / MEBIBYTE << " MiB cached, " <<
+        statistics.hugePageSize / MEBIBYTE << " MiB in huge pages";
+    return description.str();
+}
+
+std::size_t PlanePool::getSizeClass(const std::size_t size) {
+    std::size_t granule = ImageBuffer::ALIGNMENT;
+    while (granule * 2 * CLASSES_PER_DOUBLING <= size)
+        granule *= 2;
+    return (size + granule - 1) / granule * granule;
+}
+
+PlanePool::Block PlanePool::allocate(const std::size_t size) {
+    if (PlanePool* pool = getInstalled())
+        return pool->acquire(size);
+    return Block(static_cast<uint8_t*>(::operator new(size, std::align_val_t(ImageBuffer::ALIGNMENT))));
+}
+
+PlanePool* PlanePool::getInstalled() {
+    return installedPool.load();
+}
@@ -0,0 +1,202 @@
+#ifndef PLANEPOOL_H
+#define PLANEPOOL_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+/**
+ * Represents a pool of memory blocks recycled by size class, so that the planes of image buffers allocated and
+ * freed over and over, e.g. by the repetitions of a benchmark, reuse memory whose pages are already mapped instead
+ * of paying page faults and TLB misses each time.
+ *
+ * Each requested size is rounded up to its size class, i.e. to one of the four evenly spaced sizes between two
+ * consecutive powers of two, so that buffers of slightly different sizes, e.g. images padded for kernels of
+ * different orders, share their blocks. Freed blocks are kept until the cached size would exceed the given
+ * maximum, in which case they are released to the system.
+ *
+ * Blocks of at least a huge page can be aligned to the huge page size and advised to be backed by transparent
+ * huge pages, on Linux only, and pre-faulted when they are allocated, so that their first use is not slowed down.
+ *
+ * Image buffers take their planes from the pool installed by a @ref Scope, if any, and from the heap otherwise.
+ * The pool is thread-safe; blocks may outlive it, in which case they are released to the system once freed.
+ */
+class PlanePool final {
+    struct Shelves;
+
+public:
+    /**
+     * Represents the usage statistics of a pool.
+     */
+    struct Statistics {
+        /**
+         * The number of blocks served by recycling a cached block.
+         */
+        unsigned long numHits;
+
+        /**
+         * The number of blocks that had to be allocated from the system.
+         */
+        unsigned long numMisses;
+
+        /**
+         * The number of freed blocks released to the system because the cache was full.
+         */
+        unsigned long numEvictions;
+
+        /**
+         * The size in bytes of the blocks currently cached, i.e. freed and ready to be recycled.
+         */
+        std::size_t cachedSize;
+
+        /**
+         * The size in bytes of the blocks currently allocated and advised to be backed by huge pages.
+         */
+        std::size_t hugePageSize;
+    };
+
+    /**
+     * Releases a block, either to the pool which it was taken from or to the heap.
+     */
+    class Releaser {
+    public:
+        void operator()(uint8_t* block) const;
+
+    private:
+        friend class PlanePool;
+
+        /**
+         * The shelves of the pool which the block was taken from, or null for heap blocks.
+         */
+        std::shared_ptr<Shelves> shelves;
+
+        /**
+         * The size of the block, i.e. its size class for pooled blocks.
+         */
+        std::size_t size = 0;
+    };
+
+    /**
+     * An owned block of memory, aligned at least to ImageBuffer::ALIGNMENT.
+     */
+    using Block = std::unique_ptr<uint8_t, Releaser>;
+
+    /**
+     * Installs a pool for the lifetime of the scope, so that the image buffers constructed in the meantime
+     * by any thread take their planes from it; the previously installed pool, if any, is restored at the end.
+     *
+     * Scopes must be destroyed in the reverse order of their construction, and before the installed pool.
+     */
+    class Scope {
+    public:
+        /**
+         * Installs the given pool.
+         *
+         * @param pool The pool to install.
+         */
+        explicit Scope(PlanePool& pool);
+
+        /**
+         * Restores the previously installed pool.
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        /**
+         * The pool installed before this scope, or null if none was.
+         */
+        PlanePool* previous;
+    };
+
+    /**
+     * Constructs a PlanePool object with the default options: up to 1 GiB of cached blocks, and large blocks
+     * backed by pre-faulted huge pages.
+     */
+    PlanePool();
+
+    /**
+     * Constructs a PlanePool object with the specified options.
+     *
+     * @param maxCachedSize The maximum size in bytes of the blocks kept for recycling.
+     * @param useHugePages Whether blocks of at least a huge page are advised to be backed by transparent huge pages.
+     * @param preFault Whether blocks of at least a huge page are touched when they are allocated from the system.
+     */
+    PlanePool(std::size_t maxCachedSize, bool useHugePages, bool preFault);
+
+    /**
+     * Destructor which releases the cached blocks to the system.
+     */
+    ~PlanePool();
+
+    PlanePool(const PlanePool&) = delete;
+    PlanePool& operator=(const PlanePool&) = delete;
+
+    /**
+     * Takes a block of at least the given size, recycling a cached block of the same size class if there is one.
+     *
+     * @param size The size of the block in bytes.
+     * @return The block, which is given back to the pool when it is freed.
+     */
+    [[nodiscard]] Block acquire(std::size_t size);
+
+    /**
+     * Releases all cached blocks to the system; blocks currently in use are not affected.
+     */
+    void trim();
+
+    /**
+     * Retrieves the usage statistics of the pool.
+     *
+     * @return A snapshot of the statistics.
+     */
+    [[nodiscard]] Statistics getStatistics() const;
+
+    /**
+     * Retrieves a human-readable description of the statistics, e.g. for benchmark reports.
+     *
+     * @return A string describing hits, misses, evictions and cached size.
+     */
+    [[nodiscard]] std::string toString() const;
+
+    /**
+     * Retrieves the size class of the given size, i.e. the size of the blocks serving it.
+     *
+     * @param size The requested size in bytes.
+     * @return The size class in bytes, at least the given size.
+     */
+    static std::size_t getSizeClass(std::size_t size);
+
+    /**
+     * Takes a block from the installed pool, if any, or allocates it from the heap otherwise.
+     *
+     * @param size The size of the block in bytes.
+     * @return The block.
+     */
+    [[nodiscard]] static Block allocate(std::size_t size);
+
+    /**
+     * Retrieves the pool installed by the innermost scope.
+     *
+     * @return A pointer to the pool, or null if none is installed.
+     */
+    static PlanePool* getInstalled();
+
+    /**
+     * The size of a huge page in bytes, which large blocks are aligned to when huge pages are used.
+     */
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+private:
+    /**
+     * The cached blocks and the statistics, shared with the blocks taken from the pool.
+     */
+    std::shared_ptr<Shelves> shelves;
+};
+
+
+
+#endif //PLANEPOOL_H
@@ -1,5 +1,111 @@
 #include "ImageReader.h"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include "image/ImageBuffer.h"
+
+#define RGB_CHANNELS 3
+
+/**
+ * Returns the rows of an image loaded entirely.
+ */
+class LoadedRowReader final : public RowReader {
+public:
+    explicit LoadedRowReader(std::unique_ptr<Image> img): image(std::move(img)) {}
+
+    [[nodiscard]] unsigned int getWidth() const override {
+        return image->getWidth();
+    }
+
+    [[nodiscard]] unsigned int getHeight() const override {
+        return image->getHeight();
+    }
+
+    [[nodiscard]] unsigned int getNextRow() const override {
+        return nextRow;
+    }
+
+    void readRows(const MutableImageView &output) override {
+        if (output.width != getWidth())
+            throw std::invalid_argument("The width of the planes differs from the image one.");
+        if (output.height > getHeight() - nextRow)
+            throw std::invalid_argument("The number of rows exceeds the rows left.");
+
+        const uint8_t* inputs[RGB_CHANNELS] = {image->viewReds().data(), image->viewGreens().data(), image->viewBlues().data()};
+        uint8_t* outputs[RGB_CHANNELS] = {output.reds, output.greens, output.blues};
+        for (unsigned int y = 0; y < output.height; y++) {
+            for (unsigned int c = 0; c < RGB_CHANNELS; c++) {
+                std::copy_n(inputs[c] + static_cast<std::size_t>(nextRow) * image->getStride(), output.width,
+                    outputs[c] + static_cast<std::size_t>(y) * output.stride);
+            }
+            nextRow++;
+        }
+    }
+
+private:
+    std::unique_ptr<Image> image;
+    unsigned int nextRow = 0;
+};
+
+/**
+ * Collects the rows of an image, which is saved by the reader once the last row is written.
+ */
+class CollectedRowWriter final : public RowWriter {
+public:
+    CollectedRowWriter(ImageReader& reader, std::filesystem::path path, const unsigned int w, const unsigned int h):
+        imageReader(reader), filePath(std::move(path)), buffer(w, h), width(w), height(h) {}
+
+    [[nodiscard]] unsigned int getWidth() const override {
+        return width;
+    }
+
+    [[nodiscard]] unsigned int getHeight() const override {
+        return height;
+    }
+
+    [[nodiscard]] unsigned int getNextRow() const override {
+        return nextRow;
+    }
+
+    void writeRows(const ImageView &input) override {
+        if (input.width != getWidth())
+            throw std::invalid_argument("The width of the planes differs from the image one.");
+        if (input.height > getHeight() - nextRow)
+            throw std::invalid_argument("The number of rows exceeds the rows left.");
+
+        const MutableImageView planes = buffer.view();
+        const uint8_t* inputs[RGB_CHANNELS] = {input.reds, input.greens, input.blues};
+        uint8_t* outputs[RGB_CHANNELS] = {planes.reds, planes.greens, planes.blues};
+        for (unsigned int y = 0; y < input.height; y++) {
+            for (unsigned int c = 0; c < RGB_CHANNELS; c++) {
+                std::copy_n(inputs[c] + static_cast<std::size_t>(y) * input.stride, input.width,
+                    outputs[c] + static_cast<std::size_t>(nextRow) * planes.stride);
+            }
+            nextRow++;
+        }
+        if (input.height > 0 && nextRow == getHeight())
+            imageReader.saveJPGImage(Image(std::move(buffer)), filePath);
+    }
+
+private:
+    ImageReader& imageReader;
+    std::filesystem::path filePath;
+    ImageBuffer buffer;
+    unsigned int width;
+    unsigned int height;
+    unsigned int nextRow = 0;
+};
+
 ImageReader::ImageReader() = default;
 
 ImageReader::~ImageReader() = default;
+
+std::unique_ptr<RowReader> ImageReader::openRGBImage(const std::filesystem::path &filePath) {
+    return std::make_unique<LoadedRowReader>(loadRGBImage(filePath));
+}
+
+std::unique_ptr<RowWriter> ImageReader::createJPGImage(const std::filesystem::path &filePath,
+    const unsigned int width, const unsigned int height) {
+    return std::make_unique<CollectedRowWriter>(*this, filePath, width, height);
+}
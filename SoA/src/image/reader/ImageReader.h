@@ -1,8 +1,11 @@
 #ifndef IMAGEREADER_H
 #define IMAGEREADER_H
 #include <filesystem>
+#include <memory>
 
 #include "image/Image.h"
+#include "RowReader.h"
+#include "RowWriter.h"
 
 
 /**
@@ -35,11 +38,43 @@ public:
     /**
      * Saves an image in JPEG format to the specified file path.
      *
+     * Implementations of other formats save through it too: @ref RawImageReader writes its raw planar format,
+     * whatever the extension of the path.
+     *
      * @param img The Image object to save.
      * @param filePath The full or relative file path where the JPEG image will be saved.
      * @throw std::runtime_error If the image fails to save.
      */
     virtual void saveJPGImage(const Image& img, const std::filesystem::path& filePath) = 0;
+
+    /**
+     * Opens an RGB image from the specified file path, to be read a strip at a time.
+     *
+     * The default implementation loads the whole image by @ref loadRGBImage and copies its rows; implementations
+     * able to decode rows on demand override it, so that the memory held by the reader is bounded.
+     *
+     * @param filePath The full or relative file path to the image to open.
+     * @return A unique pointer to the RowReader object returning the rows of the image.
+     * @throw std::runtime_error If the image fails to load.
+     */
+    virtual std::unique_ptr<RowReader> openRGBImage(const std::filesystem::path& filePath);
+
+    /**
+     * Creates an image in JPEG format at the specified file path, to be written a strip at a time.
+     *
+     * The default implementation collects the rows into a whole image, which is saved by @ref saveJPGImage once
+     * the last row is written; implementations able to encode rows as they come override it, so that the memory
+     * held by the writer is bounded.
+     *
+     * @param filePath The full or relative file path where the JPEG image will be saved.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @return A unique pointer to the RowWriter object receiving the rows of the image.
+     * @throw std::invalid_argument If a size is not supported by the format.
+     * @throw std::runtime_error If the image fails to save.
+     */
+    virtual std::unique_ptr<RowWriter> createJPGImage(const std::filesystem::path& filePath, unsigned int width,
+        unsigned int height);
 };
 
 
@@ -0,0 +1,760 @@
+// the stb implementation lives here, since the decoder reuses its internal stages
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "JpegDecoder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define RGB_CHANNELS 3
+#define MAX_COMPONENTS 4
+// extra values of the line buffers, which are written past the width when upsampling by up to 4
+#define LINE_BUFFER_PADDING 3
+#define SSE2_STEP 16
+#define BLOCK_VALUES 64
+// tasks of each thread in a parallel operation, so that threads are balanced although tasks differ in cost
+#define TASKS_PER_THREAD 4
+
+/**
+ * Represents the coefficients of a block, aligned as the SIMD inverse DCT of stb reads them, also when the
+ * blocks are stored in a vector.
+ */
+struct CoefficientBlock {
+    alignas(16) short values[BLOCK_VALUES];
+};
+
+/**
+ * Converts a row of YCbCr values into three planes, with the same fixed-point arithmetic as stb, so that the
+ * results are identical to the interleaved ones.
+ */
+static void convertYCbCrRow(const uint8_t* luma, const uint8_t* blueChroma, const uint8_t* redChroma, uint8_t* reds,
+    uint8_t* greens, uint8_t* blues, const unsigned int count) {
+    unsigned int i = 0;
+#ifdef STBI_SSE2
+    // same steps as stbi__YCbCr_to_RGB_simd, storing each channel instead of transposing them
+    const __m128i signFlip = _mm_set1_epi8(-0x80);
+    const __m128i crConst0 = _mm_set1_epi16(static_cast<short>(1.40200f * 4096.0f + 0.5f));
+    const __m128i crConst1 = _mm_set1_epi16(-static_cast<short>(0.71414f * 4096.0f + 0.5f));
+    const __m128i cbConst0 = _mm_set1_epi16(-static_cast<short>(0.34414f * 4096.0f + 0.5f));
+    const __m128i cbConst1 = _mm_set1_epi16(static_cast<short>(1.77200f * 4096.0f + 0.5f));
+    const __m128i yBias = _mm_set1_epi8(static_cast<char>(128));
+
+    for (; i + SSE2_STEP <= count; i += SSE2_STEP) {
+        __m128i channels[RGB_CHANNELS][2];
+        for (unsigned int half = 0; half < 2; half++) {
+            const unsigned int x = i + 8 * half;
+            const __m128i yBytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(luma + x));
+            const __m128i crBytes = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(redChroma + x)),
+                signFlip);
+            const __m128i cbBytes = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(blueChroma + x)),
+                signFlip);
+
+            // unpack to 16 bits, shifting chroma left by 8
+            const __m128i yw = _mm_srli_epi16(_mm_unpacklo_epi8(yBias, yBytes), 4);
+            const __m128i crw = _mm_unpacklo_epi8(_mm_setzero_si128(), crBytes);
+            const __m128i cbw = _mm_unpacklo_epi8(_mm_setzero_si128(), cbBytes);
+
+            const __m128i rws = _mm_add_epi16(_mm_mulhi_epi16(crConst0, crw), yw);
+            const __m128i gws = _mm_add_epi16(_mm_add_epi16(_mm_mulhi_epi16(cbConst0, cbw), yw),
+                _mm_mulhi_epi16(crw, crConst1));
+            const __m128i bws = _mm_add_epi16(yw, _mm_mulhi_epi16(cbw, cbConst1));
+            channels[0][half] = _mm_srai_epi16(rws, 4);
+            channels[1][half] = _mm_srai_epi16(gws, 4);
+            channels[2][half] = _mm_srai_epi16(bws, 4);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(reds + i), _mm_packus_epi16(channels[0][0], channels[0][1]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(greens + i), _mm_packus_epi16(channels[1][0], channels[1][1]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(blues + i), _mm_packus_epi16(channels[2][0], channels[2][1]));
+    }
+#endif
+
+    // same steps as stbi__YCbCr_to_RGB_row
+    for (; i < count; i++) {
+        const int yFixed = (luma[i] << 20) + (1 << 19);
+        const int cr = redChroma[i] - 128;
+        const int cb = blueChroma[i] - 128;
+        int r = yFixed + cr * stbi__float2fixed(1.40200f);
+        int g = yFixed + (cr * -stbi__float2fixed(0.71414f)) + ((cb * -stbi__float2fixed(0.34414f)) & 0xffff0000);
+        int b = yFixed + cb * stbi__float2fixed(1.77200f);
+        r >>= 20;
+        g >>= 20;
+        b >>= 20;
+        reds[i] = static_cast<uint8_t>(r < 0 ? 0 : r > 255 ? 255 : r);
+        greens[i] = static_cast<uint8_t>(g < 0 ? 0 : g > 255 ? 255 : g);
+        blues[i] = static_cast<uint8_t>(b < 0 ? 0 : b > 255 ? 255 : b);
+    }
+}
+
+struct JpegDecoder::State {
+    /**
+     * The JPEG file, kept open while a streamed image is decoded.
+     */
+    FILE* file = nullptr;
+
+    /**
+     * The stb input context, reading the file.
+     */
+    stbi__context context{};
+
+    /**
+     * The stb decoder, holding the decoded components.
+     */
+    stbi__jpeg* jpeg = nullptr;
+
+    /**
+     * The resampling state of each component.
+     */
+    stbi__resample resamplers[MAX_COMPONENTS]{};
+
+    /**
+     * The indices of the component rows pointed by line0 and line1 of each resampling state, which are resolved
+     * right before each use, since streamed rows move around their window.
+     */
+    int lineRows[MAX_COMPONENTS][2]{};
+
+    /**
+     * The number of rows held for each component, i.e. all of them unless the image is streamed.
+     */
+    int windowHeights[MAX_COMPONENTS]{};
+
+    /**
+     * The number of rows of each component decoded so far.
+     */
+    int decodedRows[MAX_COMPONENTS]{};
+
+    /**
+     * Whether the rows of the components are decoded while reading.
+     */
+    bool isStreamed = false;
+
+    /**
+     * Whether the entropy-coded data ends before the last MCU, in which case the remaining ones are skipped
+     * as stb does.
+     */
+    bool isTruncated = false;
+
+    /**
+     * Whether the three components are RGB values instead of YCbCr ones.
+     */
+    bool isRgb = false;
+
+    /**
+     * The pool decoding the components and converting the rows in parallel, or null if the image is streamed.
+     */
+    ThreadPool* threadPool = nullptr;
+
+    /**
+     * The index of the next row to be read.
+     */
+    unsigned int nextRow = 0;
+
+    ~State() {
+        releaseDecoder();
+        if (file)
+            fclose(file);
+    }
+
+    void releaseDecoder() {
+        if (jpeg) {
+            stbi__cleanup_jpeg(jpeg);
+            STBI_FREE(jpeg);
+            jpeg = nullptr;
+        }
+    }
+
+    /**
+     * Sets up the stb decoder at the start of the file, as stbi__jpeg_load does.
+     */
+    void startDecoder() {
+        jpeg = static_cast<stbi__jpeg*>(stbi__malloc(sizeof(stbi__jpeg)));
+        if (!jpeg)
+            throw std::bad_alloc();
+        std::memset(jpeg, 0, sizeof(stbi__jpeg));
+        std::fseek(file, 0, SEEK_SET);
+        stbi__start_file(&context, file);
+        jpeg->s = &context;
+        stbi__setup_jpeg(jpeg);
+        jpeg->s->img_n = 0;
+    }
+
+    /**
+     * Replaces the full-size components allocated by stb, which are not touched yet, by windows of two rows of
+     * blocks of each component, or of MCUs if they are interleaved.
+     *
+     * Two rows are enough, since the resampling of an output row reads two adjacent rows of each component,
+     * and the rows are decoded only once the resampling reaches them.
+     */
+    void allocateWindows(const int unitHeights[MAX_COMPONENTS]) {
+        stbi__jpeg* z = jpeg;
+        for (int k = 0; k < z->s->img_n; k++) {
+            windowHeights[k] = 2 * unitHeights[k];
+            STBI_FREE(z->img_comp[k].raw_data);
+            z->img_comp[k].raw_data = stbi__malloc_mad2(z->img_comp[k].w2, windowHeights[k], 15);
+            if (!z->img_comp[k].raw_data)
+                throw std::bad_alloc();
+            // values are defined even if the data is truncated
+            std::memset(z->img_comp[k].raw_data, 0, static_cast<std::size_t>(z->img_comp[k].w2) * windowHeights[k]);
+            z->img_comp[k].data = reinterpret_cast<stbi_uc*>(
+                (reinterpret_cast<std::size_t>(z->img_comp[k].raw_data) + 15) & ~static_cast<std::size_t>(15));
+        }
+        isStreamed = true;
+    }
+
+    /**
+     * Keeps the full-size components allocated by stb, cleared so that values are defined even if the data is
+     * truncated, to be decoded entirely by the constructor.
+     */
+    void keepComponents() {
+        stbi__jpeg* z = jpeg;
+        for (int k = 0; k < z->s->img_n; k++) {
+            windowHeights[k] = z->img_comp[k].h2;
+            std::memset(z->img_comp[k].data, 0, static_cast<std::size_t>(z->img_comp[k].w2) * z->img_comp[k].h2);
+        }
+    }
+
+    /**
+     * Reads the headers and sets up the streaming: baseline images are read up to their first scan, which must
+     * hold all the components, whereas all the scans of progressive images are decoded into their coefficients,
+     * as stbi__decode_jpeg_image does, leaving the inverse DCT to the reads.
+     *
+     * With a thread pool, the same images are set up into full-size components instead of windows, which
+     * @ref decodeComponents then fills.
+     *
+     * @return True if the image can be streamed, false otherwise.
+     */
+    bool startStream() {
+        stbi__jpeg* z = jpeg;
+        for (int k = 0; k < MAX_COMPONENTS; k++) {
+            z->img_comp[k].raw_data = nullptr;
+            z->img_comp[k].raw_coeff = nullptr;
+        }
+        z->restart_interval = 0;
+        if (!stbi__decode_jpeg_header(z, STBI__SCAN_load))
+            return false;
+
+        const int unitHeights[MAX_COMPONENTS] = {8, 8, 8, 8};
+        int marker = stbi__get_marker(z);
+        if (z->progressive) {
+            if (threadPool)
+                keepComponents();
+            else
+                allocateWindows(unitHeights);
+            while (!stbi__EOI(marker)) {
+                if (stbi__SOS(marker)) {
+                    if (!stbi__process_scan_header(z) || !stbi__parse_entropy_coded_data(z))
+                        throw std::runtime_error(std::string("JPEG decoding fails: ") + stbi_failure_reason() + ".");
+                    if (z->marker == STBI__MARKER_none)
+                        z->marker = stbi__skip_jpeg_junk_at_end(z);
+                    marker = stbi__get_marker(z);
+                    if (STBI__RESTART(marker))
+                        marker = stbi__get_marker(z);
+                } else if (stbi__DNL(marker)) {
+                    const int length = stbi__get16be(z->s);
+                    const stbi__uint32 numLines = stbi__get16be(z->s);
+                    if (length != 4 || numLines != z->s->img_y)
+                        throw std::runtime_error("JPEG decoding fails: Corrupt JPEG.");
+                    marker = stbi__get_marker(z);
+                } else {
+                    if (!stbi__process_marker(z, marker))
+                        break;
+                    marker = stbi__get_marker(z);
+                }
+            }
+            return true;
+        }
+
+        while (!stbi__SOS(marker)) {
+            if (stbi__EOI(marker) || stbi__DNL(marker) || !stbi__process_marker(z, marker))
+                return false;
+            marker = stbi__get_marker(z);
+        }
+        if (!stbi__process_scan_header(z) || z->scan_n != z->s->img_n)
+            return false;
+        // a single component is not interleaved, thus it is decoded by rows of blocks
+        int mcuHeights[MAX_COMPONENTS] = {8, 8, 8, 8};
+        for (int k = 0; k < z->s->img_n && z->scan_n > 1; k++)
+            mcuHeights[k] = z->img_comp[k].v * 8;
+        if (threadPool)
+            keepComponents();
+        else
+            allocateWindows(mcuHeights);
+        stbi__jpeg_reset(z);
+        return true;
+    }
+
+    /**
+     * Decodes the whole image, as stbi__decode_jpeg_image does.
+     */
+    void decodeImage() {
+        if (!stbi__decode_jpeg_image(jpeg))
+            throw std::runtime_error(std::string("JPEG decoding fails: ") + stbi_failure_reason() + ".");
+        for (int k = 0; k < jpeg->s->img_n; k++) {
+            windowHeights[k] = jpeg->img_comp[k].h2;
+            decodedRows[k] = jpeg->img_comp[k].h2;
+        }
+    }
+
+    [[nodiscard]] stbi_uc* getComponentRow(const int component, const int row) const {
+        const int windowRow = row % windowHeights[component];
+        return jpeg->img_comp[component].data + static_cast<std::size_t>(windowRow) * jpeg->img_comp[component].w2;
+    }
+
+    /**
+     * Entropy-decodes the next block of a component with the given decoder, which holds the position in the
+     * data, into its dequantized coefficients.
+     */
+    static void decodeCoefficients(stbi__jpeg* z, const int component, short* coefficients) {
+        const int ha = z->img_comp[component].ha;
+        if (!stbi__jpeg_decode_block(z, coefficients, z->huff_dc + z->img_comp[component].hd, z->huff_ac + ha,
+            z->fast_ac[ha], component, z->dequant[z->img_comp[component].tq]))
+            throw std::runtime_error(std::string("JPEG decoding fails: ") + stbi_failure_reason() + ".");
+    }
+
+    void decodeBlock(const int component, stbi_uc* output, short* coefficients) const {
+        decodeCoefficients(jpeg, component, coefficients);
+        jpeg->idct_block_kernel(output, jpeg->img_comp[component].w2, coefficients);
+    }
+
+    /**
+     * Counts down the restart interval after an MCU.
+     *
+     * @return False if the data ends without a restart marker, true otherwise.
+     */
+    bool countDownRestart() {
+        stbi__jpeg* z = jpeg;
+        if (--z->todo <= 0) {
+            if (z->code_bits < 24)
+                stbi__grow_buffer_unsafe(z);
+            if (!STBI__RESTART(z->marker))
+                return false;
+            stbi__jpeg_reset(z);
+        }
+        return true;
+    }
+
+    /**
+     * Decodes the next row of MCUs of a baseline image into the windows, with the same steps as the baseline
+     * loops of stbi__parse_entropy_coded_data.
+     */
+    void decodeUnit() {
+        stbi__jpeg* z = jpeg;
+        STBI_SIMD_ALIGN(short, coefficients[64]);
+        if (z->scan_n == 1) {
+            const int n = z->order[0];
+            stbi_uc* row = getComponentRow(n, decodedRows[n]);
+            decodedRows[n] += 8;
+            for (int i = 0; i < (z->img_comp[n].x + 7) >> 3 && !isTruncated; i++) {
+                decodeBlock(n, row + i * 8, coefficients);
+                isTruncated = !countDownRestart();
+            }
+            return;
+        }
+
+        const int unit = decodedRows[0] / (z->img_comp[0].v * 8);
+        for (int k = 0; k < z->s->img_n; k++)
+            decodedRows[k] += z->img_comp[k].v * 8;
+        for (int i = 0; i < z->img_mcu_x && !isTruncated; i++) {
+            for (int k = 0; k < z->scan_n; k++) {
+                const int n = z->order[k];
+                for (int y = 0; y < z->img_comp[n].v; y++) {
+                    stbi_uc* row = getComponentRow(n, (unit * z->img_comp[n].v + y) * 8);
+                    for (int x = 0; x < z->img_comp[n].h; x++)
+                        decodeBlock(n, row + (i * z->img_comp[n].h + x) * 8, coefficients);
+                }
+            }
+            isTruncated = !countDownRestart();
+        }
+    }
+
+    /**
+     * Transforms the given row of blocks of a component of a progressive image into its window, with the same
+     * steps as stbi__jpeg_finish.
+     */
+    void transformBlockRow(const int component, const int j) const {
+        stbi__jpeg* z = jpeg;
+        stbi_uc* row = getComponentRow(component, j * 8);
+        for (int i = 0; i < (z->img_comp[component].x + 7) >> 3; i++) {
+            short* coefficients = z->img_comp[component].coeff + 64 * (i + j * z->img_comp[component].coeff_w);
+            stbi__jpeg_dequantize(coefficients, z->dequant[z->img_comp[component].tq]);
+            z->idct_block_kernel(row + i * 8, z->img_comp[component].w2, coefficients);
+        }
+    }
+
+    /**
+     * Decodes the rows of the given component up to the given one, if they are not decoded yet.
+     */
+    void decodeRows(const int component, const int row) {
+        while (row >= decodedRows[component]) {
+            if (jpeg->progressive) {
+                transformBlockRow(component, decodedRows[component] >> 3);
+                decodedRows[component] += 8;
+            } else {
+                decodeUnit();
+            }
+        }
+    }
+
+    /**
+     * Retrieves the number of MCUs of each row of MCUs of a baseline scan, i.e. of blocks if its single
+     * component is not interleaved.
+     */
+    [[nodiscard]] int getNumUnitMcus() const {
+        return jpeg->scan_n == 1 ? (jpeg->img_comp[jpeg->order[0]].x + 7) >> 3 : jpeg->img_mcu_x;
+    }
+
+    [[nodiscard]] int getNumUnits() const {
+        return jpeg->scan_n == 1 ? (jpeg->img_comp[jpeg->order[0]].y + 7) >> 3 : jpeg->img_mcu_y;
+    }
+
+    [[nodiscard]] int getNumMcuBlocks() const {
+        int numBlocks = 0;
+        for (int k = 0; k < jpeg->scan_n; k++)
+            numBlocks += jpeg->img_comp[jpeg->order[k]].h * jpeg->img_comp[jpeg->order[k]].v;
+        return numBlocks;
+    }
+
+    /**
+     * Calls the given function on each block of an MCU of a baseline scan, in coding order, with its component and
+     * its position in the full-size component.
+     */
+    template<typename BlockFunction>
+    void forEachBlock(const int mcu, const BlockFunction& function) const {
+        stbi__jpeg* z = jpeg;
+        if (z->scan_n == 1) {
+            const int n = z->order[0];
+            const int numUnitMcus = getNumUnitMcus();
+            function(n, z->img_comp[n].data + static_cast<std::size_t>(mcu / numUnitMcus) * 8 * z->img_comp[n].w2 +
+                mcu % numUnitMcus * 8);
+            return;
+        }
+        const int mcuX = mcu % z->img_mcu_x;
+        const int mcuY = mcu / z->img_mcu_x;
+        for (int k = 0; k < z->scan_n; k++) {
+            const int n = z->order[k];
+            for (int y = 0; y < z->img_comp[n].v; y++) {
+                stbi_uc* row = z->img_comp[n].data +
+                    static_cast<std::size_t>(mcuY * z->img_comp[n].v + y) * 8 * z->img_comp[n].w2;
+                for (int x = 0; x < z->img_comp[n].h; x++)
+                    function(n, row + (mcuX * z->img_comp[n].h + x) * 8);
+            }
+        }
+    }
+
+    /**
+     * Decodes the restart intervals of a baseline scan concurrently, each one by a copy of the decoder reset at
+     * its start, as the sequential decoder is when it meets the restart marker.
+     *
+     * @param data The entropy-coded data of the scan, up to the end of the file.
+     * @return False if the restart markers do not delimit one interval per restart period, in which case nothing
+     * is decoded, true otherwise.
+     */
+    bool decodeIntervals(const std::vector<stbi_uc>& data) {
+        stbi__jpeg* z = jpeg;
+        if (z->restart_interval <= 0)
+            return false;
+        // the intervals start after each restart marker, up to any other marker; stuffed zeros and fill bytes
+        // are not markers
+        std::vector<std::size_t> intervalStarts = {0};
+        for (std::size_t i = 0; i + 1 < data.size(); i++) {
+            if (data[i] != 0xFF || data[i + 1] == 0xFF)
+                continue;
+            if (data[i + 1] != 0x00 && !STBI__RESTART(data[i + 1]))
+                break;
+            if (data[i + 1] != 0x00)
+                intervalStarts.push_back(i + 2);
+            i++;
+        }
+        const int numMcus = getNumUnits() * getNumUnitMcus();
+        const auto numIntervals = static_cast<std::size_t>((numMcus + z->restart_interval - 1) / z->restart_interval);
+        if (intervalStarts.size() != numIntervals)
+            return false;
+
+        const unsigned int numTasks = static_cast<unsigned int>(std::min<std::size_t>(numIntervals,
+            static_cast<std::size_t>(threadPool->getNumThreads()) * TASKS_PER_THREAD));
+        threadPool->parallelFor(numTasks, [&](const unsigned int task) {
+            stbi__context intervalContext = context;
+            const auto decoder = std::make_unique<stbi__jpeg>(*z);
+            decoder->s = &intervalContext;
+            STBI_SIMD_ALIGN(short, coefficients[BLOCK_VALUES]);
+            for (std::size_t interval = numIntervals * task / numTasks;
+                interval < numIntervals * (task + 1) / numTasks; interval++) {
+                stbi__start_mem(&intervalContext, data.data() + intervalStarts[interval],
+                    static_cast<int>(data.size() - intervalStarts[interval]));
+                stbi__jpeg_reset(decoder.get());
+                const int end = std::min(static_cast<int>(interval + 1) * z->restart_interval, numMcus);
+                for (int mcu = static_cast<int>(interval) * z->restart_interval; mcu < end; mcu++) {
+                    forEachBlock(mcu, [&](const int component, stbi_uc* output) {
+                        decodeCoefficients(decoder.get(), component, coefficients);
+                        z->idct_block_kernel(output, z->img_comp[component].w2, coefficients);
+                    });
+                }
+            }
+        });
+        return true;
+    }
+
+    /**
+     * Decodes a baseline scan by batches of rows of MCUs: the entropy-coded data of a batch is decoded
+     * sequentially into coefficients, then the inverse DCT of its rows of MCUs is computed concurrently.
+     */
+    void decodeBatches() {
+        const int numUnitMcus = getNumUnitMcus();
+        const int numUnits = getNumUnits();
+        const int numMcuBlocks = getNumMcuBlocks();
+        const int batchUnits = static_cast<int>(threadPool->getNumThreads()) * TASKS_PER_THREAD;
+        const auto mcuSize = static_cast<std::size_t>(numMcuBlocks);
+        std::vector<CoefficientBlock> coefficients(static_cast<std::size_t>(batchUnits) * numUnitMcus * mcuSize);
+        for (int firstUnit = 0; firstUnit < numUnits && !isTruncated; firstUnit += batchUnits) {
+            const int numBatchUnits = std::min(batchUnits, numUnits - firstUnit);
+            const int firstMcu = firstUnit * numUnitMcus;
+            int numDecodedMcus = 0;
+            while (numDecodedMcus < numBatchUnits * numUnitMcus && !isTruncated) {
+                CoefficientBlock* mcuCoefficients = coefficients.data() + numDecodedMcus * mcuSize;
+                forEachBlock(firstMcu + numDecodedMcus, [&](const int component, stbi_uc*) {
+                    decodeCoefficients(jpeg, component, mcuCoefficients->values);
+                    mcuCoefficients++;
+                });
+                numDecodedMcus++;
+                isTruncated = !countDownRestart();
+            }
+
+            threadPool->parallelFor(numBatchUnits, [&](const unsigned int unit) {
+                const int end = std::min(static_cast<int>(unit + 1) * numUnitMcus, numDecodedMcus);
+                for (int mcu = static_cast<int>(unit) * numUnitMcus; mcu < end; mcu++) {
+                    CoefficientBlock* mcuCoefficients = coefficients.data() + mcu * mcuSize;
+                    forEachBlock(firstMcu + mcu, [&](const int component, stbi_uc* output) {
+                        jpeg->idct_block_kernel(output, jpeg->img_comp[component].w2, mcuCoefficients->values);
+                        mcuCoefficients++;
+                    });
+                }
+            });
+        }
+    }
+
+    /**
+     * Decodes the components set up by @ref startStream entirely, in the thread pool: the restart intervals of
+     * baseline images are decoded concurrently if there are any, otherwise only their inverse DCT is, as it is
+     * for the coefficients of progressive images.
+     */
+    void decodeComponents() {
+        stbi__jpeg* z = jpeg;
+        if (z->progressive) {
+            std::vector<std::pair<int, int>> blockRows;
+            for (int k = 0; k < z->s->img_n; k++) {
+                for (int j = 0; j < (z->img_comp[k].y + 7) >> 3; j++)
+                    blockRows.emplace_back(k, j);
+            }
+            threadPool->parallelFor(static_cast<unsigned int>(blockRows.size()), [&](const unsigned int task) {
+                transformBlockRow(blockRows[task].first, blockRows[task].second);
+            });
+        } else {
+            // the rest of the file, starting with the bytes already buffered by stb, is decoded from memory
+            std::vector<stbi_uc> data(context.img_buffer, context.img_buffer_end);
+            stbi_uc chunk[BUFSIZ];
+            for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;)
+                data.insert(data.end(), chunk, chunk + n);
+            stbi__start_mem(&context, data.data(), static_cast<int>(data.size()));
+            if (!decodeIntervals(data))
+                decodeBatches();
+            stbi__start_mem(&context, nullptr, 0);
+        }
+        for (int k = 0; k < z->s->img_n; k++)
+            decodedRows[k] = z->img_comp[k].h2;
+    }
+
+    /**
+     * Sets the resampling state of a component as it is after the given number of rows, which load_jpeg_image
+     * reaches one row at a time: the pair of component rows moves down every vs rows, starting half way.
+     */
+    void seekResampler(const int component, stbi__resample& r, int lineRows[2], const unsigned int row) const {
+        const int numSteps = (r.vs >> 1) + static_cast<int>(row);
+        const int numMoves = numSteps / r.vs;
+        const int lastRow = jpeg->img_comp[component].y - 1;
+        r.ystep = numSteps % r.vs;
+        r.ypos = numMoves;
+        lineRows[0] = std::min(std::max(numMoves - 1, 0), lastRow);
+        lineRows[1] = std::min(numMoves, lastRow);
+    }
+
+    /**
+     * Resamples the next row of each component into the given line buffers, as load_jpeg_image does, decoding
+     * the rows of MCUs as soon as they are read, then converts them straight into a row of the planes.
+     */
+    void readRow(stbi__resample* rs, int (*lineRows)[2], stbi_uc* const* lineBuffers, uint8_t* const* planes) {
+        stbi__jpeg* z = jpeg;
+        const unsigned int width = z->s->img_x;
+        const stbi_uc* components[MAX_COMPONENTS] = {};
+        for (int k = 0; k < z->s->img_n; k++) {
+            stbi__resample* r = &rs[k];
+            decodeRows(k, lineRows[k][1]);
+            r->line0 = getComponentRow(k, lineRows[k][0]);
+            r->line1 = getComponentRow(k, lineRows[k][1]);
+
+            const bool isBottom = r->ystep >= (r->vs >> 1);
+            components[k] = r->resample(lineBuffers[k], isBottom ? r->line1 : r->line0,
+                isBottom ? r->line0 : r->line1, r->w_lores, r->hs);
+            if (++r->ystep >= r->vs) {
+                r->ystep = 0;
+                lineRows[k][0] = lineRows[k][1];
+                if (++r->ypos < z->img_comp[k].y)
+                    lineRows[k][1]++;
+            }
+        }
+
+        // color conversion straight into the planes
+        if (z->s->img_n == 3 && isRgb) {
+            for (unsigned int c = 0; c < RGB_CHANNELS; c++)
+                std::memcpy(planes[c], components[c], width);
+        } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+            // CMYK
+            for (unsigned int x = 0; x < width; x++) {
+                const stbi_uc m = components[3][x];
+                for (unsigned int c = 0; c < RGB_CHANNELS; c++)
+                    planes[c][x] = stbi__blinn_8x8(components[c][x], m);
+            }
+        } else if (z->s->img_n >= 3) {
+            convertYCbCrRow(components[0], components[1], components[2], planes[0], planes[1], planes[2], width);
+            // YCCK, whereas the fourth channel of other 4-component images is ignored
+            if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+                for (unsigned int x = 0; x < width; x++) {
+                    const stbi_uc m = components[3][x];
+                    for (unsigned int c = 0; c < RGB_CHANNELS; c++)
+                        planes[c][x] = stbi__blinn_8x8(255 - planes[c][x], m);
+                }
+            }
+        } else {
+            // grayscale
+            for (unsigned int c = 0; c < RGB_CHANNELS; c++)
+                std::memcpy(planes[c], components[0], width);
+        }
+    }
+};
+
+JpegDecoder::JpegDecoder(const std::filesystem::path &filePath): JpegDecoder(filePath, nullptr) {}
+
+JpegDecoder::JpegDecoder(const std::filesystem::path &filePath, ThreadPool &threadPool):
+    JpegDecoder(filePath, &threadPool) {}
+
+JpegDecoder::JpegDecoder(const std::filesystem::path &filePath, ThreadPool *threadPool):
+    state(std::make_unique<State>()) {
+    state->file = stbi__fopen(filePath.generic_string().c_str(), "rb");
+    if (!state->file)
+        throw std::runtime_error("Unable to open " + filePath.generic_string() + ".");
+    state->threadPool = threadPool;
+
+    state->startDecoder();
+    if (!state->startStream()) {
+        // decoded again from the start, as stbi__jpeg_load does
+        state->releaseDecoder();
+        state->startDecoder();
+        state->decodeImage();
+        fclose(state->file);
+        state->file = nullptr;
+    } else if (threadPool) {
+        state->decodeComponents();
+        fclose(state->file);
+        state->file = nullptr;
+    }
+
+    stbi__jpeg* z = state->jpeg;
+    state->isRgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+    for (int k = 0; k < z->s->img_n; k++) {
+        stbi__resample* r = &state->resamplers[k];
+        z->img_comp[k].linebuf = static_cast<stbi_uc*>(stbi__malloc(z->s->img_x + LINE_BUFFER_PADDING));
+        if (!z->img_comp[k].linebuf)
+            throw std::bad_alloc();
+
+        r->hs = z->img_h_max / z->img_comp[k].h;
+        r->vs = z->img_v_max / z->img_comp[k].v;
+        r->ystep = r->vs >> 1;
+        r->w_lores = (static_cast<int>(z->s->img_x) + r->hs - 1) / r->hs;
+        r->ypos = 0;
+        if (r->hs == 1 && r->vs == 1)
+            r->resample = resample_row_1;
+        else if (r->hs == 1 && r->vs == 2)
+            r->resample = stbi__resample_row_v_2;
+        else if (r->hs == 2 && r->vs == 1)
+            r->resample = stbi__resample_row_h_2;
+        else if (r->hs == 2 && r->vs == 2)
+            r->resample = z->resample_row_hv_2_kernel;
+        else
+            r->resample = stbi__resample_row_generic;
+    }
+}
+
+JpegDecoder::~JpegDecoder() = default;
+
+bool JpegDecoder::isJpeg(const std::filesystem::path &filePath) {
+    FILE* file = stbi__fopen(filePath.generic_string().c_str(), "rb");
+    if (!file)
+        return false;
+    stbi__context context;
+    stbi__start_file(&context, file);
+    const bool isJpeg = stbi__jpeg_test(&context) != 0;
+    fclose(file);
+    return isJpeg;
+}
+
+unsigned int JpegDecoder::getWidth() const {
+    return state->jpeg->s->img_x;
+}
+
+unsigned int JpegDecoder::getHeight() const {
+    return state->jpeg->s->img_y;
+}
+
+unsigned int JpegDecoder::getNextRow() const {
+    return state->nextRow;
+}
+
+bool JpegDecoder::isStreamed() const {
+    return state->isStreamed;
+}
+
+void JpegDecoder::readRows(const MutableImageView &output) {
+    if (output.width != getWidth())
+        throw std::invalid_argument("The width of the planes differs from the image one.");
+    if (output.height > getHeight() - state->nextRow)
+        throw std::invalid_argument("The number of rows exceeds the rows left.");
+
+    stbi__jpeg* z = state->jpeg;
+    if (state->threadPool && output.height > 1) {
+        // bands of rows are read concurrently, each one with its own resampling state and line buffers
+        const unsigned int numBands = std::min(output.height, state->threadPool->getNumThreads() * TASKS_PER_THREAD);
+        const std::size_t lineBufferSize = z->s->img_x + LINE_BUFFER_PADDING;
+        state->threadPool->parallelFor(numBands, [&](const unsigned int band) {
+            const unsigned int firstRow = output.height * band / numBands;
+            stbi__resample resamplers[MAX_COMPONENTS];
+            int lineRows[MAX_COMPONENTS][2];
+            std::vector<stbi_uc> lines(z->s->img_n * lineBufferSize);
+            stbi_uc* lineBuffers[MAX_COMPONENTS] = {};
+            for (int k = 0; k < z->s->img_n; k++) {
+                resamplers[k] = state->resamplers[k];
+                state->seekResampler(k, resamplers[k], lineRows[k], state->nextRow + firstRow);
+                lineBuffers[k] = lines.data() + k * lineBufferSize;
+            }
+            for (unsigned int y = firstRow; y < output.height * (band + 1) / numBands; y++) {
+                const std::size_t pos = static_cast<std::size_t>(y) * output.stride;
+                uint8_t* planes[RGB_CHANNELS] = {output.reds + pos, output.greens + pos, output.blues + pos};
+                state->readRow(resamplers, lineRows, lineBuffers, planes);
+            }
+        });
+        for (int k = 0; k < z->s->img_n; k++)
+            state->seekResampler(k, state->resamplers[k], state->lineRows[k], state->nextRow + output.height);
+    } else {
+        stbi_uc* lineBuffers[MAX_COMPONENTS] = {};
+        for (int k = 0; k < z->s->img_n; k++)
+            lineBuffers[k] = z->img_comp[k].linebuf;
+        for (unsigned int y = 0; y < output.height; y++) {
+            const std::size_t pos = static_cast<std::size_t>(y) * output.stride;
+            uint8_t* planes[RGB_CHANNELS] = {output.reds + pos, output.greens + pos, output.blues + pos};
+            state->readRow(state->resamplers, state->lineRows, lineBuffers, planes);
+        }
+    }
+    state->nextRow += output.height;
+}
@@ -0,0 +1,129 @@
+#ifndef JPEGDECODER_H
+#define JPEGDECODER_H
+#include <filesystem>
+#include <memory>
+
+#include "image/ImageView.h"
+#include "processing/parallel/ThreadPool.h"
+#include "RowReader.h"
+
+
+/**
+ * Represents a JPEG decoder emitting RGB channel planes row by row, with no interleaved intermediate.
+ *
+ * It relies on the stages of the stb decoder, which decode the entropy-coded data and the inverse DCT into the
+ * native, possibly subsampled components; each read resamples the components and converts them from YCbCr
+ * (or CMYK, YCCK, RGB and grayscale) straight into the destination planes, so that the pixels are written once
+ * instead of being interleaved by stb and split again. The values are identical to the ones of `stbi_load`
+ * with three requested channels.
+ *
+ * Images are streamed, i.e. their components are decoded on demand, while reading, into windows of two rows of
+ * blocks: baseline images whose components are interleaved in a single scan, i.e. nearly all the baseline ones,
+ * are entropy-decoded a row of MCUs at a time, so that the memory held by the decoder is proportional to the
+ * image width. Progressive images refine their coefficients by several scans over the whole image, thus the
+ * constructor decodes all of them, and only their inverse DCT is left to the reads. The remaining images,
+ * i.e. baseline ones whose components are in separate scans, are decoded entirely by the constructor.
+ *
+ * A parallel decoder, given a thread pool, is never streamed: its constructor decodes the components entirely.
+ * The restart intervals of a baseline scan, if any, are decoded concurrently, since the coder state is reset
+ * at each restart marker; otherwise the entropy-coded data is decoded sequentially by batches of rows of MCUs,
+ * whose inverse DCT is then computed concurrently, as is the one of the coefficients of progressive images.
+ * Each read then resamples and converts bands of rows concurrently. The values are the same as the ones of
+ * a sequential decoder.
+ */
+class JpegDecoder final : public RowReader {
+public:
+    /**
+     * Constructs a decoder of the specified JPEG file, reading its headers and, unless the image is baseline
+     * and interleaved, decoding its scans.
+     *
+     * @param filePath The full or relative file path to the JPEG image to decode.
+     * @throw std::runtime_error If the file cannot be opened or is not a valid JPEG image.
+     */
+    explicit JpegDecoder(const std::filesystem::path& filePath);
+
+    /**
+     * Constructs a parallel decoder of the specified JPEG file, decoding its components in the given thread pool.
+     *
+     * @param filePath The full or relative file path to the JPEG image to decode.
+     * @param threadPool The pool decoding the image and converting its rows, which must outlive the decoder.
+     * @throw std::runtime_error If the file cannot be opened or is not a valid JPEG image.
+     */
+    JpegDecoder(const std::filesystem::path& filePath, ThreadPool& threadPool);
+
+    /**
+     * Destructor which releases the decoded components.
+     */
+    ~JpegDecoder() override;
+
+    JpegDecoder(const JpegDecoder&) = delete;
+    JpegDecoder& operator=(const JpegDecoder&) = delete;
+
+    /**
+     * Checks whether the specified file is a JPEG image, by reading its header only.
+     *
+     * @param filePath The full or relative file path to the image.
+     * @return True if the file can be opened and is a JPEG image, false otherwise.
+     */
+    static bool isJpeg(const std::filesystem::path& filePath);
+
+    /**
+     * Retrieves the width of the image.
+     *
+     * @return The width of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getWidth() const override;
+
+    /**
+     * Retrieves the height of the image.
+     *
+     * @return The height of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getHeight() const override;
+
+    /**
+     * Retrieves the index of the next row to be read, i.e. the number of rows already read.
+     *
+     * @return The row index as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getNextRow() const override;
+
+    /**
+     * Checks whether the image is streamed, i.e. whether its components are decoded while reading its rows,
+     * instead of by the constructor.
+     *
+     * @return True if the image is streamed, false otherwise.
+     */
+    [[nodiscard]] bool isStreamed() const;
+
+    /**
+     * Reads the next rows of the image into the given planes, as many as their height, concurrently for
+     * a parallel decoder.
+     *
+     * @param output The planes receiving the rows, as wide as the image.
+     * @throw std::invalid_argument If the width of the planes differs from the image one, or their height
+     *                              exceeds the number of rows left.
+     * @throw std::runtime_error If the entropy-coded data of a streamed baseline image is corrupt.
+     */
+    void readRows(const MutableImageView& output) override;
+
+private:
+    /**
+     * The state of the stb decoder and of the resampling of each component.
+     */
+    struct State;
+
+    /**
+     * Constructs a decoder, parallel if the given pool is not null.
+     */
+    JpegDecoder(const std::filesystem::path& filePath, ThreadPool* threadPool);
+
+    /**
+     * The decoder state, hidden so that stb declarations do not leak out of its implementation file.
+     */
+    std::unique_ptr<State> state;
+};
+
+
+
+#endif //JPEGDECODER_H
@@ -0,0 +1,523 @@
+// the stb implementation lives here, since the encoder reuses its output context and tables
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include "JpegEncoder.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "processing/simd/ForwardDct.h"
+
+#define RGB_CHANNELS 3
+#define MAX_JPEG_SIZE 65535
+#define BLOCK_SIZE 8
+#define NUM_RESTART_MARKERS 8
+// rows of MCUs encoded by each thread in a batch, so that threads are balanced and few segments are held at once
+#define UNITS_PER_THREAD 4
+
+// the tables of stbi_write_jpg_core, where they are local
+static const unsigned char std_dc_luminance_nrcodes[] = {0,0,1,5,1,1,1,1,1,1,0,0,0,0,0,0,0};
+static const unsigned char std_dc_luminance_values[] = {0,1,2,3,4,5,6,7,8,9,10,11};
+static const unsigned char std_ac_luminance_nrcodes[] = {0,0,2,1,3,3,2,4,3,5,5,4,4,0,0,1,0x7d};
+static const unsigned char std_ac_luminance_values[] = {
+    0x01,0x02,0x03,0x00,0x04,0x11,0x05,0x12,0x21,0x31,0x41,0x06,0x13,0x51,0x61,0x07,0x22,0x71,0x14,0x32,0x81,0x91,0xa1,0x08,
+    0x23,0x42,0xb1,0xc1,0x15,0x52,0xd1,0xf0,0x24,0x33,0x62,0x72,0x82,0x09,0x0a,0x16,0x17,0x18,0x19,0x1a,0x25,0x26,0x27,0x28,
+    0x29,0x2a,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x53,0x54,0x55,0x56,0x57,0x58,0x59,
+    0x5a,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x83,0x84,0x85,0x86,0x87,0x88,0x89,
+    0x8a,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xb2,0xb3,0xb4,0xb5,0xb6,
+    0xb7,0xb8,0xb9,0xba,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xe1,0xe2,
+    0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa
+};
+static const unsigned char std_dc_chrominance_nrcodes[] = {0,0,3,1,1,1,1,1,1,1,1,1,0,0,0,0,0};
+static const unsigned char std_dc_chrominance_values[] = {0,1,2,3,4,5,6,7,8,9,10,11};
+static const unsigned char std_ac_chrominance_nrcodes[] = {0,0,2,1,2,4,4,3,4,7,5,4,4,0,1,2,0x77};
+static const unsigned char std_ac_chrominance_values[] = {
+    0x00,0x01,0x02,0x03,0x11,0x04,0x05,0x21,0x31,0x06,0x12,0x41,0x51,0x07,0x61,0x71,0x13,0x22,0x32,0x81,0x08,0x14,0x42,0x91,
+    0xa1,0xb1,0xc1,0x09,0x23,0x33,0x52,0xf0,0x15,0x62,0x72,0xd1,0x0a,0x16,0x24,0x34,0xe1,0x25,0xf1,0x17,0x18,0x19,0x1a,0x26,
+    0x27,0x28,0x29,0x2a,0x35,0x36,0x37,0x38,0x39,0x3a,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x53,0x54,0x55,0x56,0x57,0x58,
+    0x59,0x5a,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x82,0x83,0x84,0x85,0x86,0x87,
+    0x88,0x89,0x8a,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xb2,0xb3,0xb4,
+    0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,
+    0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa
+};
+static const unsigned short YDC_HT[256][2] = { {0,2},{2,3},{3,3},{4,3},{5,3},{6,3},{14,4},{30,5},{62,6},{126,7},{254,8},{510,9}};
+static const unsigned short UVDC_HT[256][2] = { {0,2},{1,2},{2,2},{6,3},{14,4},{30,5},{62,6},{126,7},{254,8},{510,9},{1022,10},{2046,11}};
+static const unsigned short YAC_HT[256][2] = {
+    {10,4},{0,2},{1,2},{4,3},{11,4},{26,5},{120,7},{248,8},{1014,10},{65410,16},{65411,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {12,4},{27,5},{121,7},{502,9},{2038,11},{65412,16},{65413,16},{65414,16},{65415,16},{65416,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {28,5},{249,8},{1015,10},{4084,12},{65417,16},{65418,16},{65419,16},{65420,16},{65421,16},{65422,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {58,6},{503,9},{4085,12},{65423,16},{65424,16},{65425,16},{65426,16},{65427,16},{65428,16},{65429,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {59,6},{1016,10},{65430,16},{65431,16},{65432,16},{65433,16},{65434,16},{65435,16},{65436,16},{65437,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {122,7},{2039,11},{65438,16},{65439,16},{65440,16},{65441,16},{65442,16},{65443,16},{65444,16},{65445,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {123,7},{4086,12},{65446,16},{65447,16},{65448,16},{65449,16},{65450,16},{65451,16},{65452,16},{65453,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {250,8},{4087,12},{65454,16},{65455,16},{65456,16},{65457,16},{65458,16},{65459,16},{65460,16},{65461,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {504,9},{32704,15},{65462,16},{65463,16},{65464,16},{65465,16},{65466,16},{65467,16},{65468,16},{65469,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {505,9},{65470,16},{65471,16},{65472,16},{65473,16},{65474,16},{65475,16},{65476,16},{65477,16},{65478,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {506,9},{65479,16},{65480,16},{65481,16},{65482,16},{65483,16},{65484,16},{65485,16},{65486,16},{65487,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {1017,10},{65488,16},{65489,16},{65490,16},{65491,16},{65492,16},{65493,16},{65494,16},{65495,16},{65496,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {1018,10},{65497,16},{65498,16},{65499,16},{65500,16},{65501,16},{65502,16},{65503,16},{65504,16},{65505,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {2040,11},{65506,16},{65507,16},{65508,16},{65509,16},{65510,16},{65511,16},{65512,16},{65513,16},{65514,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {65515,16},{65516,16},{65517,16},{65518,16},{65519,16},{65520,16},{65521,16},{65522,16},{65523,16},{65524,16},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {2041,11},{65525,16},{65526,16},{65527,16},{65528,16},{65529,16},{65530,16},{65531,16},{65532,16},{65533,16},{65534,16},{0,0},{0,0},{0,0},{0,0},{0,0}
+};
+static const unsigned short UVAC_HT[256][2] = {
+    {0,2},{1,2},{4,3},{10,4},{24,5},{25,5},{56,6},{120,7},{500,9},{1014,10},{4084,12},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {11,4},{57,6},{246,8},{501,9},{2038,11},{4085,12},{65416,16},{65417,16},{65418,16},{65419,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {26,5},{247,8},{1015,10},{4086,12},{32706,15},{65420,16},{65421,16},{65422,16},{65423,16},{65424,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {27,5},{248,8},{1016,10},{4087,12},{65425,16},{65426,16},{65427,16},{65428,16},{65429,16},{65430,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {58,6},{502,9},{65431,16},{65432,16},{65433,16},{65434,16},{65435,16},{65436,16},{65437,16},{65438,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {59,6},{1017,10},{65439,16},{65440,16},{65441,16},{65442,16},{65443,16},{65444,16},{65445,16},{65446,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {121,7},{2039,11},{65447,16},{65448,16},{65449,16},{65450,16},{65451,16},{65452,16},{65453,16},{65454,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {122,7},{2040,11},{65455,16},{65456,16},{65457,16},{65458,16},{65459,16},{65460,16},{65461,16},{65462,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {249,8},{65463,16},{65464,16},{65465,16},{65466,16},{65467,16},{65468,16},{65469,16},{65470,16},{65471,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {503,9},{65472,16},{65473,16},{65474,16},{65475,16},{65476,16},{65477,16},{65478,16},{65479,16},{65480,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {504,9},{65481,16},{65482,16},{65483,16},{65484,16},{65485,16},{65486,16},{65487,16},{65488,16},{65489,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {505,9},{65490,16},{65491,16},{65492,16},{65493,16},{65494,16},{65495,16},{65496,16},{65497,16},{65498,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {506,9},{65499,16},{65500,16},{65501,16},{65502,16},{65503,16},{65504,16},{65505,16},{65506,16},{65507,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {2041,11},{65508,16},{65509,16},{65510,16},{65511,16},{65512,16},{65513,16},{65514,16},{65515,16},{65516,16},{0,0},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {16352,14},{65517,16},{65518,16},{65519,16},{65520,16},{65521,16},{65522,16},{65523,16},{65524,16},{65525,16},{0,0},{0,0},{0,0},{0,0},{0,0},
+    {1018,10},{32707,15},{65526,16},{65527,16},{65528,16},{65529,16},{65530,16},{65531,16},{65532,16},{65533,16},{65534,16},{0,0},{0,0},{0,0},{0,0},{0,0}
+};
+static const int YQT[] = {16,11,10,16,24,40,51,61,12,12,14,19,26,58,60,55,14,13,16,24,40,57,69,56,14,17,22,29,51,87,80,62,18,22,
+                          37,56,68,109,103,77,24,35,55,64,81,104,113,92,49,64,78,87,103,121,120,101,72,92,95,98,112,100,103,99};
+static const int UVQT[] = {17,18,24,47,99,99,99,99,18,21,26,66,99,99,99,99,24,26,56,99,99,99,99,99,47,66,99,99,99,99,99,99,
+                           99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99};
+static const float aasf[] = { 1.0f * 2.828427125f, 1.387039845f * 2.828427125f, 1.306562965f * 2.828427125f, 1.175875602f * 2.828427125f,
+                              1.0f * 2.828427125f, 0.785694958f * 2.828427125f, 0.541196100f * 2.828427125f, 0.275899379f * 2.828427125f };
+
+
+/**
+ * Represents the entropy-coded data of consecutive rows of MCUs, together with the state of the Huffman coder,
+ * which the stb encoder keeps in its output context and writes a byte at a time.
+ */
+struct EntropySegment {
+    /**
+     * The coded bytes, with a zero stuffed after each 0xFF byte.
+     */
+    std::vector<uint8_t> bytes;
+
+    /**
+     * The bits not yet written, and the DC coefficients of the last blocks of each component.
+     */
+    int bitBuffer = 0;
+    int bitCount = 0;
+    int dcs[RGB_CHANNELS] = {0, 0, 0};
+
+    /**
+     * Appends the given code, i.e. its value and its length, as stbiw__jpg_writeBits does.
+     */
+    void writeBits(const unsigned short* bits) {
+        bitCount += bits[1];
+        bitBuffer |= bits[0] << (24 - bitCount);
+        while (bitCount >= 8) {
+            const auto byte = static_cast<uint8_t>((bitBuffer >> 16) & 255);
+            bytes.push_back(byte);
+            if (byte == 255)
+                bytes.push_back(0);
+            bitBuffer <<= 8;
+            bitCount -= 8;
+        }
+    }
+
+    /**
+     * Pads the last byte with one bits, as required before a marker.
+     */
+    void fill() {
+        static const unsigned short fillBits[] = {0x7F, 7};
+        writeBits(fillBits);
+    }
+
+    /**
+     * Codes the quantized coefficients of a block of the given component, given in natural order,
+     * as stbiw__jpg_processDU does.
+     */
+    void encodeBlock(const int* coefficients, const unsigned int component, const unsigned short dcTable[256][2],
+        const unsigned short acTable[256][2]) {
+        int zigzagCoefficients[64];
+        for (int j = 0; j < 64; j++)
+            zigzagCoefficients[stbiw__jpg_ZigZag[j]] = coefficients[j];
+
+        const int difference = zigzagCoefficients[0] - dcs[component];
+        dcs[component] = zigzagCoefficients[0];
+        if (difference == 0) {
+            writeBits(dcTable[0]);
+        } else {
+            unsigned short bits[2];
+            stbiw__jpg_calcBits(difference, bits);
+            writeBits(dcTable[bits[1]]);
+            writeBits(bits);
+        }
+
+        int lastPos = 63;
+        while (lastPos > 0 && zigzagCoefficients[lastPos] == 0)
+            lastPos--;
+        for (int i = 1; i <= lastPos; i++) {
+            const int startPos = i;
+            while (zigzagCoefficients[i] == 0)
+                i++;
+            int numZeroes = i - startPos;
+            for (; numZeroes >= 16; numZeroes -= 16)
+                writeBits(acTable[0xF0]);
+            unsigned short bits[2];
+            stbiw__jpg_calcBits(zigzagCoefficients[i], bits);
+            writeBits(acTable[(numZeroes << 4) + bits[1]]);
+            writeBits(bits);
+        }
+        if (lastPos != 63)
+            writeBits(acTable[0x00]);
+    }
+};
+
+struct JpegEncoder::State {
+    /**
+     * The stb output context, writing the file.
+     */
+    stbi__write_context context{};
+
+    /**
+     * Whether the file is open, i.e. until the last row is written.
+     */
+    bool isOpen = false;
+
+    /**
+     * The sizes of the image.
+     */
+    unsigned int width = 0;
+    unsigned int height = 0;
+
+    /**
+     * Whether chroma is subsampled by 2 in both directions.
+     */
+    bool isSubsampled = false;
+
+    /**
+     * The quantization tables of luma and chroma, scaled for the forward DCT.
+     */
+    float lumaTable[64]{};
+    float chromaTable[64]{};
+
+    /**
+     * The forward DCT engine of the detected instruction set.
+     */
+    ForwardDct::TransformFunction transform = nullptr;
+
+    /**
+     * The pool encoding the rows of MCUs in parallel, each one as a restart interval, or null if they are
+     * encoded sequentially in a single interval.
+     */
+    ThreadPool* threadPool = nullptr;
+
+    /**
+     * The coded data not yet written and the state of the coder, when rows of MCUs are encoded sequentially.
+     */
+    EntropySegment segment;
+
+    /**
+     * The number of rows of MCUs already encoded.
+     */
+    unsigned int numEncodedUnits = 0;
+
+    /**
+     * The rows of the current row of MCUs, one plane after the other, each as tall as the MCUs.
+     */
+    std::vector<uint8_t> rows;
+
+    /**
+     * The index of the next row to be written.
+     */
+    unsigned int nextRow = 0;
+
+    ~State() {
+        if (isOpen)
+            stbi__end_write_file(&context);
+    }
+
+    [[nodiscard]] unsigned int getUnitHeight() const {
+        return isSubsampled ? 2 * BLOCK_SIZE : BLOCK_SIZE;
+    }
+
+    /**
+     * Retrieves a view of the buffered rows of the current row of MCUs.
+     */
+    [[nodiscard]] ImageView viewRows(const unsigned int numRows) const {
+        const std::size_t planeSize = static_cast<std::size_t>(getUnitHeight()) * width;
+        return {width, numRows, width, rows.data(), rows.data() + planeSize, rows.data() + 2 * planeSize};
+    }
+
+    /**
+     * Computes the quantization tables and writes the headers, as stbi_write_jpg_core does, adding the restart
+     * interval of a row of MCUs when they are encoded in parallel.
+     */
+    void writeHeaders(int quality) {
+        quality = quality ? quality : 90;
+        isSubsampled = quality <= 90;
+        quality = quality < 1 ? 1 : quality > 100 ? 100 : quality;
+        quality = quality < 50 ? 5000 / quality : 200 - quality * 2;
+
+        unsigned char lumaQuantization[64], chromaQuantization[64];
+        for (int i = 0; i < 64; i++) {
+            const int lumaValue = (YQT[i] * quality + 50) / 100;
+            const int chromaValue = (UVQT[i] * quality + 50) / 100;
+            lumaQuantization[stbiw__jpg_ZigZag[i]] = static_cast<unsigned char>(
+                lumaValue < 1 ? 1 : lumaValue > 255 ? 255 : lumaValue);
+            chromaQuantization[stbiw__jpg_ZigZag[i]] = static_cast<unsigned char>(
+                chromaValue < 1 ? 1 : chromaValue > 255 ? 255 : chromaValue);
+        }
+        for (int row = 0, k = 0; row < 8; row++) {
+            for (int col = 0; col < 8; col++, k++) {
+                lumaTable[k] = 1 / (lumaQuantization[stbiw__jpg_ZigZag[k]] * aasf[row] * aasf[col]);
+                chromaTable[k] = 1 / (chromaQuantization[stbiw__jpg_ZigZag[k]] * aasf[row] * aasf[col]);
+            }
+        }
+
+        static const unsigned char head0[] = {0xFF, 0xD8, 0xFF, 0xE0, 0, 0x10, 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0,
+            1, 0, 0, 0xFF, 0xDB, 0, 0x84, 0};
+        static const unsigned char head2[] = {0xFF, 0xDA, 0, 0xC, 3, 1, 0, 2, 0x11, 3, 0x11, 0, 0x3F, 0};
+        const unsigned char head1[] = {0xFF, 0xC0, 0, 0x11, 8, static_cast<unsigned char>(height >> 8),
+            static_cast<unsigned char>(height & 0xFF), static_cast<unsigned char>(width >> 8),
+            static_cast<unsigned char>(width & 0xFF), 3, 1, static_cast<unsigned char>(isSubsampled ? 0x22 : 0x11), 0,
+            2, 0x11, 1, 3, 0x11, 1, 0xFF, 0xC4, 0x01, 0xA2, 0};
+        stbi__write_context* s = &context;
+        s->func(s->context, const_cast<unsigned char*>(head0), sizeof(head0));
+        s->func(s->context, lumaQuantization, sizeof(lumaQuantization));
+        stbiw__putc(s, 1);
+        s->func(s->context, chromaQuantization, sizeof(chromaQuantization));
+        s->func(s->context, const_cast<unsigned char*>(head1), sizeof(head1));
+        s->func(s->context, const_cast<unsigned char*>(std_dc_luminance_nrcodes + 1),
+            sizeof(std_dc_luminance_nrcodes) - 1);
+        s->func(s->context, const_cast<unsigned char*>(std_dc_luminance_values), sizeof(std_dc_luminance_values));
+        stbiw__putc(s, 0x10);
+        s->func(s->context, const_cast<unsigned char*>(std_ac_luminance_nrcodes + 1),
+            sizeof(std_ac_luminance_nrcodes) - 1);
+        s->func(s->context, const_cast<unsigned char*>(std_ac_luminance_values), sizeof(std_ac_luminance_values));
+        stbiw__putc(s, 1);
+        s->func(s->context, const_cast<unsigned char*>(std_dc_chrominance_nrcodes + 1),
+            sizeof(std_dc_chrominance_nrcodes) - 1);
+        s->func(s->context, const_cast<unsigned char*>(std_dc_chrominance_values), sizeof(std_dc_chrominance_values));
+        stbiw__putc(s, 0x11);
+        s->func(s->context, const_cast<unsigned char*>(std_ac_chrominance_nrcodes + 1),
+            sizeof(std_ac_chrominance_nrcodes) - 1);
+        s->func(s->context, const_cast<unsigned char*>(std_ac_chrominance_values), sizeof(std_ac_chrominance_values));
+        if (threadPool) {
+            const unsigned int unitWidth = getUnitHeight();
+            const unsigned int restartInterval = (width + unitWidth - 1) / unitWidth;
+            const unsigned char restartHead[] = {0xFF, 0xDD, 0, 4, static_cast<unsigned char>(restartInterval >> 8),
+                static_cast<unsigned char>(restartInterval & 0xFF)};
+            s->func(s->context, const_cast<unsigned char*>(restartHead), sizeof(restartHead));
+        }
+        s->func(s->context, const_cast<unsigned char*>(head2), sizeof(head2));
+    }
+
+    /**
+     * Converts a square of pixels of a row of MCUs to YCbCr, replicating the last row and column past the image
+     * edges, with the same arithmetic as stbi_write_jpg_core.
+     */
+    void convertBlock(const ImageView& unit, const unsigned int x, const unsigned int size, float* luma,
+        float* blueChroma, float* redChroma) const {
+        for (unsigned int row = 0, pos = 0; row < size; row++) {
+            const std::size_t rowPos = static_cast<std::size_t>(std::min(row, unit.height - 1)) * unit.stride;
+            const uint8_t* reds = unit.reds + rowPos;
+            const uint8_t* greens = unit.greens + rowPos;
+            const uint8_t* blues = unit.blues + rowPos;
+            for (unsigned int col = x; col < x + size; col++, pos++) {
+                const unsigned int p = std::min(col, width - 1);
+                const float r = reds[p], g = greens[p], b = blues[p];
+                luma[pos] = +0.29900f * r + 0.58700f * g + 0.11400f * b - 128;
+                blueChroma[pos] = -0.16874f * r - 0.33126f * g + 0.50000f * b;
+                redChroma[pos] = +0.50000f * r - 0.41869f * g - 0.08131f * b;
+            }
+        }
+    }
+
+    /**
+     * Encodes a row of MCUs, whose rows are the ones of the given view, into the given segment.
+     */
+    void encodeUnit(const ImageView& unit, EntropySegment& output) const {
+        int coefficients[64];
+        if (isSubsampled) {
+            for (unsigned int x = 0; x < width; x += 2 * BLOCK_SIZE) {
+                float luma[256], blueChroma[256], redChroma[256];
+                convertBlock(unit, x, 2 * BLOCK_SIZE, luma, blueChroma, redChroma);
+                for (const unsigned int offset : {0, 8, 128, 136}) {
+                    transform(luma + offset, 2 * BLOCK_SIZE, lumaTable, coefficients);
+                    output.encodeBlock(coefficients, 0, YDC_HT, YAC_HT);
+                }
+
+                float subBlueChroma[64], subRedChroma[64];
+                for (int yy = 0, pos = 0; yy < 8; yy++) {
+                    for (int xx = 0; xx < 8; xx++, pos++) {
+                        const int j = yy * 32 + xx * 2;
+                        subBlueChroma[pos] = (blueChroma[j + 0] + blueChroma[j + 1] + blueChroma[j + 16] +
+                            blueChroma[j + 17]) * 0.25f;
+                        subRedChroma[pos] = (redChroma[j + 0] + redChroma[j + 1] + redChroma[j + 16] +
+                            redChroma[j + 17]) * 0.25f;
+                    }
+                }
+                transform(subBlueChroma, BLOCK_SIZE, chromaTable, coefficients);
+                output.encodeBlock(coefficients, 1, UVDC_HT, UVAC_HT);
+                transform(subRedChroma, BLOCK_SIZE, chromaTable, coefficients);
+                output.encodeBlock(coefficients, 2, UVDC_HT, UVAC_HT);
+            }
+        } else {
+            for (unsigned int x = 0; x < width; x += BLOCK_SIZE) {
+                float luma[64], blueChroma[64], redChroma[64];
+                convertBlock(unit, x, BLOCK_SIZE, luma, blueChroma, redChroma);
+                transform(luma, BLOCK_SIZE, lumaTable, coefficients);
+                output.encodeBlock(coefficients, 0, YDC_HT, YAC_HT);
+                transform(blueChroma, BLOCK_SIZE, chromaTable, coefficients);
+                output.encodeBlock(coefficients, 1, UVDC_HT, UVAC_HT);
+                transform(redChroma, BLOCK_SIZE, chromaTable, coefficients);
+                output.encodeBlock(coefficients, 2, UVDC_HT, UVAC_HT);
+            }
+        }
+    }
+
+    /**
+     * Writes the coded bytes of a segment into the file.
+     */
+    void writeSegment(EntropySegment& output) {
+        if (!output.bytes.empty())
+            context.func(context.context, output.bytes.data(), static_cast<int>(output.bytes.size()));
+        output.bytes.clear();
+    }
+
+    /**
+     * Encodes the given rows of MCUs, in order: either sequentially into a single interval, or in parallel batches
+     * of restart intervals, which are then written in order, each after its restart marker.
+     */
+    void encodeUnits(const std::vector<ImageView>& units) {
+        if (!threadPool) {
+            for (const ImageView& unit : units) {
+                encodeUnit(unit, segment);
+                writeSegment(segment);
+            }
+            numEncodedUnits += static_cast<unsigned int>(units.size());
+            return;
+        }
+
+        const std::size_t batchSize = static_cast<std::size_t>(threadPool->getNumThreads()) * UNITS_PER_THREAD;
+        std::vector<EntropySegment> segments;
+        for (std::size_t first = 0; first < units.size(); first += batchSize) {
+            const auto numUnits = static_cast<unsigned int>(std::min(batchSize, units.size() - first));
+            segments.assign(numUnits, EntropySegment());
+            const auto encodeInterval = [&](const unsigned int k) {
+                encodeUnit(units[first + k], segments[k]);
+                segments[k].fill();
+            };
+            if (numUnits == 1)
+                encodeInterval(0);
+            else
+                threadPool->parallelFor(numUnits, encodeInterval);
+
+            for (EntropySegment& interval : segments) {
+                if (numEncodedUnits > 0) {
+                    stbiw__putc(&context, 0xFF);
+                    stbiw__putc(&context, static_cast<unsigned char>(0xD0 + (numEncodedUnits - 1) % NUM_RESTART_MARKERS));
+                }
+                writeSegment(interval);
+                numEncodedUnits++;
+            }
+        }
+    }
+
+    /**
+     * Writes the bit alignment, if not written with the last interval, and the EOI marker, then closes the file.
+     */
+    void finish() {
+        if (!threadPool) {
+            segment.fill();
+            writeSegment(segment);
+        }
+        stbiw__putc(&context, 0xFF);
+        stbiw__putc(&context, 0xD9);
+        stbi__end_write_file(&context);
+        isOpen = false;
+    }
+};
+
+JpegEncoder::JpegEncoder(const std::filesystem::path &filePath, const unsigned int w, const unsigned int h,
+    const int quality): JpegEncoder(filePath, w, h, quality, nullptr) {}
+
+JpegEncoder::JpegEncoder(const std::filesystem::path &filePath, const unsigned int w, const unsigned int h,
+    const int quality, ThreadPool &threadPool): JpegEncoder(filePath, w, h, quality, &threadPool) {}
+
+JpegEncoder::JpegEncoder(const std::filesystem::path &filePath, const unsigned int w, const unsigned int h,
+    const int quality, ThreadPool *threadPool): state(std::make_unique<State>()) {
+    if (w == 0 || h == 0 || w > MAX_JPEG_SIZE || h > MAX_JPEG_SIZE)
+        throw std::invalid_argument("Image sizes must be between 1 and 65535 pixels.");
+    if (!stbi__start_write_file(&state->context, filePath.generic_string().c_str()))
+        throw std::runtime_error("Unable to open " + filePath.generic_string() + ".");
+    state->isOpen = true;
+    state->width = w;
+    state->height = h;
+    state->threadPool = threadPool;
+    state->transform = ForwardDct::selectTransform(InstructionSets::detect());
+    state->writeHeaders(quality);
+    state->rows.resize(static_cast<std::size_t>(RGB_CHANNELS) * state->getUnitHeight() * w);
+}
+
+JpegEncoder::~JpegEncoder() = default;
+
+unsigned int JpegEncoder::getWidth() const {
+    return state->width;
+}
+
+unsigned int JpegEncoder::getHeight() const {
+    return state->height;
+}
+
+unsigned int JpegEncoder::getNextRow() const {
+    return state->nextRow;
+}
+
+void JpegEncoder::writeRows(const ImageView &input) {
+    if (input.width != state->width)
+        throw std::invalid_argument("The width of the planes differs from the image one.");
+    if (input.height > state->height - state->nextRow)
+        throw std::invalid_argument("The number of rows exceeds the rows left.");
+
+    const unsigned int unitHeight = state->getUnitHeight();
+    const std::size_t planeSize = static_cast<std::size_t>(unitHeight) * state->width;
+    const uint8_t* planes[RGB_CHANNELS] = {input.reds, input.greens, input.blues};
+    // rows of MCUs straddling several calls are buffered, whereas the ones within the input are encoded in place;
+    // the last row of MCUs may be incomplete, in which case its last row is replicated
+    unsigned int y = 0;
+    const auto bufferRows = [&](const unsigned int numRows) {
+        for (const unsigned int end = y + numRows; y < end; y++, state->nextRow++) {
+            const unsigned int unitRow = state->nextRow % unitHeight;
+            for (unsigned int c = 0; c < RGB_CHANNELS; c++) {
+                std::copy_n(planes[c] + static_cast<std::size_t>(y) * input.stride, state->width,
+                    state->rows.data() + c * planeSize + static_cast<std::size_t>(unitRow) * state->width);
+            }
+        }
+    };
+    const auto isUnitComplete = [&]() {
+        return state->nextRow % unitHeight == 0 || state->nextRow == state->height;
+    };
+
+    if (state->nextRow % unitHeight != 0) {
+        const unsigned int unitRow = state->nextRow % unitHeight;
+        bufferRows(std::min(unitHeight - unitRow, input.height));
+        if (isUnitComplete())
+            state->encodeUnits({state->viewRows((state->nextRow - 1) % unitHeight + 1)});
+    }
+
+    std::vector<ImageView> units;
+    while (y < input.height && (input.height - y >= unitHeight || state->nextRow + input.height - y == state->height)) {
+        const unsigned int numRows = std::min(unitHeight, input.height - y);
+        const std::size_t pos = static_cast<std::size_t>(y) * input.stride;
+        units.push_back({state->width, numRows, input.stride, input.reds + pos, input.greens + pos,
+            input.blues + pos});
+        y += numRows;
+        state->nextRow += numRows;
+    }
+    if (!units.empty())
+        state->encodeUnits(units);
+    bufferRows(input.height - y);
+
+    if (state->nextRow == state->height && state->isOpen)
+        state->finish();
+}
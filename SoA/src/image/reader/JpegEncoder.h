@@ -0,0 +1,113 @@
+#ifndef JPEGENCODER_H
+#define JPEGENCODER_H
+#include <filesystem>
+#include <memory>
+
+#include "image/ImageView.h"
+#include "processing/parallel/ThreadPool.h"
+#include "RowWriter.h"
+
+
+/**
+ * Represents a JPEG encoder taking RGB channel planes row by row, with no interleaved intermediate.
+ *
+ * It follows the stages of the stb encoder: each row of MCUs, i.e. 8 rows, or 16 ones when the chroma is
+ * subsampled, is converted to YCbCr, transformed by the vectorized @ref ForwardDct engines, quantized and
+ * Huffman-coded. Rows of MCUs within a call are encoded in place, whereas the ones straddling calls are buffered,
+ * so the memory held by the encoder is proportional to the image width.
+ *
+ * A sequential encoder codes all the MCUs into a single interval, so the file is identical to the one written by
+ * `stbi_write_jpg` with three channels and the same quality. A parallel encoder declares each row of MCUs as a
+ * restart interval, whose coder state is reset, so that the rows of MCUs of a call are coded concurrently by
+ * a thread pool, then written in order between restart markers; the file is larger by a few bytes per row of MCUs
+ * and decodes to the same pixels.
+ */
+class JpegEncoder final : public RowWriter {
+public:
+    /**
+     * Constructs an encoder of a JPEG image with the given sizes, writing its headers into the specified file.
+     *
+     * @param filePath The full or relative file path where the JPEG image will be saved.
+     * @param w The width of the image.
+     * @param h The height of the image.
+     * @param quality The quality of the image, from 1 to 100; chroma is subsampled up to 90, as stb does.
+     * @throw std::invalid_argument If a size is zero or exceeds the JPEG limit of 65535 pixels.
+     * @throw std::runtime_error If the file cannot be opened.
+     */
+    JpegEncoder(const std::filesystem::path& filePath, unsigned int w, unsigned int h, int quality);
+
+    /**
+     * Constructs a parallel encoder of a JPEG image with the given sizes, writing its headers into the specified
+     * file, which encodes each row of MCUs as a restart interval in the given thread pool.
+     *
+     * @param filePath The full or relative file path where the JPEG image will be saved.
+     * @param w The width of the image.
+     * @param h The height of the image.
+     * @param quality The quality of the image, from 1 to 100; chroma is subsampled up to 90, as stb does.
+     * @param threadPool The pool encoding the rows of MCUs, which must outlive the encoder.
+     * @throw std::invalid_argument If a size is zero or exceeds the JPEG limit of 65535 pixels.
+     * @throw std::runtime_error If the file cannot be opened.
+     */
+    JpegEncoder(const std::filesystem::path& filePath, unsigned int w, unsigned int h, int quality,
+        ThreadPool& threadPool);
+
+    /**
+     * Destructor which closes the file, leaving it truncated if not all the rows have been written.
+     */
+    ~JpegEncoder() override;
+
+    JpegEncoder(const JpegEncoder&) = delete;
+    JpegEncoder& operator=(const JpegEncoder&) = delete;
+
+    /**
+     * Retrieves the width of the image.
+     *
+     * @return The width of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getWidth() const override;
+
+    /**
+     * Retrieves the height of the image.
+     *
+     * @return The height of the image in pixels.
+     */
+    [[nodiscard]] unsigned int getHeight() const override;
+
+    /**
+     * Retrieves the index of the next row to be written, i.e. the number of rows already written.
+     *
+     * @return The row index as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getNextRow() const override;
+
+    /**
+     * Writes the given rows after the ones already written, encoding every completed row of MCUs, concurrently
+     * for a parallel encoder; the file is completed and closed once the last row is written.
+     *
+     * @param input The planes holding the rows, as wide as the image.
+     * @throw std::invalid_argument If the width of the planes differs from the image one, or their height
+     *                              exceeds the number of rows left.
+     */
+    void writeRows(const ImageView& input) override;
+
+private:
+    /**
+     * The state of the stb output and of the Huffman coder, and the rows of the current row of MCUs.
+     */
+    struct State;
+
+    /**
+     * Constructs an encoder, parallel if the given pool is not null.
+     */
+    JpegEncoder(const std::filesystem::path& filePath, unsigned int w, unsigned int h, int quality,
+        ThreadPool* threadPool);
+
+    /**
+     * The encoder state, hidden so that stb declarations do not leak out of its implementation file.
+     */
+    std::unique_ptr<State> state;
+};
+
+
+
+#endif //JPEGENCODER_H
@@ -0,0 +1,174 @@
+#include "RawImageReader.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define USE_MMAP
+#endif
+#ifdef __linux__
+// saved files are mapped only where posix_fallocate can reserve their blocks beforehand
+#define USE_MMAP_WRITE
+#endif
+
+#define RGB_CHANNELS 3
+#define RAW_MAGIC "KIPRAW01"
+#define RAW_MAGIC_SIZE 8
+#define RAW_HEADER_SIZE 64
+// planes whose distance is a multiple of it would map onto the same cache sets
+#define ALIASING_PERIOD 4096
+
+/**
+ * The header at the start of each raw planar file.
+ */
+struct RawHeader {
+    char magic[RAW_MAGIC_SIZE];
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t reserved;
+    uint64_t planeDistance;
+    uint8_t padding[RAW_HEADER_SIZE - 32];
+};
+static_assert(sizeof(RawHeader) == RAW_HEADER_SIZE, "The raw header must fill its 64 bytes.");
+
+/**
+ * Retrieves the distance between the planes of a file, i.e. the size of each plane rounded up to the alignment,
+ * and shifted by a line when the planes would alias each other, as the ones of a single allocation.
+ */
+uint64_t getPlaneDistance(const unsigned int stride, const unsigned int height) {
+    uint64_t planeSize = static_cast<uint64_t>(stride) * height;
+    planeSize = (planeSize + ImageBuffer::ALIGNMENT - 1) / ImageBuffer::ALIGNMENT * ImageBuffer::ALIGNMENT;
+    if (planeSize % ALIASING_PERIOD == 0)
+        planeSize += ImageBuffer::ALIGNMENT;
+    return planeSize;
+}
+
+/**
+ * Checks the header of a file of the given size, so that its planes lie within the file.
+ */
+void checkHeader(const RawHeader& header, const uint64_t fileSize, const std::filesystem::path& filePath) {
+    if (fileSize < RAW_HEADER_SIZE || std::memcmp(header.magic, RAW_MAGIC, RAW_MAGIC_SIZE) != 0)
+        throw std::runtime_error(filePath.generic_string() + " is not a raw planar image.");
+    if (header.width == 0 || header.height == 0 || header.stride < header.width ||
+        header.planeDistance < static_cast<uint64_t>(header.stride) * header.height ||
+        header.planeDistance % ImageBuffer::ALIGNMENT != 0 ||
+        header.planeDistance > (fileSize - RAW_HEADER_SIZE) / RGB_CHANNELS)
+        throw std::runtime_error(filePath.generic_string() + " is a corrupted raw planar image.");
+}
+
+RawImageReader::RawImageReader() = default;
+
+RawImageReader::~RawImageReader() = default;
+
+std::unique_ptr<Image> RawImageReader::loadRGBImage(const std::filesystem::path &filePath) {
+#ifdef USE_MMAP
+    const int file = open(filePath.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("Unable to open " + filePath.generic_string() + ".");
+    struct stat fileStatus{};
+    if (fstat(file, &fileStatus) != 0 || fileStatus.st_size < RAW_HEADER_SIZE) {
+        close(file);
+        throw std::runtime_error(filePath.generic_string() + " is not a raw planar image.");
+    }
+    const auto fileSize = static_cast<std::size_t>(fileStatus.st_size);
+    // a read-only mapping, as the buffer is only viewed through an immutable image; where supported, the pages
+    // in the page cache are mapped at once instead of being faulted in one at a time
+#ifdef MAP_POPULATE
+    constexpr int mapFlags = MAP_PRIVATE | MAP_POPULATE;
+#else
+    constexpr int mapFlags = MAP_PRIVATE;
+#endif
+    void* address = mmap(nullptr, fileSize, PROT_READ, mapFlags, file, 0);
+    close(file);
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Unable to map " + filePath.generic_string() + ".");
+    const std::shared_ptr<void> mapping(address, [fileSize](void* mappedAddress) {
+        munmap(mappedAddress, fileSize);
+    });
+
+    RawHeader header{};
+    std::memcpy(&header, address, RAW_HEADER_SIZE);
+    checkHeader(header, fileSize, filePath);
+    uint8_t* planes = static_cast<uint8_t*>(address) + RAW_HEADER_SIZE;
+    return std::make_unique<Image>(ImageBuffer(header.width, header.height, header.stride, planes,
+        planes + header.planeDistance, planes + 2 * header.planeDistance, mapping));
+#else
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Unable to open " + filePath.generic_string() + ".");
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    RawHeader header{};
+    file.read(reinterpret_cast<char*>(&header), RAW_HEADER_SIZE);
+    checkHeader(header, fileSize, filePath);
+
+    // without mappings, planes are read into a buffer with the same layout
+    ImageBuffer buffer(header.width, header.height, header.stride, false);
+    const MutableImageView planes = buffer.view();
+    for (unsigned int c = 0; c < RGB_CHANNELS; c++) {
+        uint8_t* plane = c == 0 ? planes.reds : c == 1 ? planes.greens : planes.blues;
+        file.seekg(static_cast<std::streamoff>(RAW_HEADER_SIZE + c * header.planeDistance));
+        file.read(reinterpret_cast<char*>(plane), static_cast<std::streamsize>(header.stride) * header.height);
+        if (!file)
+            throw std::runtime_error(filePath.generic_string() + " is a corrupted raw planar image.");
+    }
+    return std::make_unique<Image>(std::move(buffer));
+#endif
+}
+
+void RawImageReader::saveJPGImage(const Image &img, const std::filesystem::path &filePath) {
+    RawHeader header{};
+    std::memcpy(header.magic, RAW_MAGIC, RAW_MAGIC_SIZE);
+    header.width = img.getWidth();
+    header.height = img.getHeight();
+    header.stride = img.getStride();
+    header.planeDistance = getPlaneDistance(header.stride, header.height);
+    const std::size_t planeSize = static_cast<std::size_t>(header.stride) * header.height;
+    const uint8_t* planes[RGB_CHANNELS] = {img.viewReds().data(), img.viewGreens().data(), img.viewBlues().data()};
+    const auto fileSize = static_cast<std::size_t>(RAW_HEADER_SIZE + RGB_CHANNELS * header.planeDistance);
+
+#ifdef USE_MMAP_WRITE
+    const int file = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        throw std::runtime_error("Image saving fails.");
+    // the blocks are reserved up front, since writes to a mapped hole that the disk cannot hold raise SIGBUS
+    void* address = posix_fallocate(file, 0, static_cast<off_t>(fileSize)) == 0 ?
+        mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0) : MAP_FAILED;
+    close(file);
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Image saving fails.");
+
+    // the file is created empty, so the gaps between the planes are already zero
+    auto* data = static_cast<uint8_t*>(address);
+    std::memcpy(data, &header, RAW_HEADER_SIZE);
+    for (unsigned int c = 0; c < RGB_CHANNELS; c++)
+        std::memcpy(data + RAW_HEADER_SIZE + c * header.planeDistance, planes[c], planeSize);
+    munmap(address, fileSize);
+#else
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Image saving fails.");
+    const std::vector<char> gap(header.planeDistance - planeSize, 0);
+    file.write(reinterpret_cast<const char*>(&header), RAW_HEADER_SIZE);
+    for (const uint8_t* plane : planes) {
+        file.write(reinterpret_cast<const char*>(plane), static_cast<std::streamsize>(planeSize));
+        file.write(gap.data(), static_cast<std::streamsize>(gap.size()));
+    }
+    if (!file)
+        throw std::runtime_error("Image saving fails.");
+#endif
+}
+
+bool RawImageReader::isRawImage(const std::filesystem::path &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    char magic[RAW_MAGIC_SIZE];
+    return file.read(magic, RAW_MAGIC_SIZE) && std::memcmp(magic, RAW_MAGIC, RAW_MAGIC_SIZE) == 0;
+}
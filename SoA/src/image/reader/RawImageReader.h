@@ -0,0 +1,71 @@
+#ifndef RAWIMAGEREADER_H
+#define RAWIMAGEREADER_H
+#include <filesystem>
+
+#include "image/Image.h"
+#include "ImageReader.h"
+
+
+/**
+ * A final concrete implementation of the @ref ImageReader interface for reading and writing images in a raw planar
+ * format, which stores the planes exactly as they are laid out in memory, so that images are neither decoded
+ * nor encoded.
+ *
+ * A file starts with a header of 64 bytes, i.e. the magic number "KIPRAW01", then the width, the height and the
+ * row stride as 32-bit integers, a reserved 32-bit integer and the distance between the planes as a 64-bit integer,
+ * all in the byte order of the machine that wrote it. The red, green and blue planes follow, each of them as many
+ * rows of stride values as the height, 64-byte aligned and with zeroed padding after the width of each row.
+ *
+ * On POSIX systems, files are memory-mapped: loaded images view the planes of the mapping without copying them,
+ * so that loading an image already in the page cache costs no more than mapping it, and saved images are copied
+ * straight into the mapping of the new file.
+ */
+class RawImageReader final : public ImageReader {
+public:
+    /**
+     * Default constructor.
+     */
+    RawImageReader();
+
+    /**
+     * Default destructor.
+     */
+    ~RawImageReader() override;
+
+
+    /**
+     * Loads an RGB image from the specified raw planar file, whose planes are mapped read-only and never copied.
+     *
+     * @param filePath The full or relative file path to the image to load.
+     * @return A unique pointer to the Image object viewing the planes of the file, which stays mapped as long as
+     * the image.
+     * @throw std::runtime_error If the file cannot be opened or is not a valid raw planar image.
+     */
+    std::unique_ptr<Image> loadRGBImage(const std::filesystem::path& filePath) override;
+
+    /**
+     * Saves an image in the raw planar format to the specified file path, with the stride of the image.
+     *
+     * The name is the one of the interface, whose other implementations write JPEG images; the file written by
+     * this one is not a JPEG image, whatever its extension. On Linux, the space of the file is allocated before
+     * its planes are mapped, so that a full disk is reported as an error rather than by a signal while writing;
+     * elsewhere, the file is written by a stream.
+     *
+     * @param img The Image object to save.
+     * @param filePath The full or relative file path where the raw planar image will be saved.
+     * @throw std::runtime_error If the image fails to save.
+     */
+    void saveJPGImage(const Image& img, const std::filesystem::path& filePath) override;
+
+    /**
+     * Checks whether the file at the given path starts with the magic number of the raw planar format.
+     *
+     * @param filePath The full or relative file path to the image.
+     * @return True if the file can be read and is a raw planar image, false otherwise.
+     */
+    static bool isRawImage(const std::filesystem::path& filePath);
+};
+
+
+
+#endif //RAWIMAGEREADER_H
@@ -0,0 +1,5 @@
+#include "RowReader.h"
+
+RowReader::RowReader() = default;
+
+RowReader::~RowReader() = default;
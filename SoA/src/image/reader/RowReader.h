@@ -0,0 +1,60 @@
+#ifndef ROWREADER_H
+#define ROWREADER_H
+
+#include "image/ImageView.h"
+
+
+/**
+ * Represents an interface for reading the rows of an RGB image in order, a strip at a time, so that the whole image
+ * does not need to be held in memory.
+ */
+class RowReader {
+public:
+    /**
+     * Default constructor.
+     */
+    RowReader();
+
+    /**
+     * Default destructor.
+     *
+     * It is declared as virtual to ensure that the proper destructor is called for derived classes.
+     */
+    virtual ~RowReader();
+
+
+    /**
+     * Retrieves the width of the image.
+     *
+     * @return The width of the image in pixels.
+     */
+    [[nodiscard]] virtual unsigned int getWidth() const = 0;
+
+    /**
+     * Retrieves the height of the image.
+     *
+     * @return The height of the image in pixels.
+     */
+    [[nodiscard]] virtual unsigned int getHeight() const = 0;
+
+    /**
+     * Retrieves the index of the next row to be read, i.e. the number of rows already read.
+     *
+     * @return The row index as an unsigned integer.
+     */
+    [[nodiscard]] virtual unsigned int getNextRow() const = 0;
+
+    /**
+     * Reads the next rows of the image into the given planes, as many as their height.
+     *
+     * @param output The planes receiving the rows, as wide as the image.
+     * @throw std::invalid_argument If the width of the planes differs from the image one, or their height
+     *                              exceeds the number of rows left.
+     * @throw std::runtime_error If the rows fail to be read.
+     */
+    virtual void readRows(const MutableImageView& output) = 0;
+};
+
+
+
+#endif //ROWREADER_H
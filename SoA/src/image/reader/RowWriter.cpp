@@ -0,0 +1,5 @@
+#include "RowWriter.h"
+
+RowWriter::RowWriter() = default;
+
+RowWriter::~RowWriter() = default;
@@ -0,0 +1,62 @@
+#ifndef ROWWRITER_H
+#define ROWWRITER_H
+
+#include "image/ImageView.h"
+
+
+/**
+ * Represents an interface for writing the rows of an RGB image in order, a strip at a time, so that the whole image
+ * does not need to be held in memory.
+ *
+ * The image is complete once its last row is written.
+ */
+class RowWriter {
+public:
+    /**
+     * Default constructor.
+     */
+    RowWriter();
+
+    /**
+     * Default destructor.
+     *
+     * It is declared as virtual to ensure that the proper destructor is called for derived classes.
+     */
+    virtual ~RowWriter();
+
+
+    /**
+     * Retrieves the width of the image.
+     *
+     * @return The width of the image in pixels.
+     */
+    [[nodiscard]] virtual unsigned int getWidth() const = 0;
+
+    /**
+     * Retrieves the height of the image.
+     *
+     * @return The height of the image in pixels.
+     */
+    [[nodiscard]] virtual unsigned int getHeight() const = 0;
+
+    /**
+     * Retrieves the index of the next row to be written, i.e. the number of rows already written.
+     *
+     * @return The row index as an unsigned integer.
+     */
+    [[nodiscard]] virtual unsigned int getNextRow() const = 0;
+
+    /**
+     * Writes the given rows after the ones already written, as many as their height.
+     *
+     * @param input The planes holding the rows, as wide as the image.
+     * @throw std::invalid_argument If the width of the planes differs from the image one, or their height
+     *                              exceeds the number of rows left.
+     * @throw std::runtime_error If the rows fail to be written.
+     */
+    virtual void writeRows(const ImageView& input) = 0;
+};
+
+
+
+#endif //ROWWRITER_H
@@ -1,18 +1,30 @@
-#define STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image.h"
 #include "stb_image_write.h"
 
 #include "STBImageReader.h"
+#include "JpegDecoder.h"
+#include "JpegEncoder.h"
+#include "processing/simd/ChannelLayout.h"
 
 #define RGB_CHANNELS 3
 #define JPG_QUALITY 100
 
 STBImageReader::STBImageReader() = default;
 
+STBImageReader::STBImageReader(ThreadPool &threadPool): threadPool(&threadPool) {}
+
 STBImageReader::~STBImageReader() = default;
 
 std::unique_ptr<Image> STBImageReader::loadRGBImage(const std::filesystem::path &filePath) {
+    // JPEG images are decoded straight into padded planes, the other formats through an interleaved buffer
+    if (JpegDecoder::isJpeg(filePath)) {
+        const std::unique_ptr<JpegDecoder> decoder = threadPool ? std::make_unique<JpegDecoder>(filePath, *threadPool) :
+            std::make_unique<JpegDecoder>(filePath);
+        ImageBuffer buffer(decoder->getWidth(), decoder->getHeight());
+        decoder->readRows(buffer.view());
+        return std::make_unique<Image>(std::move(buffer));
+    }
+
     int width, height, channels;
 
     unsigned char* imgData = stbi_load(filePath.generic_string().c_str(), &width, &height, &channels, RGB_CHANNELS);
@@ -20,47 +32,52 @@ std::unique_ptr<Image> STBImageReader::loadRGBImage(const std::filesystem::path
         throw std::runtime_error("Image loading fails.");
     }
 
-    // conversion
-    std::vector<uint8_t> reds (width * height);
-    std::vector<uint8_t> greens (width * height);
-    std::vector<uint8_t> blues (width * height);
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            const unsigned int pos = y * width + x;
-            const unsigned int idx = (y * width + x) * RGB_CHANNELS;
-            reds[pos] = imgData[idx];
-            greens[pos] = imgData[idx + 1];
-            blues[pos] = imgData[idx + 2];
-        }
-    }
+    // conversion into padded rows, which the engines read without copies
+    ImageBuffer buffer(width, height);
+    const MutableImageView planes = buffer.view();
+    ChannelLayout::deinterleave(imgData, width, height, planes.reds, planes.greens, planes.blues, planes.stride);
 
     stbi_image_free(imgData);
-    return std::make_unique<Image>(width, height, reds, greens, blues);
+    return std::make_unique<Image>(std::move(buffer));
 }
 
 void STBImageReader::saveJPGImage(const Image &img, const std::filesystem::path &filePath) {
     const unsigned int width = img.getWidth();
     const unsigned int height = img.getHeight();
 
+    // the parallel encoder reads the planes in place
+    if (threadPool) {
+        JpegEncoder encoder(filePath, width, height, JPG_QUALITY, *threadPool);
+        encoder.writeRows({width, height, img.getStride(), img.viewReds().data(), img.viewGreens().data(),
+            img.viewBlues().data()});
+        return;
+    }
+
     std::vector<uint8_t> flatData(width * height * RGB_CHANNELS);
 
     // retrieve data
-    const auto reds = img.getReds();
-    const auto greens = img.getGreens();
-    const auto blues = img.getBlues();
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            const unsigned int idx = (y * width + x) * RGB_CHANNELS;
-            const unsigned int pos = y * width + x;
-            flatData[idx] = reds[pos];
-            flatData[idx + 1] = greens[pos];
-            flatData[idx + 2] = blues[pos];
-        }
-    }
+    ChannelLayout::interleave(img.viewReds().data(), img.viewGreens().data(), img.viewBlues().data(), img.getStride(),
+        width, height, flatData.data());
 
     // save
     if (!stbi_write_jpg(filePath.generic_string().c_str(), static_cast<int>(width), static_cast<int>(height),
         RGB_CHANNELS, flatData.data(), JPG_QUALITY)) {
         throw std::runtime_error("Image saving fails.");
     }
-}
\ No newline at end of file
+}
+
+std::unique_ptr<RowReader> STBImageReader::openRGBImage(const std::filesystem::path &filePath) {
+    if (JpegDecoder::isJpeg(filePath)) {
+        if (threadPool)
+            return std::make_unique<JpegDecoder>(filePath, *threadPool);
+        return std::make_unique<JpegDecoder>(filePath);
+    }
+    return ImageReader::openRGBImage(filePath);
+}
+
+std::unique_ptr<RowWriter> STBImageReader::createJPGImage(const std::filesystem::path &filePath,
+    const unsigned int width, const unsigned int height) {
+    if (threadPool)
+        return std::make_unique<JpegEncoder>(filePath, width, height, JPG_QUALITY, *threadPool);
+    return std::make_unique<JpegEncoder>(filePath, width, height, JPG_QUALITY);
+}
@@ -3,6 +3,7 @@
 #include <filesystem>
 
 #include "image/Image.h"
+#include "processing/parallel/ThreadPool.h"
 #include "ImageReader.h"
 
 
@@ -16,6 +17,14 @@ public:
      */
     STBImageReader();
 
+    /**
+     * Constructs a reader which decodes and encodes JPEG images in parallel in the given thread pool, encoding
+     * each row of MCUs as a restart interval.
+     *
+     * @param threadPool The pool decoding and encoding the images, which must outlive the reader.
+     */
+    explicit STBImageReader(ThreadPool& threadPool);
+
     /**
      * Default destructor.
      */
@@ -23,7 +32,8 @@ public:
 
 
     /**
-     * Loads an RGB image from the specified file path using STB library.
+     * Loads an RGB image from the specified file path using STB library, decoding JPEG images in the thread pool
+     * of the reader, if any.
      *
      * @param filePath The full or relative file path to the image to load.
      * @return A unique pointer to the Image object containing the loaded image data.
@@ -32,13 +42,48 @@ public:
     std::unique_ptr<Image> loadRGBImage(const std::filesystem::path& filePath) override;
 
     /**
-     * Saves an image in JPEG format to the specified file path using STB library.
+     * Saves an image in JPEG format to the specified file path using STB library, or using a parallel
+     * @ref JpegEncoder if the reader has a thread pool.
      *
      * @param img The Image object to save.
      * @param filePath The full or relative file path where the JPEG image will be saved.
      * @throw std::runtime_error If the image fails to save.
      */
     void saveJPGImage(const Image &img, const std::filesystem::path &filePath) override;
+
+    /**
+     * Opens an RGB image from the specified file path, to be read a strip at a time.
+     *
+     * JPEG images are read by a @ref JpegDecoder, which decodes them while reading, or entirely when opened in
+     * the thread pool of the reader, whereas the other formats are loaded entirely, as stb does not decode them
+     * incrementally.
+     *
+     * @param filePath The full or relative file path to the image to open.
+     * @return A unique pointer to the RowReader object returning the rows of the image.
+     * @throw std::runtime_error If the image fails to load.
+     */
+    std::unique_ptr<RowReader> openRGBImage(const std::filesystem::path &filePath) override;
+
+    /**
+     * Creates an image in JPEG format at the specified file path, to be written a strip at a time by a
+     * @ref JpegEncoder, which encodes the rows as they come, with the same quality as @ref saveJPGImage and
+     * in the thread pool of the reader, if any.
+     *
+     * @param filePath The full or relative file path where the JPEG image will be saved.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @return A unique pointer to the RowWriter object receiving the rows of the image.
+     * @throw std::invalid_argument If a size is zero or exceeds the JPEG limit of 65535 pixels.
+     * @throw std::runtime_error If the file cannot be opened.
+     */
+    std::unique_ptr<RowWriter> createJPGImage(const std::filesystem::path &filePath, unsigned int width,
+        unsigned int height) override;
+
+private:
+    /**
+     * The pool decoding and encoding JPEG images, or null if they are processed sequentially.
+     */
+    ThreadPool* threadPool = nullptr;
 };
 
 
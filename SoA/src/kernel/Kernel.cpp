@@ -1,8 +1,8 @@
 #include <iostream>
 #include "Kernel.h"
 
-Kernel::Kernel(std::string name, const unsigned int order, const std::vector<float>& weights):
-    name(std::move(name)), order(order), weights(weights) {}
+Kernel::Kernel(std::string name, const unsigned int order, std::vector<float> weights):
+    name(std::move(name)), order(order), weights(std::move(weights)) {}
 
 Kernel::~Kernel() = default;
 
@@ -16,4 +16,8 @@ unsigned int Kernel::getOrder() const {
 
 std::vector<float> Kernel::getWeights() const {
     return weights;
+}
+
+Span<const float> Kernel::viewWeights() const {
+    return {weights.data(), weights.size()};
 }
\ No newline at end of file
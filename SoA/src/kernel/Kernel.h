@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 
+#include "view/Span.h"
+
 
 /**
  * Represents a kernel used in image processing operations, providing a name,
@@ -15,11 +17,13 @@ public:
     /**
      * Constructs a Kernel object with the specified name, order, and weights.
      *
+     * Name and weights are taken by value, so that temporary or moved ones are moved into the kernel.
+     *
      * @param name The name of the kernel as a string.
      * @param order The order of the kernel.
      * @param weights A vector of floating-point numbers representing the weights associated with the kernel.
      */
-    explicit Kernel(std::string name, unsigned int order, const std::vector<float>& weights);
+    explicit Kernel(std::string name, unsigned int order, std::vector<float> weights);
 
     /**
      * Default destructor.
@@ -47,6 +51,13 @@ public:
      */
     [[nodiscard]] std::vector<float> getWeights() const;
 
+    /**
+     * Retrieves a read-only view of the weights of the kernel, without copying them.
+     *
+     * @return A view of the order * order weights, stored by rows, valid as long as the kernel.
+     */
+    [[nodiscard]] Span<const float> viewWeights() const;
+
 private:
     /**
      * Represents the name of the kernel, i.e. a string that identifies the kernel.
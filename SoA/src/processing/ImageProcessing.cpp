@@ -1,7 +1,78 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
 #include "ImageProcessing.h"
+#include "image/ImageBuffer.h"
+#include "cache/CacheTopology.h"
+#include "fft/FftConvolution.h"
+#include "kernel/KernelFactory.h"
+#include "simd/FixedPointConvolution.h"
+#include "sparse/SparseKernel.h"
+#include "simd/PlaneConvolution.h"
+#include "simd/SymmetricConvolution.h"
+#include "simd/UnrolledConvolution.h"
 
 #define MIN_VALUE 0
 #define MAX_VALUE 255
+#define SEPARABILITY_EPSILON 1e-6f
+#define FIXED_POINT_EPSILON 1e-5
+// largest sums whose quotient is exactly truncated after a single precision division
+#define FIXED_POINT_DIVISION_LIMIT (1 << 24)
+// largest integers held exactly by single precision floats
+#define FLOAT_EXACT_LIMIT (1 << 24)
+#define RGB_CHANNELS 3
+#define BANDS_PER_THREAD 24
+// rows read, computed and written at once by streamed convolutions, i.e. a row of subsampled JPEG blocks
+#define STREAM_STRIP_HEIGHT 16
+#define FFT_CACHE_SIZE 4
+#define CONVOLUTION_TASK_CACHE_SIZE 16
+// multiple of the widest vector step, so that blocks do not change which columns are left to scalar code
+#define BLOCK_WIDTH_GRANULARITY 64
+// costs in nanoseconds, measured by the crossover benchmark (see expt/crossover.cpp)
+#define FFT_OPERATION_COST 0.55
+#define SCALAR_TAP_COST 1.2
+#define SSE42_TAP_COST 0.24
+#define AVX2_TAP_COST 0.11
+#define AVX512_TAP_COST 0.1
+#define AVX512_UNROLLED_TAP_COST 0.065
+#define SCALAR_SPARSE_TAP_COST 1.2
+#define SSE42_SPARSE_TAP_COST 0.24
+#define AVX2_SPARSE_TAP_COST 0.12
+#define AVX512_SPARSE_TAP_COST 0.1
+#define SCALAR_FOLD_COST 3.3
+#define SSE42_FOLD_COST 0.6
+#define AVX2_FOLD_COST 0.26
+#define AVX512_FOLD_COST 0.13
+// fixed-point taps accumulated in 32-bit lanes, measured with edge detection kernels of orders 13 to 31
+#define SCALAR_WIDE_FIXED_POINT_TAP_COST 1.0
+#define SSE42_WIDE_FIXED_POINT_TAP_COST 0.29
+#define AVX2_WIDE_FIXED_POINT_TAP_COST 0.12
+#define AVX512_WIDE_FIXED_POINT_TAP_COST 0.08
+// box filter and separable engines are plain loops, whose cost hardly depends on the instruction set
+#define BOX_FILTER_PIXEL_COST 5.4
+#define SEPARABLE_TAP_COST 1.6
+
+/**
+ * Computes the first numRows output rows of a block, reading and writing them with the given strides.
+ */
+using BlockConvolution = std::function<void(const uint8_t* input, unsigned int inputStride, uint8_t* output,
+    unsigned int outputStride, unsigned int outputWidth, unsigned int numRows)>;
+
+/**
+ * Computes the output rows in the range [rowBegin, rowEnd) of a single channel plane.
+ *
+ * Each engine is wrapped into a task, so that the same computation can be run either sequentially on whole planes
+ * or in parallel on horizontal bands, with bit-identical results. The input stride is bound when the task is
+ * created, while the output one is given on each run; values after the output width up to the output stride
+ * may be overwritten.
+ */
+using PlaneTask = std::function<void(const uint8_t* input, uint8_t* output, unsigned int outputStride,
+    unsigned int rowBegin, unsigned int rowEnd)>;
 
 uint8_t getChannelAsUint8(const float channel) {
     if (channel < MIN_VALUE)
@@ -11,21 +82,1295 @@ uint8_t getChannelAsUint8(const float channel) {
     return static_cast<uint8_t>(channel);
 }
 
-std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel) {
+bool decomposeSeparable(const Kernel &kernel, std::vector<float> &verticalWeights,
+    std::vector<float> &horizontalWeights) {
+    const unsigned int order = kernel.getOrder();
+    const auto kernelWeights = kernel.viewWeights();
+
+    // the weight with the greatest magnitude is used as pivot to keep the decomposition well-conditioned
+    unsigned int pivot = 0;
+    for (unsigned int k = 1; k < order * order; k++) {
+        if (std::fabs(kernelWeights[k]) > std::fabs(kernelWeights[pivot]))
+            pivot = k;
+    }
+    const float pivotWeight = kernelWeights[pivot];
+    const unsigned int pivotRow = pivot / order;
+    const unsigned int pivotColumn = pivot % order;
+
+    verticalWeights.resize(order);
+    horizontalWeights.resize(order);
+    for (unsigned int k = 0; k < order; k++) {
+        verticalWeights[k] = kernelWeights[k * order + pivotColumn];
+        horizontalWeights[k] = pivotWeight != 0 ? kernelWeights[pivotRow * order + k] / pivotWeight : 0;
+    }
+
+    // rank-one check
+    const float tolerance = SEPARABILITY_EPSILON * std::fabs(pivotWeight);
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            if (std::fabs(verticalWeights[j] * horizontalWeights[i] - kernelWeights[j * order + i]) > tolerance)
+                return false;
+        }
+    }
+    return true;
+}
+
+void separablePlane(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const std::vector<float> &verticalWeights, const std::vector<float> &horizontalWeights) {
+    const auto order = static_cast<unsigned int>(verticalWeights.size());
+    const unsigned int inputWidth = outputWidth + order - 1;
+
+    // scratch buffers are kept by each thread, so that repeated convolutions do not allocate
+    thread_local std::vector<float> row;
+    row.resize(inputWidth);
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        // vertical pass
+        std::fill(row.begin(), row.end(), 0.0f);
+        for (unsigned int j = 0; j < order; j++) {
+            const float kernelWeight = verticalWeights[j];
+            for (unsigned int x = 0; x < inputWidth; x++) {
+                row[x] += static_cast<float>(input[(y + j) * inputStride + x]) * kernelWeight;
+            }
+        }
+
+        // horizontal pass
+        for (unsigned int x = 0; x < outputWidth; x++) {
+            float channel = 0;
+            for (unsigned int i = 0; i < order; i++) {
+                channel += row[x + i] * horizontalWeights[i];
+            }
+            output[y * outputStride + x] = getChannelAsUint8(channel);
+        }
+    }
+}
+
+uint8_t getBoxSumAsUint8(const uint32_t sum, const uint32_t numOfWeights, const bool isMean, const double weight) {
+    if (isMean)
+        return static_cast<uint8_t>(sum / numOfWeights);
+    return getChannelAsUint8(static_cast<float>(static_cast<double>(sum) * weight));
+}
+
+void boxFilterPlane(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const unsigned int order, const float weight) {
+    const unsigned int inputWidth = outputWidth + order - 1;
+    const uint32_t numOfWeights = order * order;
+    // weights equal to the mean make the result an exact integer division
+    const bool isMean = weight == 1 / static_cast<float>(numOfWeights);
+
+    // column sums of the first window
+    thread_local std::vector<uint32_t> columns;
+    columns.assign(inputWidth, 0);
+    for (unsigned int j = rowBegin; j < rowBegin + order - 1; j++) {
+        for (unsigned int x = 0; x < inputWidth; x++) {
+            columns[x] += input[j * inputStride + x];
+        }
+    }
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        // vertical sliding: add the entering row and, from the second row on, subtract the leaving one
+        for (unsigned int x = 0; x < inputWidth; x++) {
+            columns[x] += input[(y + order - 1) * inputStride + x];
+        }
+        if (y > rowBegin) {
+            for (unsigned int x = 0; x < inputWidth; x++) {
+                columns[x] -= input[(y - 1) * inputStride + x];
+            }
+        }
+
+        // horizontal sliding
+        uint32_t sum = 0;
+        for (unsigned int i = 0; i < order; i++) {
+            sum += columns[i];
+        }
+        for (unsigned int x = 0; x < outputWidth; x++) {
+            if (x > 0)
+                sum += columns[x + order - 1] - columns[x - 1];
+            output[y * outputStride + x] = getBoxSumAsUint8(sum, numOfWeights, isMean, weight);
+        }
+    }
+}
+
+PlaneTask createBoxFilterTask(const Kernel &kernel, const unsigned int inputStride, const unsigned int outputWidth) {
     const unsigned int order = kernel.getOrder();
+    const float weight = kernel.viewWeights()[0];
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        boxFilterPlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, order, weight);
+    };
+}
+
+PlaneTask createSeparableTask(const std::vector<float> &verticalWeights, const std::vector<float> &horizontalWeights,
+    const unsigned int inputStride, const unsigned int outputWidth) {
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        separablePlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, verticalWeights,
+            horizontalWeights);
+    };
+}
+
+PlaneTask createVectorizedTask(const Kernel &kernel, const InstructionSet instructionSet,
+    const unsigned int inputStride, const unsigned int outputWidth) {
+    const unsigned int order = kernel.getOrder();
+    const PlaneConvolution::Function convolvePlane = UnrolledConvolution::select(instructionSet, order);
     const auto kernelWeights = kernel.getWeights();
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        convolvePlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, kernelWeights.data(),
+            order);
+    };
+}
+
+bool decomposeFixedPoint(const Kernel &kernel, FixedPointConvolution::Weights &fixedPointWeights) {
+    const auto kernelWeights = kernel.viewWeights();
+
+    // weights must be integer multiples of the smallest one, which must be either integer or a reciprocal
+    double unit = 0;
+    for (const float weight : kernelWeights) {
+        if (weight != 0 && (unit == 0 || std::fabs(weight) < unit))
+            unit = std::fabs(weight);
+    }
+    const bool isInteger = std::all_of(kernelWeights.begin(), kernelWeights.end(),
+        [](const float weight) { return weight == std::round(weight); });
+    double divisor = 1;
+    if (!isInteger) {
+        divisor = std::round(1 / unit);
+        if (divisor < 1 || std::fabs(divisor * unit - 1) > FIXED_POINT_EPSILON)
+            return false;
+    }
+
+    std::vector<int32_t> numerators(kernelWeights.size());
+    int64_t positiveSum = 0;
+    int64_t negativeSum = 0;
+    for (unsigned int k = 0; k < kernelWeights.size(); k++) {
+        const double scaledWeight = kernelWeights[k] * divisor;
+        const double numerator = std::round(scaledWeight);
+        if (std::fabs(scaledWeight - numerator) > FIXED_POINT_EPSILON * std::max(1.0, std::fabs(numerator)) ||
+            std::fabs(numerator) > INT32_MAX / MAX_VALUE)
+            return false;
+        numerators[k] = static_cast<int32_t>(numerator);
+        if (numerators[k] > 0)
+            positiveSum += numerators[k];
+        else
+            negativeSum -= numerators[k];
+    }
+
+    // worst-case sums are reached by saturated values under positive weights, and zeros under negative ones
+    const int64_t maxSum = positiveSum * MAX_VALUE;
+    const int64_t minSum = -negativeSum * MAX_VALUE;
+    if (maxSum > INT32_MAX || minSum < INT32_MIN || (divisor != 1 && maxSum >= FIXED_POINT_DIVISION_LIMIT))
+        return false;
+
+    fixedPointWeights.numerators = std::move(numerators);
+    fixedPointWeights.order = kernel.getOrder();
+    fixedPointWeights.divisor = static_cast<int32_t>(divisor);
+    fixedPointWeights.isNarrow = maxSum <= INT16_MAX && minSum >= INT16_MIN;
+    // partial sums lie between the worst-case ones, and single precision floats hold integers up to 2^24
+    fixedPointWeights.isExactInFloat = divisor == 1 && maxSum < FLOAT_EXACT_LIMIT && minSum > -FLOAT_EXACT_LIMIT;
+    return true;
+}
+
+PlaneTask createFixedPointTask(const FixedPointConvolution::Weights &fixedPointWeights,
+    const InstructionSet instructionSet, const unsigned int inputStride, const unsigned int outputWidth) {
+    const FixedPointConvolution::Function convolvePlane = FixedPointConvolution::select(instructionSet);
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        convolvePlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, fixedPointWeights);
+    };
+}
+
+unsigned int ImageProcessing::chooseBlockWidth(const unsigned int order, const unsigned int outputWidth,
+    const CacheTopology &cacheTopology) {
+    // the order input rows read by consecutive output rows must stay in half the level 1 cache,
+    // or at least in half the level 2 cache for large orders
+    unsigned int blockWidth = BLOCK_WIDTH_GRANULARITY;
+    for (const unsigned int cacheSize : {cacheTopology.getL1DataSize(), cacheTopology.getL2Size()}) {
+        const unsigned int rowSize = cacheSize / 2 / order;
+        if (rowSize >= order - 1 + BLOCK_WIDTH_GRANULARITY) {
+            blockWidth = (rowSize - (order - 1)) / BLOCK_WIDTH_GRANULARITY * BLOCK_WIDTH_GRANULARITY;
+            break;
+        }
+    }
+    const unsigned int alignedOutputWidth =
+        (outputWidth + BLOCK_WIDTH_GRANULARITY - 1) / BLOCK_WIDTH_GRANULARITY * BLOCK_WIDTH_GRANULARITY;
+    return std::min(blockWidth, alignedOutputWidth);
+}
+
+unsigned int ImageProcessing::chooseBlockHeight(const unsigned int order, const unsigned int blockWidth,
+    const CacheTopology &cacheTopology) {
+    // the packed input block and the output block must stay in half the level 2 cache
+    const unsigned long inputWidth = blockWidth + order - 1;
+    const unsigned long availableSize = cacheTopology.getL2Size() / 2;
+    if (availableSize <= (order - 1) * inputWidth + inputWidth + blockWidth)
+        return 1;
+    return static_cast<unsigned int>((availableSize - (order - 1) * inputWidth) / (inputWidth + blockWidth));
+}
+
+/**
+ * Chooses the stride of the packed input blocks: a whole number of cache lines, odd so that
+ * consecutive rows are spread over all level 1 sets instead of competing for the same ways.
+ */
+unsigned int choosePackedStride(const unsigned int inputBlockWidth, const CacheTopology &cacheTopology) {
+    const unsigned int lineSize = cacheTopology.getLineSize();
+    unsigned int numLines = (inputBlockWidth + lineSize - 1) / lineSize;
+    if (numLines % 2 == 0)
+        numLines++;
+    return numLines * lineSize;
+}
+
+PlaneTask createBlockedTask(const BlockConvolution &convolveBlock, const unsigned int order,
+    const CacheTopology &cacheTopology, const unsigned int inputStride, const unsigned int outputWidth) {
+    const unsigned int blockWidth = ImageProcessing::chooseBlockWidth(order, outputWidth, cacheTopology);
+    const unsigned int blockHeight = ImageProcessing::chooseBlockHeight(order, blockWidth, cacheTopology);
+    const unsigned int packedStride = choosePackedStride(blockWidth + order - 1, cacheTopology);
+
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        thread_local std::vector<uint8_t> packedInput;
+        thread_local std::vector<uint8_t> blockOutput;
+        packedInput.resize(packedStride * (blockHeight + order - 1));
+        blockOutput.resize(blockWidth * blockHeight);
+
+        for (unsigned int blockRow = rowBegin; blockRow < rowEnd; blockRow += blockHeight) {
+            const unsigned int numRows = std::min(blockHeight, rowEnd - blockRow);
+            for (unsigned int blockColumn = 0; blockColumn < outputWidth; blockColumn += blockWidth) {
+                const unsigned int width = std::min(blockWidth, outputWidth - blockColumn);
+
+                // packing decouples the block from the image stride, which may alias in the level 1 cache
+                for (unsigned int j = 0; j < numRows + order - 1; j++) {
+                    const uint8_t* inputRow = input + (blockRow + j) * inputStride + blockColumn;
+                    std::copy_n(inputRow, width + order - 1, packedInput.data() + j * packedStride);
+                }
+                // the block width is a multiple of the widest vector step, thus partial blocks are vectorized too
+                convolveBlock(packedInput.data(), packedStride, blockOutput.data(), blockWidth, width, numRows);
+                for (unsigned int y = 0; y < numRows; y++) {
+                    std::copy_n(blockOutput.data() + y * blockWidth, width,
+                        output + (blockRow + y) * outputStride + blockColumn);
+                }
+            }
+        }
+    };
+}
+
+PlaneTask createBlockedVectorizedTask(const Kernel &kernel, const InstructionSet instructionSet,
+    const CacheTopology &cacheTopology, const unsigned int inputStride, const unsigned int outputWidth) {
+    const unsigned int order = kernel.getOrder();
+    const PlaneConvolution::Function convolvePlane = UnrolledConvolution::select(instructionSet, order);
+    const auto kernelWeights = kernel.getWeights();
+    const BlockConvolution convolveBlock = [=](const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+        const unsigned int outputStride, const unsigned int width, const unsigned int numRows) {
+        convolvePlane(input, inputStride, output, outputStride, width, 0, numRows, kernelWeights.data(), order);
+    };
+    return createBlockedTask(convolveBlock, order, cacheTopology, inputStride, outputWidth);
+}
+
+PlaneTask createBlockedFixedPointTask(const FixedPointConvolution::Weights &fixedPointWeights,
+    const InstructionSet instructionSet, const CacheTopology &cacheTopology, const unsigned int inputStride,
+    const unsigned int outputWidth) {
+    const FixedPointConvolution::Function convolvePlane = FixedPointConvolution::select(instructionSet);
+    const BlockConvolution convolveBlock = [=](const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+        const unsigned int outputStride, const unsigned int width, const unsigned int numRows) {
+        convolvePlane(input, inputStride, output, outputStride, width, 0, numRows, fixedPointWeights);
+    };
+    return createBlockedTask(convolveBlock, fixedPointWeights.order, cacheTopology, inputStride, outputWidth);
+}
+
+bool decomposeSymmetric(const Kernel &kernel, const unsigned int inputStride,
+    SymmetricConvolution::Weights &symmetricWeights) {
+    const unsigned int order = kernel.getOrder();
+    const auto kernelWeights = kernel.viewWeights();
+
+    bool isHorizontal = true;
+    bool isVertical = true;
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            const float weight = kernelWeights[j * order + i];
+            isHorizontal &= weight == kernelWeights[j * order + (order - 1 - i)];
+            isVertical &= weight == kernelWeights[(order - 1 - j) * order + i];
+        }
+    }
+    if (!isHorizontal && !isVertical)
+        return false;
+
+    // along a symmetric direction, only the first half and the central line are visited
+    const unsigned int numRows = isVertical ? order / 2 + 1 : order;
+    const unsigned int numColumns = isHorizontal ? order / 2 + 1 : order;
+    symmetricWeights.folds.clear();
+    for (unsigned int j = 0; j < numRows; j++) {
+        for (unsigned int i = 0; i < numColumns; i++) {
+            const float weight = kernelWeights[j * order + i];
+            if (weight == 0)
+                continue;
+
+            const unsigned int rows[2] = {j, order - 1 - j};
+            const unsigned int columns[2] = {i, order - 1 - i};
+            const unsigned int numMirroredRows = isVertical && rows[0] != rows[1] ? 2 : 1;
+            const unsigned int numMirroredColumns = isHorizontal && columns[0] != columns[1] ? 2 : 1;
+            SymmetricConvolution::Fold fold{};
+            fold.weight = weight;
+            for (unsigned int r = 0; r < numMirroredRows; r++) {
+                for (unsigned int c = 0; c < numMirroredColumns; c++)
+                    fold.offsets[fold.numOffsets++] = rows[r] * inputStride + columns[c];
+            }
+            symmetricWeights.folds.push_back(fold);
+        }
+    }
+    symmetricWeights.order = order;
+    return true;
+}
+
+PlaneTask createSymmetricTask(const SymmetricConvolution::Weights &symmetricWeights,
+    const InstructionSet instructionSet, const unsigned int inputStride, const unsigned int outputWidth) {
+    const SymmetricConvolution::Function convolvePlane = SymmetricConvolution::select(instructionSet);
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        convolvePlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, symmetricWeights);
+    };
+}
+
+double getDenseTapCost(const unsigned int order) {
+    switch (InstructionSets::detect()) {
+        case InstructionSet::avx512:
+            // only AVX-512 microkernels have enough registers to gain noticeably from row blocking
+            return order <= UnrolledConvolution::MAX_ORDER ? AVX512_UNROLLED_TAP_COST : AVX512_TAP_COST;
+        case InstructionSet::avx2:
+            return AVX2_TAP_COST;
+        case InstructionSet::sse42:
+            return SSE42_TAP_COST;
+        default:
+            return SCALAR_TAP_COST;
+    }
+}
+
+double getSparseTapCost() {
+    switch (InstructionSets::detect()) {
+        case InstructionSet::avx512:
+            return AVX512_SPARSE_TAP_COST;
+        case InstructionSet::avx2:
+            return AVX2_SPARSE_TAP_COST;
+        case InstructionSet::sse42:
+            return SSE42_SPARSE_TAP_COST;
+        default:
+            return SCALAR_SPARSE_TAP_COST;
+    }
+}
+
+double getFoldCost() {
+    // a fold of four mirrored input values, with one conversion and one multiplication
+    switch (InstructionSets::detect()) {
+        case InstructionSet::avx512:
+            return AVX512_FOLD_COST;
+        case InstructionSet::avx2:
+            return AVX2_FOLD_COST;
+        case InstructionSet::sse42:
+            return SSE42_FOLD_COST;
+        default:
+            return SCALAR_FOLD_COST;
+    }
+}
+
+double getWideFixedPointTapCost() {
+    // 32-bit lanes hold as many values as float ones, but integer multiplications are slower than fused ones
+    switch (InstructionSets::detect()) {
+        case InstructionSet::avx512:
+            return AVX512_WIDE_FIXED_POINT_TAP_COST;
+        case InstructionSet::avx2:
+            return AVX2_WIDE_FIXED_POINT_TAP_COST;
+        case InstructionSet::sse42:
+            return SSE42_WIDE_FIXED_POINT_TAP_COST;
+        default:
+            return SCALAR_WIDE_FIXED_POINT_TAP_COST;
+    }
+}
+
+bool isFixedPointPreferred(const FixedPointConvolution::Weights &fixedPointWeights) {
+    // 16-bit lanes, twice as many as float ones, are always used, while 32-bit ones are used only when they are
+    // cheaper than the float taps, or when these would not be exact
+    const unsigned int order = fixedPointWeights.order;
+    return fixedPointWeights.isNarrow || !fixedPointWeights.isExactInFloat ||
+        getWideFixedPointTapCost() < getDenseTapCost(order);
+}
+
+double estimateFftCost(const unsigned int order, const unsigned int outputWidth, const unsigned int outputHeight) {
+    const unsigned int tileSize = FftConvolution::chooseTileSize(order);
+    const unsigned int validSize = tileSize - (order - 1);
+    // partial tiles at the right and bottom borders cost as much as full ones
+    const double numTiles = std::ceil(static_cast<double>(outputWidth) / validSize) *
+        std::ceil(static_cast<double>(outputHeight) / validSize);
+    return FFT_OPERATION_COST * FftConvolution::estimateOperationsPerValue(order, tileSize) *
+        numTiles * validSize * validSize;
+}
+
+double estimateDenseCost(const unsigned int order, const bool isFixedPoint,
+    const FixedPointConvolution::Weights &fixedPointWeights, const unsigned int outputWidth,
+    const unsigned int outputHeight, const bool isFftAllowed) {
+    // kernels with a fixed-point form run on exact engines, thus never on the transforms, which round their results
+    const double outputSize = static_cast<double>(outputWidth) * outputHeight;
+    const double tapCost = getDenseTapCost(order) * order * order * outputSize;
+    if (isFixedPoint && !fixedPointWeights.isNarrow && isFixedPointPreferred(fixedPointWeights))
+        return getWideFixedPointTapCost() * order * order * outputSize;
+    if (isFixedPoint || !isFftAllowed)
+        return tapCost;
+    return std::min(tapCost, estimateFftCost(order, outputWidth, outputHeight));
+}
+
+unsigned int countTaps(const Kernel &kernel) {
+    const auto kernelWeights = kernel.viewWeights();
+    return static_cast<unsigned int>(std::count_if(kernelWeights.begin(), kernelWeights.end(),
+        [](const float weight) { return weight != 0; }));
+}
+
+PlaneTask createSparseTask(const Kernel &kernel, const InstructionSet instructionSet, const unsigned int inputStride,
+    const unsigned int outputWidth) {
+    const auto sparseKernel = std::make_shared<const SparseKernel>(kernel, inputStride);
+    const PlaneConvolution::SparseFunction convolvePlane = PlaneConvolution::selectSparse(instructionSet);
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        const std::vector<SparseKernel::Tap> &taps = sparseKernel->getTaps();
+        convolvePlane(input, inputStride, output, outputStride, outputWidth, rowBegin, rowEnd, taps.data(),
+            static_cast<unsigned int>(taps.size()));
+    };
+}
+
+std::shared_ptr<const FftConvolution> getFftConvolution(const Kernel &kernel) {
+    // the most recently used engines are kept, so that kernel spectra are not recomputed by repeated convolutions
+    static std::mutex cacheMutex;
+    static std::deque<std::shared_ptr<const FftConvolution>> cache;
+
+    std::lock_guard lock(cacheMutex);
+    const auto cached = std::find_if(cache.begin(), cache.end(),
+        [&kernel](const std::shared_ptr<const FftConvolution> &fftConvolution) { return fftConvolution->matches(kernel); });
+    if (cached != cache.end()) {
+        const auto fftConvolution = *cached;
+        cache.erase(cached);
+        cache.push_front(fftConvolution);
+        return fftConvolution;
+    }
+
+    const auto fftConvolution = std::make_shared<const FftConvolution>(kernel);
+    cache.push_front(fftConvolution);
+    if (cache.size() > FFT_CACHE_SIZE)
+        cache.pop_back();
+    return fftConvolution;
+}
+
+PlaneTask createFftTask(const Kernel &kernel, const unsigned int inputStride, const unsigned int inputWidth,
+    const unsigned int inputHeight) {
+    const std::shared_ptr<const FftConvolution> fftConvolution = getFftConvolution(kernel);
+    return [=](const uint8_t *input, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+        const unsigned int rowEnd) {
+        fftConvolution->convolvePlane(input, inputStride, inputWidth, inputHeight, output, outputStride, rowBegin,
+            rowEnd);
+    };
+}
+
+PlaneTask createConvolutionTask(const Kernel &kernel, const unsigned int inputStride, const unsigned int inputWidth,
+    const unsigned int inputHeight, const bool isFftAllowed) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int outputWidth = inputWidth - (order - 1);
+    if (order > 1 && ImageProcessing::isBoxFilter(kernel))
+        return createBoxFilterTask(kernel, inputStride, outputWidth);
+
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    if (order > 1 && decomposeSeparable(kernel, verticalWeights, horizontalWeights))
+        return createSeparableTask(verticalWeights, horizontalWeights, inputStride, outputWidth);
+    const InstructionSet instructionSet = InstructionSets::detect();
+    const unsigned int outputHeight = inputHeight - (order - 1);
+    FixedPointConvolution::Weights fixedPointWeights;
+    const bool isFixedPoint = decomposeFixedPoint(kernel, fixedPointWeights);
+    // zero weights and symmetries are exploited when they beat the dense engine that would run otherwise, as they
+    // do for large dilated or symmetric kernels, even if the kernel has a fixed-point form
+    const double outputSize = static_cast<double>(outputWidth) * outputHeight;
+    const double denseCost = estimateDenseCost(order, isFixedPoint, fixedPointWeights, outputWidth, outputHeight,
+        isFftAllowed);
+    const double sparseCost = getSparseTapCost() * countTaps(kernel) * outputSize;
+    SymmetricConvolution::Weights symmetricWeights;
+    const bool isSymmetric = decomposeSymmetric(kernel, inputStride, symmetricWeights);
+    const double symmetricCost = getFoldCost() * static_cast<double>(symmetricWeights.folds.size()) * outputSize;
+    if (isSymmetric && symmetricCost < std::min(sparseCost, denseCost))
+        return createSymmetricTask(symmetricWeights, instructionSet, inputStride, outputWidth);
+    if (sparseCost < denseCost)
+        return createSparseTask(kernel, instructionSet, inputStride, outputWidth);
+    // blocks pay off only when the input rows read by an output row spill out of the level 2 cache
+    const CacheTopology& cacheTopology = CacheTopology::detect();
+    const bool isBlocked = static_cast<unsigned long>(order) * inputWidth > cacheTopology.getL2Size() / 2;
+
+    // then kernels with a fixed-point form run on the fixed-point engine if it is preferred to the float taps, and
+    // are never handed to the transforms
+    if (isFixedPoint && isFixedPointPreferred(fixedPointWeights)) {
+        if (isBlocked)
+            return createBlockedFixedPointTask(fixedPointWeights, instructionSet, cacheTopology, inputStride, outputWidth);
+        return createFixedPointTask(fixedPointWeights, instructionSet, inputStride, outputWidth);
+    }
+    if (!isFixedPoint && isFftAllowed && ImageProcessing::isFftFaster(order, outputWidth, outputHeight))
+        return createFftTask(kernel, inputStride, inputWidth, inputHeight);
+    if (isBlocked)
+        return createBlockedVectorizedTask(kernel, instructionSet, cacheTopology, inputStride, outputWidth);
+    return createVectorizedTask(kernel, instructionSet, inputStride, outputWidth);
+}
+
+double estimateConvolutionCost(const Kernel &kernel, const unsigned int inputWidth, const unsigned int inputHeight) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int outputWidth = inputWidth - (order - 1);
+    const unsigned int outputHeight = inputHeight - (order - 1);
+    const double outputSize = static_cast<double>(outputWidth) * outputHeight;
+    if (order > 1 && ImageProcessing::isBoxFilter(kernel))
+        return BOX_FILTER_PIXEL_COST * outputSize;
+
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    if (order > 1 && decomposeSeparable(kernel, verticalWeights, horizontalWeights))
+        return SEPARABLE_TAP_COST * 2 * order * outputSize;
+    // the engines picked by createConvolutionTask, with 16-bit fixed-point ones costing as the float taps
+    FixedPointConvolution::Weights fixedPointWeights;
+    const bool isFixedPoint = decomposeFixedPoint(kernel, fixedPointWeights);
+    double cost = std::min(estimateDenseCost(order, isFixedPoint, fixedPointWeights, outputWidth, outputHeight, true),
+        getSparseTapCost() * countTaps(kernel) * outputSize);
+    SymmetricConvolution::Weights symmetricWeights;
+    if (decomposeSymmetric(kernel, inputWidth, symmetricWeights))
+        cost = std::min(cost, getFoldCost() * static_cast<double>(symmetricWeights.folds.size()) * outputSize);
+    return cost;
+}
+
+/**
+ * Represents a convolution task cached for a kernel, an input size and an input stride.
+ */
+struct CachedTask {
+    unsigned int order;
+    std::vector<float> weights;
+    unsigned int inputStride;
+    unsigned int inputWidth;
+    unsigned int inputHeight;
+    std::shared_ptr<const PlaneTask> task;
+};
+
+std::shared_ptr<const PlaneTask> getConvolutionTask(const Kernel &kernel, const unsigned int inputStride,
+    const unsigned int inputWidth, const unsigned int inputHeight) {
+    // the most recently used tasks are kept, so that repeated convolutions do not pick and set up engines again
+    static std::mutex cacheMutex;
+    static std::deque<CachedTask> cache;
+
+    std::lock_guard lock(cacheMutex);
+    const auto cached = std::find_if(cache.begin(), cache.end(), [&](const CachedTask &cachedTask) {
+        return cachedTask.order == kernel.getOrder() && cachedTask.inputStride == inputStride &&
+            cachedTask.inputWidth == inputWidth && cachedTask.inputHeight == inputHeight &&
+            std::equal(cachedTask.weights.begin(), cachedTask.weights.end(), kernel.viewWeights().begin());
+    });
+    if (cached != cache.end()) {
+        if (cached != cache.begin())
+            std::rotate(cache.begin(), cached, cached + 1);
+        return cache.front().task;
+    }
+
+    cache.push_front({kernel.getOrder(), kernel.getWeights(), inputStride, inputWidth, inputHeight,
+        std::make_shared<const PlaneTask>(createConvolutionTask(kernel, inputStride, inputWidth, inputHeight, true))});
+    if (cache.size() > CONVOLUTION_TASK_CACHE_SIZE)
+        cache.pop_back();
+    return cache.front().task;
+}
+
+void checkOutputSizes(const MutableImageView &output, const unsigned int width, const unsigned int height) {
+    if (output.width != width || output.height != height)
+        throw std::invalid_argument("Output image must have the sizes of the transformed image.");
+    if (output.stride < output.width)
+        throw std::invalid_argument("Output image must have a stride not smaller than its width.");
+}
+
+void runTask(const Image &image, const PlaneTask &task, const MutableImageView &output) {
+    const auto originalReds = image.viewReds();
+    const auto originalGreens = image.viewGreens();
+    const auto originalBlues = image.viewBlues();
+
+    task(originalReds.data(), output.reds, output.stride, 0, output.height);
+    task(originalGreens.data(), output.greens, output.stride, 0, output.height);
+    task(originalBlues.data(), output.blues, output.stride, 0, output.height);
+}
+
+std::unique_ptr<Image> runTask(const Image &image, const unsigned int order, const PlaneTask &task) {
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = image.getWidth() - (order - 1);
+
+    ImageBuffer buffer(outputWidth, outputHeight);
+    runTask(image, task, buffer.view());
+
+    return std::make_unique<Image>(std::move(buffer));
+}
+
+void runTaskInParallel(const Image &image, const PlaneTask &task, ThreadPool &threadPool,
+    const MutableImageView &output) {
+    const auto originalReds = image.viewReds();
+    const auto originalGreens = image.viewGreens();
+    const auto originalBlues = image.viewBlues();
+
+    // many bands per thread allow a dynamic balancing among cores of different speed
+    const unsigned int outputHeight = output.height;
+    const unsigned int numBands = std::max(1u, std::min(outputHeight,
+        threadPool.getNumThreads() * BANDS_PER_THREAD / RGB_CHANNELS));
+    const unsigned int bandHeight = (outputHeight + numBands - 1) / numBands;
+    const uint8_t* inputs[RGB_CHANNELS] = {originalReds.data(), originalGreens.data(), originalBlues.data()};
+    uint8_t* outputs[RGB_CHANNELS] = {output.reds, output.greens, output.blues};
+    threadPool.parallelFor(numBands * RGB_CHANNELS, [&](const unsigned int chunk) {
+        const unsigned int channel = chunk % RGB_CHANNELS;
+        const unsigned int rowBegin = chunk / RGB_CHANNELS * bandHeight;
+        const unsigned int rowEnd = std::min(rowBegin + bandHeight, outputHeight);
+        if (rowBegin < rowEnd)
+            task(inputs[channel], outputs[channel], output.stride, rowBegin, rowEnd);
+    });
+}
+
+std::unique_ptr<Image> runTaskInParallel(const Image &image, const unsigned int order, const PlaneTask &task,
+    ThreadPool &threadPool) {
+    const unsigned int outputHeight = image.getHeight() - (order - 1);
+    const unsigned int outputWidth = image.getWidth() - (order - 1);
+
+    ImageBuffer buffer(outputWidth, outputHeight);
+    runTaskInParallel(image, task, threadPool, buffer.view());
+
+    return std::make_unique<Image>(std::move(buffer));
+}
+
+unsigned int resolveEdgeCoordinate(const int coordinate, const unsigned int size,
+    const ImageProcessing::EdgePolicy edgePolicy) {
+    const int signedSize = static_cast<int>(size);
+    if (coordinate >= 0 && coordinate < signedSize)
+        return static_cast<unsigned int>(coordinate);
+
+    switch (edgePolicy) {
+        case ImageProcessing::EdgePolicy::extend:
+            return coordinate < 0 ? 0 : size - 1;
+        case ImageProcessing::EdgePolicy::wrap:
+            return static_cast<unsigned int>((coordinate % signedSize + signedSize) % signedSize);
+        case ImageProcessing::EdgePolicy::mirror: {
+            if (size == 1)
+                return 0;
+            // reflections repeat with a period of twice the distance between the edge pixels
+            const int period = 2 * (signedSize - 1);
+            const int reflected = (coordinate % period + period) % period;
+            return static_cast<unsigned int>(reflected < signedSize ? reflected : period - reflected);
+        }
+        default:
+            // the size itself marks the coordinates of constant values
+            return size;
+    }
+}
+
+/**
+ * Represents a rectangle of output values along the edges, which is computed from a patch of input values
+ * whose outer part is resolved by the edge policy.
+ */
+struct EdgePatch {
+    unsigned int rowBegin;
+    unsigned int rowEnd;
+    unsigned int columnBegin;
+    unsigned int columnEnd;
+    std::shared_ptr<const PlaneTask> task;
+};
+
+/**
+ * Creates the top, bottom, left and right patches, whose task is null when they are empty.
+ */
+std::array<EdgePatch, 4> createEdgePatches(const Kernel &kernel, const unsigned int width, const unsigned int height) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int radius = order / 2;
+    const unsigned int topEnd = std::min(radius, height);
+    const unsigned int bottomBegin = std::max(height - topEnd, topEnd);
+    const unsigned int leftEnd = std::min(radius, width);
+    const unsigned int rightBegin = std::max(width - leftEnd, leftEnd);
+
+    // top and bottom rectangles span the whole width, left and right ones the rows in between
+    const unsigned int bounds[4][4] = {{0, topEnd, 0, width}, {bottomBegin, height, 0, width},
+        {topEnd, bottomBegin, 0, leftEnd}, {topEnd, bottomBegin, rightBegin, width}};
+    std::array<EdgePatch, 4> edgePatches;
+    for (unsigned int k = 0; k < edgePatches.size(); k++) {
+        const unsigned int* bound = bounds[k];
+        edgePatches[k] = {bound[0], bound[1], bound[2], bound[3], nullptr};
+        if (bound[0] < bound[1] && bound[2] < bound[3]) {
+            const unsigned int patchWidth = bound[3] - bound[2] + order - 1;
+            const unsigned int patchHeight = bound[1] - bound[0] + order - 1;
+            edgePatches[k].task = getConvolutionTask(kernel, ImageBuffer::chooseStride(patchWidth), patchWidth,
+                patchHeight);
+        }
+    }
+    return edgePatches;
+}
+
+void convolveEdgePatch(const uint8_t *input, const unsigned int inputStride, const unsigned int width,
+    const unsigned int height, uint8_t *output, const unsigned int outputStride, const unsigned int order,
+    const ImageProcessing::EdgePolicy edgePolicy, const EdgePatch &edgePatch) {
+    const auto radius = static_cast<int>(order / 2);
+    const unsigned int outputWidth = edgePatch.columnEnd - edgePatch.columnBegin;
+    const unsigned int outputHeight = edgePatch.rowEnd - edgePatch.rowBegin;
+    const unsigned int patchWidth = outputWidth + order - 1;
+    const unsigned int patchHeight = outputHeight + order - 1;
+    // patches are padded as image buffers, so that their last columns are vectorized as those of the interior
+    const unsigned int patchStride = ImageBuffer::chooseStride(patchWidth);
+    const unsigned int patchOutputStride = ImageBuffer::chooseStride(outputWidth);
+
+    // buffers are reused by later patches of the same thread, so that repeated convolutions do not allocate
+    thread_local std::vector<unsigned int> columns;
+    thread_local std::vector<uint8_t> patch;
+    thread_local std::vector<uint8_t> patchOutput;
+    columns.resize(patchWidth);
+    patch.resize(patchStride * patchHeight);
+    patchOutput.resize(patchOutputStride * outputHeight);
+    for (unsigned int i = 0; i < patchWidth; i++)
+        columns[i] = resolveEdgeCoordinate(static_cast<int>(edgePatch.columnBegin + i) - radius, width, edgePolicy);
+    for (unsigned int j = 0; j < patchHeight; j++) {
+        const unsigned int row = resolveEdgeCoordinate(static_cast<int>(edgePatch.rowBegin + j) - radius, height,
+            edgePolicy);
+        for (unsigned int i = 0; i < patchWidth; i++)
+            patch[j * patchStride + i] = row == height || columns[i] == width ? 0 : input[row * inputStride + columns[i]];
+    }
+
+    (*edgePatch.task)(patch.data(), patchOutput.data(), patchOutputStride, 0, outputHeight);
+    for (unsigned int y = 0; y < outputHeight; y++) {
+        std::copy_n(patchOutput.data() + y * patchOutputStride, outputWidth,
+            output + (edgePatch.rowBegin + y) * outputStride + edgePatch.columnBegin);
+    }
+}
+
+void runTaskWithEdges(const Image &image, const Kernel &kernel, const ImageProcessing::EdgePolicy edgePolicy,
+    ThreadPool *threadPool, const MutableImageView &output) {
+    const unsigned int order = kernel.getOrder();
+    const unsigned int width = image.getWidth();
+    const unsigned int height = image.getHeight();
+    const bool hasInterior = width >= order && height >= order;
+    const unsigned int interiorHeight = hasInterior ? height - (order - 1) : 0;
+    const std::shared_ptr<const PlaneTask> interiorTask = hasInterior ?
+        getConvolutionTask(kernel, image.getStride(), width, height) : nullptr;
+    const std::array<EdgePatch, 4> edgePatches = createEdgePatches(kernel, width, height);
+
+    uint8_t* planes[RGB_CHANNELS] = {output.reds, output.greens, output.blues};
+    for (unsigned int channel = 0; channel < RGB_CHANNELS; channel++) {
+        const Span<const uint8_t> input = channel == 0 ? image.viewReds() :
+            channel == 1 ? image.viewGreens() : image.viewBlues();
+        uint8_t* plane = planes[channel];
+
+        if (hasInterior) {
+            // interior values are written in their final position: the values after each interior row up to
+            // the stride are the right edge, the row padding and the left edge of the next row, which are all
+            // computed afterwards by the edge patches
+            uint8_t* interior = plane + order / 2 * output.stride + order / 2;
+            if (threadPool != nullptr) {
+                const unsigned int numBands = std::max(1u, std::min(interiorHeight,
+                    threadPool->getNumThreads() * BANDS_PER_THREAD));
+                const unsigned int bandHeight = (interiorHeight + numBands - 1) / numBands;
+                threadPool->parallelFor(numBands, [&](const unsigned int band) {
+                    const unsigned int rowBegin = band * bandHeight;
+                    const unsigned int rowEnd = std::min(rowBegin + bandHeight, interiorHeight);
+                    if (rowBegin < rowEnd)
+                        (*interiorTask)(input.data(), interior, output.stride, rowBegin, rowEnd);
+                });
+            } else {
+                (*interiorTask)(input.data(), interior, output.stride, 0, interiorHeight);
+            }
+        }
+        for (const EdgePatch &edgePatch : edgePatches) {
+            if (edgePatch.task) {
+                convolveEdgePatch(input.data(), image.getStride(), width, height, plane, output.stride, order,
+                    edgePolicy, edgePatch);
+            }
+        }
+    }
+}
+
+std::unique_ptr<Image> runTaskWithEdges(const Image &image, const Kernel &kernel,
+    const ImageProcessing::EdgePolicy edgePolicy, ThreadPool *threadPool) {
+    const unsigned int width = image.getWidth();
+    const unsigned int height = image.getHeight();
+
+    ImageBuffer buffer(width, height);
+    runTaskWithEdges(image, kernel, edgePolicy, threadPool, buffer.view());
+
+    return std::make_unique<Image>(std::move(buffer));
+}
+
+/**
+ * Represents a stage of a streamed chain of convolutions, which keeps only the last input rows read by a strip
+ * of output rows in a ring buffer.
+ *
+ * Each input row is stored twice, in slots k and k + numSlots, so that any numSlots consecutive rows are contiguous
+ * and can be read by the engines with their usual stride. Rows are padded horizontally when stored,
+ * and vertically while they are read; slots are a row stride apart, as the rows of an image buffer.
+ */
+struct StreamStage {
+    PlaneTask task;
+    PlaneTask stripTask;
+    unsigned int order;
+    unsigned int padding;
+    unsigned int inputWidth;
+    unsigned int inputHeight;
+    unsigned int paddedWidth;
+    unsigned int rowStride;
+    unsigned int outputWidth;
+    unsigned int outputHeight;
+    unsigned int stripHeight;
+    unsigned int numSlots;
+    std::vector<unsigned int> paddingColumns;
+    std::vector<uint8_t> rows;
+    std::vector<uint8_t> window;
+    std::vector<uint8_t> strip;
+    unsigned int stripStride;
+    unsigned int numReceivedRows;
+    unsigned int numEmittedRows;
+};
+
+std::vector<StreamStage> createStreamStages(const std::vector<Kernel> &kernels, unsigned int width,
+    unsigned int height, const ImageProcessing::EdgePolicy edgePolicy) {
+    std::vector<StreamStage> stages;
+    for (const Kernel &kernel : kernels) {
+        const unsigned int order = kernel.getOrder();
+        const unsigned int padding = edgePolicy == ImageProcessing::EdgePolicy::crop ? 0 : order / 2;
+        if (width + 2 * padding < order || height + 2 * padding < order)
+            throw std::invalid_argument("Image must not be smaller than the kernels.");
+
+        StreamStage stage;
+        stage.order = order;
+        stage.padding = padding;
+        stage.inputWidth = width;
+        stage.inputHeight = height;
+        stage.paddedWidth = width + 2 * padding;
+        stage.rowStride = ImageBuffer::chooseStride(stage.paddedWidth);
+        stage.outputWidth = stage.paddedWidth - (order - 1);
+        stage.outputHeight = height + 2 * padding - (order - 1);
+        stage.stripHeight = std::min(static_cast<unsigned int>(STREAM_STRIP_HEIGHT), stage.outputHeight);
+        stage.numSlots = order + stage.stripHeight - 1;
+        // rows resolved by the edge policy are gathered and computed one at a time, the others a strip at a time;
+        // but for the transforms, whose tiles would be mostly wasted on a strip, engines are picked as for the whole
+        // input, since the costs of the others are all proportional to the number of rows
+        stage.task = createConvolutionTask(kernel, stage.rowStride, stage.paddedWidth, order, false);
+        stage.stripTask = createConvolutionTask(kernel, stage.rowStride, stage.paddedWidth, stage.numSlots, false);
+        for (unsigned int i = 0; i < 2 * padding; i++) {
+            const int column = i < padding ? static_cast<int>(i) - static_cast<int>(padding) :
+                static_cast<int>(width + i - padding);
+            stage.paddingColumns.push_back(resolveEdgeCoordinate(column, width, edgePolicy));
+        }
+        stage.rows.resize(2 * stage.numSlots * stage.rowStride);
+        stage.window.resize(order * stage.rowStride);
+        stage.stripStride = ImageBuffer::chooseStride(stage.outputWidth);
+        stage.strip.resize(stage.stripHeight * stage.stripStride);
+        stage.numReceivedRows = 0;
+        stage.numEmittedRows = 0;
+
+        width = stage.outputWidth;
+        height = stage.outputHeight;
+        stages.push_back(std::move(stage));
+    }
+    return stages;
+}
+
+uint8_t* getStreamRow(StreamStage &stage) {
+    return stage.rows.data() + stage.numReceivedRows % stage.numSlots * stage.rowStride + stage.padding;
+}
+
+void commitStreamRow(StreamStage &stage) {
+    uint8_t* row = getStreamRow(stage) - stage.padding;
+    for (unsigned int i = 0; i < 2 * stage.padding; i++) {
+        const unsigned int column = stage.paddingColumns[i];
+        const uint8_t value = column == stage.inputWidth ? 0 : row[stage.padding + column];
+        row[i < stage.padding ? i : stage.inputWidth + i] = value;
+    }
+    std::memcpy(row + stage.numSlots * stage.rowStride, row, stage.paddedWidth);
+    stage.numReceivedRows++;
+}
+
+unsigned int getLastStreamRow(const StreamStage &stage, const unsigned int outputRow) {
+    return std::min(outputRow + stage.order - 1 - stage.padding, stage.inputHeight - 1);
+}
+
+/**
+ * Counts the rows of the next strip of the stage whose input rows have all been received; a strip is full
+ * unless it holds the last rows.
+ */
+unsigned int countStreamRows(const StreamStage &stage) {
+    const unsigned int numRows = std::min(stage.stripHeight, stage.outputHeight - stage.numEmittedRows);
+    if (numRows == 0 || getLastStreamRow(stage, stage.numEmittedRows + numRows - 1) >= stage.numReceivedRows)
+        return 0;
+    return numRows;
+}
+
+/**
+ * Computes the given number of rows of the stage into the output, whose rows are the given stride apart.
+ */
+void emitStreamRows(StreamStage &stage, const unsigned int numRows, uint8_t *output, const unsigned int outputStride,
+    const ImageProcessing::EdgePolicy edgePolicy) {
+    for (unsigned int i = 0; i < numRows;) {
+        uint8_t* outputRow = output + static_cast<std::size_t>(i) * outputStride;
+        const int firstRow = static_cast<int>(stage.numEmittedRows + i) - static_cast<int>(stage.padding);
+        if (firstRow >= 0 && static_cast<unsigned int>(firstRow) + stage.order <= stage.inputHeight) {
+            // the rows inside the input are contiguous in the ring, thus computed by a single run
+            const unsigned int numInnerRows = std::min(numRows - i,
+                stage.inputHeight - stage.order + 1 - static_cast<unsigned int>(firstRow));
+            stage.stripTask(stage.rows.data() + firstRow % stage.numSlots * stage.rowStride, outputRow, outputStride,
+                0, numInnerRows);
+            i += numInnerRows;
+            continue;
+        }
+
+        // rows near the top and bottom edges are resolved by the policy, then gathered
+        for (unsigned int j = 0; j < stage.order; j++) {
+            const unsigned int row = resolveEdgeCoordinate(firstRow + static_cast<int>(j), stage.inputHeight,
+                edgePolicy);
+            uint8_t* windowRow = stage.window.data() + j * stage.rowStride;
+            if (row == stage.inputHeight)
+                std::fill_n(windowRow, stage.paddedWidth, 0);
+            else
+                std::copy_n(stage.rows.data() + row % stage.numSlots * stage.rowStride, stage.paddedWidth, windowRow);
+        }
+        stage.task(stage.window.data(), outputRow, outputStride, 0, 1);
+        i++;
+    }
+    stage.numEmittedRows += numRows;
+}
+
+/**
+ * Pushes the strips ready at the given stage through the following ones; the rows of the last stage are written
+ * into the output planes, whose first row is the output row of the given index.
+ */
+void drainStreamStages(std::vector<StreamStage> &stages, const unsigned int stageIndex, uint8_t *output,
+    const unsigned int outputStride, const unsigned int firstOutputRow, const ImageProcessing::EdgePolicy edgePolicy) {
+    StreamStage &stage = stages[stageIndex];
+    const bool isLast = stageIndex + 1 == stages.size();
+    for (unsigned int numRows = countStreamRows(stage); numRows > 0; numRows = countStreamRows(stage)) {
+        if (isLast) {
+            emitStreamRows(stage, numRows,
+                output + static_cast<std::size_t>(stage.numEmittedRows - firstOutputRow) * outputStride, outputStride,
+                edgePolicy);
+            continue;
+        }
+
+        // the rows of a strip are pushed to the next stage one at a time, so that its ring is never overrun,
+        // while the strip is still in the cache
+        emitStreamRows(stage, numRows, stage.strip.data(), stage.stripStride, edgePolicy);
+        StreamStage &nextStage = stages[stageIndex + 1];
+        for (unsigned int i = 0; i < numRows; i++) {
+            std::copy_n(stage.strip.data() + i * stage.stripStride, stage.outputWidth, getStreamRow(nextStage));
+            commitStreamRow(nextStage);
+            drainStreamStages(stages, stageIndex + 1, output, outputStride, firstOutputRow, edgePolicy);
+        }
+    }
+}
+
+std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel) {
+    return runTask(image, kernel.getOrder(), *getConvolutionTask(kernel, image.getStride(), image.getWidth(), image.getHeight()));
+}
+
+std::unique_ptr<Image> ImageProcessing::parallelConvolution(const Image &image, const Kernel &kernel,
+    ThreadPool &threadPool) {
+    return runTaskInParallel(image, kernel.getOrder(),
+        *getConvolutionTask(kernel, image.getStride(), image.getWidth(), image.getHeight()), threadPool);
+}
+
+void ImageProcessing::convolution(const Image &image, const Kernel &kernel, const MutableImageView &output) {
+    const unsigned int order = kernel.getOrder();
+    checkOutputSizes(output, image.getWidth() - (order - 1), image.getHeight() - (order - 1));
+    runTask(image, *getConvolutionTask(kernel, image.getStride(), image.getWidth(), image.getHeight()), output);
+}
+
+void ImageProcessing::parallelConvolution(const Image &image, const Kernel &kernel, ThreadPool &threadPool,
+    const MutableImageView &output) {
+    const unsigned int order = kernel.getOrder();
+    checkOutputSizes(output, image.getWidth() - (order - 1), image.getHeight() - (order - 1));
+    runTaskInParallel(image, *getConvolutionTask(kernel, image.getStride(), image.getWidth(), image.getHeight()), threadPool, output);
+}
+
+std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Kernel &kernel,
+    const EdgePolicy edgePolicy) {
+    if (edgePolicy == EdgePolicy::crop)
+        return convolution(image, kernel);
+    return runTaskWithEdges(image, kernel, edgePolicy, nullptr);
+}
+
+std::unique_ptr<Image> ImageProcessing::parallelConvolution(const Image &image, const Kernel &kernel,
+    ThreadPool &threadPool, const EdgePolicy edgePolicy) {
+    if (edgePolicy == EdgePolicy::crop)
+        return parallelConvolution(image, kernel, threadPool);
+    return runTaskWithEdges(image, kernel, edgePolicy, &threadPool);
+}
+
+void ImageProcessing::convolution(const Image &image, const Kernel &kernel, const EdgePolicy edgePolicy,
+    const MutableImageView &output) {
+    if (edgePolicy == EdgePolicy::crop) {
+        convolution(image, kernel, output);
+        return;
+    }
+    checkOutputSizes(output, image.getWidth(), image.getHeight());
+    runTaskWithEdges(image, kernel, edgePolicy, nullptr, output);
+}
+
+void ImageProcessing::parallelConvolution(const Image &image, const Kernel &kernel, ThreadPool &threadPool,
+    const EdgePolicy edgePolicy, const MutableImageView &output) {
+    if (edgePolicy == EdgePolicy::crop) {
+        parallelConvolution(image, kernel, threadPool, output);
+        return;
+    }
+    checkOutputSizes(output, image.getWidth(), image.getHeight());
+    runTaskWithEdges(image, kernel, edgePolicy, &threadPool, output);
+}
+
+std::unique_ptr<Image> ImageProcessing::pipelineConvolution(const Image &image, const std::vector<Kernel> &kernels) {
+    return pipelineConvolution(image, kernels, EdgePolicy::crop);
+}
+
+std::unique_ptr<Image> ImageProcessing::pipelineConvolution(const Image &image, const std::vector<Kernel> &kernels,
+    const EdgePolicy edgePolicy) {
+    if (kernels.empty())
+        throw std::invalid_argument("Kernel chain must not be empty.");
+    if (edgePolicy == EdgePolicy::wrap)
+        throw std::invalid_argument("Edge policy must not read rows after the last one.");
+
+    const unsigned int width = image.getWidth();
+    const unsigned int height = image.getHeight();
+    std::vector<StreamStage> stages = createStreamStages(kernels, width, height, edgePolicy);
+    const unsigned int outputWidth = stages.back().outputWidth;
+    const unsigned int outputHeight = stages.back().outputHeight;
+
+    ImageBuffer buffer(outputWidth, outputHeight);
+    const MutableImageView output = buffer.view();
+    uint8_t* planes[RGB_CHANNELS] = {output.reds, output.greens, output.blues};
+    for (unsigned int channel = 0; channel < RGB_CHANNELS; channel++) {
+        const Span<const uint8_t> input = channel == 0 ? image.viewReds() :
+            channel == 1 ? image.viewGreens() : image.viewBlues();
+        for (StreamStage &stage : stages) {
+            stage.numReceivedRows = 0;
+            stage.numEmittedRows = 0;
+        }
+
+        for (unsigned int y = 0; y < height; y++) {
+            std::copy_n(input.data() + y * image.getStride(), width, getStreamRow(stages.front()));
+            commitStreamRow(stages.front());
+            drainStreamStages(stages, 0, planes[channel], output.stride, 0, edgePolicy);
+        }
+    }
+
+    return std::make_unique<Image>(std::move(buffer));
+}
+
+void ImageProcessing::streamConvolution(RowReader &input, const std::vector<Kernel> &kernels,
+    const EdgePolicy edgePolicy, RowWriter &output) {
+    if (kernels.empty())
+        throw std::invalid_argument("Kernel chain must not be empty.");
+    if (edgePolicy == EdgePolicy::wrap)
+        throw std::invalid_argument("Edge policy must not read rows after the last one.");
+
+    // channels are streamed side by side, since the reader returns all of them at once
+    const unsigned int width = input.getWidth();
+    const unsigned int height = input.getHeight();
+    std::vector<StreamStage> stages[RGB_CHANNELS];
+    for (std::vector<StreamStage> &channelStages : stages)
+        channelStages = createStreamStages(kernels, width, height, edgePolicy);
+    const unsigned int outputWidth = stages[0].back().outputWidth;
+    const unsigned int outputHeight = stages[0].back().outputHeight;
+    if (output.getWidth() != outputWidth || output.getHeight() != outputHeight)
+        throw std::invalid_argument("Output sizes differ from those of the transformed image.");
+
+    // an input row may complete a strip of each stage, and near the bottom edge the padding rows after it
+    unsigned int numPendingRows = STREAM_STRIP_HEIGHT;
+    for (const StreamStage &stage : stages[0])
+        numPendingRows += stage.stripHeight + stage.padding;
+    ImageBuffer inputStrip(width, STREAM_STRIP_HEIGHT);
+    ImageBuffer outputStrip(outputWidth, numPendingRows);
+    const MutableImageView inputPlanes = inputStrip.view();
+    const MutableImageView outputPlanes = outputStrip.view();
+    const uint8_t* inputs[RGB_CHANNELS] = {inputPlanes.reds, inputPlanes.greens, inputPlanes.blues};
+    uint8_t* outputs[RGB_CHANNELS] = {outputPlanes.reds, outputPlanes.greens, outputPlanes.blues};
+
+    unsigned int firstOutputRow = 0;
+    const auto writeStrip = [&]() {
+        const unsigned int numRows = stages[0].back().numEmittedRows - firstOutputRow;
+        output.writeRows({outputWidth, numRows, outputPlanes.stride, outputPlanes.reds, outputPlanes.greens,
+            outputPlanes.blues});
+        firstOutputRow += numRows;
+    };
+    for (unsigned int row = 0; row < height; row += STREAM_STRIP_HEIGHT) {
+        const unsigned int numRows = std::min(static_cast<unsigned int>(STREAM_STRIP_HEIGHT), height - row);
+        input.readRows({width, numRows, inputPlanes.stride, inputPlanes.reds, inputPlanes.greens, inputPlanes.blues});
+
+        for (unsigned int y = 0; y < numRows; y++) {
+            for (unsigned int channel = 0; channel < RGB_CHANNELS; channel++) {
+                std::copy_n(inputs[channel] + y * inputPlanes.stride, width, getStreamRow(stages[channel].front()));
+                commitStreamRow(stages[channel].front());
+                drainStreamStages(stages[channel], 0, outputs[channel], outputPlanes.stride, firstOutputRow,
+                    edgePolicy);
+            }
+            if (stages[0].back().numEmittedRows - firstOutputRow >= STREAM_STRIP_HEIGHT)
+                writeStrip();
+        }
+    }
+    if (stages[0].back().numEmittedRows > firstOutputRow)
+        writeStrip();
+}
+
+bool ImageProcessing::isFusionFaster(const std::vector<Kernel> &kernels, unsigned int width, unsigned int height) {
+    if (kernels.empty())
+        throw std::invalid_argument("Kernel chain must not be empty.");
+
+    double stagedCost = 0;
+    std::unique_ptr<Kernel> fusedKernel = std::make_unique<Kernel>(kernels.front());
+    for (unsigned int k = 0; k < kernels.size(); k++) {
+        const unsigned int order = kernels[k].getOrder();
+        if (width < order || height < order)
+            throw std::invalid_argument("Image must not be smaller than the kernels.");
+        stagedCost += estimateConvolutionCost(kernels[k], width, height);
+        if (k > 0)
+            fusedKernel = KernelFactory::createComposedKernel(*fusedKernel, kernels[k]);
+        width -= order - 1;
+        height -= order - 1;
+    }
+    const unsigned int fusedOrder = fusedKernel->getOrder();
+    return estimateConvolutionCost(*fusedKernel, width + fusedOrder - 1, height + fusedOrder - 1) < stagedCost;
+}
+
+std::unique_ptr<Image> ImageProcessing::chainConvolution(const Image &image, const std::vector<Kernel> &kernels) {
+    if (!isFusionFaster(kernels, image.getWidth(), image.getHeight()))
+        return pipelineConvolution(image, kernels);
+
+    std::unique_ptr<Kernel> fusedKernel = std::make_unique<Kernel>(kernels.front());
+    for (unsigned int k = 1; k < kernels.size(); k++)
+        fusedKernel = KernelFactory::createComposedKernel(*fusedKernel, kernels[k]);
+    return convolution(image, *fusedKernel);
+}
+
+std::unique_ptr<Image> ImageProcessing::fixedPointConvolution(const Image &image, const Kernel &kernel) {
+    return fixedPointConvolution(image, kernel, InstructionSets::detect());
+}
+
+std::unique_ptr<Image> ImageProcessing::fixedPointConvolution(const Image &image, const Kernel &kernel,
+    const InstructionSet instructionSet) {
+    FixedPointConvolution::Weights fixedPointWeights;
+    if (!decomposeFixedPoint(kernel, fixedPointWeights))
+        throw std::invalid_argument("Kernel must have integer weights, up to a common divisor.");
+    if (!InstructionSets::isSupported(instructionSet))
+        throw std::invalid_argument("Instruction set is not supported by the CPU.");
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(),
+        createFixedPointTask(fixedPointWeights, instructionSet, image.getStride(), outputWidth));
+}
+
+bool ImageProcessing::isFixedPoint(const Kernel &kernel) {
+    FixedPointConvolution::Weights fixedPointWeights;
+    return decomposeFixedPoint(kernel, fixedPointWeights);
+}
+
+std::unique_ptr<Image> ImageProcessing::blockedConvolution(const Image &image, const Kernel &kernel) {
+    return blockedConvolution(image, kernel, CacheTopology::detect());
+}
+
+std::unique_ptr<Image> ImageProcessing::blockedConvolution(const Image &image, const Kernel &kernel,
+    const CacheTopology &cacheTopology) {
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(), createBlockedVectorizedTask(kernel, InstructionSets::detect(),
+        cacheTopology, image.getStride(), outputWidth));
+}
+
+std::unique_ptr<Image> ImageProcessing::symmetricConvolution(const Image &image, const Kernel &kernel) {
+    return symmetricConvolution(image, kernel, InstructionSets::detect());
+}
+
+std::unique_ptr<Image> ImageProcessing::symmetricConvolution(const Image &image, const Kernel &kernel,
+    const InstructionSet instructionSet) {
+    if (!InstructionSets::isSupported(instructionSet))
+        throw std::invalid_argument("Instruction set is not supported by the CPU.");
+    SymmetricConvolution::Weights symmetricWeights;
+    if (!decomposeSymmetric(kernel, image.getStride(), symmetricWeights))
+        return vectorizedConvolution(image, kernel, instructionSet);
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(),
+        createSymmetricTask(symmetricWeights, instructionSet, image.getStride(), outputWidth));
+}
+
+bool ImageProcessing::isSymmetric(const Kernel &kernel) {
+    SymmetricConvolution::Weights symmetricWeights;
+    return decomposeSymmetric(kernel, kernel.getOrder(), symmetricWeights);
+}
+
+std::unique_ptr<Image> ImageProcessing::sparseConvolution(const Image &image, const Kernel &kernel) {
+    return sparseConvolution(image, kernel, InstructionSets::detect());
+}
+
+std::unique_ptr<Image> ImageProcessing::sparseConvolution(const Image &image, const Kernel &kernel,
+    const InstructionSet instructionSet) {
+    if (!InstructionSets::isSupported(instructionSet))
+        throw std::invalid_argument("Instruction set is not supported by the CPU.");
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(), createSparseTask(kernel, instructionSet, image.getStride(), outputWidth));
+}
+
+bool ImageProcessing::isSparseFaster(const Kernel &kernel) {
+    const unsigned int order = kernel.getOrder();
+    return getSparseTapCost() * countTaps(kernel) < getDenseTapCost(order) * order * order;
+}
+
+std::unique_ptr<Image> ImageProcessing::fftConvolution(const Image &image, const Kernel &kernel) {
+    return runTask(image, kernel.getOrder(),
+        createFftTask(kernel, image.getStride(), image.getWidth(), image.getHeight()));
+}
+
+bool ImageProcessing::isFftFaster(const unsigned int order, const unsigned int outputWidth,
+    const unsigned int outputHeight) {
+    const double directCost = getDenseTapCost(order) * order * order * outputWidth * outputHeight;
+    return estimateFftCost(order, outputWidth, outputHeight) < directCost;
+}
+
+std::unique_ptr<Image> ImageProcessing::boxFilterConvolution(const Image &image, const Kernel &kernel) {
+    if (!isBoxFilter(kernel))
+        throw std::invalid_argument("Kernel must be a box filter.");
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(), createBoxFilterTask(kernel, image.getStride(), outputWidth));
+}
+
+bool ImageProcessing::isBoxFilter(const Kernel &kernel) {
+    const auto kernelWeights = kernel.viewWeights();
+    return std::all_of(kernelWeights.begin(), kernelWeights.end(),
+        [&kernelWeights](const float weight) { return weight == kernelWeights[0]; });
+}
+
+std::unique_ptr<Image> ImageProcessing::vectorizedConvolution(const Image &image, const Kernel &kernel) {
+    return vectorizedConvolution(image, kernel, InstructionSets::detect());
+}
+
+std::unique_ptr<Image> ImageProcessing::vectorizedConvolution(const Image &image, const Kernel &kernel,
+    const InstructionSet instructionSet) {
+    if (!InstructionSets::isSupported(instructionSet))
+        throw std::invalid_argument("Instruction set is not supported by the CPU.");
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(),
+        createVectorizedTask(kernel, instructionSet, image.getStride(), outputWidth));
+}
+
+std::unique_ptr<Image> ImageProcessing::separableConvolution(const Image &image, const Kernel &kernel) {
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    if (!decomposeSeparable(kernel, verticalWeights, horizontalWeights))
+        throw std::invalid_argument("Kernel must be separable.");
+    const unsigned int outputWidth = image.getWidth() - (kernel.getOrder() - 1);
+    return runTask(image, kernel.getOrder(),
+        createSeparableTask(verticalWeights, horizontalWeights, image.getStride(), outputWidth));
+}
+
+bool ImageProcessing::isSeparable(const Kernel &kernel) {
+    std::vector<float> verticalWeights;
+    std::vector<float> horizontalWeights;
+    return decomposeSeparable(kernel, verticalWeights, horizontalWeights);
+}
+
+std::unique_ptr<Image> ImageProcessing::directConvolution(const Image &image, const Kernel &kernel) {
+    const unsigned int order = kernel.getOrder();
+    const auto kernelWeights = kernel.viewWeights();
 
     const unsigned int width = image.getWidth();
-    const auto originalReds = image.getReds();
-    const auto originalGreens = image.getGreens();
-    const auto originalBlues = image.getBlues();
+    const unsigned int stride = image.getStride();
+    const auto originalReds = image.viewReds();
+    const auto originalGreens = image.viewGreens();
+    const auto originalBlues = image.viewBlues();
 
     const unsigned int outputHeight = image.getHeight() - (order - 1);
     const unsigned int outputWidth = width - (order - 1);
 
-    std::vector<uint8_t> reds(outputWidth * outputHeight);
-    std::vector<uint8_t> greens(outputWidth * outputHeight);
-    std::vector<uint8_t> blues(outputWidth * outputHeight);
+    ImageBuffer buffer(outputWidth, outputHeight);
+    const MutableImageView output = buffer.view();
     for (unsigned int y = 0; y < outputHeight; y++) {
         for (unsigned int x = 0; x < outputWidth; x++) {
             float channelRed = 0;
@@ -34,41 +1379,44 @@ std::unique_ptr<Image> ImageProcessing::convolution(const Image &image, const Ke
 
             for (unsigned int j = 0; j < order; j++) {
                 for (unsigned int i = 0; i < order; i++) {
-                    const unsigned int pos = (y + j) * width + (x + i);
+                    const unsigned int pos = (y + j) * stride + (x + i);
                     const float kernelWeight = kernelWeights[j * order + i];
                     channelRed += static_cast<float>(originalReds[pos]) * kernelWeight;
                     channelGreen += static_cast<float>(originalGreens[pos]) * kernelWeight;
                     channelBlue += static_cast<float>(originalBlues[pos]) * kernelWeight;
                 }
             }
-            reds[y * outputWidth + x] = getChannelAsUint8(channelRed);
-            greens[y * outputWidth + x] = getChannelAsUint8(channelGreen);
-            blues[y * outputWidth + x] = getChannelAsUint8(channelBlue);
+            output.reds[y * output.stride + x] = getChannelAsUint8(channelRed);
+            output.greens[y * output.stride + x] = getChannelAsUint8(channelGreen);
+            output.blues[y * output.stride + x] = getChannelAsUint8(channelBlue);
         }
     }
 
-    return std::make_unique<Image>(outputWidth, outputHeight, reds, greens, blues);
+    return std::make_unique<Image>(std::move(buffer));
 }
 
 
 std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const unsigned int padding) {
-    const auto originalReds = image.getReds();
-    const auto originalGreens = image.getGreens();
-    const auto originalBlues = image.getBlues();
+    const auto originalReds = image.viewReds();
+    const auto originalGreens = image.viewGreens();
+    const auto originalBlues = image.viewBlues();
     const unsigned int height = image.getHeight();
     const unsigned int width = image.getWidth();
+    const unsigned int stride = image.getStride();
 
     const unsigned int extendedHeight = height + 2 * padding;
     const unsigned int extendedWidth = width + 2 * padding;
 
-    std::vector<uint8_t> reds(extendedWidth * extendedHeight);
-    std::vector<uint8_t> greens(extendedWidth * extendedHeight);
-    std::vector<uint8_t> blues(extendedWidth * extendedHeight);
+    ImageBuffer buffer(extendedWidth, extendedHeight);
+    const unsigned int extendedStride = buffer.getStride();
+    const Span<uint8_t> reds = buffer.viewReds();
+    const Span<uint8_t> greens = buffer.viewGreens();
+    const Span<uint8_t> blues = buffer.viewBlues();
     // copy image main data
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            const unsigned int pos = (j + padding) * extendedWidth + (i + padding);
-            const unsigned int idx = j * width + i;
+            const unsigned int pos = (j + padding) * extendedStride + (i + padding);
+            const unsigned int idx = j * stride + i;
             reds[pos] = originalReds[idx];
             greens[pos] = originalGreens[idx];
             blues[pos] = originalBlues[idx];
@@ -78,8 +1426,8 @@ std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const uns
     // fill left internal new columns
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            const unsigned int pos = (j + padding) * extendedWidth + i;
-            const unsigned int idx = j * width;
+            const unsigned int pos = (j + padding) * extendedStride + i;
+            const unsigned int idx = j * stride;
             reds[pos] = originalReds[idx];
             greens[pos] = originalGreens[idx];
             blues[pos] = originalBlues[idx];
@@ -89,8 +1437,8 @@ std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const uns
     // fill right internal new columns
     for (unsigned int j = 0; j < height; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            const unsigned int pos = (j + padding) * extendedWidth + (padding + width + i);
-            const unsigned int idx = j * width + (width - 1);
+            const unsigned int pos = (j + padding) * extendedStride + (padding + width + i);
+            const unsigned int idx = j * stride + (width - 1);
             reds[pos] = originalReds[idx];
             greens[pos] = originalGreens[idx];
             blues[pos] = originalBlues[idx];
@@ -100,7 +1448,7 @@ std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const uns
     // fill top internal new rows
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            const unsigned int pos = j * extendedWidth + (padding + i);
+            const unsigned int pos = j * extendedStride + (padding + i);
             const unsigned int idx = i;
             reds[pos] = originalReds[idx];
             greens[pos] = originalGreens[idx];
@@ -111,8 +1459,8 @@ std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const uns
     // fill bottom internal new rows
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < width; i++) {
-            const unsigned int pos = (padding + height + j) * extendedWidth + (padding + i);
-            const unsigned int idx = (height - 1) * width + i;
+            const unsigned int pos = (padding + height + j) * extendedStride + (padding + i);
+            const unsigned int idx = (height - 1) * stride + i;
             reds[pos] = originalReds[idx];
             greens[pos] = originalGreens[idx];
             blues[pos] = originalBlues[idx];
@@ -122,34 +1470,34 @@ std::unique_ptr<Image> ImageProcessing::extendEdge(const Image &image, const uns
     // fill corners
     for (unsigned int j = 0; j < padding; j++) {
         for (unsigned int i = 0; i < padding; i++) {
-            const unsigned int pos0 = j * extendedWidth + i;
+            const unsigned int pos0 = j * extendedStride + i;
             const unsigned int idx0 = 0;
             reds[pos0] = originalReds[idx0];
             greens[pos0] = originalGreens[idx0];
             blues[pos0] = originalBlues[idx0];
 
             // bottom-left
-            const unsigned int pos1 = (extendedHeight - 1 - j) * extendedWidth + i;
-            const unsigned int idx1 = (height - 1) * width;
+            const unsigned int pos1 = (extendedHeight - 1 - j) * extendedStride + i;
+            const unsigned int idx1 = (height - 1) * stride;
             reds[pos1] = originalReds[idx1];
             greens[pos1] = originalGreens[idx1];
             blues[pos1] = originalBlues[idx1];
 
             // top-right
-            const unsigned int pos2 = j * extendedWidth + (extendedWidth - 1 - i);
+            const unsigned int pos2 = j * extendedStride + (extendedWidth - 1 - i);
             const unsigned int idx2 = width - 1;
             reds[pos2] = originalReds[idx2];
             greens[pos2] = originalGreens[idx2];
             blues[pos2] = originalBlues[idx2];
 
             // bottom-right
-            const unsigned int pos3 = (extendedHeight - 1 - j) * extendedWidth + (extendedWidth - 1 - i);
-            const unsigned int idx3 = (height - 1) * width + (width - 1);
+            const unsigned int pos3 = (extendedHeight - 1 - j) * extendedStride + (extendedWidth - 1 - i);
+            const unsigned int idx3 = (height - 1) * stride + (width - 1);
             reds[pos3] = originalReds[idx3];
             greens[pos3] = originalGreens[idx3];
             blues[pos3] = originalBlues[idx3];
         }
     }
 
-    return std::make_unique<Image>(extendedWidth, extendedHeight, reds, greens, blues);
+    return std::make_unique<Image>(std::move(buffer));
 }
\ No newline at end of file
@@ -1,21 +1,134 @@
 #ifndef IMAGEPROCESSING_H
 #define IMAGEPROCESSING_H
 #include <memory>
+#include <vector>
 
 #include "image/Image.h"
+#include "image/ImageView.h"
+#include "image/reader/RowReader.h"
+#include "image/reader/RowWriter.h"
 #include "kernel/Kernel.h"
+#include "cache/CacheTopology.h"
+#include "parallel/ThreadPool.h"
+#include "simd/InstructionSet.h"
 
 
 /**
  * Namespace for operations involving images.
  */
 namespace ImageProcessing {
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref separableConvolution
+     * and the one returned by @ref directConvolution with the same separable kernel.
+     *
+     * Both engines accumulate in single precision but sum the products in a different order, so the
+     * truncation to 8-bit unsigned integer may differ by one intensity level.
+     */
+    constexpr unsigned int SEPARABLE_TOLERANCE = 1;
+
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref boxFilterConvolution
+     * and the one returned by @ref directConvolution with the same box filter kernel.
+     *
+     * The box filter engine is exact, while the direct one accumulates rounding errors in single precision
+     * and may therefore truncate to the previous intensity level.
+     */
+    constexpr unsigned int BOX_FILTER_TOLERANCE = 1;
+
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref vectorizedConvolution
+     * and the one returned by @ref directConvolution with the same kernel.
+     *
+     * AVX2 and AVX-512 engines use fused multiply-add, i.e. a single rounding per product-sum instead of two,
+     * so the truncation to 8-bit unsigned integer may differ by one intensity level.
+     * The SSE4.2 engine is bit-identical to the direct one.
+     */
+    constexpr unsigned int VECTORIZED_TOLERANCE = 1;
+
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref fftConvolution
+     * and the one returned by @ref directConvolution with the same kernel.
+     *
+     * The FFT engine works in double precision, but its rounding errors are spread over the whole tile,
+     * so the truncation to 8-bit unsigned integer may differ by one intensity level when the exact sum lies
+     * within that error of an integer other than itself; results that are integer, e.g. on flat areas or with
+     * integer weights, are exact.
+     */
+    constexpr unsigned int FFT_TOLERANCE = 1;
+
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref fixedPointConvolution
+     * and the one returned by @ref directConvolution with the same kernel.
+     *
+     * The fixed-point engine is exact, whereas the direct one rounds fractional weights and sums to float,
+     * so the truncation to 8-bit unsigned integer may differ by one intensity level.
+     * With integer weights, both are exact as long as sums fit the float mantissa.
+     */
+    constexpr unsigned int FIXED_POINT_TOLERANCE = 1;
+
+    /**
+     * Maximum difference, for each channel value, between the image returned by @ref symmetricConvolution
+     * and the one returned by @ref directConvolution with the same kernel.
+     *
+     * Mirrored input values are added exactly in integers, but each sum is multiplied by its weight only once,
+     * so the truncation to 8-bit unsigned integer may differ by one intensity level.
+     */
+    constexpr unsigned int SYMMETRIC_TOLERANCE = 1;
+
+    /**
+     * Policies resolving the input values that a convolution reads outside the image near its edges.
+     *
+     * Given the row abcdefgh of an image, the values read on its left side are:
+     * - extend:   aaaa|abcdefgh
+     * - constant: 0000|abcdefgh
+     * - wrap:     efgh|abcdefgh
+     * - mirror:   edcb|abcdefgh
+     */
+    enum class EdgePolicy {
+        /**
+         * The nearest edge pixel is replicated, as in @ref extendEdge.
+         */
+        extend,
+
+        /**
+         * Pixels outside the image are black, i.e. all their channel values are zero.
+         */
+        constant,
+
+        /**
+         * The image repeats periodically, i.e. pixels outside an edge are read from the opposite one.
+         */
+        wrap,
+
+        /**
+         * The image is reflected around its edge pixels, which are not repeated.
+         */
+        mirror,
+
+        /**
+         * No pixel is read outside the image, thus the output image is cropped as in @ref convolution.
+         */
+        crop
+    };
+
     /**
      * Applies a convolution operation on the given image using the specified kernel.
      *
      * This operation reduces the size of the transformed image relative to the input image
      * by a number of pixels equal to the kernel order.
-     * To obtain an image without cropping, use @ref extendEdge before performing this operation.
+     * To obtain an image without cropping, pass an EdgePolicy, or use @ref extendEdge before performing
+     * this operation.
+     *
+     * The fastest available engine is picked automatically: box filter kernels are processed by
+     * @ref boxFilterConvolution, other separable kernels by @ref separableConvolution. Then symmetric kernels
+     * are processed by @ref symmetricConvolution, and kernels with many zero weights by @ref sparseConvolution,
+     * whenever their estimated cost beats the dense engine that would run otherwise. The remaining kernels are
+     * processed by @ref fixedPointConvolution if @ref isFixedPoint and either their sums fit 16-bit integers,
+     * or its 32-bit lanes are cheaper than the float taps, or these would not be exact, i.e. unless the weights are
+     * integers and the sums are lower than 2^24. Otherwise, kernels without a fixed-point form are processed by
+     * @ref fftConvolution if @ref isFftFaster, and any other kernel by @ref vectorizedConvolution. These direct
+     * engines work on cache-sized blocks, as in @ref blockedConvolution, when the input rows read by an output
+     * row do not fit half the level 2 cache.
      *
      * @param image The input image on which the convolution operation will be performed.
      * @param kernel The kernel used for the convolution.
@@ -23,6 +136,486 @@ namespace ImageProcessing {
      */
     std::unique_ptr<Image> convolution(const Image& image, const Kernel& kernel);
 
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, sharing the work
+     * among the threads of the given pool.
+     *
+     * Each channel plane is split into horizontal bands, which are handed out dynamically to the threads.
+     * Bands are processed by the same engine picked by @ref convolution, so the result is bit-identical to it.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param threadPool The pool of threads performing the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> parallelConvolution(const Image& image, const Kernel& kernel, ThreadPool& threadPool);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel as @ref convolution does,
+     * writing the result into the given output planes instead of a new image.
+     *
+     * Engines are set up once per kernel and input size, and their buffers are reused, so that repeated
+     * convolutions into the same output planes run at steady-state speed without allocating them again.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param output The view of the planes receiving the result, whose sizes are cropped as in @ref convolution.
+     * @throw std::invalid_argument If the output sizes differ from those of the transformed image.
+     */
+    void convolution(const Image& image, const Kernel& kernel, const MutableImageView& output);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel as @ref parallelConvolution
+     * does, writing the result into the given output planes instead of a new image.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param threadPool The pool of threads performing the convolution.
+     * @param output The view of the planes receiving the result, whose sizes are cropped as in @ref convolution.
+     * @throw std::invalid_argument If the output sizes differ from those of the transformed image.
+     */
+    void parallelConvolution(const Image& image, const Kernel& kernel, ThreadPool& threadPool,
+        const MutableImageView& output);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, resolving the values
+     * read outside the image by the given edge policy, so that the transformed image keeps the input sizes
+     * (unless the policy is EdgePolicy::crop).
+     *
+     * No padded copy of the image is made: the interior output values, whose neighborhood lies inside the image,
+     * are computed straight from the input by the engine picked by @ref convolution, while the output values
+     * along the edges are computed from small patches whose outer values are resolved by the policy.
+     * With EdgePolicy::extend, the result matches the one of @ref convolution applied to the image returned
+     * by @ref extendEdge with half the kernel order as padding, within one intensity level.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param edgePolicy The policy resolving the values outside the image.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> convolution(const Image& image, const Kernel& kernel, EdgePolicy edgePolicy);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, resolving the values
+     * read outside the image by the given edge policy and sharing the work among the threads of the given pool.
+     *
+     * Interior output values are split into horizontal bands, as in @ref parallelConvolution,
+     * so the result is bit-identical to the one of the sequential version.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param threadPool The pool of threads performing the convolution.
+     * @param edgePolicy The policy resolving the values outside the image.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> parallelConvolution(const Image& image, const Kernel& kernel, ThreadPool& threadPool,
+        EdgePolicy edgePolicy);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel and edge policy
+     * as @ref convolution does, writing the result into the given output planes instead of a new image.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param edgePolicy The policy resolving the values outside the image.
+     * @param output The view of the planes receiving the result, whose sizes are the input ones
+     * (unless the policy is EdgePolicy::crop).
+     * @throw std::invalid_argument If the output sizes differ from those of the transformed image.
+     */
+    void convolution(const Image& image, const Kernel& kernel, EdgePolicy edgePolicy, const MutableImageView& output);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel and edge policy
+     * as @ref parallelConvolution does, writing the result into the given output planes instead of a new image.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param threadPool The pool of threads performing the convolution.
+     * @param edgePolicy The policy resolving the values outside the image.
+     * @param output The view of the planes receiving the result, whose sizes are the input ones
+     * (unless the policy is EdgePolicy::crop).
+     * @throw std::invalid_argument If the output sizes differ from those of the transformed image.
+     */
+    void parallelConvolution(const Image& image, const Kernel& kernel, ThreadPool& threadPool, EdgePolicy edgePolicy,
+        const MutableImageView& output);
+
+    /**
+     * Applies a chain of convolutions on the given image, i.e. the first kernel to the image, the second one
+     * to the result, and so on, without building the intermediate images.
+     *
+     * Rows are streamed through the chain: each stage keeps its last input rows in a ring buffer as tall as its
+     * kernel order plus a strip of 16 rows, and computes a strip of output rows as soon as the input rows it reads
+     * are available, pushing them to the next stage straight away. Hence intermediate rows stay in cache, and the
+     * memory footprint is proportional to the image width times the sum of the kernel orders. Each stage runs the engine picked by
+     * @ref convolution for its whole input, so the result is bit-identical to the one of a sequence of
+     * @ref convolution calls, except for stages that @ref convolution would hand to @ref fftConvolution: as the
+     * tiles would be mostly wasted on a strip, these run the direct engines instead and match within
+     * @ref FFT_TOLERANCE.
+     *
+     * @param image The input image on which the convolutions will be performed.
+     * @param kernels The kernels to apply, in order.
+     * @return A unique pointer to a new Image object containing the result of the last convolution, cropped
+     * by the sum of the kernel orders.
+     * @throw std::invalid_argument If the chain is empty or the image is smaller than the kernels.
+     */
+    std::unique_ptr<Image> pipelineConvolution(const Image& image, const std::vector<Kernel>& kernels);
+
+    /**
+     * Applies a chain of convolutions on the given image as @ref pipelineConvolution does, resolving the values
+     * read outside each intermediate image by the given edge policy, so that every stage keeps the input sizes
+     * (unless the policy is EdgePolicy::crop).
+     *
+     * Streaming forbids EdgePolicy::wrap, which reads the last rows before the first ones are computed.
+     *
+     * @param image The input image on which the convolutions will be performed.
+     * @param kernels The kernels to apply, in order.
+     * @param edgePolicy The policy resolving the values outside the images.
+     * @return A unique pointer to a new Image object containing the result of the last convolution.
+     * @throw std::invalid_argument If the chain is empty, the image is smaller than the kernels with
+     * EdgePolicy::crop, or the policy is EdgePolicy::wrap.
+     */
+    std::unique_ptr<Image> pipelineConvolution(const Image& image, const std::vector<Kernel>& kernels,
+        EdgePolicy edgePolicy);
+
+    /**
+     * Applies a chain of convolutions as @ref pipelineConvolution does, streaming the image from the given reader
+     * to the given writer instead of holding it in memory.
+     *
+     * Input rows are read a strip at a time and pushed through the stages, whose ring buffers keep the last rows
+     * read by each kernel, while the output rows are handed to the writer a strip at a time as soon as they are
+     * computed. Hence, with a reader and a writer that decode and encode rows on demand, e.g. the ones returned
+     * by STBImageReader for JPEG images, the memory footprint is proportional to the image width times the sum
+     * of the kernel orders, instead of its height. The result is identical to the one of @ref pipelineConvolution
+     * applied to the whole image.
+     *
+     * @param input The reader of the input image, none of whose rows has been read yet.
+     * @param kernels The kernels to apply, in order.
+     * @param edgePolicy The policy resolving the values outside the images.
+     * @param output The writer of the output image, whose sizes are those of the result of the last convolution,
+     * and none of whose rows has been written yet.
+     * @throw std::invalid_argument If the chain is empty, the image is smaller than the kernels with
+     * EdgePolicy::crop, the policy is EdgePolicy::wrap, or the output sizes differ from those of the result.
+     */
+    void streamConvolution(RowReader& input, const std::vector<Kernel>& kernels, EdgePolicy edgePolicy,
+        RowWriter& output);
+
+    /**
+     * Applies a chain of convolutions on the given image, either fused into the single kernel returned by
+     * KernelFactory::createComposedKernel and processed by @ref convolution, or staged through
+     * @ref pipelineConvolution, whichever @ref isFusionFaster estimates to be cheaper.
+     *
+     * Fusion skips the rounding and clamping of the intermediate images, thus the two plans agree only up to
+     * them, e.g. within one intensity level for a chain of blurs.
+     *
+     * @param image The input image on which the convolutions will be performed.
+     * @param kernels The kernels to apply, in order.
+     * @return A unique pointer to a new Image object containing the result of the chain, cropped by the sum of
+     * the kernel orders.
+     * @throw std::invalid_argument If the chain is empty or the image is smaller than the kernels.
+     */
+    std::unique_ptr<Image> chainConvolution(const Image& image, const std::vector<Kernel>& kernels);
+
+    /**
+     * Checks whether a chain of convolutions is expected to be faster when its kernels are fused into a single one,
+     * rather than applied one after the other.
+     *
+     * Both plans are estimated with the costs of the engines that @ref convolution would pick: e.g. two large dense
+     * kernels are cheaper fused, since a single transform serves the fused kernel as in @ref fftConvolution, while
+     * a chain of box filters, whose cost does not depend on the order, is cheaper staged.
+     *
+     * @param kernels The kernels to apply, in order.
+     * @param width The width of the input image.
+     * @param height The height of the input image.
+     * @return True if the fused kernel is expected to be faster, false otherwise.
+     * @throw std::invalid_argument If the chain is empty or the image is smaller than the kernels.
+     */
+    bool isFusionFaster(const std::vector<Kernel>& kernels, unsigned int width, unsigned int height);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel,
+     * by means of the full 2D sum of products for each output pixel, i.e. in O(K^2) per pixel.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> directConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, by means of the
+     * vectorized engine for the most powerful instruction set supported by the CPU, detected at runtime.
+     *
+     * Each channel is processed separately, computing several adjacent output values per step;
+     * values are widened to floats, multiplied and accumulated, then clamped and packed back to 8-bit.
+     * Kernel orders from 3 to 25 are routed to microkernels unrolled at compile time and register-blocked
+     * over several output rows, which give the same result.
+     * The result matches the one of @ref directConvolution within @ref VECTORIZED_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> vectorizedConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, by means of the
+     * vectorized engine for the given instruction set.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param instructionSet The instruction set of the engine to use.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the instruction set is not supported by the CPU.
+     */
+    std::unique_ptr<Image> vectorizedConvolution(const Image& image, const Kernel& kernel, InstructionSet instructionSet);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel with integer weights,
+     * up to a common divisor, by means of integer arithmetic.
+     *
+     * Products are accumulated in 16-bit SIMD lanes when the worst-case sum fits them, otherwise in 32-bit lanes,
+     * and the sum is divided once per output value and truncated. The result is exact, thus bit-identical
+     * whatever the instruction set and the platform; it matches the one of @ref directConvolution
+     * within @ref FIXED_POINT_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the kernel has no fixed-point form, see @ref isFixedPoint.
+     */
+    std::unique_ptr<Image> fixedPointConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel with integer weights,
+     * up to a common divisor, by means of the fixed-point engine for the given instruction set.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param instructionSet The instruction set of the engine to use.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the kernel has no fixed-point form, see @ref isFixedPoint,
+     *                              or if the instruction set is not supported by the CPU.
+     */
+    std::unique_ptr<Image> fixedPointConvolution(const Image& image, const Kernel& kernel,
+        InstructionSet instructionSet);
+
+    /**
+     * Checks whether the given kernel can be applied by @ref fixedPointConvolution, i.e. whether its weights
+     * are integer multiples of the reciprocal of an integer divisor, as in edge detection (divisor one)
+     * or box blur (divisor order^2), and sums fit 32-bit integers.
+     *
+     * When the divisor is not one, the sum of the positive numerators times 255 must be lower than 2^24.
+     *
+     * @param kernel The kernel to check.
+     * @return True if the kernel has a fixed-point form, false otherwise.
+     */
+    bool isFixedPoint(const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, by means of the
+     * vectorized engine working on cache-sized blocks.
+     *
+     * Each channel plane is split into blocks whose width lets the input rows read by consecutive output rows
+     * stay in the level 1 cache (see @ref chooseBlockWidth), and whose height lets the whole block stay
+     * in the level 2 cache (see @ref chooseBlockHeight). The input of each block is packed with a stride that
+     * cannot alias in the level 1 cache. Block sizes are derived from the detected cache topology.
+     * The result is bit-identical to the one of @ref vectorizedConvolution.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> blockedConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, by means of the
+     * vectorized engine working on blocks sized after the given cache topology.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param cacheTopology The cache topology from which block sizes are derived.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> blockedConvolution(const Image& image, const Kernel& kernel,
+        const CacheTopology& cacheTopology);
+
+    /**
+     * Chooses the width of the output blocks of a blocked convolution: the largest multiple of 64 such that
+     * the input rows read by an output row fit half the level 1 data cache or, for large orders,
+     * half the level 2 cache. It is never wider than the output width rounded up to a multiple of 64.
+     *
+     * @param order The order of the kernel.
+     * @param outputWidth The width of the transformed image.
+     * @param cacheTopology The cache topology of the machine.
+     * @return The block width as an unsigned integer.
+     */
+    unsigned int chooseBlockWidth(unsigned int order, unsigned int outputWidth, const CacheTopology& cacheTopology);
+
+    /**
+     * Chooses the height of the output blocks of a blocked convolution, such that the input block and
+     * the output block fit half the level 2 cache.
+     *
+     * @param order The order of the kernel.
+     * @param blockWidth The width of the output blocks.
+     * @param cacheTopology The cache topology of the machine.
+     * @return The block height as a positive unsigned integer.
+     */
+    unsigned int chooseBlockHeight(unsigned int order, unsigned int blockWidth, const CacheTopology& cacheTopology);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, folding its symmetries.
+     *
+     * When the kernel is symmetric under horizontal flips, vertical flips or both, as every kernel built by
+     * KernelFactory, the up to four input values sharing a weight are added in 16-bit integer lanes, then
+     * converted and multiplied by their weight only once; zero weights are skipped as well. Kernels without
+     * any such symmetry are processed by @ref vectorizedConvolution instead.
+     * The result matches the one of @ref directConvolution within @ref SYMMETRIC_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> symmetricConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, folding its symmetries
+     * by means of the symmetric engine for the given instruction set.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param instructionSet The instruction set of the engine to use.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the instruction set is not supported by the CPU.
+     */
+    std::unique_ptr<Image> symmetricConvolution(const Image& image, const Kernel& kernel,
+        InstructionSet instructionSet);
+
+    /**
+     * Checks whether the given kernel is symmetric under horizontal flips, i.e. its columns mirror each other,
+     * or under vertical flips, i.e. its rows mirror each other.
+     *
+     * @param kernel The kernel to check.
+     * @return True if the kernel has at least one of the two symmetries, false otherwise.
+     */
+    bool isSymmetric(const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, skipping its zero weights.
+     *
+     * The kernel is compacted into a list of (offset, weight) taps, see SparseKernel, so that the engine for
+     * the best instruction set of the CPU reads only the non-zero weights, i.e. in O(T) per pixel for T taps.
+     * Products are summed in the same order as in the generic engines of @ref vectorizedConvolution, thus the
+     * result is bit-identical to theirs and matches the one of @ref directConvolution within
+     * @ref VECTORIZED_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> sparseConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, skipping its zero weights
+     * by means of the sparse engine for the given instruction set.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @param instructionSet The instruction set of the engine to use.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the instruction set is not supported by the CPU.
+     */
+    std::unique_ptr<Image> sparseConvolution(const Image& image, const Kernel& kernel, InstructionSet instructionSet);
+
+    /**
+     * Checks whether @ref sparseConvolution is expected to be faster than @ref vectorizedConvolution for the
+     * given kernel, on the running machine.
+     *
+     * The estimate compares the cost of the non-zero taps in the sparse engine with the cost of all
+     * taps in the vectorized one, for the detected instruction set.
+     *
+     * @param kernel The kernel used for the convolution.
+     * @return True if the sparse engine is expected to be faster, false otherwise.
+     */
+    bool isSparseFaster(const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified kernel, by means of the
+     * Fast Fourier Transform, i.e. in O(log K) per pixel instead of O(K^2).
+     *
+     * Each channel plane is split into tiles processed through overlap-save, so that memory stays bounded
+     * whatever the image size. The kernel spectrum is computed once and shared by the three channels;
+     * moreover, spectra of the most recently used kernels are cached for repeated convolutions.
+     * The result matches the one of @ref directConvolution within @ref FFT_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     */
+    std::unique_ptr<Image> fftConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Checks whether @ref fftConvolution is expected to be faster than @ref vectorizedConvolution for the given
+     * kernel order and output size, on the running machine.
+     *
+     * The estimate compares the cost of the direct taps, for the detected instruction set, with the cost of the
+     * transforms of all tiles, partial ones included; cost constants are derived from the crossover benchmark.
+     *
+     * @param order The order of the kernel.
+     * @param outputWidth The width of the transformed image.
+     * @param outputHeight The height of the transformed image.
+     * @return True if the FFT engine is expected to be faster, false otherwise.
+     */
+    bool isFftFaster(unsigned int order, unsigned int outputWidth, unsigned int outputHeight);
+
+    /**
+     * Applies a convolution operation on the given image using the specified separable kernel,
+     * i.e. a kernel whose weights are the outer product of a vertical and a horizontal 1D kernel.
+     *
+     * Each output row is computed by a vertical 1D pass, which accumulates the involved input rows
+     * into a row buffer, followed by a horizontal 1D pass over that buffer, i.e. in O(K) per pixel.
+     * The result matches the one of @ref directConvolution within @ref SEPARABLE_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The separable kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the kernel is not separable.
+     */
+    std::unique_ptr<Image> separableConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Applies a convolution operation on the given image using the specified box filter kernel,
+     * i.e. a kernel whose weights are all equal.
+     *
+     * For each channel, running column sums are updated by adding the row entering the window and
+     * subtracting the one leaving it, and each output row is then swept by a sliding window over those sums.
+     * Therefore, the cost per pixel does not depend on the kernel order.
+     * Sums are accumulated as exact integers, so that results are bit-reproducible; when the weights are
+     * the mean of the window (as for box blur), each sum is divided by the number of weights and truncated.
+     * The result matches the one of @ref directConvolution within @ref BOX_FILTER_TOLERANCE.
+     *
+     * @param image The input image on which the convolution operation will be performed.
+     * @param kernel The box filter kernel used for the convolution.
+     * @return A unique pointer to a new Image object containing the result of the convolution.
+     * @throw std::invalid_argument If the kernel weights are not all equal.
+     */
+    std::unique_ptr<Image> boxFilterConvolution(const Image& image, const Kernel& kernel);
+
+    /**
+     * Checks whether the given kernel is a box filter, i.e. whether its weights are all equal.
+     *
+     * @param kernel The kernel to check.
+     * @return True if the kernel can be processed by @ref boxFilterConvolution, false otherwise.
+     */
+    bool isBoxFilter(const Kernel& kernel);
+
+    /**
+     * Checks whether the given kernel is separable, i.e. whether its weights matrix has rank one.
+     *
+     * @param kernel The kernel to check.
+     * @return True if the kernel can be processed by @ref separableConvolution, false otherwise.
+     */
+    bool isSeparable(const Kernel& kernel);
+
     /**
      * Extends the edges of the given image by padding a specified number of pixels around it.
      * The edge pixels are replicated outward to fill the padding region.
@@ -0,0 +1,168 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "CacheTopology.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <vector>
+#include <windows.h>
+#endif
+
+#define DEFAULT_LINE_SIZE 64
+#define DEFAULT_L1_DATA_SIZE (32 * 1024)
+#define DEFAULT_L1_ASSOCIATIVITY 8
+#define DEFAULT_L2_SIZE (256 * 1024)
+#define DEFAULT_L3_SIZE (8 * 1024 * 1024)
+#define KIBIBYTE 1024
+
+CacheTopology::CacheTopology(const unsigned int lineSize, const unsigned int l1DataSize,
+    const unsigned int l1Associativity, const unsigned int l2Size, const unsigned int l3Size)
+    : lineSize(lineSize), l1DataSize(l1DataSize), l1Associativity(l1Associativity), l2Size(l2Size), l3Size(l3Size) {
+    if (lineSize == 0 || l1DataSize == 0 || l1Associativity == 0 || l2Size == 0)
+        throw std::invalid_argument("Cache sizes and associativity must be positive.");
+}
+
+CacheTopology::~CacheTopology() = default;
+
+#if defined(__linux__)
+/**
+ * Reads the value of the given attribute of a cache index from sysfs, e.g. "32K" for a size.
+ *
+ * @return The value in bytes, or zero if the attribute is not available.
+ */
+unsigned int readSysfsValue(const unsigned int index, const std::string& attribute) {
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/" + attribute);
+    unsigned long value = 0;
+    char unit = 0;
+    if (!(file >> value))
+        return 0;
+    if (file >> unit && (unit == 'K' || unit == 'k'))
+        value *= KIBIBYTE;
+    else if (unit == 'M' || unit == 'm')
+        value *= KIBIBYTE * KIBIBYTE;
+    return static_cast<unsigned int>(value);
+}
+
+std::string readSysfsString(const unsigned int index, const std::string& attribute) {
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/" + attribute);
+    std::string value;
+    file >> value;
+    return value;
+}
+
+unsigned int readSysconfValue(const int name) {
+    const long value = sysconf(name);
+    return value > 0 ? static_cast<unsigned int>(value) : 0;
+}
+#endif
+
+CacheTopology detectTopologyOnce() {
+    unsigned int lineSize = 0;
+    unsigned int l1DataSize = 0;
+    unsigned int l1Associativity = 0;
+    unsigned int l2Size = 0;
+    unsigned int l3Size = 0;
+
+#if defined(__linux__)
+    for (unsigned int index = 0; ; index++) {
+        const unsigned int level = readSysfsValue(index, "level");
+        if (level == 0)
+            break;
+        if (readSysfsString(index, "type") == "Instruction")
+            continue;
+        const unsigned int size = readSysfsValue(index, "size");
+        if (level == 1) {
+            l1DataSize = size;
+            l1Associativity = readSysfsValue(index, "ways_of_associativity");
+            lineSize = readSysfsValue(index, "coherency_line_size");
+        } else if (level == 2) {
+            l2Size = size;
+        } else if (level == 3) {
+            l3Size = size;
+        }
+    }
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    // e.g. in containers hiding sysfs
+    if (l1DataSize == 0) {
+        l1DataSize = readSysconfValue(_SC_LEVEL1_DCACHE_SIZE);
+        l1Associativity = readSysconfValue(_SC_LEVEL1_DCACHE_ASSOC);
+        lineSize = readSysconfValue(_SC_LEVEL1_DCACHE_LINESIZE);
+    }
+    if (l2Size == 0)
+        l2Size = readSysconfValue(_SC_LEVEL2_CACHE_SIZE);
+    if (l3Size == 0)
+        l3Size = readSysconfValue(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#elif defined(_WIN32)
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!infos.empty() && GetLogicalProcessorInformation(infos.data(), &length)) {
+        for (const auto& info : infos) {
+            if (info.Relationship != RelationCache || info.Cache.Type == CacheInstruction)
+                continue;
+            if (info.Cache.Level == 1) {
+                l1DataSize = info.Cache.Size;
+                l1Associativity = info.Cache.Associativity;
+                lineSize = info.Cache.LineSize;
+            } else if (info.Cache.Level == 2) {
+                l2Size = info.Cache.Size;
+            } else if (info.Cache.Level == 3) {
+                l3Size = info.Cache.Size;
+            }
+        }
+    }
+#endif
+
+    if (l1DataSize == 0)
+        l1DataSize = DEFAULT_L1_DATA_SIZE;
+    // fully associative caches report no ways
+    if (l1Associativity == 0 || l1Associativity > l1DataSize / DEFAULT_LINE_SIZE)
+        l1Associativity = DEFAULT_L1_ASSOCIATIVITY;
+    if (lineSize == 0)
+        lineSize = DEFAULT_LINE_SIZE;
+    if (l2Size == 0)
+        l2Size = DEFAULT_L2_SIZE;
+    if (l3Size == 0)
+        l3Size = DEFAULT_L3_SIZE;
+    return {lineSize, l1DataSize, l1Associativity, l2Size, l3Size};
+}
+
+const CacheTopology& CacheTopology::detect() {
+    static const CacheTopology detected = detectTopologyOnce();
+    return detected;
+}
+
+unsigned int CacheTopology::getLineSize() const {
+    return lineSize;
+}
+
+unsigned int CacheTopology::getL1DataSize() const {
+    return l1DataSize;
+}
+
+unsigned int CacheTopology::getL1Associativity() const {
+    return l1Associativity;
+}
+
+unsigned int CacheTopology::getL2Size() const {
+    return l2Size;
+}
+
+unsigned int CacheTopology::getL3Size() const {
+    return l3Size;
+}
+
+unsigned int CacheTopology::getL1SetStride() const {
+    return l1DataSize / l1Associativity;
+}
+
+std::string CacheTopology::toString() const {
+    std::stringstream description;
+    description << "L1d " << l1DataSize / KIBIBYTE << " KiB (" << l1Associativity << "-way), L2 " <<
+        l2Size / KIBIBYTE << " KiB, L3 " << l3Size / KIBIBYTE << " KiB, " << lineSize << "-byte lines";
+    return description.str();
+}
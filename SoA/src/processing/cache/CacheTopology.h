@@ -0,0 +1,123 @@
+#ifndef CACHETOPOLOGY_H
+#define CACHETOPOLOGY_H
+#include <string>
+
+
+/**
+ * Represents the data cache hierarchy of a CPU, as seen by a single core.
+ *
+ * It lets engines size their working sets, e.g. tiles and buffers, after the caches of the running machine.
+ *
+ * This class is immutable once constructed.
+ */
+class CacheTopology final {
+public:
+    /**
+     * Constructs a CacheTopology object with the specified cache parameters.
+     *
+     * @param lineSize The size of a cache line, in bytes.
+     * @param l1DataSize The size of the level 1 data cache, in bytes.
+     * @param l1Associativity The number of ways of the level 1 data cache.
+     * @param l2Size The size of the level 2 cache, in bytes.
+     * @param l3Size The size of the level 3 cache, in bytes, or zero if there is none.
+     * @throws std::invalid_argument if the line size, the level 1 and level 2 sizes or the associativity are zero.
+     */
+    CacheTopology(unsigned int lineSize, unsigned int l1DataSize, unsigned int l1Associativity, unsigned int l2Size,
+        unsigned int l3Size);
+
+    /**
+     * Default destructor.
+     */
+    ~CacheTopology();
+
+    /**
+     * Detects the cache topology of the running machine, by reading sysfs (falling back to sysconf) on Linux
+     * and the logical processor information on Windows. The detection is performed only once.
+     *
+     * Parameters that cannot be detected take typical values: 64-byte lines, 32 KiB 8-way level 1 data cache,
+     * 256 KiB level 2 cache and 8 MiB level 3 cache.
+     *
+     * @return A reference to the detected topology.
+     */
+    static const CacheTopology& detect();
+
+    /**
+     * Retrieves the size of a cache line.
+     *
+     * @return The size in bytes as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getLineSize() const;
+
+    /**
+     * Retrieves the size of the level 1 data cache.
+     *
+     * @return The size in bytes as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getL1DataSize() const;
+
+    /**
+     * Retrieves the number of ways of the level 1 data cache.
+     *
+     * @return The associativity as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getL1Associativity() const;
+
+    /**
+     * Retrieves the size of the level 2 cache.
+     *
+     * @return The size in bytes as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getL2Size() const;
+
+    /**
+     * Retrieves the size of the level 3 cache.
+     *
+     * @return The size in bytes as an unsigned integer, or zero if there is none.
+     */
+    [[nodiscard]] unsigned int getL3Size() const;
+
+    /**
+     * Retrieves the distance between two addresses mapped to the same level 1 set, i.e. the level 1 size
+     * divided by its associativity. Rows whose stride is a multiple of it compete for the same ways.
+     *
+     * @return The distance in bytes as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getL1SetStride() const;
+
+    /**
+     * Retrieves a human-readable description of the topology, e.g. for benchmark reports.
+     *
+     * @return A string describing line size and cache sizes.
+     */
+    [[nodiscard]] std::string toString() const;
+
+private:
+    /**
+     * Represents the size of a cache line, in bytes.
+     */
+    unsigned int lineSize;
+
+    /**
+     * Represents the size of the level 1 data cache, in bytes.
+     */
+    unsigned int l1DataSize;
+
+    /**
+     * Represents the number of ways of the level 1 data cache.
+     */
+    unsigned int l1Associativity;
+
+    /**
+     * Represents the size of the level 2 cache, in bytes.
+     */
+    unsigned int l2Size;
+
+    /**
+     * Represents the size of the level 3 cache, in bytes.
+     */
+    unsigned int l3Size;
+};
+
+
+
+#endif //CACHETOPOLOGY_H
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Fft.h"
+
+
+Fft::Fft(const unsigned int size): size(size), twiddles(size > 1 ? size - 1 : 0), bitReversal(size) {
+    if (size == 0 || (size & (size - 1)) != 0)
+        throw std::invalid_argument("FFT size must be a power of two.");
+
+    const double pi = std::acos(-1.0);
+    for (unsigned int half = 1; half < size; half <<= 1) {
+        for (unsigned int k = 0; k < half; k++)
+            twiddles[half - 1 + k] = std::polar(1.0, -pi * k / half);
+    }
+
+    unsigned int numBits = 0;
+    while ((1u << numBits) < size)
+        numBits++;
+    for (unsigned int k = 0; k < size; k++) {
+        unsigned int reversed = 0;
+        for (unsigned int bit = 0; bit < numBits; bit++)
+            reversed |= (k >> bit & 1u) << (numBits - 1 - bit);
+        bitReversal[k] = reversed;
+    }
+}
+
+Fft::~Fft() = default;
+
+unsigned int Fft::getSize() const {
+    return size;
+}
+
+/**
+ * Computes in place the butterflies of the radix-2 Cooley-Tukey algorithm on a sequence of size elements, where
+ * each element is a vector of width complex values stored contiguously, after the bit-reversal permutation.
+ *
+ * With a width of one, this is the plain 1D transform; with a width equal to the size, it transforms all columns
+ * of a square matrix at once, the innermost loop running along its rows.
+ */
+void butterflies(std::complex<double> *data, const unsigned int size, const unsigned int width,
+    const std::complex<double> *twiddles) {
+    auto *values = reinterpret_cast<double*>(data);
+    for (unsigned int half = 1; half < size; half <<= 1) {
+        const std::complex<double>* stageTwiddles = twiddles + half - 1;
+        for (unsigned int start = 0; start < size; start += 2 * half) {
+            for (unsigned int k = 0; k < half; k++) {
+                const double twiddleReal = stageTwiddles[k].real();
+                const double twiddleImag = stageTwiddles[k].imag();
+                double* even = values + 2 * (start + k) * width;
+                double* odd = values + 2 * (start + k + half) * width;
+                for (unsigned int c = 0; c < 2 * width; c += 2) {
+                    // explicit product, avoiding the slow NaN-aware path of std::complex multiplication
+                    const double productReal = odd[c] * twiddleReal - odd[c + 1] * twiddleImag;
+                    const double productImag = odd[c] * twiddleImag + odd[c + 1] * twiddleReal;
+                    odd[c] = even[c] - productReal;
+                    odd[c + 1] = even[c + 1] - productImag;
+                    even[c] += productReal;
+                    even[c + 1] += productImag;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Conjugates in place the given values, optionally scaling them.
+ *
+ * The inverse transform is computed as the conjugate of the direct transform of the conjugated input.
+ */
+void conjugate(std::complex<double> *data, const unsigned int length, const double scale) {
+    auto *values = reinterpret_cast<double*>(data);
+    for (unsigned int k = 0; k < 2 * length; k += 2) {
+        values[k] *= scale;
+        values[k + 1] *= -scale;
+    }
+}
+
+void Fft::transform(std::complex<double> *data, const bool inverse) const {
+    if (inverse)
+        conjugate(data, size, 1);
+    for (unsigned int k = 0; k < size; k++) {
+        if (k < bitReversal[k])
+            std::swap(data[k], data[bitReversal[k]]);
+    }
+    butterflies(data, size, 1, twiddles.data());
+    if (inverse)
+        conjugate(data, size, 1.0 / size);
+}
+
+void Fft::transform2D(std::complex<double> *data, const bool inverse) const {
+    const unsigned int length = size * size;
+    if (inverse)
+        conjugate(data, length, 1);
+
+    // rows
+    for (unsigned int y = 0; y < size; y++) {
+        std::complex<double>* row = data + y * size;
+        for (unsigned int k = 0; k < size; k++) {
+            if (k < bitReversal[k])
+                std::swap(row[k], row[bitReversal[k]]);
+        }
+        butterflies(row, size, 1, twiddles.data());
+    }
+
+    // columns, i.e. butterflies between whole rows
+    for (unsigned int y = 0; y < size; y++) {
+        if (y < bitReversal[y])
+            std::swap_ranges(data + y * size, data + (y + 1) * size, data + bitReversal[y] * size);
+    }
+    butterflies(data, size, size, twiddles.data());
+
+    if (inverse)
+        conjugate(data, length, 1.0 / length);
+}
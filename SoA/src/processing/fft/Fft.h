@@ -0,0 +1,74 @@
+#ifndef FFT_H
+#define FFT_H
+#include <complex>
+#include <vector>
+
+
+/**
+ * Represents a plan for computing radix-2 Fast Fourier Transforms of a given size, in one or two dimensions.
+ *
+ * Twiddle factors and the bit-reversal permutation are computed once at construction,
+ * so that the same plan can be reused for many transforms.
+ *
+ * This class is immutable once constructed.
+ */
+class Fft final {
+public:
+    /**
+     * Constructs a Fft object for transforms of the specified size.
+     *
+     * @param size The number of points of the 1D transforms, i.e. the side of the 2D transforms.
+     *             It must be a power of two.
+     * @throws std::invalid_argument if the size is not a power of two.
+     */
+    explicit Fft(unsigned int size);
+
+    /**
+     * Default destructor.
+     */
+    ~Fft();
+
+    /**
+     * Retrieves the size of the transforms.
+     *
+     * @return The size as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getSize() const;
+
+    /**
+     * Computes in place the 1D transform of the given data.
+     *
+     * @param data A sequence of size complex values.
+     * @param inverse Whether the inverse transform has to be computed, in which case the result is scaled by 1/size.
+     */
+    void transform(std::complex<double>* data, bool inverse) const;
+
+    /**
+     * Computes in place the 2D transform of the given data, i.e. the 1D transform of each row and then of each column.
+     *
+     * @param data A square matrix of size x size complex values, stored by rows.
+     * @param inverse Whether the inverse transform has to be computed, in which case the result is scaled by 1/size^2.
+     */
+    void transform2D(std::complex<double>* data, bool inverse) const;
+
+private:
+    /**
+     * Represents the number of points of the transforms.
+     */
+    unsigned int size;
+
+    /**
+     * Stores the twiddle factors of all butterfly stages contiguously: the stage combining sequences of
+     * half = 1, 2, 4, ... points uses the factors exp(-pi*i*k/half), for k in [0, half), starting at index half - 1.
+     */
+    std::vector<std::complex<double>> twiddles;
+
+    /**
+     * Stores, for each index, the index with reversed bits.
+     */
+    std::vector<unsigned int> bitReversal;
+};
+
+
+
+#endif //FFT_H
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+#include "FftConvolution.h"
+
+#define MIN_TILE_SIZE 32
+#define MAX_TILE_SIZE 512
+#define TILES_PER_TRANSFORM 2
+// the round-off of the transforms, far below the resolution of the weights, may put a sum just below the integer
+// that the direct engines reach exactly
+#define ROUND_OFF_TOLERANCE 1e-6
+
+FftConvolution::FftConvolution(const Kernel &kernel): order(kernel.getOrder()), weights(kernel.getWeights()),
+    fft(chooseTileSize(kernel.getOrder())) {
+    const unsigned int tileSize = fft.getSize();
+
+    // the kernel is flipped, so that the circular convolution computes the same sum of products of directConvolution
+    kernelSpectrum.assign(tileSize * tileSize, 0);
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            kernelSpectrum[j * tileSize + i] = weights[(order - 1 - j) * order + (order - 1 - i)];
+        }
+    }
+    fft.transform2D(kernelSpectrum.data(), false);
+}
+
+FftConvolution::~FftConvolution() = default;
+
+unsigned int FftConvolution::getTileSize() const {
+    return fft.getSize();
+}
+
+bool FftConvolution::matches(const Kernel &kernel) const {
+    return kernel.getOrder() == order && std::equal(weights.begin(), weights.end(), kernel.viewWeights().begin());
+}
+
+uint8_t getValueAsUint8(const double value) {
+    if (value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return static_cast<uint8_t>(value + ROUND_OFF_TOLERANCE);
+}
+
+void FftConvolution::convolvePlane(const uint8_t *input, const unsigned int inputStride, const unsigned int inputWidth,
+    const unsigned int inputHeight, uint8_t *output, const unsigned int outputStride, const unsigned int rowBegin,
+    const unsigned int rowEnd) const {
+    const unsigned int tileSize = fft.getSize();
+    // output values of a tile not affected by the circular wrap-around
+    const unsigned int validSize = tileSize - (order - 1);
+    const unsigned int outputWidth = inputWidth - (order - 1);
+
+    // the tile buffer is kept by each thread, so that repeated convolutions do not allocate
+    thread_local std::vector<std::complex<double>> block;
+    block.resize(tileSize * tileSize);
+    // tiles lie on a grid anchored at the first row, whatever the range, so that the round-off of each value does
+    // not depend on how the plane is split into bands; only the rows of the range are written
+    for (unsigned int tileY = rowBegin - rowBegin % validSize; tileY < rowEnd; tileY += validSize) {
+        const unsigned int firstRow = std::max(tileY, rowBegin) - tileY;
+        const unsigned int numRows = std::min(validSize, rowEnd - tileY);
+        const unsigned int numInputRows = std::min(tileSize, inputHeight - tileY);
+
+        for (unsigned int tileX = 0; tileX < outputWidth; tileX += TILES_PER_TRANSFORM * validSize) {
+            // the first tile goes into the real part and the second one, if any, into the imaginary part
+            const unsigned int secondTileX = tileX + validSize;
+            const unsigned int numRealColumns = std::min(tileSize, inputWidth - tileX);
+            const unsigned int numImagColumns = secondTileX < outputWidth ? std::min(tileSize, inputWidth - secondTileX) : 0;
+            std::fill(block.begin(), block.end(), 0);
+            for (unsigned int j = 0; j < numInputRows; j++) {
+                const uint8_t* inputRow = input + (tileY + j) * inputStride;
+                std::complex<double>* blockRow = block.data() + j * tileSize;
+                for (unsigned int i = 0; i < numRealColumns; i++)
+                    blockRow[i].real(inputRow[tileX + i]);
+                for (unsigned int i = 0; i < numImagColumns; i++)
+                    blockRow[i].imag(inputRow[secondTileX + i]);
+            }
+
+            fft.transform2D(block.data(), false);
+            for (unsigned int k = 0; k < tileSize * tileSize; k++) {
+                const std::complex<double> value = block[k];
+                const std::complex<double> weight = kernelSpectrum[k];
+                block[k] = std::complex<double>(value.real() * weight.real() - value.imag() * weight.imag(),
+                    value.real() * weight.imag() + value.imag() * weight.real());
+            }
+            fft.transform2D(block.data(), true);
+
+            const unsigned int numRealOutputs = std::min(validSize, outputWidth - tileX);
+            const unsigned int numImagOutputs = secondTileX < outputWidth ? std::min(validSize, outputWidth - secondTileX) : 0;
+            for (unsigned int j = firstRow; j < numRows; j++) {
+                const std::complex<double>* blockRow = block.data() + (j + order - 1) * tileSize + (order - 1);
+                uint8_t* outputRow = output + (tileY + j) * outputStride;
+                for (unsigned int i = 0; i < numRealOutputs; i++)
+                    outputRow[tileX + i] = getValueAsUint8(blockRow[i].real());
+                for (unsigned int i = 0; i < numImagOutputs; i++)
+                    outputRow[secondTileX + i] = getValueAsUint8(blockRow[i].imag());
+            }
+        }
+    }
+}
+
+double FftConvolution::estimateOperationsPerValue(const unsigned int order, const unsigned int tileSize) {
+    if (tileSize < 2 * order)
+        return INFINITY;
+    const double validSize = tileSize - (order - 1);
+    // a 1D transform costs about 5 * N * log2(N) operations, so a 2D one 10 * N^2 * log2(N); each block requires
+    // a forward and an inverse 2D transform plus the product by the spectrum, and it is shared by two tiles
+    const double operationsPerBlock = 20.0 * tileSize * tileSize * std::log2(tileSize) + 6.0 * tileSize * tileSize;
+    return operationsPerBlock / (TILES_PER_TRANSFORM * validSize * validSize);
+}
+
+unsigned int FftConvolution::chooseTileSize(const unsigned int order) {
+    unsigned int maxTileSize = MAX_TILE_SIZE;
+    while (maxTileSize < 2 * order)
+        maxTileSize <<= 1;
+
+    unsigned int bestTileSize = maxTileSize;
+    for (unsigned int tileSize = MIN_TILE_SIZE; tileSize < maxTileSize; tileSize <<= 1) {
+        if (estimateOperationsPerValue(order, tileSize) < estimateOperationsPerValue(order, bestTileSize))
+            bestTileSize = tileSize;
+    }
+    return bestTileSize;
+}
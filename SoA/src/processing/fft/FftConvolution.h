@@ -0,0 +1,116 @@
+#ifndef FFTCONVOLUTION_H
+#define FFTCONVOLUTION_H
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "Fft.h"
+#include "kernel/Kernel.h"
+
+
+/**
+ * Represents a convolution engine based on the Fast Fourier Transform, suitable for large kernels
+ * with arbitrary weights.
+ *
+ * The output plane is split into square tiles, each computed through overlap-save: an input block of
+ * tileSize x tileSize values is transformed, multiplied by the kernel spectrum and transformed back, keeping only
+ * the values not affected by circular wrap-around. Two tiles are packed into the real and imaginary parts of a
+ * single complex block, so each transform serves two tiles. Memory is bounded by the tile size, whatever the image size.
+ * Tiles lie on a grid anchored at the first row and column of the plane, so the value of each output does not depend
+ * on the range of rows it is computed with, and sums are truncated after a tolerance for the round-off of the
+ * transforms, so that integer results are exact.
+ *
+ * The kernel spectrum is computed once at construction, so the same object can be reused for all channel planes
+ * and for repeated convolutions.
+ *
+ * This class is immutable once constructed.
+ */
+class FftConvolution final {
+public:
+    /**
+     * Constructs a FftConvolution object for the specified kernel, choosing the tile size which minimizes
+     * the number of operations per output value.
+     *
+     * @param kernel The kernel used for the convolution.
+     */
+    explicit FftConvolution(const Kernel& kernel);
+
+    /**
+     * Default destructor.
+     */
+    ~FftConvolution();
+
+    /**
+     * Retrieves the side of the square tiles, i.e. the size of the transforms.
+     *
+     * @return The tile size as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getTileSize() const;
+
+    /**
+     * Checks whether this engine has been built for the given kernel.
+     *
+     * @param kernel The kernel to compare.
+     * @return True if the kernel has the same order and weights of the one used at construction, false otherwise.
+     */
+    [[nodiscard]] bool matches(const Kernel& kernel) const;
+
+    /**
+     * Computes the output rows in the range [rowBegin, rowEnd) of the cropped convolution of a single channel plane,
+     * with the same values as if the whole plane were computed at once.
+     *
+     * @param input The input channel plane.
+     * @param inputStride The distance between consecutive rows of the input plane.
+     * @param inputWidth The width of the input plane.
+     * @param inputHeight The height of the input plane.
+     * @param output The output channel plane, whose width is inputWidth - (order - 1).
+     * @param outputStride The distance between consecutive rows of the output plane.
+     * @param rowBegin The first output row to compute.
+     * @param rowEnd The output row after the last one to compute.
+     */
+    void convolvePlane(const uint8_t* input, unsigned int inputStride, unsigned int inputWidth,
+        unsigned int inputHeight, uint8_t* output, unsigned int outputStride, unsigned int rowBegin,
+        unsigned int rowEnd) const;
+
+    /**
+     * Estimates the number of floating-point operations per output value, for the given kernel order and tile size.
+     *
+     * @param order The order of the kernel.
+     * @param tileSize The side of the square tiles.
+     * @return The estimated number of operations per output value.
+     */
+    static double estimateOperationsPerValue(unsigned int order, unsigned int tileSize);
+
+    /**
+     * Chooses the tile size which minimizes the number of operations per output value for the given kernel order.
+     *
+     * @param order The order of the kernel.
+     * @return The side of the square tiles, a power of two.
+     */
+    static unsigned int chooseTileSize(unsigned int order);
+
+private:
+    /**
+     * Represents the order of the kernel.
+     */
+    unsigned int order;
+
+    /**
+     * Stores the weights of the kernel, used to recognize it.
+     */
+    std::vector<float> weights;
+
+    /**
+     * Represents the transform plan, whose size is the tile side.
+     */
+    Fft fft;
+
+    /**
+     * Stores the 2D spectrum of the kernel, flipped and zero-padded to the tile size.
+     */
+    std::vector<std::complex<double>> kernelSpectrum;
+};
+
+
+
+#endif //FFTCONVOLUTION_H
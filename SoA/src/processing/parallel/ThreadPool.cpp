@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <stdexcept>
+#include "ThreadPool.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+void pinToCpu(std::thread &thread, const unsigned int cpu) {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(1) << cpu);
+#endif
+}
+
+ThreadPool::ThreadPool(const unsigned int numThreads, const bool pinThreads) {
+    if (numThreads == 0)
+        throw std::invalid_argument("Number of threads must be positive.");
+
+    const unsigned int numCpus = std::max(std::thread::hardware_concurrency(), 1u);
+    workers.reserve(numThreads - 1);
+    for (unsigned int k = 0; k < numThreads - 1; k++) {
+        workers.emplace_back(&ThreadPool::work, this);
+        if (pinThreads)
+            pinToCpu(workers.back(), (k + 1) % numCpus);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    operationReady.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+unsigned int ThreadPool::getNumThreads() const {
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void ThreadPool::runOperation(const unsigned int numTasks, const void *task,
+    void (*invoker)(const void*, unsigned int)) {
+    if (numTasks == 0)
+        return;
+
+    {
+        std::lock_guard lock(mutex);
+        currentTask = task;
+        currentInvoker = invoker;
+        this->numTasks = numTasks;
+        nextTask = 0;
+        pendingWorkers = static_cast<unsigned int>(workers.size());
+        firstException = nullptr;
+        generation++;
+    }
+    operationReady.notify_all();
+
+    // the calling thread works too
+    runTasks();
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock lock(mutex);
+        operationDone.wait(lock, [this] { return pendingWorkers == 0; });
+        currentTask = nullptr;
+        currentInvoker = nullptr;
+        exception = firstException;
+    }
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+void ThreadPool::work() {
+    unsigned long long lastGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            operationReady.wait(lock, [this, lastGeneration] { return stopping || generation != lastGeneration; });
+            if (stopping)
+                return;
+            lastGeneration = generation;
+        }
+
+        runTasks();
+
+        {
+            std::lock_guard lock(mutex);
+            pendingWorkers--;
+        }
+        operationDone.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() {
+    for (unsigned int task = nextTask++; task < numTasks; task = nextTask++) {
+        try {
+            currentInvoker(currentTask, task);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!firstException)
+                firstException = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Represents a persistent pool of worker threads which can be reused by several parallel operations,
+ * so that threads are created only once instead of at each operation.
+ *
+ * Work is split into indexed tasks which are handed out dynamically: each thread picks the next task as soon as
+ * it has finished the previous one, so that faster cores (e.g. Performance cores of hybrid CPUs) process more tasks
+ * and all threads finish at about the same time.
+ *
+ * The pool is not meant to be used by several callers concurrently.
+ */
+class ThreadPool final {
+public:
+    /**
+     * Constructs a ThreadPool object with the specified number of threads.
+     *
+     * The calling thread takes part in the work, so only (numThreads - 1) worker threads are spawned.
+     *
+     * @param numThreads The number of threads working on each parallel operation. It must be positive; by default,
+     *                   the number of logical CPUs, or one if it cannot be detected.
+     * @param pinThreads Whether each worker thread has to be pinned to a single logical CPU; the k-th worker
+     *                   is pinned to the CPU (k + 1) modulo the number of logical CPUs, leaving the first one
+     *                   to the calling thread. It is ignored on platforms without thread affinity support.
+     * @throws std::invalid_argument if the number of threads is zero.
+     */
+    explicit ThreadPool(unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u),
+        bool pinThreads = false);
+
+    /**
+     * Destructor which stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Retrieves the number of threads working on each parallel operation, including the calling one.
+     *
+     * @return The number of threads as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getNumThreads() const;
+
+    /**
+     * Executes the given task once for each index in the range [0, numTasks), distributing the indexes
+     * among all threads, and waits for all of them to be completed.
+     *
+     * The task is called through a reference instead of being copied into a std::function, so that an operation
+     * does not allocate, whatever the captures of the task.
+     *
+     * @tparam Task The type of a function object callable with a task index.
+     * @param numTasks The number of task indexes.
+     * @param task The function to execute for each task index.
+     * @throws Any exception thrown by a task; the first one is rethrown once all tasks are finished.
+     */
+    template <typename Task>
+    void parallelFor(const unsigned int numTasks, const Task& task) {
+        runOperation(numTasks, &task, [](const void* erasedTask, const unsigned int index) {
+            (*static_cast<const Task*>(erasedTask))(index);
+        });
+    }
+
+private:
+    /**
+     * Executes the task of a parallel operation, given as an erased pointer along with the function calling it.
+     *
+     * @param numTasks The number of task indexes.
+     * @param task The task, which the invoker casts back to its type.
+     * @param invoker The function executing the task for a task index.
+     */
+    void runOperation(unsigned int numTasks, const void* task, void (*invoker)(const void*, unsigned int));
+
+    /**
+     * Main loop of the worker threads, which wait for a new operation and then take part in it.
+     */
+    void work();
+
+    /**
+     * Executes the tasks of the current operation until none is left.
+     */
+    void runTasks();
+
+    /**
+     * Stores the worker threads, i.e. all threads except the calling one.
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * Protects the state of the current operation shared with worker threads.
+     */
+    std::mutex mutex;
+
+    /**
+     * Notifies worker threads that a new operation is ready or that the pool is stopping.
+     */
+    std::condition_variable operationReady;
+
+    /**
+     * Notifies the calling thread that all worker threads have finished the current operation.
+     */
+    std::condition_variable operationDone;
+
+    /**
+     * Points to the task of the current operation.
+     */
+    const void* currentTask = nullptr;
+
+    /**
+     * Points to the function executing the task of the current operation.
+     */
+    void (*currentInvoker)(const void*, unsigned int) = nullptr;
+
+    /**
+     * Represents the number of task indexes of the current operation.
+     */
+    unsigned int numTasks = 0;
+
+    /**
+     * Represents the next task index to hand out.
+     */
+    std::atomic<unsigned int> nextTask{0};
+
+    /**
+     * Represents the number of worker threads which have not finished the current operation yet.
+     */
+    unsigned int pendingWorkers = 0;
+
+    /**
+     * Counts the operations started so far, so that each worker takes part in each operation exactly once.
+     */
+    unsigned long long generation = 0;
+
+    /**
+     * Indicates whether worker threads have to terminate.
+     */
+    bool stopping = false;
+
+    /**
+     * Stores the first exception thrown by a task of the current operation.
+     */
+    std::exception_ptr firstException;
+};
+
+
+
+#endif //THREADPOOL_H
@@ -0,0 +1,181 @@
+#ifndef CHANNELLAYOUT_H
+#define CHANNELLAYOUT_H
+#include <cstdint>
+
+#include "InstructionSet.h"
+
+
+/**
+ * Namespace for the conversions between the interleaved layout of RGB pixels, i.e. the AoS layout used by image
+ * files and codecs, and the planar layout of the channels, i.e. the SoA layout used by images and engines.
+ *
+ * Each conversion is provided by a scalar engine and by engines shuffling bytes with SSSE3 (16 pixels per step)
+ * and AVX2 (32 pixels per step) instructions, selected at runtime as the convolution engines; the engines of
+ * @ref Deinterleave and @ref Interleave convert single rows, whereas @ref deinterleave and @ref interleave convert
+ * whole images with the detected engine.
+ */
+namespace ChannelLayout {
+    /**
+     * Namespace for the deinterleaving engines, which split a row of interleaved pixels into three channels.
+     */
+    namespace Deinterleave {
+        /**
+         * Signature shared by all deinterleaving engines.
+         *
+         * @param interleaved The interleaved pixels, i.e. numPixels triplets of red, green and blue values.
+         * @param reds The red channel values.
+         * @param greens The green channel values.
+         * @param blues The blue channel values.
+         * @param numPixels The number of pixels to convert.
+         */
+        using Function = void (*)(const uint8_t* interleaved, uint8_t* reds, uint8_t* greens, uint8_t* blues,
+            unsigned int numPixels);
+
+        /**
+         * Portable engine converting one pixel at a time.
+         */
+        void scalar(const uint8_t* interleaved, uint8_t* reds, uint8_t* greens, uint8_t* blues,
+            unsigned int numPixels);
+
+        /**
+         * SSSE3 engine converting 16 pixels per step, i.e. three 16-byte vectors into one per channel.
+         */
+        void sse42(const uint8_t* interleaved, uint8_t* reds, uint8_t* greens, uint8_t* blues,
+            unsigned int numPixels);
+
+        /**
+         * AVX2 engine converting 32 pixels per step, i.e. two groups of 16 pixels in parallel lanes.
+         */
+        void avx2(const uint8_t* interleaved, uint8_t* reds, uint8_t* greens, uint8_t* blues,
+            unsigned int numPixels);
+
+        /**
+         * Retrieves the engine specialized for the given instruction set; AVX-512 uses the AVX2 one,
+         * since byte permutations across lanes would require the AVX-512 VBMI extension.
+         *
+         * @param instructionSet The instruction set of the engine.
+         * @return The deinterleaving engine, or the scalar one if the platform has no such specialization.
+         */
+        Function select(InstructionSet instructionSet);
+    }
+
+    /**
+     * Namespace for the interleaving engines, which merge three channels into a row of interleaved pixels.
+     */
+    namespace Interleave {
+        /**
+         * Signature shared by all interleaving engines.
+         *
+         * @param reds The red channel values.
+         * @param greens The green channel values.
+         * @param blues The blue channel values.
+         * @param interleaved The interleaved pixels, i.e. numPixels triplets of red, green and blue values.
+         * @param numPixels The number of pixels to convert.
+         */
+        using Function = void (*)(const uint8_t* reds, const uint8_t* greens, const uint8_t* blues,
+            uint8_t* interleaved, unsigned int numPixels);
+
+        /**
+         * Portable engine converting one pixel at a time.
+         */
+        void scalar(const uint8_t* reds, const uint8_t* greens, const uint8_t* blues, uint8_t* interleaved,
+            unsigned int numPixels);
+
+        /**
+         * SSSE3 engine converting 16 pixels per step, i.e. one 16-byte vector per channel into three.
+         */
+        void sse42(const uint8_t* reds, const uint8_t* greens, const uint8_t* blues, uint8_t* interleaved,
+            unsigned int numPixels);
+
+        /**
+         * AVX2 engine converting 32 pixels per step, i.e. two groups of 16 pixels in parallel lanes.
+         */
+        void avx2(const uint8_t* reds, const uint8_t* greens, const uint8_t* blues, uint8_t* interleaved,
+            unsigned int numPixels);
+
+        /**
+         * Retrieves the engine specialized for the given instruction set; AVX-512 uses the AVX2 one,
+         * since byte permutations across lanes would require the AVX-512 VBMI extension.
+         *
+         * @param instructionSet The instruction set of the engine.
+         * @return The interleaving engine, or the scalar one if the platform has no such specialization.
+         */
+        Function select(InstructionSet instructionSet);
+    }
+
+    /**
+     * Splits an image of interleaved pixels into three planes, with the engine of the detected instruction set.
+     *
+     * @param interleaved The interleaved pixels, stored by rows of width triplets without padding.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @param reds The red plane.
+     * @param greens The green plane.
+     * @param blues The blue plane.
+     * @param stride The distance between consecutive rows of each plane, at least the width.
+     */
+    void deinterleave(const uint8_t* interleaved, unsigned int width, unsigned int height, uint8_t* reds,
+        uint8_t* greens, uint8_t* blues, unsigned int stride);
+
+    /**
+     * Merges three planes into an image of interleaved pixels, with the engine of the detected instruction set.
+     *
+     * @param reds The red plane.
+     * @param greens The green plane.
+     * @param blues The blue plane.
+     * @param stride The distance between consecutive rows of each plane, at least the width.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @param interleaved The interleaved pixels, stored by rows of width triplets without padding.
+     */
+    void interleave(const uint8_t* reds, const uint8_t* greens, const uint8_t* blues, unsigned int stride,
+        unsigned int width, unsigned int height, uint8_t* interleaved);
+
+    /**
+     * Byte shuffle masks gathering the values of each channel (first index) out of each of three consecutive
+     * 16-byte vectors of interleaved pixels (second index); negative entries clear the destination byte.
+     */
+    alignas(16) inline constexpr int8_t DEINTERLEAVE_MASKS[3][3][16] = {
+        {
+            {0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 1, 4, 7, 10, 13}
+        },
+        {
+            {1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14}
+        },
+        {
+            {2, 5, 8, 11, 14, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, 1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128},
+            {-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15}
+        }
+    };
+
+    /**
+     * Byte shuffle masks scattering the values of each channel (second index) into each of three consecutive
+     * 16-byte vectors of interleaved pixels (first index); negative entries clear the destination byte.
+     */
+    alignas(16) inline constexpr int8_t INTERLEAVE_MASKS[3][3][16] = {
+        {
+            {0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128, 5},
+            {-128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128},
+            {-128, -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128}
+        },
+        {
+            {-128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10, -128},
+            {5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10},
+            {-128, 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128}
+        },
+        {
+            {-128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128, -128},
+            {-128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128},
+            {10, -128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15}
+        }
+    };
+}
+
+
+
+#endif //CHANNELLAYOUT_H
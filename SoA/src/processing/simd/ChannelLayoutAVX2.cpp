@@ -0,0 +1,76 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "ChannelLayout.h"
+
+#define AVX2_STEP 32
+#define RGB_CHANNELS 3
+
+/**
+ * Loads two 16-byte vectors into the low and high lanes of a 32-byte one.
+ */
+static __m256i loadLanes(const uint8_t* low, const uint8_t* high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)), 1);
+}
+
+void ChannelLayout::Deinterleave::avx2(const uint8_t *interleaved, uint8_t *reds, uint8_t *greens, uint8_t *blues,
+    const unsigned int numPixels) {
+    // byte shuffles do not cross 128-bit lanes, so each lane converts its own group of 16 pixels
+    __m256i masks[3][3];
+    for (unsigned int c = 0; c < 3; c++) {
+        for (unsigned int k = 0; k < 3; k++) {
+            masks[c][k] = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(DEINTERLEAVE_MASKS[c][k])));
+        }
+    }
+    uint8_t* planes[3] = {reds, greens, blues};
+
+    unsigned int x = 0;
+    for (; x + AVX2_STEP <= numPixels; x += AVX2_STEP) {
+        const uint8_t* pixels = interleaved + x * RGB_CHANNELS;
+        const __m256i first = loadLanes(pixels, pixels + 48);
+        const __m256i second = loadLanes(pixels + 16, pixels + 64);
+        const __m256i third = loadLanes(pixels + 32, pixels + 80);
+
+        for (unsigned int c = 0; c < 3; c++) {
+            const __m256i values = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(first, masks[c][0]),
+                _mm256_shuffle_epi8(second, masks[c][1])), _mm256_shuffle_epi8(third, masks[c][2]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes[c] + x), values);
+        }
+    }
+
+    // process the pixels left over by full vector steps
+    sse42(interleaved + x * RGB_CHANNELS, reds + x, greens + x, blues + x, numPixels - x);
+}
+
+void ChannelLayout::Interleave::avx2(const uint8_t *reds, const uint8_t *greens, const uint8_t *blues,
+    uint8_t *interleaved, const unsigned int numPixels) {
+    // byte shuffles do not cross 128-bit lanes, so each lane converts its own group of 16 pixels
+    __m256i masks[3][3];
+    for (unsigned int k = 0; k < 3; k++) {
+        for (unsigned int c = 0; c < 3; c++) {
+            masks[k][c] = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(INTERLEAVE_MASKS[k][c])));
+        }
+    }
+
+    unsigned int x = 0;
+    for (; x + AVX2_STEP <= numPixels; x += AVX2_STEP) {
+        const __m256i redValues = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(reds + x));
+        const __m256i greenValues = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(greens + x));
+        const __m256i blueValues = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blues + x));
+
+        uint8_t* pixels = interleaved + x * RGB_CHANNELS;
+        for (unsigned int k = 0; k < 3; k++) {
+            const __m256i values = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(redValues, masks[k][0]),
+                _mm256_shuffle_epi8(greenValues, masks[k][1])), _mm256_shuffle_epi8(blueValues, masks[k][2]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 16 * k), _mm256_castsi256_si128(values));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 48 + 16 * k), _mm256_extracti128_si256(values, 1));
+        }
+    }
+
+    // process the pixels left over by full vector steps
+    sse42(reds + x, greens + x, blues + x, interleaved + x * RGB_CHANNELS, numPixels - x);
+}
+#endif
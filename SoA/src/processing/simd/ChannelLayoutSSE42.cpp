@@ -0,0 +1,63 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "ChannelLayout.h"
+
+#define SSE42_STEP 16
+#define RGB_CHANNELS 3
+
+void ChannelLayout::Deinterleave::sse42(const uint8_t *interleaved, uint8_t *reds, uint8_t *greens, uint8_t *blues,
+    const unsigned int numPixels) {
+    __m128i masks[3][3];
+    for (unsigned int c = 0; c < 3; c++) {
+        for (unsigned int k = 0; k < 3; k++)
+            masks[c][k] = _mm_load_si128(reinterpret_cast<const __m128i*>(DEINTERLEAVE_MASKS[c][k]));
+    }
+    uint8_t* planes[3] = {reds, greens, blues};
+
+    unsigned int x = 0;
+    for (; x + SSE42_STEP <= numPixels; x += SSE42_STEP) {
+        const uint8_t* pixels = interleaved + x * RGB_CHANNELS;
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 16));
+        const __m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 32));
+
+        // each channel gathers its values out of the three vectors, which are then merged
+        for (unsigned int c = 0; c < 3; c++) {
+            const __m128i values = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(first, masks[c][0]),
+                _mm_shuffle_epi8(second, masks[c][1])), _mm_shuffle_epi8(third, masks[c][2]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[c] + x), values);
+        }
+    }
+
+    // process the pixels left over by full vector steps
+    scalar(interleaved + x * RGB_CHANNELS, reds + x, greens + x, blues + x, numPixels - x);
+}
+
+void ChannelLayout::Interleave::sse42(const uint8_t *reds, const uint8_t *greens, const uint8_t *blues,
+    uint8_t *interleaved, const unsigned int numPixels) {
+    __m128i masks[3][3];
+    for (unsigned int k = 0; k < 3; k++) {
+        for (unsigned int c = 0; c < 3; c++)
+            masks[k][c] = _mm_load_si128(reinterpret_cast<const __m128i*>(INTERLEAVE_MASKS[k][c]));
+    }
+
+    unsigned int x = 0;
+    for (; x + SSE42_STEP <= numPixels; x += SSE42_STEP) {
+        const __m128i redValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(reds + x));
+        const __m128i greenValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(greens + x));
+        const __m128i blueValues = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blues + x));
+
+        // each output vector scatters the values of the three channels, which are then merged
+        uint8_t* pixels = interleaved + x * RGB_CHANNELS;
+        for (unsigned int k = 0; k < 3; k++) {
+            const __m128i values = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(redValues, masks[k][0]),
+                _mm_shuffle_epi8(greenValues, masks[k][1])), _mm_shuffle_epi8(blueValues, masks[k][2]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 16 * k), values);
+        }
+    }
+
+    // process the pixels left over by full vector steps
+    scalar(reds + x, greens + x, blues + x, interleaved + x * RGB_CHANNELS, numPixels - x);
+}
+#endif
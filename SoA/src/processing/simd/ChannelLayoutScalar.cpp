@@ -0,0 +1,75 @@
+#include "ChannelLayout.h"
+
+#include <cstddef>
+
+#define RGB_CHANNELS 3
+
+void ChannelLayout::Deinterleave::scalar(const uint8_t *interleaved, uint8_t *reds, uint8_t *greens, uint8_t *blues,
+    const unsigned int numPixels) {
+    for (unsigned int x = 0; x < numPixels; x++) {
+        reds[x] = interleaved[x * RGB_CHANNELS];
+        greens[x] = interleaved[x * RGB_CHANNELS + 1];
+        blues[x] = interleaved[x * RGB_CHANNELS + 2];
+    }
+}
+
+void ChannelLayout::Interleave::scalar(const uint8_t *reds, const uint8_t *greens, const uint8_t *blues,
+    uint8_t *interleaved, const unsigned int numPixels) {
+    for (unsigned int x = 0; x < numPixels; x++) {
+        interleaved[x * RGB_CHANNELS] = reds[x];
+        interleaved[x * RGB_CHANNELS + 1] = greens[x];
+        interleaved[x * RGB_CHANNELS + 2] = blues[x];
+    }
+}
+
+ChannelLayout::Deinterleave::Function ChannelLayout::Deinterleave::select(const InstructionSet instructionSet) {
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return sse42;
+        case InstructionSet::avx2:
+        case InstructionSet::avx512:
+            return avx2;
+        default:
+            return scalar;
+    }
+#else
+    return scalar;
+#endif
+}
+
+ChannelLayout::Interleave::Function ChannelLayout::Interleave::select(const InstructionSet instructionSet) {
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return sse42;
+        case InstructionSet::avx2:
+        case InstructionSet::avx512:
+            return avx2;
+        default:
+            return scalar;
+    }
+#else
+    return scalar;
+#endif
+}
+
+void ChannelLayout::deinterleave(const uint8_t *interleaved, const unsigned int width, const unsigned int height,
+    uint8_t *reds, uint8_t *greens, uint8_t *blues, const unsigned int stride) {
+    const Deinterleave::Function engine = Deinterleave::select(InstructionSets::detect());
+    for (unsigned int y = 0; y < height; y++) {
+        const std::size_t pos = static_cast<std::size_t>(y) * stride;
+        engine(interleaved + static_cast<std::size_t>(y) * width * RGB_CHANNELS, reds + pos, greens + pos,
+            blues + pos, width);
+    }
+}
+
+void ChannelLayout::interleave(const uint8_t *reds, const uint8_t *greens, const uint8_t *blues,
+    const unsigned int stride, const unsigned int width, const unsigned int height, uint8_t *interleaved) {
+    const Interleave::Function engine = Interleave::select(InstructionSets::detect());
+    for (unsigned int y = 0; y < height; y++) {
+        const std::size_t pos = static_cast<std::size_t>(y) * stride;
+        engine(reds + pos, greens + pos, blues + pos, interleaved + static_cast<std::size_t>(y) * width * RGB_CHANNELS,
+            width);
+    }
+}
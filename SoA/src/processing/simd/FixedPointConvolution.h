@@ -0,0 +1,132 @@
+#ifndef FIXEDPOINTCONVOLUTION_H
+#define FIXEDPOINTCONVOLUTION_H
+#include <cstdint>
+#include <vector>
+
+#include "InstructionSet.h"
+
+
+/**
+ * Namespace for the integer convolution engines working on a single channel plane,
+ * each of them specialized for an instruction set.
+ *
+ * They apply kernels whose weights are integers up to a common divisor, i.e. weight = numerator / divisor:
+ * products of the numerators are accumulated in integer lanes, and the sum is divided once per output value.
+ * Results are exact, thus bit-identical among all engines and platforms.
+ *
+ * As in @ref PlaneConvolution, the output rows in the range [rowBegin, rowEnd) of a cropped convolution are computed.
+ */
+namespace FixedPointConvolution {
+    /**
+     * Represents the integer form of a kernel.
+     */
+    struct Weights {
+        /**
+         * The numerators of the kernel weights, stored by rows.
+         */
+        std::vector<int32_t> numerators;
+
+        /**
+         * The order of the kernel.
+         */
+        unsigned int order;
+
+        /**
+         * The common divisor of the kernel weights; sums are truncated after the division.
+         */
+        int32_t divisor;
+
+        /**
+         * Whether every sum, whatever the 8-bit input values, fits a 16-bit signed integer,
+         * in which case vectorized engines use 16-bit lanes.
+         */
+        bool isNarrow;
+
+        /**
+         * Whether the weights are integers and every partial sum, whatever the 8-bit input values, is lower than
+         * 2^24 in magnitude, in which case float engines compute the same sums exactly.
+         */
+        bool isExactInFloat;
+    };
+
+    /**
+     * Signature shared by all fixed-point plane convolution engines.
+     *
+     * @param input The input channel plane.
+     * @param inputStride The distance between consecutive rows of the input plane, at least outputWidth + order - 1.
+     * @param output The output channel plane.
+     * @param outputStride The distance between consecutive rows of the output plane, at least outputWidth.
+     * @param outputWidth The width of the output plane, i.e. the number of columns to compute.
+     * @param rowBegin The first output row to compute.
+     * @param rowEnd The output row after the last one to compute.
+     * @param weights The integer form of the kernel.
+     */
+    using Function = void (*)(const uint8_t* input, unsigned int inputStride, uint8_t* output,
+        unsigned int outputStride, unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd,
+        const Weights& weights);
+
+    /**
+     * Portable engine computing one output value at a time in 32-bit integers.
+     */
+    void scalar(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * SSE4.2 engine computing 8 output values per step with 16-bit lanes, or 4 with 32-bit lanes.
+     */
+    void sse42(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * AVX2 engine computing 16 output values per step with 16-bit lanes, or 8 with 32-bit lanes.
+     */
+    void avx2(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * AVX-512 engine computing 32 output values per step with 16-bit lanes, or 16 with 32-bit lanes.
+     */
+    void avx512(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * Retrieves the engine specialized for the given instruction set.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @return The fixed-point plane convolution engine, or the scalar one if the platform has no such specialization.
+     */
+    Function select(InstructionSet instructionSet);
+
+    /**
+     * Divides the given sum by the divisor, truncating the quotient, and clamps it to 8-bit unsigned integers.
+     *
+     * It has internal linkage, so that each engine keeps the copy compiled for its own instruction set.
+     */
+    static inline uint8_t scaleSum(const int32_t sum, const int32_t divisor) {
+        if (sum <= 0)
+            return 0;
+        const int32_t channel = sum / divisor;
+        if (channel > 255)
+            return 255;
+        return static_cast<uint8_t>(channel);
+    }
+
+    /**
+     * Computes a single output value in the scalar way.
+     *
+     * It is used by vectorized engines too, in order to process the columns left over by full vector steps.
+     */
+    static inline uint8_t convolvePixel(const uint8_t* input, const unsigned int inputStride, const Weights& weights) {
+        int32_t sum = 0;
+        for (unsigned int j = 0; j < weights.order; j++) {
+            for (unsigned int i = 0; i < weights.order; i++) {
+                sum += static_cast<int32_t>(input[j * inputStride + i]) * weights.numerators[j * weights.order + i];
+            }
+        }
+        return scaleSum(sum, weights.divisor);
+    }
+}
+
+
+
+#endif //FIXEDPOINTCONVOLUTION_H
@@ -0,0 +1,104 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "FixedPointConvolution.h"
+#include "RowPadding.h"
+
+#define AVX2_NARROW_STEP 16
+#define AVX2_WIDE_STEP 8
+
+// helpers have internal linkage, since each instruction set has its own translation unit
+
+/**
+ * Divides the given 32-bit sums by the divisor, truncating the quotients.
+ *
+ * The division is carried out in single precision, which is exact after truncation since
+ * the fixed-point form guarantees that sums are lower than 2^24 whenever the divisor is not one.
+ */
+static __m256i divideSums(const __m256i sums, const __m256 divisor) {
+    return _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(sums), divisor));
+}
+
+/**
+ * Packs 8 32-bit values to 8-bit unsigned integers, saturating them, into the lower half of the result.
+ */
+static __m128i packSums(const __m256i sums) {
+    const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return _mm_packus_epi16(packed, packed);
+}
+
+static void narrowConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m256 divisor = _mm256_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX2_NARROW_STEP, order, inputStride, outputStride);
+    for (; x + AVX2_NARROW_STEP <= vectorWidth; x += AVX2_NARROW_STEP) {
+        __m256i sums = _mm256_setzero_si256();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                const __m256i numerator = _mm256_set1_epi16(static_cast<int16_t>(weights.numerators[j * order + i]));
+                const __m256i values = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)));
+                sums = _mm256_add_epi16(sums, _mm256_mullo_epi16(values, numerator));
+            }
+        }
+
+        __m128i packed;
+        if (weights.divisor == 1) {
+            // packs lane by lane, so that the two halves of the result are gathered afterward
+            const __m256i saturated = _mm256_packus_epi16(sums, sums);
+            packed = _mm256_castsi256_si128(_mm256_permute4x64_epi64(saturated, 0xD8));
+        } else {
+            const __m256i sumsLow = divideSums(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(sums)), divisor);
+            const __m256i sumsHigh = divideSums(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(sums, 1)), divisor);
+            packed = _mm_packus_epi16(
+                _mm_packs_epi32(_mm256_castsi256_si128(sumsLow), _mm256_extracti128_si256(sumsLow, 1)),
+                _mm_packs_epi32(_mm256_castsi256_si128(sumsHigh), _mm256_extracti128_si256(sumsHigh, 1)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x), packed);
+    }
+}
+
+static void wideConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m256 divisor = _mm256_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX2_WIDE_STEP, order, inputStride, outputStride);
+    for (; x + AVX2_WIDE_STEP <= vectorWidth; x += AVX2_WIDE_STEP) {
+        __m256i sums = _mm256_setzero_si256();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                const __m256i numerator = _mm256_set1_epi32(weights.numerators[j * order + i]);
+                const __m256i values = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i)));
+                sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(values, numerator));
+            }
+        }
+
+        if (weights.divisor != 1)
+            sums = divideSums(sums, divisor);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + y * outputStride + x), packSums(sums));
+    }
+}
+
+void FixedPointConvolution::avx2(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        if (weights.isNarrow)
+            narrowConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        else
+            wideConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights);
+        }
+    }
+}
+#endif
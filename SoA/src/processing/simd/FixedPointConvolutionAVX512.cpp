@@ -0,0 +1,96 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "FixedPointConvolution.h"
+#include "RowPadding.h"
+
+#define AVX512_NARROW_STEP 32
+#define AVX512_WIDE_STEP 16
+
+// helpers have internal linkage, since each instruction set has its own translation unit
+
+/**
+ * Divides the given 32-bit sums by the divisor, truncating the quotients, and clamps them to 8-bit unsigned integers.
+ *
+ * The division is carried out in single precision, which is exact after truncation since
+ * the fixed-point form guarantees that sums are lower than 2^24 whenever the divisor is not one.
+ */
+static __m128i divideAndPackSums(__m512i sums, const __m512 divisor, const bool hasDivisor) {
+    if (hasDivisor)
+        sums = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(sums), divisor));
+    sums = _mm512_min_epi32(_mm512_max_epi32(sums, _mm512_setzero_si512()), _mm512_set1_epi32(255));
+    return _mm512_cvtepi32_epi8(sums);
+}
+
+static void narrowConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m512 divisor = _mm512_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX512_NARROW_STEP, order, inputStride, outputStride);
+    for (; x + AVX512_NARROW_STEP <= vectorWidth; x += AVX512_NARROW_STEP) {
+        __m512i sums = _mm512_setzero_si512();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                const __m512i numerator = _mm512_set1_epi16(static_cast<int16_t>(weights.numerators[j * order + i]));
+                const __m512i values =
+                    _mm512_cvtepu8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i)));
+                sums = _mm512_add_epi16(sums, _mm512_mullo_epi16(values, numerator));
+            }
+        }
+
+        uint8_t* outputRow = output + y * outputStride + x;
+        if (weights.divisor == 1) {
+            sums = _mm512_min_epi16(_mm512_max_epi16(sums, _mm512_setzero_si512()), _mm512_set1_epi16(255));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputRow), _mm512_cvtepi16_epi8(sums));
+        } else {
+            const __m512i sumsLow = _mm512_cvtepi16_epi32(_mm512_castsi512_si256(sums));
+            const __m512i sumsHigh = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(sums, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outputRow), divideAndPackSums(sumsLow, divisor, true));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outputRow + 16), divideAndPackSums(sumsHigh, divisor, true));
+        }
+    }
+}
+
+static void wideConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m512 divisor = _mm512_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX512_WIDE_STEP, order, inputStride, outputStride);
+    for (; x + AVX512_WIDE_STEP <= vectorWidth; x += AVX512_WIDE_STEP) {
+        __m512i sums = _mm512_setzero_si512();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                const __m512i numerator = _mm512_set1_epi32(weights.numerators[j * order + i]);
+                const __m512i values = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)));
+                sums = _mm512_add_epi32(sums, _mm512_mullo_epi32(values, numerator));
+            }
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+            divideAndPackSums(sums, divisor, weights.divisor != 1));
+    }
+}
+
+void FixedPointConvolution::avx512(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        if (weights.isNarrow)
+            narrowConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        else
+            wideConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights);
+        }
+    }
+}
+#endif
@@ -0,0 +1,94 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <cstring>
+#include <immintrin.h>
+
+#include "FixedPointConvolution.h"
+#include "RowPadding.h"
+
+#define SSE42_NARROW_STEP 8
+#define SSE42_WIDE_STEP 4
+
+// helpers have internal linkage, since each instruction set has its own translation unit
+
+/**
+ * Divides the given 32-bit sums by the divisor, truncating the quotients.
+ *
+ * The division is carried out in single precision, which is exact after truncation since
+ * the fixed-point form guarantees that sums are lower than 2^24 whenever the divisor is not one.
+ */
+static __m128i divideSums(const __m128i sums, const __m128 divisor) {
+    return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sums), divisor));
+}
+
+static void narrowConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m128 divisor = _mm_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, SSE42_NARROW_STEP, order, inputStride, outputStride);
+    for (; x + SSE42_NARROW_STEP <= vectorWidth; x += SSE42_NARROW_STEP) {
+        __m128i sums = _mm_setzero_si128();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                const __m128i numerator = _mm_set1_epi16(static_cast<int16_t>(weights.numerators[j * order + i]));
+                const __m128i values = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i)));
+                sums = _mm_add_epi16(sums, _mm_mullo_epi16(values, numerator));
+            }
+        }
+
+        if (weights.divisor != 1) {
+            const __m128i sumsLow = divideSums(_mm_cvtepi16_epi32(sums), divisor);
+            const __m128i sumsHigh = divideSums(_mm_cvtepi16_epi32(_mm_srli_si128(sums, 8)), divisor);
+            sums = _mm_packs_epi32(sumsLow, sumsHigh);
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + y * outputStride + x), _mm_packus_epi16(sums, sums));
+    }
+}
+
+static void wideConvolution(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int y, unsigned int& x,
+    const FixedPointConvolution::Weights &weights) {
+    const unsigned int order = weights.order;
+    const __m128 divisor = _mm_set1_ps(static_cast<float>(weights.divisor));
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, SSE42_WIDE_STEP, order, inputStride, outputStride);
+    for (; x + SSE42_WIDE_STEP <= vectorWidth; x += SSE42_WIDE_STEP) {
+        __m128i sums = _mm_setzero_si128();
+        for (unsigned int j = 0; j < order; j++) {
+            const uint8_t* row = input + (y + j) * inputStride + x;
+            for (unsigned int i = 0; i < order; i++) {
+                int32_t fourValues;
+                std::memcpy(&fourValues, row + i, sizeof(fourValues));
+                const __m128i numerator = _mm_set1_epi32(weights.numerators[j * order + i]);
+                const __m128i values = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(fourValues));
+                sums = _mm_add_epi32(sums, _mm_mullo_epi32(values, numerator));
+            }
+        }
+
+        if (weights.divisor != 1)
+            sums = divideSums(sums, divisor);
+        const __m128i packed = _mm_packs_epi32(sums, sums);
+        const int32_t fourChannels = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+        std::memcpy(output + y * outputStride + x, &fourChannels, sizeof(fourChannels));
+    }
+}
+
+void FixedPointConvolution::sse42(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        if (weights.isNarrow)
+            narrowConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        else
+            wideConvolution(input, inputStride, output, outputStride, outputWidth, y, x, weights);
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights);
+        }
+    }
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef FORWARDDCT_H
+#define FORWARDDCT_H
+#include <cstdint>
+
+#include "InstructionSet.h"
+
+
+/**
+ * Namespace for the forward DCT and quantization of the 8x8 blocks of a JPEG image, with the arithmetic of the stb
+ * encoder: the AAN floating-point transform of the rows, then of the columns, followed by the multiplication by
+ * the scaled quantization table and the rounding half away from zero.
+ *
+ * Each transform is provided by a scalar engine and by engines transforming all the rows, then all the columns,
+ * of a block at once with SSE (4 lanes per vector) and AVX (8 lanes per vector) instructions, selected at runtime
+ * as the convolution engines. Vector engines run the same single precision operations in the same order as the
+ * scalar one, and their translation units are compiled without contracting them into fused multiply-adds, so all
+ * engines produce the same coefficients as `stbi_write_jpg`.
+ */
+namespace ForwardDct {
+    /**
+     * Signature shared by all transform engines, which transform and quantize a block.
+     *
+     * @param block The 8 rows of 8 values of the block, stride values apart, e.g. luma values centered on zero.
+     * @param stride The distance between consecutive rows of the block.
+     * @param table The 64 reciprocals of the quantization steps, scaled for the transform, by rows.
+     * @param coefficients The 64 quantized coefficients, by rows, i.e. in natural rather than zigzag order.
+     */
+    using TransformFunction = void (*)(const float* block, unsigned int stride, const float* table,
+        int* coefficients);
+
+    /**
+     * Portable transform engine, which transforms one row or column at a time.
+     */
+    void transformScalar(const float* block, unsigned int stride, const float* table, int* coefficients);
+
+    /**
+     * SSE transform engine, which transforms the rows and the columns of each half of the block in 4 lanes,
+     * transposing 4x4 tiles between the two passes.
+     */
+    void transformSSE42(const float* block, unsigned int stride, const float* table, int* coefficients);
+
+    /**
+     * AVX transform engine, which transforms the 8 rows, then the 8 columns, in 8 lanes, transposing the block
+     * before and after the first pass.
+     */
+    void transformAVX2(const float* block, unsigned int stride, const float* table, int* coefficients);
+
+    /**
+     * Retrieves the transform engine specialized for the given instruction set; AVX-512 uses the AVX one,
+     * since a block row fills exactly 8 lanes.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @return The transform engine, or the scalar one if the platform has no such specialization.
+     */
+    TransformFunction selectTransform(InstructionSet instructionSet);
+}
+
+
+
+#endif //FORWARDDCT_H
@@ -0,0 +1,100 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "ForwardDct.h"
+
+#define BLOCK_SIZE 8
+
+/**
+ * Transforms 8 vectors lane by lane, with the operations of stbiw__jpg_DCT.
+ */
+static void transformVectors(__m256* d) {
+    const __m256 tmp0 = _mm256_add_ps(d[0], d[7]);
+    const __m256 tmp7 = _mm256_sub_ps(d[0], d[7]);
+    const __m256 tmp1 = _mm256_add_ps(d[1], d[6]);
+    const __m256 tmp6 = _mm256_sub_ps(d[1], d[6]);
+    const __m256 tmp2 = _mm256_add_ps(d[2], d[5]);
+    const __m256 tmp5 = _mm256_sub_ps(d[2], d[5]);
+    const __m256 tmp3 = _mm256_add_ps(d[3], d[4]);
+    const __m256 tmp4 = _mm256_sub_ps(d[3], d[4]);
+
+    // even part
+    const __m256 tmp10 = _mm256_add_ps(tmp0, tmp3);
+    const __m256 tmp13 = _mm256_sub_ps(tmp0, tmp3);
+    const __m256 tmp11 = _mm256_add_ps(tmp1, tmp2);
+    const __m256 tmp12 = _mm256_sub_ps(tmp1, tmp2);
+    d[0] = _mm256_add_ps(tmp10, tmp11);
+    d[4] = _mm256_sub_ps(tmp10, tmp11);
+    const __m256 z1 = _mm256_mul_ps(_mm256_add_ps(tmp12, tmp13), _mm256_set1_ps(0.707106781f));
+    d[2] = _mm256_add_ps(tmp13, z1);
+    d[6] = _mm256_sub_ps(tmp13, z1);
+
+    // odd part
+    const __m256 odd10 = _mm256_add_ps(tmp4, tmp5);
+    const __m256 odd11 = _mm256_add_ps(tmp5, tmp6);
+    const __m256 odd12 = _mm256_add_ps(tmp6, tmp7);
+    const __m256 z5 = _mm256_mul_ps(_mm256_sub_ps(odd10, odd12), _mm256_set1_ps(0.382683433f));
+    const __m256 z2 = _mm256_add_ps(_mm256_mul_ps(odd10, _mm256_set1_ps(0.541196100f)), z5);
+    const __m256 z4 = _mm256_add_ps(_mm256_mul_ps(odd12, _mm256_set1_ps(1.306562965f)), z5);
+    const __m256 z3 = _mm256_mul_ps(odd11, _mm256_set1_ps(0.707106781f));
+    const __m256 z11 = _mm256_add_ps(tmp7, z3);
+    const __m256 z13 = _mm256_sub_ps(tmp7, z3);
+    d[5] = _mm256_add_ps(z13, z2);
+    d[3] = _mm256_sub_ps(z13, z2);
+    d[1] = _mm256_add_ps(z11, z4);
+    d[7] = _mm256_sub_ps(z11, z4);
+}
+
+/**
+ * Transposes 8 vectors of 8 lanes, i.e. an 8x8 block stored by rows.
+ */
+static void transpose(__m256* rows) {
+    const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    rows[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+    rows[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+    rows[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+    rows[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+    rows[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    rows[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    rows[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    rows[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+void ForwardDct::transformAVX2(const float *block, const unsigned int stride, const float *table,
+    int *coefficients) {
+    __m256 vectors[BLOCK_SIZE];
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++)
+        vectors[y] = _mm256_loadu_ps(block + y * stride);
+
+    // the rows are transformed as the lanes of transposed vectors, then the columns as the lanes of the rows
+    transpose(vectors);
+    transformVectors(vectors);
+    transpose(vectors);
+    transformVectors(vectors);
+
+    // adding a half with the sign of the value, then truncating, rounds half away from zero
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++) {
+        const __m256 values = _mm256_mul_ps(vectors[y], _mm256_loadu_ps(table + y * BLOCK_SIZE));
+        const __m256 rounded = _mm256_add_ps(values, _mm256_or_ps(half, _mm256_and_ps(values, signMask)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(coefficients + y * BLOCK_SIZE), _mm256_cvttps_epi32(rounded));
+    }
+}
+
+#endif
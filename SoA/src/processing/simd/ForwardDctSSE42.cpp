@@ -0,0 +1,117 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "ForwardDct.h"
+
+#define BLOCK_SIZE 8
+#define SSE42_STEP 4
+
+/**
+ * Transforms 8 vectors lane by lane, with the operations of stbiw__jpg_DCT.
+ */
+static void transformVectors(__m128* d) {
+    const __m128 tmp0 = _mm_add_ps(d[0], d[7]);
+    const __m128 tmp7 = _mm_sub_ps(d[0], d[7]);
+    const __m128 tmp1 = _mm_add_ps(d[1], d[6]);
+    const __m128 tmp6 = _mm_sub_ps(d[1], d[6]);
+    const __m128 tmp2 = _mm_add_ps(d[2], d[5]);
+    const __m128 tmp5 = _mm_sub_ps(d[2], d[5]);
+    const __m128 tmp3 = _mm_add_ps(d[3], d[4]);
+    const __m128 tmp4 = _mm_sub_ps(d[3], d[4]);
+
+    // even part
+    const __m128 tmp10 = _mm_add_ps(tmp0, tmp3);
+    const __m128 tmp13 = _mm_sub_ps(tmp0, tmp3);
+    const __m128 tmp11 = _mm_add_ps(tmp1, tmp2);
+    const __m128 tmp12 = _mm_sub_ps(tmp1, tmp2);
+    d[0] = _mm_add_ps(tmp10, tmp11);
+    d[4] = _mm_sub_ps(tmp10, tmp11);
+    const __m128 z1 = _mm_mul_ps(_mm_add_ps(tmp12, tmp13), _mm_set1_ps(0.707106781f));
+    d[2] = _mm_add_ps(tmp13, z1);
+    d[6] = _mm_sub_ps(tmp13, z1);
+
+    // odd part
+    const __m128 odd10 = _mm_add_ps(tmp4, tmp5);
+    const __m128 odd11 = _mm_add_ps(tmp5, tmp6);
+    const __m128 odd12 = _mm_add_ps(tmp6, tmp7);
+    const __m128 z5 = _mm_mul_ps(_mm_sub_ps(odd10, odd12), _mm_set1_ps(0.382683433f));
+    const __m128 z2 = _mm_add_ps(_mm_mul_ps(odd10, _mm_set1_ps(0.541196100f)), z5);
+    const __m128 z4 = _mm_add_ps(_mm_mul_ps(odd12, _mm_set1_ps(1.306562965f)), z5);
+    const __m128 z3 = _mm_mul_ps(odd11, _mm_set1_ps(0.707106781f));
+    const __m128 z11 = _mm_add_ps(tmp7, z3);
+    const __m128 z13 = _mm_sub_ps(tmp7, z3);
+    d[5] = _mm_add_ps(z13, z2);
+    d[3] = _mm_sub_ps(z13, z2);
+    d[1] = _mm_add_ps(z11, z4);
+    d[7] = _mm_sub_ps(z11, z4);
+}
+
+/**
+ * Transposes the 4x4 tiles of a block stored as 8 rows of a left and a right half, i.e. left[y] and right[y] hold
+ * the columns 0 to 3 and 4 to 7 of row y, into vectors holding 4 rows of a column, i.e. columns[g][x] holds the
+ * rows 4g to 4g + 3 of column x.
+ */
+static void transposeTiles(__m128* left, __m128* right, __m128 columns[2][BLOCK_SIZE]) {
+    for (unsigned int g = 0; g < 2; g++) {
+        for (unsigned int h = 0; h < 2; h++) {
+            __m128* halves = h == 0 ? left : right;
+            __m128 r0 = halves[4 * g], r1 = halves[4 * g + 1], r2 = halves[4 * g + 2], r3 = halves[4 * g + 3];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            columns[g][4 * h] = r0;
+            columns[g][4 * h + 1] = r1;
+            columns[g][4 * h + 2] = r2;
+            columns[g][4 * h + 3] = r3;
+        }
+    }
+}
+
+/**
+ * Transposes vectors holding 4 rows of a column back into the left and right halves of the rows.
+ */
+static void transposeColumns(__m128 columns[2][BLOCK_SIZE], __m128* left, __m128* right) {
+    for (unsigned int g = 0; g < 2; g++) {
+        for (unsigned int h = 0; h < 2; h++) {
+            __m128 r0 = columns[g][4 * h], r1 = columns[g][4 * h + 1], r2 = columns[g][4 * h + 2];
+            __m128 r3 = columns[g][4 * h + 3];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            __m128* halves = h == 0 ? left : right;
+            halves[4 * g] = r0;
+            halves[4 * g + 1] = r1;
+            halves[4 * g + 2] = r2;
+            halves[4 * g + 3] = r3;
+        }
+    }
+}
+
+void ForwardDct::transformSSE42(const float *block, const unsigned int stride, const float *table,
+    int *coefficients) {
+    __m128 left[BLOCK_SIZE], right[BLOCK_SIZE];
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++) {
+        left[y] = _mm_loadu_ps(block + y * stride);
+        right[y] = _mm_loadu_ps(block + y * stride + SSE42_STEP);
+    }
+
+    // the rows are transformed as the lanes of transposed tiles, 4 rows at a time, then the columns as the lanes
+    // of the halves of the rows
+    __m128 columns[2][BLOCK_SIZE];
+    transposeTiles(left, right, columns);
+    transformVectors(columns[0]);
+    transformVectors(columns[1]);
+    transposeColumns(columns, left, right);
+    transformVectors(left);
+    transformVectors(right);
+
+    // adding a half with the sign of the value, then truncating, rounds half away from zero
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++) {
+        for (unsigned int h = 0; h < 2; h++) {
+            const unsigned int pos = y * BLOCK_SIZE + h * SSE42_STEP;
+            const __m128 values = _mm_mul_ps(h == 0 ? left[y] : right[y], _mm_loadu_ps(table + pos));
+            const __m128 rounded = _mm_add_ps(values, _mm_or_ps(half, _mm_and_ps(values, signMask)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(coefficients + pos), _mm_cvttps_epi32(rounded));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "ForwardDct.h"
+
+#define BLOCK_SIZE 8
+
+/**
+ * Transforms the 8 values the given distance apart, with the operations of stbiw__jpg_DCT.
+ */
+static void transformValues(float* values, const unsigned int distance) {
+    const float d0 = values[0], d1 = values[distance], d2 = values[2 * distance], d3 = values[3 * distance];
+    const float d4 = values[4 * distance], d5 = values[5 * distance], d6 = values[6 * distance];
+    const float d7 = values[7 * distance];
+
+    const float tmp0 = d0 + d7;
+    const float tmp7 = d0 - d7;
+    const float tmp1 = d1 + d6;
+    const float tmp6 = d1 - d6;
+    const float tmp2 = d2 + d5;
+    const float tmp5 = d2 - d5;
+    const float tmp3 = d3 + d4;
+    const float tmp4 = d3 - d4;
+
+    // even part
+    const float tmp10 = tmp0 + tmp3;
+    const float tmp13 = tmp0 - tmp3;
+    const float tmp11 = tmp1 + tmp2;
+    const float tmp12 = tmp1 - tmp2;
+    values[0] = tmp10 + tmp11;
+    values[4 * distance] = tmp10 - tmp11;
+    const float z1 = (tmp12 + tmp13) * 0.707106781f;
+    values[2 * distance] = tmp13 + z1;
+    values[6 * distance] = tmp13 - z1;
+
+    // odd part
+    const float odd10 = tmp4 + tmp5;
+    const float odd11 = tmp5 + tmp6;
+    const float odd12 = tmp6 + tmp7;
+    const float z5 = (odd10 - odd12) * 0.382683433f;
+    const float z2 = odd10 * 0.541196100f + z5;
+    const float z4 = odd12 * 1.306562965f + z5;
+    const float z3 = odd11 * 0.707106781f;
+    const float z11 = tmp7 + z3;
+    const float z13 = tmp7 - z3;
+    values[5 * distance] = z13 + z2;
+    values[3 * distance] = z13 - z2;
+    values[distance] = z11 + z4;
+    values[7 * distance] = z11 - z4;
+}
+
+void ForwardDct::transformScalar(const float *block, const unsigned int stride, const float *table,
+    int *coefficients) {
+    float values[BLOCK_SIZE * BLOCK_SIZE];
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++) {
+        for (unsigned int x = 0; x < BLOCK_SIZE; x++)
+            values[y * BLOCK_SIZE + x] = block[y * stride + x];
+    }
+
+    for (unsigned int y = 0; y < BLOCK_SIZE; y++)
+        transformValues(values + y * BLOCK_SIZE, 1);
+    for (unsigned int x = 0; x < BLOCK_SIZE; x++)
+        transformValues(values + x, BLOCK_SIZE);
+    for (unsigned int k = 0; k < BLOCK_SIZE * BLOCK_SIZE; k++) {
+        const float value = values[k] * table[k];
+        coefficients[k] = static_cast<int>(value < 0 ? value - 0.5f : value + 0.5f);
+    }
+}
+
+ForwardDct::TransformFunction ForwardDct::selectTransform(const InstructionSet instructionSet) {
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return transformSSE42;
+        case InstructionSet::avx2:
+        case InstructionSet::avx512:
+            return transformAVX2;
+        default:
+            return transformScalar;
+    }
+#else
+    return transformScalar;
+#endif
+}
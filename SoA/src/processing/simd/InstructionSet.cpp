@@ -0,0 +1,94 @@
+#include "InstructionSet.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define X86_64_PLATFORM
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#ifdef X86_64_PLATFORM
+#define SSE42_ECX_BIT (1u << 20)
+#define FMA_ECX_BIT (1u << 12)
+#define OSXSAVE_ECX_BIT (1u << 27)
+#define AVX_ECX_BIT (1u << 28)
+#define AVX2_EBX_BIT (1u << 5)
+#define AVX512F_EBX_BIT (1u << 16)
+#define AVX512BW_EBX_BIT (1u << 30)
+#define XCR0_YMM_STATE 0x06u
+#define XCR0_ZMM_STATE 0xE6u
+
+void cpuid(const unsigned int leaf, const unsigned int subleaf, unsigned int registers[4]) {
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (unsigned int k = 0; k < 4; k++)
+        registers[k] = static_cast<unsigned int>(values[k]);
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+unsigned int readXCR0() {
+#if defined(_MSC_VER)
+    return static_cast<unsigned int>(_xgetbv(0));
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+#endif
+}
+
+InstructionSet detectOnce() {
+    unsigned int registers[4];
+    cpuid(0, 0, registers);
+    const unsigned int maxLeaf = registers[0];
+
+    cpuid(1, 0, registers);
+    const unsigned int ecx = registers[2];
+    if (!(ecx & SSE42_ECX_BIT))
+        return InstructionSet::scalar;
+    // AVX registers must also be saved by the operating system on context switches
+    if (!(ecx & OSXSAVE_ECX_BIT) || !(ecx & AVX_ECX_BIT) || !(ecx & FMA_ECX_BIT) || maxLeaf < 7)
+        return InstructionSet::sse42;
+    const unsigned int xcr0 = readXCR0();
+    if ((xcr0 & XCR0_YMM_STATE) != XCR0_YMM_STATE)
+        return InstructionSet::sse42;
+
+    cpuid(7, 0, registers);
+    const unsigned int ebx = registers[1];
+    if (!(ebx & AVX2_EBX_BIT))
+        return InstructionSet::sse42;
+    if (!(ebx & AVX512F_EBX_BIT) || !(ebx & AVX512BW_EBX_BIT) || (xcr0 & XCR0_ZMM_STATE) != XCR0_ZMM_STATE)
+        return InstructionSet::avx2;
+    return InstructionSet::avx512;
+}
+#else
+InstructionSet detectOnce() {
+    return InstructionSet::scalar;
+}
+#endif
+
+InstructionSet InstructionSets::detect() {
+    static const InstructionSet detected = detectOnce();
+    return detected;
+}
+
+bool InstructionSets::isSupported(const InstructionSet instructionSet) {
+    return static_cast<int>(instructionSet) <= static_cast<int>(detect());
+}
+
+std::string InstructionSets::getName(const InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return "SSE4.2";
+        case InstructionSet::avx2:
+            return "AVX2";
+        case InstructionSet::avx512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
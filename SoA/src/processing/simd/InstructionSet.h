@@ -0,0 +1,48 @@
+#ifndef INSTRUCTIONSET_H
+#define INSTRUCTIONSET_H
+#include <string>
+
+
+/**
+ * Enumerates the instruction set extensions for which vectorized engines are available,
+ * ordered from the least to the most powerful.
+ */
+enum class InstructionSet {
+    scalar,
+    sse42,
+    avx2,
+    avx512
+};
+
+/**
+ * Namespace for the runtime detection of the instruction set extensions supported by the CPU.
+ */
+namespace InstructionSets {
+    /**
+     * Detects the most powerful instruction set supported by both the CPU and the operating system,
+     * by means of the CPUID instruction. The detection is performed only once.
+     *
+     * @return The most powerful supported instruction set, or @ref InstructionSet::scalar on non-x86 platforms.
+     */
+    InstructionSet detect();
+
+    /**
+     * Checks whether the given instruction set can be used on the running machine.
+     *
+     * @param instructionSet The instruction set to check.
+     * @return True if the instruction set is supported, false otherwise.
+     */
+    bool isSupported(InstructionSet instructionSet);
+
+    /**
+     * Retrieves a human-readable name of the given instruction set.
+     *
+     * @param instructionSet The instruction set.
+     * @return A string representing the name of the instruction set.
+     */
+    std::string getName(InstructionSet instructionSet);
+}
+
+
+
+#endif //INSTRUCTIONSET_H
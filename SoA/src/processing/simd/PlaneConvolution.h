@@ -0,0 +1,184 @@
+#ifndef PLANECONVOLUTION_H
+#define PLANECONVOLUTION_H
+#include <cstdint>
+
+#include "InstructionSet.h"
+#include "processing/sparse/SparseKernel.h"
+
+
+/**
+ * Namespace for the convolution engines working on a single channel plane,
+ * each of them specialized for an instruction set.
+ *
+ * All engines compute the output rows in the range [rowBegin, rowEnd) of a cropped convolution,
+ * i.e. the output plane is narrower than the input one by (order - 1) columns.
+ * Products are summed by rows of the kernel and then by columns, as in the scalar engine.
+ * When the row strides leave room for it, vectorized engines compute the last partial step of each row
+ * by vectors too, reading and writing the padding after the rows: see @ref RowPadding::getVectorWidth.
+ */
+namespace PlaneConvolution {
+    /**
+     * Signature shared by all plane convolution engines.
+     *
+     * @param input The input channel plane.
+     * @param inputStride The distance between consecutive rows of the input plane, at least outputWidth + order - 1.
+     * @param output The output channel plane.
+     * @param outputStride The distance between consecutive rows of the output plane, at least outputWidth.
+     * @param outputWidth The width of the output plane, i.e. the number of columns to compute.
+     * @param rowBegin The first output row to compute.
+     * @param rowEnd The output row after the last one to compute.
+     * @param weights The kernel weights, stored by rows.
+     * @param order The order of the kernel.
+     */
+    using Function = void (*)(const uint8_t* input, unsigned int inputStride, uint8_t* output,
+        unsigned int outputStride, unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd,
+        const float* weights, unsigned int order);
+
+    /**
+     * Portable engine computing one output value at a time.
+     */
+    void scalar(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const float* weights,
+        unsigned int order);
+
+    /**
+     * SSE4.2 engine computing 8 output values per step, with separate multiply and add
+     * so that results are bit-identical to the scalar engine.
+     */
+    void sse42(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const float* weights,
+        unsigned int order);
+
+    /**
+     * AVX2 engine computing 16 output values per step by means of fused multiply-add.
+     */
+    void avx2(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const float* weights,
+        unsigned int order);
+
+    /**
+     * AVX-512 engine computing 16 output values per step by means of fused multiply-add.
+     */
+    void avx512(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const float* weights,
+        unsigned int order);
+
+    /**
+     * Retrieves the engine specialized for the given instruction set.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @return The plane convolution engine, or the scalar one if the platform has no such specialization.
+     */
+    Function select(InstructionSet instructionSet);
+
+    /**
+     * Signature shared by all sparse plane convolution engines, which read only the non-zero weights of a kernel.
+     *
+     * Products are summed in the same order as in the dense engine of the same instruction set and,
+     * since skipped products are zero, results are bit-identical to it.
+     *
+     * @param input The input channel plane.
+     * @param inputStride The distance between consecutive rows of the input plane, at least outputWidth + order - 1.
+     * @param output The output channel plane.
+     * @param outputStride The distance between consecutive rows of the output plane, at least outputWidth.
+     * @param outputWidth The width of the output plane, i.e. the number of columns to compute.
+     * @param rowBegin The first output row to compute.
+     * @param rowEnd The output row after the last one to compute.
+     * @param taps The taps of the non-zero weights, whose offsets refer to inputStride.
+     * @param numTaps The number of taps.
+     */
+    using SparseFunction = void (*)(const uint8_t* input, unsigned int inputStride, uint8_t* output,
+        unsigned int outputStride, unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd,
+        const SparseKernel::Tap* taps, unsigned int numTaps);
+
+    /**
+     * Portable sparse engine computing one output value at a time.
+     */
+    void sparseScalar(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const SparseKernel::Tap* taps,
+        unsigned int numTaps);
+
+    /**
+     * SSE4.2 sparse engine computing 8 output values per step.
+     */
+    void sparseSse42(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const SparseKernel::Tap* taps,
+        unsigned int numTaps);
+
+    /**
+     * AVX2 sparse engine computing 16 output values per step.
+     */
+    void sparseAvx2(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const SparseKernel::Tap* taps,
+        unsigned int numTaps);
+
+    /**
+     * AVX-512 sparse engine computing 16 output values per step.
+     */
+    void sparseAvx512(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const SparseKernel::Tap* taps,
+        unsigned int numTaps);
+
+    /**
+     * Retrieves the sparse engine specialized for the given instruction set.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @return The sparse plane convolution engine, or the scalar one if the platform has no such specialization.
+     */
+    SparseFunction selectSparse(InstructionSet instructionSet);
+
+    /**
+     * Computes a single output value in the scalar way.
+     *
+     * It is used by vectorized engines too, in order to process the columns left over by full vector steps.
+     * It has internal linkage, so that each engine keeps the copy compiled for its own instruction set.
+     */
+    static inline uint8_t convolvePixel(const uint8_t* input, const unsigned int inputStride, const float* weights,
+        const unsigned int order) {
+        float channel = 0;
+        for (unsigned int j = 0; j < order; j++) {
+            for (unsigned int i = 0; i < order; i++) {
+                channel += static_cast<float>(input[j * inputStride + i]) * weights[j * order + i];
+            }
+        }
+        if (channel < 0)
+            return 0;
+        if (channel > 255)
+            return 255;
+        return static_cast<uint8_t>(channel);
+    }
+
+    /**
+     * Retrieves the number of input columns read for each output value by the given taps,
+     * i.e. the order of the kernel when its last column has a non-zero weight.
+     */
+    static inline unsigned int getTapsExtent(const SparseKernel::Tap* taps, const unsigned int numTaps,
+        const unsigned int inputStride) {
+        unsigned int extent = 1;
+        for (unsigned int t = 0; t < numTaps; t++) {
+            if (taps[t].offset % inputStride + 1 > extent)
+                extent = taps[t].offset % inputStride + 1;
+        }
+        return extent;
+    }
+
+    /**
+     * Computes a single output value in the scalar way, reading only the given taps.
+     */
+    static inline uint8_t convolveSparsePixel(const uint8_t* input, const SparseKernel::Tap* taps,
+        const unsigned int numTaps) {
+        float channel = 0;
+        for (unsigned int t = 0; t < numTaps; t++) {
+            channel += static_cast<float>(input[taps[t].offset]) * taps[t].weight;
+        }
+        if (channel < 0)
+            return 0;
+        if (channel > 255)
+            return 255;
+        return static_cast<uint8_t>(channel);
+    }
+}
+
+
+
+#endif //PLANECONVOLUTION_H
@@ -0,0 +1,95 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "PlaneConvolution.h"
+#include "RowPadding.h"
+
+#define AVX2_STEP 16
+
+void PlaneConvolution::avx2(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const float *weights, const unsigned int order) {
+    const __m256 minValue = _mm256_setzero_ps();
+    const __m256 maxValue = _mm256_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, AVX2_STEP, order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX2_STEP <= vectorWidth; x += AVX2_STEP) {
+            __m256 channelLow = _mm256_setzero_ps();
+            __m256 channelHigh = _mm256_setzero_ps();
+
+            for (unsigned int j = 0; j < order; j++) {
+                const uint8_t* row = input + (y + j) * inputStride + x;
+                for (unsigned int i = 0; i < order; i++) {
+                    const __m256 kernelWeight = _mm256_set1_ps(weights[j * order + i]);
+                    // widen 16 values to two vectors of 8 floats
+                    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+                    const __m256 valuesLow = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+                    const __m256 valuesHigh = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+                    channelLow = _mm256_fmadd_ps(valuesLow, kernelWeight, channelLow);
+                    channelHigh = _mm256_fmadd_ps(valuesHigh, kernelWeight, channelHigh);
+                }
+            }
+
+            // clamp, truncate and pack to 8-bit unsigned integers
+            channelLow = _mm256_min_ps(_mm256_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm256_min_ps(_mm256_max_ps(channelHigh, minValue), maxValue);
+            const __m256i integersLow = _mm256_cvttps_epi32(channelLow);
+            const __m256i integersHigh = _mm256_cvttps_epi32(channelHigh);
+            const __m128i packedLow = _mm_packus_epi32(_mm256_castsi256_si128(integersLow),
+                _mm256_extracti128_si256(integersLow, 1));
+            const __m128i packedHigh = _mm_packus_epi32(_mm256_castsi256_si128(integersHigh),
+                _mm256_extracti128_si256(integersHigh, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+                _mm_packus_epi16(packedLow, packedHigh));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights, order);
+        }
+    }
+}
+
+void PlaneConvolution::sparseAvx2(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const SparseKernel::Tap *taps, const unsigned int numTaps) {
+    const __m256 minValue = _mm256_setzero_ps();
+    const __m256 maxValue = _mm256_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, AVX2_STEP,
+        getTapsExtent(taps, numTaps, inputStride), inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX2_STEP <= vectorWidth; x += AVX2_STEP) {
+            __m256 channelLow = _mm256_setzero_ps();
+            __m256 channelHigh = _mm256_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (unsigned int t = 0; t < numTaps; t++) {
+                const __m256 kernelWeight = _mm256_set1_ps(taps[t].weight);
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corner + taps[t].offset));
+                const __m256 valuesLow = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+                const __m256 valuesHigh = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)));
+                channelLow = _mm256_fmadd_ps(valuesLow, kernelWeight, channelLow);
+                channelHigh = _mm256_fmadd_ps(valuesHigh, kernelWeight, channelHigh);
+            }
+
+            channelLow = _mm256_min_ps(_mm256_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm256_min_ps(_mm256_max_ps(channelHigh, minValue), maxValue);
+            const __m256i integersLow = _mm256_cvttps_epi32(channelLow);
+            const __m256i integersHigh = _mm256_cvttps_epi32(channelHigh);
+            const __m128i packedLow = _mm_packus_epi32(_mm256_castsi256_si128(integersLow),
+                _mm256_extracti128_si256(integersLow, 1));
+            const __m128i packedHigh = _mm_packus_epi32(_mm256_castsi256_si128(integersHigh),
+                _mm256_extracti128_si256(integersHigh, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+                _mm_packus_epi16(packedLow, packedHigh));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolveSparsePixel(input + y * inputStride + x, taps, numTaps);
+        }
+    }
+}
+#endif
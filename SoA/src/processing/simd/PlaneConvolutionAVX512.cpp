@@ -0,0 +1,73 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "PlaneConvolution.h"
+#include "RowPadding.h"
+
+#define AVX512_STEP 16
+
+void PlaneConvolution::avx512(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const float *weights, const unsigned int order) {
+    const __m512 minValue = _mm512_setzero_ps();
+    const __m512 maxValue = _mm512_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, AVX512_STEP, order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX512_STEP <= vectorWidth; x += AVX512_STEP) {
+            __m512 channel = _mm512_setzero_ps();
+
+            for (unsigned int j = 0; j < order; j++) {
+                const uint8_t* row = input + (y + j) * inputStride + x;
+                for (unsigned int i = 0; i < order; i++) {
+                    // widen 16 values to a vector of 16 floats
+                    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+                    const __m512 valuesWidened = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(values));
+                    channel = _mm512_fmadd_ps(valuesWidened, _mm512_set1_ps(weights[j * order + i]), channel);
+                }
+            }
+
+            // clamp, truncate and narrow to 8-bit unsigned integers
+            channel = _mm512_min_ps(_mm512_max_ps(channel, minValue), maxValue);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+                _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(channel)));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights, order);
+        }
+    }
+}
+
+void PlaneConvolution::sparseAvx512(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const SparseKernel::Tap *taps, const unsigned int numTaps) {
+    const __m512 minValue = _mm512_setzero_ps();
+    const __m512 maxValue = _mm512_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, AVX512_STEP,
+        getTapsExtent(taps, numTaps, inputStride), inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX512_STEP <= vectorWidth; x += AVX512_STEP) {
+            __m512 channel = _mm512_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (unsigned int t = 0; t < numTaps; t++) {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corner + taps[t].offset));
+                const __m512 valuesWidened = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(values));
+                channel = _mm512_fmadd_ps(valuesWidened, _mm512_set1_ps(taps[t].weight), channel);
+            }
+
+            channel = _mm512_min_ps(_mm512_max_ps(channel, minValue), maxValue);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+                _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(channel)));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolveSparsePixel(input + y * inputStride + x, taps, numTaps);
+        }
+    }
+}
+#endif
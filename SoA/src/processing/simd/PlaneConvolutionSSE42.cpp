@@ -0,0 +1,83 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+
+#include "PlaneConvolution.h"
+#include "RowPadding.h"
+
+#define SSE42_STEP 8
+
+void PlaneConvolution::sse42(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const float *weights, const unsigned int order) {
+    const __m128 minValue = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, SSE42_STEP, order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + SSE42_STEP <= vectorWidth; x += SSE42_STEP) {
+            __m128 channelLow = _mm_setzero_ps();
+            __m128 channelHigh = _mm_setzero_ps();
+
+            for (unsigned int j = 0; j < order; j++) {
+                const uint8_t* row = input + (y + j) * inputStride + x;
+                for (unsigned int i = 0; i < order; i++) {
+                    const __m128 kernelWeight = _mm_set1_ps(weights[j * order + i]);
+                    // widen 8 values to two vectors of 4 floats
+                    const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i));
+                    const __m128 valuesLow = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(values));
+                    const __m128 valuesHigh = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(values, 4)));
+                    channelLow = _mm_add_ps(channelLow, _mm_mul_ps(valuesLow, kernelWeight));
+                    channelHigh = _mm_add_ps(channelHigh, _mm_mul_ps(valuesHigh, kernelWeight));
+                }
+            }
+
+            // clamp, truncate and pack to 8-bit unsigned integers
+            channelLow = _mm_min_ps(_mm_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm_min_ps(_mm_max_ps(channelHigh, minValue), maxValue);
+            const __m128i packed = _mm_packus_epi32(_mm_cvttps_epi32(channelLow), _mm_cvttps_epi32(channelHigh));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + y * outputStride + x), _mm_packus_epi16(packed, packed));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights, order);
+        }
+    }
+}
+
+void PlaneConvolution::sparseSse42(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const SparseKernel::Tap *taps, const unsigned int numTaps) {
+    const __m128 minValue = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(255);
+
+    const unsigned int vectorWidth = RowPadding::getVectorWidth(outputWidth, SSE42_STEP,
+        getTapsExtent(taps, numTaps, inputStride), inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + SSE42_STEP <= vectorWidth; x += SSE42_STEP) {
+            __m128 channelLow = _mm_setzero_ps();
+            __m128 channelHigh = _mm_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (unsigned int t = 0; t < numTaps; t++) {
+                const __m128 kernelWeight = _mm_set1_ps(taps[t].weight);
+                const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(corner + taps[t].offset));
+                const __m128 valuesLow = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(values));
+                const __m128 valuesHigh = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(values, 4)));
+                channelLow = _mm_add_ps(channelLow, _mm_mul_ps(valuesLow, kernelWeight));
+                channelHigh = _mm_add_ps(channelHigh, _mm_mul_ps(valuesHigh, kernelWeight));
+            }
+
+            channelLow = _mm_min_ps(_mm_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm_min_ps(_mm_max_ps(channelHigh, minValue), maxValue);
+            const __m128i packed = _mm_packus_epi32(_mm_cvttps_epi32(channelLow), _mm_cvttps_epi32(channelHigh));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + y * outputStride + x), _mm_packus_epi16(packed, packed));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolveSparsePixel(input + y * inputStride + x, taps, numTaps);
+        }
+    }
+}
+#endif
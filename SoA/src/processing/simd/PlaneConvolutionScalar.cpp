@@ -0,0 +1,55 @@
+#include "PlaneConvolution.h"
+
+void PlaneConvolution::scalar(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const float *weights, const unsigned int order) {
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        for (unsigned int x = 0; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, inputStride, weights, order);
+        }
+    }
+}
+
+PlaneConvolution::Function PlaneConvolution::select(const InstructionSet instructionSet) {
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return sse42;
+        case InstructionSet::avx2:
+            return avx2;
+        case InstructionSet::avx512:
+            return avx512;
+        default:
+            return scalar;
+    }
+#else
+    return scalar;
+#endif
+}
+
+void PlaneConvolution::sparseScalar(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const SparseKernel::Tap *taps, const unsigned int numTaps) {
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        for (unsigned int x = 0; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolveSparsePixel(input + y * inputStride + x, taps, numTaps);
+        }
+    }
+}
+
+PlaneConvolution::SparseFunction PlaneConvolution::selectSparse(const InstructionSet instructionSet) {
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            return sparseSse42;
+        case InstructionSet::avx2:
+            return sparseAvx2;
+        case InstructionSet::avx512:
+            return sparseAvx512;
+        default:
+            return sparseScalar;
+    }
+#else
+    return sparseScalar;
+#endif
+}
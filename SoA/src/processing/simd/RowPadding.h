@@ -0,0 +1,34 @@
+#ifndef ROWPADDING_H
+#define ROWPADDING_H
+
+
+namespace RowPadding {
+    /**
+     * Retrieves the number of output columns of each row computed by vector steps.
+     *
+     * When the padding of the rows leaves room for it, i.e. the loads of a step rounded up to the whole vector
+     * stay within the input stride and its stores within the output stride, the last partial step of each row
+     * is computed by vectors too, writing into the padding of the output row, so that no column is left to
+     * scalar code. Otherwise, only full steps are computed by vectors.
+     *
+     * It has internal linkage, so that each engine keeps the copy compiled for its own instruction set.
+     *
+     * @param outputWidth The width of the output plane.
+     * @param step The number of output values computed per vector step.
+     * @param order The number of input columns read for each output value, i.e. the kernel order.
+     * @param inputStride The distance between consecutive rows of the input plane.
+     * @param outputStride The distance between consecutive rows of the output plane.
+     * @return The number of columns computed by vector steps, a multiple of the step.
+     */
+    static inline unsigned int getVectorWidth(const unsigned int outputWidth, const unsigned int step,
+        const unsigned int order, const unsigned int inputStride, const unsigned int outputStride) {
+        const unsigned int paddedWidth = (outputWidth + step - 1) / step * step;
+        if (paddedWidth + order - 1 <= inputStride && paddedWidth <= outputStride)
+            return paddedWidth;
+        return outputWidth / step * step;
+    }
+}
+
+
+
+#endif //ROWPADDING_H
@@ -0,0 +1,127 @@
+#ifndef SYMMETRICCONVOLUTION_H
+#define SYMMETRICCONVOLUTION_H
+#include <cstdint>
+#include <vector>
+
+#include "InstructionSet.h"
+
+
+/**
+ * Namespace for the convolution engines folding the symmetries of a kernel, working on a single channel plane,
+ * each of them specialized for an instruction set.
+ *
+ * When a kernel is symmetric under horizontal flips, vertical flips or both, the input values sharing a weight are
+ * first added in integer lanes, and their sum is then multiplied by the weight only once: up to four input values
+ * share a single conversion to float and a single multiplication.
+ *
+ * As in @ref PlaneConvolution, the output rows in the range [rowBegin, rowEnd) of a cropped convolution are computed.
+ */
+namespace SymmetricConvolution {
+    /**
+     * Represents a group of input values sharing the same weight, i.e. a tap and its mirrors.
+     */
+    struct Fold {
+        /**
+         * The offsets of the input values, i.e. row * inputStride + column; only the first numOffsets are valid.
+         */
+        unsigned int offsets[4];
+
+        /**
+         * The number of input values in the group: 4 for generic taps, 2 on the central row or column,
+         * 1 for the central tap or when the kernel is not symmetric along that direction.
+         */
+        unsigned int numOffsets;
+
+        /**
+         * The weight shared by the input values.
+         */
+        float weight;
+    };
+
+    /**
+     * Represents the folded form of a kernel for a given input width.
+     */
+    struct Weights {
+        /**
+         * The groups of input values with a non-zero weight, in row-major order of their top-left member.
+         */
+        std::vector<Fold> folds;
+
+        /**
+         * The order of the kernel.
+         */
+        unsigned int order;
+    };
+
+    /**
+     * Signature shared by all symmetric plane convolution engines.
+     *
+     * @param input The input channel plane.
+     * @param inputStride The distance between consecutive rows of the input plane, at least outputWidth + order - 1.
+     * @param output The output channel plane.
+     * @param outputStride The distance between consecutive rows of the output plane, at least outputWidth.
+     * @param outputWidth The width of the output plane, i.e. the number of columns to compute.
+     * @param rowBegin The first output row to compute.
+     * @param rowEnd The output row after the last one to compute.
+     * @param weights The folded form of the kernel, whose offsets refer to inputStride.
+     */
+    using Function = void (*)(const uint8_t* input, unsigned int inputStride, uint8_t* output,
+        unsigned int outputStride, unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd,
+        const Weights& weights);
+
+    /**
+     * Portable engine computing one output value at a time.
+     */
+    void scalar(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * SSE4.2 engine computing 8 output values per step, adding input values in 16-bit lanes.
+     */
+    void sse42(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * AVX2 engine computing 16 output values per step, adding input values in 16-bit lanes.
+     */
+    void avx2(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * AVX-512 engine computing 32 output values per step, adding input values in 16-bit lanes.
+     */
+    void avx512(const uint8_t* input, unsigned int inputStride, uint8_t* output, unsigned int outputStride,
+        unsigned int outputWidth, unsigned int rowBegin, unsigned int rowEnd, const Weights& weights);
+
+    /**
+     * Retrieves the engine specialized for the given instruction set.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @return The symmetric plane convolution engine, or the scalar one if the platform has no such specialization.
+     */
+    Function select(InstructionSet instructionSet);
+
+    /**
+     * Computes a single output value in the scalar way.
+     *
+     * It is used by vectorized engines too, in order to process the columns left over by full vector steps.
+     */
+    static inline uint8_t convolvePixel(const uint8_t* input, const Weights& weights) {
+        float channel = 0;
+        for (const Fold& fold : weights.folds) {
+            int32_t sum = 0;
+            for (unsigned int k = 0; k < fold.numOffsets; k++)
+                sum += input[fold.offsets[k]];
+            channel += static_cast<float>(sum) * fold.weight;
+        }
+        if (channel < 0)
+            return 0;
+        if (channel > 255)
+            return 255;
+        return static_cast<uint8_t>(channel);
+    }
+}
+
+
+
+#endif //SYMMETRICCONVOLUTION_H
@@ -0,0 +1,56 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "SymmetricConvolution.h"
+#include "RowPadding.h"
+
+#define AVX2_STEP 16
+
+void SymmetricConvolution::avx2(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    const __m256 minValue = _mm256_setzero_ps();
+    const __m256 maxValue = _mm256_set1_ps(255);
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX2_STEP, weights.order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX2_STEP <= vectorWidth; x += AVX2_STEP) {
+            __m256 channelLow = _mm256_setzero_ps();
+            __m256 channelHigh = _mm256_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (const Fold& fold : weights.folds) {
+                // mirrored input values are added before the single conversion and multiplication
+                __m256i sums = _mm256_setzero_si256();
+                for (unsigned int k = 0; k < fold.numOffsets; k++) {
+                    const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(corner + fold.offsets[k]));
+                    sums = _mm256_add_epi16(sums, _mm256_cvtepu8_epi16(values));
+                }
+                const __m256 kernelWeight = _mm256_set1_ps(fold.weight);
+                const __m256 sumsLow = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(sums)));
+                const __m256 sumsHigh = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(sums, 1)));
+                channelLow = _mm256_fmadd_ps(sumsLow, kernelWeight, channelLow);
+                channelHigh = _mm256_fmadd_ps(sumsHigh, kernelWeight, channelHigh);
+            }
+
+            // clamp, truncate and pack to 8-bit unsigned integers
+            channelLow = _mm256_min_ps(_mm256_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm256_min_ps(_mm256_max_ps(channelHigh, minValue), maxValue);
+            const __m256i integersLow = _mm256_cvttps_epi32(channelLow);
+            const __m256i integersHigh = _mm256_cvttps_epi32(channelHigh);
+            const __m128i packedLow = _mm_packus_epi32(_mm256_castsi256_si128(integersLow),
+                _mm256_extracti128_si256(integersLow, 1));
+            const __m128i packedHigh = _mm_packus_epi32(_mm256_castsi256_si128(integersHigh),
+                _mm256_extracti128_si256(integersHigh, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + y * outputStride + x),
+                _mm_packus_epi16(packedLow, packedHigh));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, weights);
+        }
+    }
+}
+#endif
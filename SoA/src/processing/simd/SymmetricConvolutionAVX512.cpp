@@ -0,0 +1,52 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "SymmetricConvolution.h"
+#include "RowPadding.h"
+
+#define AVX512_STEP 32
+
+void SymmetricConvolution::avx512(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    const __m512 minValue = _mm512_setzero_ps();
+    const __m512 maxValue = _mm512_set1_ps(255);
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, AVX512_STEP, weights.order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + AVX512_STEP <= vectorWidth; x += AVX512_STEP) {
+            __m512 channelLow = _mm512_setzero_ps();
+            __m512 channelHigh = _mm512_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (const Fold& fold : weights.folds) {
+                // mirrored input values are added before the single conversion and multiplication
+                __m512i sums = _mm512_setzero_si512();
+                for (unsigned int k = 0; k < fold.numOffsets; k++) {
+                    const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(corner + fold.offsets[k]));
+                    sums = _mm512_add_epi16(sums, _mm512_cvtepu8_epi16(values));
+                }
+                const __m512 kernelWeight = _mm512_set1_ps(fold.weight);
+                const __m512 sumsLow = _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm512_castsi512_si256(sums)));
+                const __m512 sumsHigh = _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(sums, 1)));
+                channelLow = _mm512_fmadd_ps(sumsLow, kernelWeight, channelLow);
+                channelHigh = _mm512_fmadd_ps(sumsHigh, kernelWeight, channelHigh);
+            }
+
+            // clamp, truncate and pack to 8-bit unsigned integers
+            channelLow = _mm512_min_ps(_mm512_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm512_min_ps(_mm512_max_ps(channelHigh, minValue), maxValue);
+            uint8_t* outputRow = output + y * outputStride + x;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outputRow), _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(channelLow)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outputRow + 16),
+                _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(channelHigh)));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, weights);
+        }
+    }
+}
+#endif
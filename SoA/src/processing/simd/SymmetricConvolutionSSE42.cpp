@@ -0,0 +1,50 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "SymmetricConvolution.h"
+#include "RowPadding.h"
+
+#define SSE42_STEP 8
+
+void SymmetricConvolution::sse42(const uint8_t *input, const unsigned int inputStride, uint8_t *output,
+    const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+    const unsigned int rowEnd, const Weights &weights) {
+    const __m128 minValue = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(255);
+
+    const unsigned int vectorWidth =
+        RowPadding::getVectorWidth(outputWidth, SSE42_STEP, weights.order, inputStride, outputStride);
+
+    for (unsigned int y = rowBegin; y < rowEnd; y++) {
+        unsigned int x = 0;
+        for (; x + SSE42_STEP <= vectorWidth; x += SSE42_STEP) {
+            __m128 channelLow = _mm_setzero_ps();
+            __m128 channelHigh = _mm_setzero_ps();
+
+            const uint8_t* corner = input + y * inputStride + x;
+            for (const Fold& fold : weights.folds) {
+                // mirrored input values are added before the single conversion and multiplication
+                __m128i sums = _mm_setzero_si128();
+                for (unsigned int k = 0; k < fold.numOffsets; k++) {
+                    const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(corner + fold.offsets[k]));
+                    sums = _mm_add_epi16(sums, _mm_cvtepu8_epi16(values));
+                }
+                const __m128 kernelWeight = _mm_set1_ps(fold.weight);
+                const __m128 sumsLow = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(sums));
+                const __m128 sumsHigh = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(sums, 8)));
+                channelLow = _mm_add_ps(channelLow, _mm_mul_ps(sumsLow, kernelWeight));
+                channelHigh = _mm_add_ps(channelHigh, _mm_mul_ps(sumsHigh, kernelWeight));
+            }
+
+            // clamp, truncate and pack to 8-bit unsigned integers
+            channelLow = _mm_min_ps(_mm_max_ps(channelLow, minValue), maxValue);
+            channelHigh = _mm_min_ps(_mm_max_ps(channelHigh, minValue), maxValue);
+            const __m128i packed = _mm_packus_epi32(_mm_cvttps_epi32(channelLow), _mm_cvttps_epi32(channelHigh));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + y * outputStride + x), _mm_packus_epi16(packed, packed));
+        }
+        for (; x < outputWidth; x++) {
+            output[y * outputStride + x] = convolvePixel(input + y * inputStride + x, weights);
+        }
+    }
+}
+#endif
@@ -0,0 +1,21 @@
+#include "UnrolledConvolution.h"
+
+PlaneConvolution::Function UnrolledConvolution::select(const InstructionSet instructionSet, const unsigned int order) {
+    PlaneConvolution::Function microkernel = nullptr;
+#if defined(__x86_64__) || defined(_M_X64)
+    switch (instructionSet) {
+        case InstructionSet::sse42:
+            microkernel = sse42(order);
+            break;
+        case InstructionSet::avx2:
+            microkernel = avx2(order);
+            break;
+        case InstructionSet::avx512:
+            microkernel = avx512(order);
+            break;
+        default:
+            break;
+    }
+#endif
+    return microkernel ? microkernel : PlaneConvolution::select(instructionSet);
+}
@@ -0,0 +1,175 @@
+#ifndef UNROLLEDCONVOLUTION_H
+#define UNROLLEDCONVOLUTION_H
+#include <cstdint>
+#include <utility>
+
+#include "InstructionSet.h"
+#include "PlaneConvolution.h"
+#include "RowPadding.h"
+
+
+/**
+ * Namespace for the plane convolution microkernels specialized at compile time for a kernel order.
+ *
+ * With the order known to the compiler, the loops over the kernel columns are fully unrolled and the weight offsets
+ * are constants. Moreover, microkernels are register-blocked over several output rows: every input row,
+ * once widened to float, is accumulated into all the output rows of the block that read it, instead of being
+ * loaded and converted again for each of them.
+ *
+ * Each output value accumulates its products in the same order as the generic engine of the same instruction set,
+ * thus results are bit-identical to @ref PlaneConvolution.
+ */
+namespace UnrolledConvolution {
+    /**
+     * The largest kernel order with a specialized microkernel; all odd orders from 3 up to it are specialized.
+     */
+    constexpr unsigned int MAX_ORDER = 25;
+
+    /**
+     * Retrieves the SSE4.2 microkernel for the given order.
+     *
+     * @param order The order of the kernel.
+     * @return The microkernel, or nullptr if the order is not specialized.
+     */
+    PlaneConvolution::Function sse42(unsigned int order);
+
+    /**
+     * Retrieves the AVX2 microkernel for the given order.
+     *
+     * @param order The order of the kernel.
+     * @return The microkernel, or nullptr if the order is not specialized.
+     */
+    PlaneConvolution::Function avx2(unsigned int order);
+
+    /**
+     * Retrieves the AVX-512 microkernel for the given order.
+     *
+     * @param order The order of the kernel.
+     * @return The microkernel, or nullptr if the order is not specialized.
+     */
+    PlaneConvolution::Function avx512(unsigned int order);
+
+    /**
+     * Routes a kernel order to the microkernel specialized for it and for the given instruction set,
+     * falling back to the generic engine of @ref PlaneConvolution.
+     *
+     * @param instructionSet The instruction set of the engine.
+     * @param order The order of the kernel.
+     * @return The plane convolution engine to use.
+     */
+    PlaneConvolution::Function select(InstructionSet instructionSet, unsigned int order);
+
+    /*
+     * The templates below are instantiated by each instruction set with its own Vector type, which provides:
+     * - STEP and BLOCK_ROWS, i.e. the output columns and rows computed per step;
+     * - Sum and Values, i.e. the accumulator and the widened input types;
+     * - zero(), widen(input), accumulate(sum, values, weight) and store(output, sum);
+     * - generic, i.e. the engine of PlaneConvolution for the same instruction set.
+     * Since instantiations depend on the Vector type, code compiled for different instruction sets never mixes.
+     */
+
+    /**
+     * Accumulates a widened input vector into the block output rows which read it with kernel row r - K.
+     * If IsFull, all output rows of the block read it.
+     */
+    template<typename Vector, unsigned int Order, bool IsFull, unsigned int... K>
+    inline void accumulateColumn(typename Vector::Sum (&sums)[Vector::BLOCK_ROWS], const typename Vector::Values& values,
+        const float* weights, const unsigned int r, const unsigned int i, std::integer_sequence<unsigned int, K...>) {
+        ((IsFull || (K <= r && r < K + Order) ?
+            static_cast<void>(sums[K] = Vector::accumulate(sums[K], values, weights[(r - K) * Order + i])) :
+            static_cast<void>(0)), ...);
+    }
+
+    /**
+     * Accumulates the input row r of a block, shifted by each kernel column in turn.
+     */
+    template<typename Vector, unsigned int Order, bool IsFull, unsigned int... I>
+    inline void accumulateRow(typename Vector::Sum (&sums)[Vector::BLOCK_ROWS], const uint8_t* row,
+        const float* weights, const unsigned int r, std::integer_sequence<unsigned int, I...>) {
+        (accumulateColumn<Vector, Order, IsFull>(sums, Vector::widen(row + I), weights, r, I,
+            std::make_integer_sequence<unsigned int, Vector::BLOCK_ROWS>()), ...);
+    }
+
+    /**
+     * Microkernel computing blocks of BLOCK_ROWS x STEP output values for a kernel of the given order.
+     * Rows left over by full blocks are computed by the generic engine.
+     */
+    template<typename Vector, unsigned int Order>
+    void convolve(const uint8_t* input, const unsigned int inputStride, uint8_t* output,
+        const unsigned int outputStride, const unsigned int outputWidth, const unsigned int rowBegin,
+        const unsigned int rowEnd, const float* weights, unsigned int) {
+        constexpr unsigned int blockRows = Vector::BLOCK_ROWS;
+        constexpr unsigned int numInputRows = blockRows + Order - 1;
+        // input rows in [blockRows - 1, Order) are read by all the output rows of a block
+        constexpr unsigned int fullBegin = blockRows - 1;
+        constexpr unsigned int fullEnd = Order;
+        constexpr auto columns = std::make_integer_sequence<unsigned int, Order>();
+
+        const unsigned int vectorWidth =
+            RowPadding::getVectorWidth(outputWidth, Vector::STEP, Order, inputStride, outputStride);
+
+        unsigned int y = rowBegin;
+        for (; y + blockRows <= rowEnd; y += blockRows) {
+            unsigned int x = 0;
+            for (; x + Vector::STEP <= vectorWidth; x += Vector::STEP) {
+                typename Vector::Sum sums[blockRows];
+                for (auto& sum : sums)
+                    sum = Vector::zero();
+
+                const uint8_t* block = input + y * inputStride + x;
+                unsigned int r = 0;
+                for (; r < fullBegin && r < numInputRows; r++)
+                    accumulateRow<Vector, Order, false>(sums, block + r * inputStride, weights, r, columns);
+                for (; r < fullEnd; r++)
+                    accumulateRow<Vector, Order, true>(sums, block + r * inputStride, weights, r, columns);
+                for (; r < numInputRows; r++)
+                    accumulateRow<Vector, Order, false>(sums, block + r * inputStride, weights, r, columns);
+
+                for (unsigned int k = 0; k < blockRows; k++)
+                    Vector::store(output + (y + k) * outputStride + x, sums[k]);
+            }
+            for (; x < outputWidth; x++) {
+                for (unsigned int k = 0; k < blockRows; k++) {
+                    output[(y + k) * outputStride + x] = PlaneConvolution::convolvePixel(
+                        input + (y + k) * inputStride + x, inputStride, weights, Order);
+                }
+            }
+        }
+        if (y < rowEnd)
+            Vector::generic(input, inputStride, output, outputStride, outputWidth, y, rowEnd, weights, Order);
+    }
+
+    /**
+     * Retrieves the entry of the dispatch table for the given order.
+     */
+    template<typename Vector, unsigned int Order>
+    constexpr PlaneConvolution::Function getEntry() {
+        if constexpr (Order < 3)
+            return nullptr;
+        else
+            return &convolve<Vector, Order>;
+    }
+
+    /**
+     * Looks the given order up in the dispatch table of the microkernels, indexed by order / 2.
+     */
+    template<typename Vector, unsigned int... Half>
+    PlaneConvolution::Function lookup(const unsigned int order, std::integer_sequence<unsigned int, Half...>) {
+        static constexpr PlaneConvolution::Function table[] = {getEntry<Vector, 2 * Half + 1>()...};
+        if (order % 2 == 0 || order > MAX_ORDER)
+            return nullptr;
+        return table[order / 2];
+    }
+
+    /**
+     * Looks the given order up in the dispatch table of the microkernels for the instruction set of Vector.
+     */
+    template<typename Vector>
+    PlaneConvolution::Function lookup(const unsigned int order) {
+        return lookup<Vector>(order, std::make_integer_sequence<unsigned int, MAX_ORDER / 2 + 1>());
+    }
+}
+
+
+
+#endif //UNROLLEDCONVOLUTION_H
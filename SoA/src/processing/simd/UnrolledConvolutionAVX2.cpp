@@ -0,0 +1,53 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "UnrolledConvolution.h"
+
+/**
+ * Vector type of the AVX2 microkernels: 16 output values per row, as two halves of 8 floats,
+ * and 4 rows per block, with fused multiply-add as in PlaneConvolution::avx2.
+ */
+struct Avx2Vector {
+    static constexpr unsigned int STEP = 16;
+    static constexpr unsigned int BLOCK_ROWS = 4;
+    static constexpr PlaneConvolution::Function generic = PlaneConvolution::avx2;
+
+    struct Sum {
+        __m256 low;
+        __m256 high;
+    };
+    using Values = Sum;
+
+    static Sum zero() {
+        return {_mm256_setzero_ps(), _mm256_setzero_ps()};
+    }
+
+    static Values widen(const uint8_t* input) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        return {_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values)),
+            _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, 8)))};
+    }
+
+    static Sum accumulate(const Sum& sum, const Values& values, const float weight) {
+        const __m256 kernelWeight = _mm256_set1_ps(weight);
+        return {_mm256_fmadd_ps(values.low, kernelWeight, sum.low), _mm256_fmadd_ps(values.high, kernelWeight, sum.high)};
+    }
+
+    static void store(uint8_t* output, const Sum& sum) {
+        // clamp, truncate and pack to 8-bit unsigned integers
+        const __m256 minValue = _mm256_setzero_ps();
+        const __m256 maxValue = _mm256_set1_ps(255);
+        const __m256i integersLow = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(sum.low, minValue), maxValue));
+        const __m256i integersHigh = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(sum.high, minValue), maxValue));
+        const __m128i packedLow = _mm_packus_epi32(_mm256_castsi256_si128(integersLow),
+            _mm256_extracti128_si256(integersLow, 1));
+        const __m128i packedHigh = _mm_packus_epi32(_mm256_castsi256_si128(integersHigh),
+            _mm256_extracti128_si256(integersHigh, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(packedLow, packedHigh));
+    }
+};
+
+PlaneConvolution::Function UnrolledConvolution::avx2(const unsigned int order) {
+    return lookup<Avx2Vector>(order);
+}
+#endif
@@ -0,0 +1,40 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#include "UnrolledConvolution.h"
+
+/**
+ * Vector type of the AVX-512 microkernels: 16 output values per row and 8 rows per block,
+ * with fused multiply-add as in PlaneConvolution::avx512.
+ */
+struct Avx512Vector {
+    static constexpr unsigned int STEP = 16;
+    static constexpr unsigned int BLOCK_ROWS = 8;
+    static constexpr PlaneConvolution::Function generic = PlaneConvolution::avx512;
+
+    using Sum = __m512;
+    using Values = __m512;
+
+    static Sum zero() {
+        return _mm512_setzero_ps();
+    }
+
+    static Values widen(const uint8_t* input) {
+        return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input))));
+    }
+
+    static Sum accumulate(const Sum sum, const Values values, const float weight) {
+        return _mm512_fmadd_ps(values, _mm512_set1_ps(weight), sum);
+    }
+
+    static void store(uint8_t* output, Sum sum) {
+        // clamp, truncate and narrow to 8-bit unsigned integers
+        sum = _mm512_min_ps(_mm512_max_ps(sum, _mm512_setzero_ps()), _mm512_set1_ps(255));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(sum)));
+    }
+};
+
+PlaneConvolution::Function UnrolledConvolution::avx512(const unsigned int order) {
+    return lookup<Avx512Vector>(order);
+}
+#endif
@@ -0,0 +1,50 @@
+#if defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+
+#include "UnrolledConvolution.h"
+
+/**
+ * Vector type of the SSE4.2 microkernels: 8 output values per row, as two halves of 4 floats,
+ * and 4 rows per block, with separate multiply and add as in PlaneConvolution::sse42.
+ */
+struct Sse42Vector {
+    static constexpr unsigned int STEP = 8;
+    static constexpr unsigned int BLOCK_ROWS = 4;
+    static constexpr PlaneConvolution::Function generic = PlaneConvolution::sse42;
+
+    struct Sum {
+        __m128 low;
+        __m128 high;
+    };
+    using Values = Sum;
+
+    static Sum zero() {
+        return {_mm_setzero_ps(), _mm_setzero_ps()};
+    }
+
+    static Values widen(const uint8_t* input) {
+        const __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input));
+        return {_mm_cvtepi32_ps(_mm_cvtepu8_epi32(values)), _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(values, 4)))};
+    }
+
+    static Sum accumulate(const Sum& sum, const Values& values, const float weight) {
+        const __m128 kernelWeight = _mm_set1_ps(weight);
+        return {_mm_add_ps(sum.low, _mm_mul_ps(values.low, kernelWeight)),
+            _mm_add_ps(sum.high, _mm_mul_ps(values.high, kernelWeight))};
+    }
+
+    static void store(uint8_t* output, const Sum& sum) {
+        // clamp, truncate and pack to 8-bit unsigned integers
+        const __m128 minValue = _mm_setzero_ps();
+        const __m128 maxValue = _mm_set1_ps(255);
+        const __m128i packed = _mm_packus_epi32(
+            _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(sum.low, minValue), maxValue)),
+            _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(sum.high, minValue), maxValue)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(packed, packed));
+    }
+};
+
+PlaneConvolution::Function UnrolledConvolution::sse42(const unsigned int order) {
+    return lookup<Sse42Vector>(order);
+}
+#endif
@@ -0,0 +1,22 @@
+#include "SparseKernel.h"
+
+SparseKernel::SparseKernel(const Kernel &kernel, const unsigned int inputStride): order(kernel.getOrder()) {
+    const auto kernelWeights = kernel.viewWeights();
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            const float weight = kernelWeights[j * order + i];
+            if (weight != 0)
+                taps.push_back({j * inputStride + i, weight});
+        }
+    }
+}
+
+SparseKernel::~SparseKernel() = default;
+
+unsigned int SparseKernel::getOrder() const {
+    return order;
+}
+
+const std::vector<SparseKernel::Tap>& SparseKernel::getTaps() const {
+    return taps;
+}
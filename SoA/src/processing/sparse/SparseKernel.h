@@ -0,0 +1,74 @@
+#ifndef SPARSEKERNEL_H
+#define SPARSEKERNEL_H
+#include <vector>
+
+#include "kernel/Kernel.h"
+
+
+/**
+ * Represents the non-zero weights of a kernel, compacted into a list of taps for a given image width.
+ *
+ * Each tap holds the offset of its input value from the top-left input value read by an output value,
+ * so that engines can skip zero weights without any index computation.
+ *
+ * This class is immutable once constructed.
+ */
+class SparseKernel final {
+public:
+    /**
+     * Represents a non-zero weight of the kernel.
+     */
+    struct Tap {
+        /**
+         * The offset of the input value, i.e. row * inputStride + column.
+         */
+        unsigned int offset;
+
+        /**
+         * The weight of the input value.
+         */
+        float weight;
+    };
+
+    /**
+     * Constructs a SparseKernel object from the weights of the given kernel, keeping their row-major order.
+     *
+     * @param kernel The kernel to compact.
+     * @param inputStride The distance between consecutive rows of the images the kernel will be applied to.
+     */
+    SparseKernel(const Kernel& kernel, unsigned int inputStride);
+
+    /**
+     * Default destructor.
+     */
+    ~SparseKernel();
+
+    /**
+     * Retrieves the order of the compacted kernel.
+     *
+     * @return The order as an unsigned integer.
+     */
+    [[nodiscard]] unsigned int getOrder() const;
+
+    /**
+     * Retrieves the taps of the non-zero weights, in row-major order.
+     *
+     * @return A constant reference to the taps.
+     */
+    [[nodiscard]] const std::vector<Tap>& getTaps() const;
+
+private:
+    /**
+     * Represents the order of the compacted kernel.
+     */
+    unsigned int order;
+
+    /**
+     * Stores the taps of the non-zero weights.
+     */
+    std::vector<Tap> taps;
+};
+
+
+
+#endif //SPARSEKERNEL_H
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#include "image/Image.h"
+#include "image/ImageBuffer.h"
+#include "image/ImageView.h"
+#include "image/reader/STBImageReader.h"
+#include "kernel/KernelFactory.h"
+#include "processing/ImageProcessing.h"
+#include "processing/parallel/ThreadPool.h"
+
+namespace {
+    /**
+     * Counts the allocations made through the global operator new, i.e. by every standard allocator,
+     * and through its aligned form, i.e. by image buffers, whose size is at least the given threshold.
+     */
+    std::atomic<std::size_t> numAllocations{0};
+    std::atomic<std::size_t> countingThreshold{0};
+}
+
+// the replacements below pair operator new with malloc and operator delete with free, which GCC would flag as
+// mismatched once it inlines them into their callers
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(const std::size_t size) {
+    if (size >= countingThreshold.load(std::memory_order_relaxed))
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size > 0 ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    if (size >= countingThreshold.load(std::memory_order_relaxed))
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+    const auto alignmentSize = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires a size multiple of the alignment
+    if (void* pointer = std::aligned_alloc(alignmentSize, (size + alignmentSize) / alignmentSize * alignmentSize))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+class AllocationTest : public ::testing::Test {
+protected:
+    const unsigned int height = 48;
+    const unsigned int width = 64;
+    Image* imageToProcess = nullptr;
+
+    void SetUp() override {
+        std::vector<uint8_t> reds(width * height);
+        std::vector<uint8_t> greens(width * height);
+        std::vector<uint8_t> blues(width * height);
+        for (unsigned int k = 0; k < width * height; k++) {
+            reds[k] = static_cast<uint8_t>(k * 37 % 256);
+            greens[k] = static_cast<uint8_t>(k * 91 % 256);
+            blues[k] = static_cast<uint8_t>(k * 13 % 256);
+        }
+        imageToProcess = new Image(width, height, reds, greens, blues);
+    }
+
+    void TearDown() override {
+        delete imageToProcess;
+        imageToProcess = nullptr;
+    }
+
+    /**
+     * Starts counting the allocations of at least the given size.
+     */
+    static void startCounting(const std::size_t threshold) {
+        numAllocations = 0;
+        countingThreshold = threshold;
+    }
+
+    /**
+     * Stops counting the allocations.
+     *
+     * @return The number of allocations counted since the last start.
+     */
+    static std::size_t stopCounting() {
+        countingThreshold = 0;
+        return numAllocations;
+    }
+};
+
+
+TEST_F(AllocationTest, testImageConstructorWhenBufferIsMoved) {
+    ImageBuffer buffer(width, height);
+    const uint8_t* redsData = buffer.viewReds().data();
+    const uint8_t* greensData = buffer.viewGreens().data();
+    const uint8_t* bluesData = buffer.viewBlues().data();
+
+    startCounting(1);
+    const Image image(std::move(buffer));
+    EXPECT_EQ(stopCounting(), 0);
+
+    EXPECT_EQ(image.viewReds().data(), redsData);
+    EXPECT_EQ(image.viewGreens().data(), greensData);
+    EXPECT_EQ(image.viewBlues().data(), bluesData);
+}
+
+TEST_F(AllocationTest, testKernelConstructorWhenWeightsAreMoved) {
+    std::string name = "kernelWithNameLongerThanTheSmallStringBuffer";
+    std::vector<float> weights(25, 0.04f);
+    const float* weightsData = weights.data();
+
+    startCounting(1);
+    const Kernel kernel(std::move(name), 5, std::move(weights));
+    EXPECT_EQ(stopCounting(), 0);
+
+    EXPECT_EQ(kernel.viewWeights().data(), weightsData);
+}
+
+TEST_F(AllocationTest, testImageBufferWhenSingleAllocation) {
+    const std::size_t planeSize = width * height;
+
+    startCounting(planeSize);
+    const ImageBuffer separateBuffer(width, height, ImageBuffer::chooseStride(width), false);
+    EXPECT_EQ(stopCounting(), 3);
+
+    startCounting(planeSize);
+    const ImageBuffer singleBuffer(width, height, ImageBuffer::chooseStride(width), true);
+    EXPECT_EQ(stopCounting(), 1);
+}
+
+TEST_F(AllocationTest, testConvolutionAllocatesOnlyOutputPlanes) {
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(3);
+    const std::size_t planeSize = (width - 2) * (height - 2);
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::crop,
+        ImageProcessing::EdgePolicy::extend}) {
+        // the first convolution sets up the engine and its buffers
+        (void) ImageProcessing::convolution(*imageToProcess, *kernel, edgePolicy);
+
+        startCounting(planeSize);
+        const std::unique_ptr<Image> outputImage = ImageProcessing::convolution(*imageToProcess, *kernel, edgePolicy);
+        EXPECT_EQ(stopCounting(), 3);
+    }
+}
+
+TEST_F(AllocationTest, testRepeatedConvolutionIntoOutputViewDoesNotAllocate) {
+    std::vector<uint8_t> reds(width * height);
+    std::vector<uint8_t> greens(width * height);
+    std::vector<uint8_t> blues(width * height);
+    const MutableImageView output = {width, height, width, reds.data(), greens.data(), blues.data()};
+
+    for (const unsigned int order : {3, 7}) {
+        for (const auto &kernel : {KernelFactory::createBoxBlurKernel(order),
+            KernelFactory::createEdgeDetectionKernel(order)}) {
+            ImageProcessing::convolution(*imageToProcess, *kernel, ImageProcessing::EdgePolicy::mirror, output);
+
+            startCounting(1);
+            for (unsigned int rep = 0; rep < 3; rep++)
+                ImageProcessing::convolution(*imageToProcess, *kernel, ImageProcessing::EdgePolicy::mirror, output);
+            EXPECT_EQ(stopCounting(), 0);
+        }
+    }
+}
+
+TEST_F(AllocationTest, testRepeatedParallelConvolutionIntoOutputViewDoesNotAllocate) {
+    std::vector<uint8_t> reds(width * height);
+    std::vector<uint8_t> greens(width * height);
+    std::vector<uint8_t> blues(width * height);
+    // a single thread, so that the scratch buffers set up by the first convolution are the ones reused later,
+    // whereas the bands are still handed out by the pool
+    ThreadPool threadPool(1);
+
+    for (const unsigned int order : {3, 7}) {
+        const MutableImageView croppedOutput = {width - (order - 1), height - (order - 1), width, reds.data(),
+            greens.data(), blues.data()};
+        const MutableImageView output = {width, height, width, reds.data(), greens.data(), blues.data()};
+        for (const auto &kernel : {KernelFactory::createBoxBlurKernel(order),
+            KernelFactory::createEdgeDetectionKernel(order)}) {
+            ImageProcessing::parallelConvolution(*imageToProcess, *kernel, threadPool, croppedOutput);
+            ImageProcessing::parallelConvolution(*imageToProcess, *kernel, threadPool,
+                ImageProcessing::EdgePolicy::extend, output);
+
+            startCounting(1);
+            for (unsigned int rep = 0; rep < 3; rep++) {
+                ImageProcessing::parallelConvolution(*imageToProcess, *kernel, threadPool, croppedOutput);
+                ImageProcessing::parallelConvolution(*imageToProcess, *kernel, threadPool,
+                    ImageProcessing::EdgePolicy::extend, output);
+            }
+            EXPECT_EQ(stopCounting(), 0);
+        }
+    }
+}
+
+TEST_F(AllocationTest, testReaderAllocatesOnlyPlanes) {
+    std::stringstream filePathStream;
+    filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "allocationTestImage.jpg";
+    const std::string filePath = filePathStream.str();
+    STBImageReader imageReader;
+
+    // a single interleaved buffer is needed to save the planes
+    startCounting(width * height);
+    imageReader.saveJPGImage(*imageToProcess, filePath);
+    EXPECT_EQ(stopCounting(), 1);
+
+    startCounting(width * height);
+    const std::unique_ptr<Image> loadedImage = imageReader.loadRGBImage(filePath);
+    EXPECT_EQ(stopCounting(), 3);
+    EXPECT_EQ(loadedImage->getWidth(), width);
+    EXPECT_EQ(loadedImage->getHeight(), height);
+}
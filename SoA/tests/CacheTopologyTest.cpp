@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+
+#include "processing/cache/CacheTopology.h"
+
+
+TEST(CacheTopologyTest, testConstructor) {
+    constexpr unsigned int lineSize = 64;
+    constexpr unsigned int l1DataSize = 32 * 1024;
+    constexpr unsigned int l1Associativity = 8;
+    constexpr unsigned int l2Size = 1024 * 1024;
+    constexpr unsigned int l3Size = 0;
+
+    const CacheTopology cacheTopology(lineSize, l1DataSize, l1Associativity, l2Size, l3Size);
+
+    EXPECT_EQ(cacheTopology.getLineSize(), lineSize);
+    EXPECT_EQ(cacheTopology.getL1DataSize(), l1DataSize);
+    EXPECT_EQ(cacheTopology.getL1Associativity(), l1Associativity);
+    EXPECT_EQ(cacheTopology.getL2Size(), l2Size);
+    EXPECT_EQ(cacheTopology.getL3Size(), l3Size);
+    EXPECT_EQ(cacheTopology.getL1SetStride(), 4096);
+}
+
+TEST(CacheTopologyTest, testConstructorWhenSizeIsZero) {
+    EXPECT_THROW(CacheTopology(0, 32 * 1024, 8, 1024 * 1024, 0), std::invalid_argument);
+    EXPECT_THROW(CacheTopology(64, 0, 8, 1024 * 1024, 0), std::invalid_argument);
+    EXPECT_THROW(CacheTopology(64, 32 * 1024, 0, 1024 * 1024, 0), std::invalid_argument);
+    EXPECT_THROW(CacheTopology(64, 32 * 1024, 8, 0, 0), std::invalid_argument);
+}
+
+TEST(CacheTopologyTest, testDetect) {
+    const CacheTopology& cacheTopology = CacheTopology::detect();
+
+    EXPECT_GT(cacheTopology.getLineSize(), 0);
+    EXPECT_GE(cacheTopology.getL1DataSize(), cacheTopology.getLineSize() * cacheTopology.getL1Associativity());
+    EXPECT_GE(cacheTopology.getL2Size(), cacheTopology.getL1DataSize());
+    EXPECT_EQ(&cacheTopology, &CacheTopology::detect());
+}
+
+TEST(CacheTopologyTest, testToString) {
+    const CacheTopology cacheTopology(64, 48 * 1024, 12, 2048 * 1024, 8192 * 1024);
+
+    EXPECT_EQ(cacheTopology.toString(), "L1d 48 KiB (12-way), L2 2048 KiB, L3 8192 KiB, 64-byte lines");
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "processing/simd/ChannelLayout.h"
+#include "processing/simd/InstructionSet.h"
+
+
+TEST(ChannelLayoutTest, testEnginesMatchScalarEngine) {
+    // widths around full vector steps of every engine, so that leftover pixels are included
+    for (const unsigned int numPixels : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 48u, 100u}) {
+        std::vector<uint8_t> interleaved(numPixels * 3);
+        for (unsigned int k = 0; k < numPixels * 3; k++)
+            interleaved[k] = static_cast<uint8_t>(k * 37 % 256);
+        std::vector<uint8_t> expectedPlanes[3] = {std::vector<uint8_t>(numPixels), std::vector<uint8_t>(numPixels),
+            std::vector<uint8_t>(numPixels)};
+        ChannelLayout::Deinterleave::scalar(interleaved.data(), expectedPlanes[0].data(), expectedPlanes[1].data(),
+            expectedPlanes[2].data(), numPixels);
+        for (unsigned int x = 0; x < numPixels; x++) {
+            ASSERT_EQ(expectedPlanes[0][x], interleaved[3 * x]);
+            ASSERT_EQ(expectedPlanes[2][x], interleaved[3 * x + 2]);
+        }
+
+        for (const InstructionSet instructionSet :
+            {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+            if (!InstructionSets::isSupported(instructionSet))
+                continue;
+            std::vector<uint8_t> planes[3] = {std::vector<uint8_t>(numPixels), std::vector<uint8_t>(numPixels),
+                std::vector<uint8_t>(numPixels)};
+            std::vector<uint8_t> roundTrip(numPixels * 3);
+
+            ChannelLayout::Deinterleave::select(instructionSet)(interleaved.data(), planes[0].data(), planes[1].data(),
+                planes[2].data(), numPixels);
+            ChannelLayout::Interleave::select(instructionSet)(planes[0].data(), planes[1].data(), planes[2].data(),
+                roundTrip.data(), numPixels);
+
+            for (unsigned int c = 0; c < 3; c++)
+                EXPECT_EQ(planes[c], expectedPlanes[c]) << InstructionSets::getName(instructionSet) << ", " << numPixels;
+            EXPECT_EQ(roundTrip, interleaved) << InstructionSets::getName(instructionSet) << ", " << numPixels;
+        }
+    }
+}
+
+TEST(ChannelLayoutTest, testImageConversionWhenRowsArePadded) {
+    constexpr unsigned int width = 37;
+    constexpr unsigned int height = 5;
+    constexpr unsigned int stride = 64;
+    std::vector<uint8_t> interleaved(width * height * 3);
+    for (unsigned int k = 0; k < width * height * 3; k++)
+        interleaved[k] = static_cast<uint8_t>(k * 91 % 256);
+    std::vector<uint8_t> reds(stride * height, 7);
+    std::vector<uint8_t> greens(stride * height, 7);
+    std::vector<uint8_t> blues(stride * height, 7);
+
+    ChannelLayout::deinterleave(interleaved.data(), width, height, reds.data(), greens.data(), blues.data(), stride);
+
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            EXPECT_EQ(reds[y * stride + x], interleaved[(y * width + x) * 3]);
+            EXPECT_EQ(greens[y * stride + x], interleaved[(y * width + x) * 3 + 1]);
+            EXPECT_EQ(blues[y * stride + x], interleaved[(y * width + x) * 3 + 2]);
+        }
+        // padding is left untouched
+        for (unsigned int x = width; x < stride; x++)
+            EXPECT_EQ(greens[y * stride + x], 7);
+    }
+
+    std::vector<uint8_t> roundTrip(width * height * 3);
+    ChannelLayout::interleave(reds.data(), greens.data(), blues.data(), stride, width, height, roundTrip.data());
+
+    EXPECT_EQ(roundTrip, interleaved);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "processing/fft/Fft.h"
+#include "processing/fft/FftConvolution.h"
+
+#define FFT_TEST_TOLERANCE 1e-9
+
+
+TEST(FftTest, testConstructor) {
+    constexpr unsigned int size = 16;
+
+    const Fft fft(size);
+
+    EXPECT_EQ(fft.getSize(), size);
+}
+
+TEST(FftTest, testConstructorWhenSizeIsNotPowerOfTwo) {
+    EXPECT_THROW(Fft(0), std::invalid_argument);
+    EXPECT_THROW(Fft(12), std::invalid_argument);
+}
+
+TEST(FftTest, testTransformMatchesDiscreteFourierTransform) {
+    constexpr unsigned int size = 8;
+    const Fft fft(size);
+    std::vector<std::complex<double>> data(size);
+    for (unsigned int k = 0; k < size; k++)
+        data[k] = {static_cast<double>(k * 37 % 11), static_cast<double>(k * 5 % 7)};
+    const std::vector<std::complex<double>> input = data;
+
+    fft.transform(data.data(), false);
+
+    const double pi = std::acos(-1.0);
+    for (unsigned int f = 0; f < size; f++) {
+        std::complex<double> expected = 0;
+        for (unsigned int k = 0; k < size; k++)
+            expected += input[k] * std::polar(1.0, -2 * pi * f * k / size);
+        EXPECT_NEAR(data[f].real(), expected.real(), FFT_TEST_TOLERANCE);
+        EXPECT_NEAR(data[f].imag(), expected.imag(), FFT_TEST_TOLERANCE);
+    }
+}
+
+TEST(FftTest, testTransform2DRoundTrip) {
+    constexpr unsigned int size = 32;
+    const Fft fft(size);
+    std::vector<std::complex<double>> data(size * size);
+    for (unsigned int k = 0; k < size * size; k++)
+        data[k] = {static_cast<double>(k * 37 % 256), 0};
+    const std::vector<std::complex<double>> input = data;
+
+    fft.transform2D(data.data(), false);
+    fft.transform2D(data.data(), true);
+
+    for (unsigned int k = 0; k < size * size; k++) {
+        EXPECT_NEAR(data[k].real(), input[k].real(), FFT_TEST_TOLERANCE);
+        EXPECT_NEAR(data[k].imag(), input[k].imag(), FFT_TEST_TOLERANCE);
+    }
+}
+
+TEST(FftTest, testChooseTileSize) {
+    for (const unsigned int order : {3, 25, 101, 301}) {
+        const unsigned int tileSize = FftConvolution::chooseTileSize(order);
+
+        EXPECT_EQ(tileSize & (tileSize - 1), 0);
+        EXPECT_GE(tileSize, 2 * order);
+        EXPECT_TRUE(std::isfinite(FftConvolution::estimateOperationsPerValue(order, tileSize)));
+    }
+}
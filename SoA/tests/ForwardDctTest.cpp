@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "processing/simd/ForwardDct.h"
+#include "processing/simd/InstructionSet.h"
+
+
+TEST(ForwardDctTest, testTransformOfConstantBlock) {
+    // a constant block has only a DC coefficient, 8 times its value with the scaling of the tables
+    const std::vector<float> block(64, 10.0f);
+    const std::vector<float> table(64, 1.0f / 8);
+    int coefficients[64];
+
+    ForwardDct::transformScalar(block.data(), 8, table.data(), coefficients);
+
+    EXPECT_EQ(coefficients[0], 80);
+    for (unsigned int k = 1; k < 64; k++)
+        EXPECT_EQ(coefficients[k], 0) << k;
+}
+
+TEST(ForwardDctTest, testEnginesMatchScalarEngine) {
+    // blocks within wider rows, values centered on zero and coefficients rounded in both directions
+    constexpr unsigned int stride = 16;
+    std::vector<float> values(8 * stride);
+    std::vector<float> table(64);
+    for (unsigned int k = 0; k < values.size(); k++)
+        values[k] = static_cast<float>(k * 7919 % 256) - 128.0f + 0.25f * static_cast<float>(k % 3);
+    for (unsigned int k = 0; k < table.size(); k++)
+        table[k] = 1.0f / static_cast<float>(8 + k % 13);
+
+    for (const unsigned int offset : {0u, 8u}) {
+        int expectedCoefficients[64];
+        ForwardDct::transformScalar(values.data() + offset, stride, table.data(), expectedCoefficients);
+
+        for (const InstructionSet instructionSet :
+            {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+            if (!InstructionSets::isSupported(instructionSet))
+                continue;
+            int coefficients[64];
+
+            ForwardDct::selectTransform(instructionSet)(values.data() + offset, stride, table.data(), coefficients);
+
+            for (unsigned int k = 0; k < 64; k++)
+                EXPECT_EQ(coefficients[k], expectedCoefficients[k]) << InstructionSets::getName(instructionSet) <<
+                    ", " << offset << ", " << k;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "image/ImageBuffer.h"
+
+
+TEST(ImageBufferTest, testConstructor) {
+    constexpr unsigned int width = 100;
+    constexpr unsigned int height = 7;
+
+    ImageBuffer buffer(width, height);
+
+    EXPECT_EQ(buffer.getWidth(), width);
+    EXPECT_EQ(buffer.getHeight(), height);
+    EXPECT_EQ(buffer.getStride(), ImageBuffer::chooseStride(width));
+    EXPECT_FALSE(buffer.isSingleAllocation());
+    for (const Span<uint8_t> plane : {buffer.viewReds(), buffer.viewGreens(), buffer.viewBlues()}) {
+        EXPECT_EQ(plane.size(), buffer.getStride() * height);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(plane.data()) % ImageBuffer::ALIGNMENT, 0);
+        // padding is cleared, so that vectorized reads of it are defined
+        for (unsigned int y = 0; y < height; y++) {
+            for (unsigned int x = width; x < buffer.getStride(); x++)
+                EXPECT_EQ(plane[y * buffer.getStride() + x], 0);
+        }
+    }
+}
+
+TEST(ImageBufferTest, testChooseStride) {
+    for (const unsigned int width : {1u, 31u, 32u, 33u, 100u, 4064u, 4096u}) {
+        const unsigned int stride = ImageBuffer::chooseStride(width);
+
+        EXPECT_GE(stride, width + 32);
+        EXPECT_EQ(stride % ImageBuffer::ALIGNMENT, 0);
+        // an odd number of lines spreads consecutive rows over all cache sets
+        EXPECT_EQ(stride / ImageBuffer::ALIGNMENT % 2, 1);
+        EXPECT_LT(stride, width + 32 + 2 * ImageBuffer::ALIGNMENT);
+    }
+}
+
+TEST(ImageBufferTest, testConstructorWhenSingleAllocation) {
+    constexpr unsigned int width = 60;
+    constexpr unsigned int height = 64;
+    constexpr unsigned int stride = 64;
+
+    ImageBuffer buffer(width, height, stride, true);
+
+    EXPECT_TRUE(buffer.isSingleAllocation());
+    const uint8_t* reds = buffer.viewReds().data();
+    const uint8_t* greens = buffer.viewGreens().data();
+    const uint8_t* blues = buffer.viewBlues().data();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(reds) % ImageBuffer::ALIGNMENT, 0);
+    EXPECT_EQ(greens - reds, blues - greens);
+    EXPECT_GE(static_cast<unsigned int>(greens - reds), stride * height);
+    // planes of 4096 values are shifted by a line, so that they do not alias each other
+    EXPECT_EQ(static_cast<unsigned int>(greens - reds), stride * height + ImageBuffer::ALIGNMENT);
+}
+
+TEST(ImageBufferTest, testConstructorWhenStrideIsSmallerThanWidth) {
+    EXPECT_THROW(ImageBuffer(10, 2, 9, false), std::invalid_argument);
+    EXPECT_NO_THROW(ImageBuffer(10, 2, 10, false));
+}
+
+TEST(ImageBufferTest, testConstructorWhenPlanesAreOwned) {
+    std::vector<uint8_t> planes(3 * 8 * 3, 0);
+    planes[2 * 24 + 8 + 4] = 200;
+    const std::shared_ptr<std::vector<uint8_t>> owner(&planes, [](std::vector<uint8_t>* ownedPlanes) {
+        ownedPlanes->clear();
+    });
+
+    {
+        ImageBuffer buffer(5, 3, 8, planes.data(), planes.data() + 24, planes.data() + 48, owner);
+        const ImageBuffer movedBuffer(std::move(buffer));
+
+        EXPECT_FALSE(movedBuffer.isSingleAllocation());
+        EXPECT_EQ(movedBuffer.viewBlues().data(), planes.data() + 48);
+        EXPECT_EQ(movedBuffer.viewBlues()[8 + 4], 200);
+        EXPECT_EQ(owner.use_count(), 2);
+    }
+
+    EXPECT_EQ(owner.use_count(), 1);
+    EXPECT_THROW(ImageBuffer(10, 2, 9, planes.data(), planes.data(), planes.data(), nullptr), std::invalid_argument);
+}
+
+TEST(ImageBufferTest, testCopyConstructor) {
+    ImageBuffer buffer(5, 3, 8, true);
+    buffer.viewBlues()[2 * 8 + 4] = 200;
+
+    const ImageBuffer copy(buffer);
+
+    EXPECT_EQ(copy.getStride(), 8);
+    EXPECT_TRUE(copy.isSingleAllocation());
+    EXPECT_NE(copy.viewBlues().data(), buffer.viewBlues().data());
+    EXPECT_EQ(copy.viewBlues()[2 * 8 + 4], 200);
+}
+
+TEST(ImageBufferTest, testView) {
+    ImageBuffer buffer(5, 3);
+
+    const MutableImageView view = buffer.view();
+
+    EXPECT_EQ(view.width, 5);
+    EXPECT_EQ(view.height, 3);
+    EXPECT_EQ(view.stride, buffer.getStride());
+    EXPECT_EQ(view.reds, buffer.viewReds().data());
+    EXPECT_EQ(view.greens, buffer.viewGreens().data());
+    EXPECT_EQ(view.blues, buffer.viewBlues().data());
+}
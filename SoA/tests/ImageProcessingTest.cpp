@@ -1,12 +1,90 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
 #include <array>
 
 #include "image/Image.h"
+#include "image/ImageBuffer.h"
 #include "kernel/Kernel.h"
+#include "kernel/KernelFactory.h"
 #include "processing/ImageProcessing.h"
 
+/**
+ * Reads the rows of an image held in memory, recording the largest strip read.
+ */
+class ImageRowReader final : public RowReader {
+public:
+    explicit ImageRowReader(const Image& img): image(img) {}
+
+    [[nodiscard]] unsigned int getWidth() const override {
+        return image.getWidth();
+    }
+
+    [[nodiscard]] unsigned int getHeight() const override {
+        return image.getHeight();
+    }
+
+    [[nodiscard]] unsigned int getNextRow() const override {
+        return nextRow;
+    }
+
+    void readRows(const MutableImageView& output) override {
+        ASSERT_EQ(output.width, image.getWidth());
+        ASSERT_LE(nextRow + output.height, image.getHeight());
+        for (unsigned int y = 0; y < output.height; y++, nextRow++) {
+            const std::size_t pos = static_cast<std::size_t>(nextRow) * image.getStride();
+            std::copy_n(image.viewReds().data() + pos, output.width, output.reds + y * output.stride);
+            std::copy_n(image.viewGreens().data() + pos, output.width, output.greens + y * output.stride);
+            std::copy_n(image.viewBlues().data() + pos, output.width, output.blues + y * output.stride);
+        }
+        maxStripHeight = std::max(maxStripHeight, output.height);
+    }
+
+    unsigned int maxStripHeight = 0;
+
+private:
+    const Image& image;
+    unsigned int nextRow = 0;
+};
+
+/**
+ * Writes the rows of an image into a buffer held in memory.
+ */
+class BufferRowWriter final : public RowWriter {
+public:
+    BufferRowWriter(const unsigned int w, const unsigned int h): buffer(w, h) {}
+
+    [[nodiscard]] unsigned int getWidth() const override {
+        return buffer.getWidth();
+    }
+
+    [[nodiscard]] unsigned int getHeight() const override {
+        return buffer.getHeight();
+    }
+
+    [[nodiscard]] unsigned int getNextRow() const override {
+        return nextRow;
+    }
+
+    void writeRows(const ImageView& input) override {
+        ASSERT_EQ(input.width, buffer.getWidth());
+        ASSERT_LE(nextRow + input.height, buffer.getHeight());
+        const MutableImageView planes = buffer.view();
+        for (unsigned int y = 0; y < input.height; y++, nextRow++) {
+            const std::size_t pos = static_cast<std::size_t>(nextRow) * planes.stride;
+            std::copy_n(input.reds + y * input.stride, input.width, planes.reds + pos);
+            std::copy_n(input.greens + y * input.stride, input.width, planes.greens + pos);
+            std::copy_n(input.blues + y * input.stride, input.width, planes.blues + pos);
+        }
+    }
+
+    ImageBuffer buffer;
+
+private:
+    unsigned int nextRow = 0;
+};
+
 class ImageProcessingTest : public ::testing::Test {
 protected:
     const unsigned int height = 3;
@@ -15,6 +93,9 @@ protected:
     std::vector<uint8_t> greens;
     std::vector<uint8_t> blues;
     Image* imageToProcess = nullptr;
+    const unsigned int largeHeight = 19;
+    const unsigned int largeWidth = 23;
+    Image* largeImageToProcess = nullptr;
 
     void SetUp() override {
         reds = {120, 23, 44, 123, 1,
@@ -28,11 +109,23 @@ protected:
                                     106, 0, 120, 65, 217};
 
         imageToProcess = new Image(width, height, reds, greens, blues);
+
+        std::vector<uint8_t> largeReds(largeWidth * largeHeight);
+        std::vector<uint8_t> largeGreens(largeWidth * largeHeight);
+        std::vector<uint8_t> largeBlues(largeWidth * largeHeight);
+        for (unsigned int k = 0; k < largeWidth * largeHeight; k++) {
+            largeReds[k] = static_cast<uint8_t>(k * 37 % 256);
+            largeGreens[k] = static_cast<uint8_t>(k * 91 % 256);
+            largeBlues[k] = static_cast<uint8_t>(k * 13 % 256);
+        }
+        largeImageToProcess = new Image(largeWidth, largeHeight, largeReds, largeGreens, largeBlues);
     }
 
     void TearDown() override {
         delete imageToProcess;
         imageToProcess = nullptr;
+        delete largeImageToProcess;
+        largeImageToProcess = nullptr;
     }
 };
 
@@ -105,6 +198,1048 @@ TEST_F(ImageProcessingTest, testConvolutionWhenValuesAreOutOfRange) {
     }
 }
 
+TEST_F(ImageProcessingTest, testIsSeparableWhenKernelIsRankOne) {
+    constexpr unsigned int order = 3;
+    const Kernel rankOneKernel("rankOneKernel", order, std::vector<float> {    1, 2, 1,
+                                                                                  2, 4, 2,
+                                                                                  1, 2, 1     });
+
+    EXPECT_TRUE(ImageProcessing::isSeparable(rankOneKernel));
+    EXPECT_TRUE(ImageProcessing::isSeparable(*KernelFactory::createBoxBlurKernel(order)));
+}
+
+TEST_F(ImageProcessingTest, testIsSeparableWhenKernelIsNotRankOne) {
+    constexpr unsigned int order = 3;
+
+    EXPECT_FALSE(ImageProcessing::isSeparable(*KernelFactory::createEdgeDetectionKernel(order)));
+}
+
+TEST_F(ImageProcessingTest, testSeparableConvolutionMatchesDirectConvolution) {
+    constexpr unsigned int order = 5;
+    const std::vector<float> profile = {1, 4, 6, 4, 1};
+    std::vector<float> weights(order * order);
+    for (unsigned int j = 0; j < order; j++)
+        for (unsigned int i = 0; i < order; i++)
+            weights[j * order + i] = profile[j] * profile[i] / 256;
+    const Kernel gaussianKernel("gaussianKernel", order, weights);
+    const std::unique_ptr<Kernel> boxBlurKernel = KernelFactory::createBoxBlurKernel(order);
+
+    for (const Kernel* kernel : {&gaussianKernel, static_cast<const Kernel*>(boxBlurKernel.get())}) {
+        const std::unique_ptr<Image> separableImage = ImageProcessing::separableConvolution(*largeImageToProcess, *kernel);
+        const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, *kernel);
+
+        EXPECT_EQ(separableImage->getHeight(), directImage->getHeight());
+        EXPECT_EQ(separableImage->getWidth(), directImage->getWidth());
+        ASSERT_EQ(separableImage->getReds().size(), directImage->getReds().size());
+        for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+            EXPECT_NEAR(separableImage->getReds()[k], directImage->getReds()[k], ImageProcessing::SEPARABLE_TOLERANCE);
+            EXPECT_NEAR(separableImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::SEPARABLE_TOLERANCE);
+            EXPECT_NEAR(separableImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::SEPARABLE_TOLERANCE);
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testSeparableConvolutionWhenKernelIsNotSeparable) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    EXPECT_THROW(ImageProcessing::separableConvolution(*imageToProcess, *kernel), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testIsBoxFilter) {
+    constexpr unsigned int order = 3;
+
+    EXPECT_TRUE(ImageProcessing::isBoxFilter(*KernelFactory::createBoxBlurKernel(order)));
+    EXPECT_FALSE(ImageProcessing::isBoxFilter(*KernelFactory::createEdgeDetectionKernel(order)));
+}
+
+TEST_F(ImageProcessingTest, testBoxFilterConvolutionWhenKernelIsBoxBlur) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createBoxBlurKernel(order);
+    constexpr unsigned int heightConvoluted = 1;
+    constexpr unsigned int widthConvoluted = 3;
+    constexpr std::array<uint8_t, widthConvoluted> redsConvoluted = {70, 76, 79};
+    constexpr std::array<uint8_t, widthConvoluted> greensConvoluted = {32, 43, 31};
+    constexpr std::array<uint8_t, widthConvoluted> bluesConvoluted = {100, 81, 90};
+
+    const std::unique_ptr<Image> imageProcessed = ImageProcessing::boxFilterConvolution(*imageToProcess, *kernel);
+
+    EXPECT_EQ(imageProcessed->getHeight(), heightConvoluted);
+    EXPECT_EQ(imageProcessed->getWidth(), widthConvoluted);
+    ASSERT_EQ(imageProcessed->getReds().size(), widthConvoluted * heightConvoluted);
+    ASSERT_EQ(imageProcessed->getGreens().size(), widthConvoluted * heightConvoluted);
+    ASSERT_EQ(imageProcessed->getBlues().size(), widthConvoluted * heightConvoluted);
+    for (unsigned int i = 0; i < widthConvoluted; i++) {
+        EXPECT_EQ(imageProcessed->getReds()[0 * widthConvoluted + i], redsConvoluted[i]);
+        EXPECT_EQ(imageProcessed->getGreens()[0 * widthConvoluted + i], greensConvoluted[i]);
+        EXPECT_EQ(imageProcessed->getBlues()[0 * widthConvoluted + i], bluesConvoluted[i]);
+    }
+}
+
+TEST_F(ImageProcessingTest, testBoxFilterConvolutionWhenImageIsUniform) {
+    // the mean of a uniform window must be exact, without any rounding toward the previous level
+    constexpr unsigned int order = 7;
+    constexpr uint8_t value = 201;
+    const std::vector<uint8_t> uniformChannel(largeWidth * largeHeight, value);
+    const Image uniformImage(largeWidth, largeHeight, uniformChannel, uniformChannel, uniformChannel);
+    const auto kernel = KernelFactory::createBoxBlurKernel(order);
+
+    const std::unique_ptr<Image> imageProcessed = ImageProcessing::boxFilterConvolution(uniformImage, *kernel);
+
+    EXPECT_THAT(imageProcessed->getReds(), testing::Each(value));
+    EXPECT_THAT(imageProcessed->getGreens(), testing::Each(value));
+    EXPECT_THAT(imageProcessed->getBlues(), testing::Each(value));
+}
+
+TEST_F(ImageProcessingTest, testBoxFilterConvolutionMatchesDirectConvolution) {
+    for (const unsigned int order : {3, 7, 13}) {
+        const auto kernel = KernelFactory::createBoxBlurKernel(order);
+
+        const std::unique_ptr<Image> boxFilterImage = ImageProcessing::boxFilterConvolution(*largeImageToProcess, *kernel);
+        const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, *kernel);
+
+        EXPECT_EQ(boxFilterImage->getHeight(), directImage->getHeight());
+        EXPECT_EQ(boxFilterImage->getWidth(), directImage->getWidth());
+        ASSERT_EQ(boxFilterImage->getReds().size(), directImage->getReds().size());
+        for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+            EXPECT_NEAR(boxFilterImage->getReds()[k], directImage->getReds()[k], ImageProcessing::BOX_FILTER_TOLERANCE);
+            EXPECT_NEAR(boxFilterImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::BOX_FILTER_TOLERANCE);
+            EXPECT_NEAR(boxFilterImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::BOX_FILTER_TOLERANCE);
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testBoxFilterConvolutionWhenKernelIsNotBoxFilter) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    EXPECT_THROW(ImageProcessing::boxFilterConvolution(*imageToProcess, *kernel), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testVectorizedConvolutionMatchesDirectConvolution) {
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        for (const unsigned int order : {3, 7}) {
+            const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+            const std::unique_ptr<Image> vectorizedImage =
+                ImageProcessing::vectorizedConvolution(*largeImageToProcess, *kernel, instructionSet);
+            const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, *kernel);
+
+            EXPECT_EQ(vectorizedImage->getHeight(), directImage->getHeight());
+            EXPECT_EQ(vectorizedImage->getWidth(), directImage->getWidth());
+            ASSERT_EQ(vectorizedImage->getReds().size(), directImage->getReds().size());
+            for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+                EXPECT_NEAR(vectorizedImage->getReds()[k], directImage->getReds()[k], ImageProcessing::VECTORIZED_TOLERANCE);
+                EXPECT_NEAR(vectorizedImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::VECTORIZED_TOLERANCE);
+                EXPECT_NEAR(vectorizedImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::VECTORIZED_TOLERANCE);
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testVectorizedConvolutionWhenInstructionSetIsSSE42) {
+    if (!InstructionSets::isSupported(InstructionSet::sse42))
+        GTEST_SKIP() << "SSE4.2 is not supported by the CPU.";
+    constexpr unsigned int order = 3;
+    const Kernel kernel("inRangeKernel", order, std::vector<float> {  0.025, 0.1, 0.025,
+                                                                      0.1, 0.5, 0.1,
+                                                                      0.025, 0.1, 0.025   });
+
+    const std::unique_ptr<Image> vectorizedImage =
+        ImageProcessing::vectorizedConvolution(*largeImageToProcess, kernel, InstructionSet::sse42);
+    const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, kernel);
+
+    EXPECT_EQ(vectorizedImage->getReds(), directImage->getReds());
+    EXPECT_EQ(vectorizedImage->getGreens(), directImage->getGreens());
+    EXPECT_EQ(vectorizedImage->getBlues(), directImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testVectorizedConvolutionWhenInstructionSetIsNotSupported) {
+    if (InstructionSets::isSupported(InstructionSet::avx512))
+        GTEST_SKIP() << "All instruction sets are supported by the CPU.";
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    EXPECT_THROW(ImageProcessing::vectorizedConvolution(*imageToProcess, *kernel, InstructionSet::avx512),
+        std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testIsFixedPoint) {
+    constexpr unsigned int order = 3;
+    const Kernel reciprocalKernel("reciprocalKernel", order, std::vector<float> {  0.025, 0.1, 0.025,
+                                                                                   0.1, 0.5, 0.1,
+                                                                                   0.025, 0.1, 0.025   });
+    const Kernel fractionalKernel("fractionalKernel", order, std::vector<float> {  0.1, 0.15, 0.1,
+                                                                                   0.15, 0, 0.15,
+                                                                                   0.1, 0.15, 0.1   });
+
+    EXPECT_TRUE(ImageProcessing::isFixedPoint(*KernelFactory::createEdgeDetectionKernel(order)));
+    EXPECT_TRUE(ImageProcessing::isFixedPoint(*KernelFactory::createBoxBlurKernel(order)));
+    EXPECT_TRUE(ImageProcessing::isFixedPoint(reciprocalKernel));
+    EXPECT_FALSE(ImageProcessing::isFixedPoint(fractionalKernel));
+}
+
+TEST_F(ImageProcessingTest, testFixedPointConvolutionWhenKernelIsEdgeDetection) {
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        // 16-bit lanes up to order 7, 32-bit lanes from order 9
+        for (const unsigned int order : {3, 5, 7, 9}) {
+            const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+            const std::unique_ptr<Image> fixedPointImage =
+                ImageProcessing::fixedPointConvolution(*largeImageToProcess, *kernel, instructionSet);
+            const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, *kernel);
+
+            // integer weights and sums are exact in float as well
+            EXPECT_EQ(fixedPointImage->getHeight(), directImage->getHeight());
+            EXPECT_EQ(fixedPointImage->getWidth(), directImage->getWidth());
+            EXPECT_EQ(fixedPointImage->getReds(), directImage->getReds());
+            EXPECT_EQ(fixedPointImage->getGreens(), directImage->getGreens());
+            EXPECT_EQ(fixedPointImage->getBlues(), directImage->getBlues());
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testFixedPointConvolutionWhenKernelIsBoxBlur) {
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        // 16-bit lanes for order 3, 32-bit lanes for order 13
+        for (const unsigned int order : {3, 13}) {
+            const auto kernel = KernelFactory::createBoxBlurKernel(order);
+
+            const std::unique_ptr<Image> fixedPointImage =
+                ImageProcessing::fixedPointConvolution(*largeImageToProcess, *kernel, instructionSet);
+            const std::unique_ptr<Image> boxFilterImage = ImageProcessing::boxFilterConvolution(*largeImageToProcess, *kernel);
+
+            // both engines compute the exact mean
+            EXPECT_EQ(fixedPointImage->getReds(), boxFilterImage->getReds());
+            EXPECT_EQ(fixedPointImage->getGreens(), boxFilterImage->getGreens());
+            EXPECT_EQ(fixedPointImage->getBlues(), boxFilterImage->getBlues());
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testFixedPointConvolutionMatchesDirectConvolution) {
+    constexpr unsigned int order = 3;
+    const Kernel kernel("reciprocalKernel", order, std::vector<float> {  0.025, 0.1, 0.025,
+                                                                         0.1, 0.5, 0.1,
+                                                                         0.025, 0.1, 0.025   });
+
+    const std::unique_ptr<Image> fixedPointImage = ImageProcessing::fixedPointConvolution(*largeImageToProcess, kernel);
+    const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, kernel);
+
+    ASSERT_EQ(fixedPointImage->getReds().size(), directImage->getReds().size());
+    for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+        EXPECT_NEAR(fixedPointImage->getReds()[k], directImage->getReds()[k], ImageProcessing::FIXED_POINT_TOLERANCE);
+        EXPECT_NEAR(fixedPointImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::FIXED_POINT_TOLERANCE);
+        EXPECT_NEAR(fixedPointImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::FIXED_POINT_TOLERANCE);
+    }
+}
+
+TEST_F(ImageProcessingTest, testConvolutionKeepsWideFixedPointKernelsExact) {
+    // sums overflow 16-bit integers but stay exact in float, and the kernel is large enough for the transforms
+    // to be faster: either the fixed-point engine or the float taps are picked, by cost
+    constexpr unsigned int order = 41;
+    std::vector<float> weights(order * order);
+    for (unsigned int k = 0; k < order * order; k++)
+        weights[k] = (k * 2654435761U >> 7) % 2 ? 1.0f : -1.0f;
+    const Kernel kernel("signKernel", order, weights);
+    constexpr unsigned int wideHeight = 600;
+    constexpr unsigned int wideWidth = 700;
+    ASSERT_TRUE(ImageProcessing::isFixedPoint(kernel));
+    ASSERT_TRUE(ImageProcessing::isFftFaster(order, wideWidth - order + 1, wideHeight - order + 1));
+    std::vector<uint8_t> widePlane(wideWidth * wideHeight);
+    for (unsigned int k = 0; k < wideWidth * wideHeight; k++)
+        widePlane[k] = static_cast<uint8_t>(k * 7919 % 251);
+    const Image wideImage(wideWidth, wideHeight, widePlane, widePlane, widePlane);
+
+    const std::unique_ptr<Image> convolvedImage = ImageProcessing::convolution(wideImage, kernel);
+    const std::unique_ptr<Image> fixedPointImage = ImageProcessing::fixedPointConvolution(wideImage, kernel);
+    const std::unique_ptr<Image> vectorizedImage = ImageProcessing::vectorizedConvolution(wideImage, kernel);
+
+    EXPECT_EQ(convolvedImage->getReds(), fixedPointImage->getReds());
+    EXPECT_EQ(convolvedImage->getGreens(), fixedPointImage->getGreens());
+    EXPECT_EQ(convolvedImage->getBlues(), fixedPointImage->getBlues());
+    EXPECT_EQ(convolvedImage->getReds(), vectorizedImage->getReds());
+}
+
+TEST_F(ImageProcessingTest, testConvolutionKeepsFixedPointKernelsBeyondFloatPrecisionOnFixedPointEngine) {
+    // opposite corner weights cancel out on diagonal stripes, but their partial sums exceed 2^24, thus the float
+    // taps would round away the other weights
+    constexpr unsigned int order = 5;
+    constexpr float cornerWeight = (1 << 20) + 1;
+    std::vector<float> weights(order * order);
+    for (unsigned int k = 0; k < order * order; k++)
+        weights[k] = static_cast<float>(k % 3 + 1) * (k % 2 ? 1.0f : -1.0f);
+    weights.front() = cornerWeight;
+    weights.back() = -cornerWeight;
+    const Kernel kernel("cornerKernel", order, weights);
+    constexpr unsigned int stripedHeight = 48;
+    constexpr unsigned int stripedWidth = 80;
+    ASSERT_TRUE(ImageProcessing::isFixedPoint(kernel));
+    std::vector<uint8_t> stripedPlane(stripedWidth * stripedHeight);
+    for (unsigned int row = 0; row < stripedHeight; row++) {
+        for (unsigned int column = 0; column < stripedWidth; column++)
+            stripedPlane[row * stripedWidth + column] =
+                static_cast<uint8_t>((row + stripedWidth - column) * 37 % 251);
+    }
+    const Image stripedImage(stripedWidth, stripedHeight, stripedPlane, stripedPlane, stripedPlane);
+
+    const std::unique_ptr<Image> convolvedImage = ImageProcessing::convolution(stripedImage, kernel);
+    const std::unique_ptr<Image> fixedPointImage = ImageProcessing::fixedPointConvolution(stripedImage, kernel);
+
+    EXPECT_EQ(convolvedImage->getReds(), fixedPointImage->getReds());
+    EXPECT_EQ(convolvedImage->getGreens(), fixedPointImage->getGreens());
+    EXPECT_EQ(convolvedImage->getBlues(), fixedPointImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testFixedPointConvolutionWhenKernelIsNotFixedPoint) {
+    constexpr unsigned int order = 3;
+    const Kernel kernel("fractionalKernel", order, std::vector<float> {  0.1, 0.15, 0.1,
+                                                                         0.15, 0, 0.15,
+                                                                         0.1, 0.15, 0.1   });
+
+    EXPECT_THROW(ImageProcessing::fixedPointConvolution(*imageToProcess, kernel), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testIsSymmetric) {
+    constexpr unsigned int order = 3;
+    const Kernel horizontalKernel("horizontalKernel", order, std::vector<float> {  0.1, 0.2, 0.1,
+                                                                                   0.3, 0.4, 0.3,
+                                                                                   0.5, 0.6, 0.5   });
+    const Kernel asymmetricKernel("asymmetricKernel", order, std::vector<float> {  0.1, 0.2, 0.3,
+                                                                                   0.4, 0.5, 0.6,
+                                                                                   0.7, 0.8, 0.9   });
+
+    EXPECT_TRUE(ImageProcessing::isSymmetric(*KernelFactory::createEdgeDetectionKernel(order)));
+    EXPECT_TRUE(ImageProcessing::isSymmetric(*KernelFactory::createSharpenKernel(order)));
+    EXPECT_TRUE(ImageProcessing::isSymmetric(horizontalKernel));
+    EXPECT_FALSE(ImageProcessing::isSymmetric(asymmetricKernel));
+}
+
+TEST_F(ImageProcessingTest, testSymmetricConvolutionMatchesDirectConvolution) {
+    constexpr unsigned int order = 5;
+    // symmetric under vertical flips only, with fractional weights
+    std::vector<float> weights(order * order);
+    for (unsigned int j = 0; j < order; j++) {
+        const unsigned int mirroredRow = std::min(j, order - 1 - j);
+        for (unsigned int i = 0; i < order; i++)
+            weights[j * order + i] = 0.013f * static_cast<float>(mirroredRow * order + i) - 0.05f;
+    }
+    const std::vector<Kernel> kernels = {*KernelFactory::createEdgeDetectionKernel(3),
+        *KernelFactory::createEdgeDetectionKernel(9), *KernelFactory::createSharpenKernel(7),
+        Kernel("verticalKernel", order, weights)};
+
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        for (const Kernel& kernel : kernels) {
+            const std::unique_ptr<Image> symmetricImage =
+                ImageProcessing::symmetricConvolution(*largeImageToProcess, kernel, instructionSet);
+            const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, kernel);
+
+            EXPECT_EQ(symmetricImage->getHeight(), directImage->getHeight());
+            EXPECT_EQ(symmetricImage->getWidth(), directImage->getWidth());
+            ASSERT_EQ(symmetricImage->getReds().size(), directImage->getReds().size());
+            for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+                EXPECT_NEAR(symmetricImage->getReds()[k], directImage->getReds()[k], ImageProcessing::SYMMETRIC_TOLERANCE);
+                EXPECT_NEAR(symmetricImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::SYMMETRIC_TOLERANCE);
+                EXPECT_NEAR(symmetricImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::SYMMETRIC_TOLERANCE);
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testSymmetricConvolutionWhenKernelIsAsymmetric) {
+    constexpr unsigned int order = 3;
+    const Kernel kernel("asymmetricKernel", order, std::vector<float> {  0.1, 0.2, 0.3,
+                                                                         0.4, 0.5, 0.6,
+                                                                         0.7, 0.8, 0.9   });
+
+    const std::unique_ptr<Image> symmetricImage = ImageProcessing::symmetricConvolution(*largeImageToProcess, kernel);
+    const std::unique_ptr<Image> vectorizedImage = ImageProcessing::vectorizedConvolution(*largeImageToProcess, kernel);
+
+    // the vectorized engine is the fallback
+    EXPECT_EQ(symmetricImage->getReds(), vectorizedImage->getReds());
+    EXPECT_EQ(symmetricImage->getGreens(), vectorizedImage->getGreens());
+    EXPECT_EQ(symmetricImage->getBlues(), vectorizedImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testIsSparseFaster) {
+    EXPECT_TRUE(ImageProcessing::isSparseFaster(*KernelFactory::createSharpenKernel(13)));
+    EXPECT_FALSE(ImageProcessing::isSparseFaster(*KernelFactory::createEdgeDetectionKernel(13)));
+}
+
+TEST_F(ImageProcessingTest, testSparseConvolutionWhenKernelIsSharpen) {
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        for (const unsigned int order : {3, 5, 9}) {
+            const auto kernel = KernelFactory::createSharpenKernel(order);
+
+            const std::unique_ptr<Image> sparseImage =
+                ImageProcessing::sparseConvolution(*largeImageToProcess, *kernel, instructionSet);
+            const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, *kernel);
+
+            // integer weights and sums are exact in float
+            EXPECT_EQ(sparseImage->getHeight(), directImage->getHeight());
+            EXPECT_EQ(sparseImage->getWidth(), directImage->getWidth());
+            EXPECT_EQ(sparseImage->getReds(), directImage->getReds());
+            EXPECT_EQ(sparseImage->getGreens(), directImage->getGreens());
+            EXPECT_EQ(sparseImage->getBlues(), directImage->getBlues());
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testSparseConvolutionIsBitIdenticalToVectorizedConvolution) {
+    constexpr unsigned int order = 7;
+    // dilated kernel, whose taps are spaced by 3 pixels
+    std::vector<float> weights(order * order, 0);
+    for (unsigned int j = 0; j < order; j += 3) {
+        for (unsigned int i = 0; i < order; i += 3)
+            weights[j * order + i] = 0.037f * static_cast<float>(j * order + i + 1);
+    }
+    const Kernel kernel("dilatedKernel", order, weights);
+
+    for (const InstructionSet instructionSet :
+        {InstructionSet::scalar, InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        const std::unique_ptr<Image> sparseImage =
+            ImageProcessing::sparseConvolution(*largeImageToProcess, kernel, instructionSet);
+        const std::unique_ptr<Image> vectorizedImage =
+            ImageProcessing::vectorizedConvolution(*largeImageToProcess, kernel, instructionSet);
+
+        // skipped products are zero, so the partial sums are the same
+        EXPECT_EQ(sparseImage->getReds(), vectorizedImage->getReds());
+        EXPECT_EQ(sparseImage->getGreens(), vectorizedImage->getGreens());
+        EXPECT_EQ(sparseImage->getBlues(), vectorizedImage->getBlues());
+    }
+}
+
+TEST_F(ImageProcessingTest, testChooseBlockSize) {
+    const CacheTopology cacheTopology(64, 32 * 1024, 8, 256 * 1024, 0);
+    constexpr unsigned int outputWidth = 7000;
+
+    for (const unsigned int order : {3, 25, 101}) {
+        const unsigned int blockWidth = ImageProcessing::chooseBlockWidth(order, outputWidth, cacheTopology);
+        const unsigned int blockHeight = ImageProcessing::chooseBlockHeight(order, blockWidth, cacheTopology);
+
+        EXPECT_EQ(blockWidth % 64, 0);
+        EXPECT_LE(order * (blockWidth + order - 1), cacheTopology.getL2Size() / 2);
+        EXPECT_GE(blockHeight, 1);
+        EXPECT_LE((blockHeight + order - 1) * (blockWidth + order - 1) + blockHeight * blockWidth,
+            cacheTopology.getL2Size() / 2);
+    }
+    // small orders fit the level 1 cache
+    EXPECT_LE(3 * (ImageProcessing::chooseBlockWidth(3, outputWidth, cacheTopology) + 2),
+        cacheTopology.getL1DataSize() / 2);
+    EXPECT_EQ(ImageProcessing::chooseBlockWidth(3, 100, cacheTopology), 128);
+}
+
+TEST_F(ImageProcessingTest, testBlockedConvolutionIsBitIdenticalToVectorizedConvolution) {
+    // tiny caches, so that the image is split into several blocks, partial ones included
+    const CacheTopology cacheTopology(64, 256, 2, 1024, 0);
+    constexpr unsigned int blockedHeight = 29;
+    constexpr unsigned int blockedWidth = 150;
+    std::vector<uint8_t> blockedReds(blockedWidth * blockedHeight);
+    std::vector<uint8_t> blockedGreens(blockedWidth * blockedHeight);
+    std::vector<uint8_t> blockedBlues(blockedWidth * blockedHeight);
+    for (unsigned int k = 0; k < blockedWidth * blockedHeight; k++) {
+        blockedReds[k] = static_cast<uint8_t>(k * 37 % 256);
+        blockedGreens[k] = static_cast<uint8_t>(k * 91 % 256);
+        blockedBlues[k] = static_cast<uint8_t>(k * 13 % 256);
+    }
+    const Image blockedImage(blockedWidth, blockedHeight, blockedReds, blockedGreens, blockedBlues);
+
+    for (const unsigned int order : {3, 7}) {
+        const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+        const std::unique_ptr<Image> blockedConvolvedImage =
+            ImageProcessing::blockedConvolution(blockedImage, *kernel, cacheTopology);
+        const std::unique_ptr<Image> vectorizedImage = ImageProcessing::vectorizedConvolution(blockedImage, *kernel);
+
+        EXPECT_EQ(blockedConvolvedImage->getHeight(), vectorizedImage->getHeight());
+        EXPECT_EQ(blockedConvolvedImage->getWidth(), vectorizedImage->getWidth());
+        EXPECT_EQ(blockedConvolvedImage->getReds(), vectorizedImage->getReds());
+        EXPECT_EQ(blockedConvolvedImage->getGreens(), vectorizedImage->getGreens());
+        EXPECT_EQ(blockedConvolvedImage->getBlues(), vectorizedImage->getBlues());
+    }
+}
+
+TEST_F(ImageProcessingTest, testFftConvolutionMatchesDirectConvolution) {
+    // spans several tiles of the smallest size, partial ones included
+    constexpr unsigned int fftHeight = 71;
+    constexpr unsigned int fftWidth = 97;
+    std::vector<uint8_t> fftReds(fftWidth * fftHeight);
+    std::vector<uint8_t> fftGreens(fftWidth * fftHeight);
+    std::vector<uint8_t> fftBlues(fftWidth * fftHeight);
+    for (unsigned int k = 0; k < fftWidth * fftHeight; k++) {
+        fftReds[k] = static_cast<uint8_t>(k * 37 % 256);
+        fftGreens[k] = static_cast<uint8_t>(k * 91 % 256);
+        fftBlues[k] = static_cast<uint8_t>(k * 13 % 256);
+    }
+    const Image fftImage(fftWidth, fftHeight, fftReds, fftGreens, fftBlues);
+
+    for (const unsigned int order : {3, 7, 13}) {
+        const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+        const std::unique_ptr<Image> fftConvolvedImage = ImageProcessing::fftConvolution(fftImage, *kernel);
+        const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(fftImage, *kernel);
+
+        EXPECT_EQ(fftConvolvedImage->getHeight(), directImage->getHeight());
+        EXPECT_EQ(fftConvolvedImage->getWidth(), directImage->getWidth());
+        ASSERT_EQ(fftConvolvedImage->getReds().size(), directImage->getReds().size());
+        for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+            EXPECT_NEAR(fftConvolvedImage->getReds()[k], directImage->getReds()[k], ImageProcessing::FFT_TOLERANCE);
+            EXPECT_NEAR(fftConvolvedImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::FFT_TOLERANCE);
+            EXPECT_NEAR(fftConvolvedImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::FFT_TOLERANCE);
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testFftConvolutionWhenKernelIsAsymmetric) {
+    constexpr unsigned int order = 3;
+    const Kernel kernel("asymmetricKernel", order, std::vector<float> {  0.5, 0.25, 0,
+                                                                         0, 0, 0,
+                                                                         0, 0, 0.25   });
+
+    const std::unique_ptr<Image> fftConvolvedImage = ImageProcessing::fftConvolution(*largeImageToProcess, kernel);
+    const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*largeImageToProcess, kernel);
+
+    ASSERT_EQ(fftConvolvedImage->getReds().size(), directImage->getReds().size());
+    for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+        EXPECT_NEAR(fftConvolvedImage->getReds()[k], directImage->getReds()[k], ImageProcessing::FFT_TOLERANCE);
+        EXPECT_NEAR(fftConvolvedImage->getGreens()[k], directImage->getGreens()[k], ImageProcessing::FFT_TOLERANCE);
+        EXPECT_NEAR(fftConvolvedImage->getBlues()[k], directImage->getBlues()[k], ImageProcessing::FFT_TOLERANCE);
+    }
+}
+
+TEST_F(ImageProcessingTest, testFftConvolutionIsExactOnFlatPlanes) {
+    constexpr unsigned int order = 41;
+    std::vector<float> weights(order * order);
+    float sum = 0;
+    for (unsigned int k = 0; k < order * order; k++) {
+        weights[k] = static_cast<float>(1 + k * 31 % 17);
+        sum += weights[k];
+    }
+    for (float& weight : weights)
+        weight /= sum;
+    const Kernel kernel("normalizedKernel", order, weights);
+
+    constexpr unsigned int flatHeight = 120;
+    constexpr unsigned int flatWidth = 160;
+    const std::vector<uint8_t> flatPlane(flatWidth * flatHeight, 100);
+    const Image flatImage(flatWidth, flatHeight, flatPlane, flatPlane, flatPlane);
+
+    const std::unique_ptr<Image> fftConvolvedImage = ImageProcessing::fftConvolution(flatImage, kernel);
+    const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(flatImage, kernel);
+
+    EXPECT_EQ(fftConvolvedImage->getReds(), directImage->getReds());
+    EXPECT_EQ(fftConvolvedImage->getGreens(), directImage->getGreens());
+    EXPECT_EQ(fftConvolvedImage->getBlues(), directImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testFftConvolutionIsExactWhenWeightsAreIntegers) {
+    constexpr unsigned int order = 41;
+    std::vector<float> weights(order * order);
+    for (unsigned int k = 0; k < order * order; k++)
+        weights[k] = (k * 2654435761U >> 7) % 2 ? 1.0f : -1.0f;
+    const Kernel kernel("signKernel", order, weights);
+
+    constexpr unsigned int noiseHeight = 120;
+    constexpr unsigned int noiseWidth = 160;
+    std::vector<uint8_t> noiseReds(noiseWidth * noiseHeight);
+    std::vector<uint8_t> noiseGreens(noiseWidth * noiseHeight);
+    std::vector<uint8_t> noiseBlues(noiseWidth * noiseHeight);
+    for (unsigned int k = 0; k < noiseWidth * noiseHeight; k++) {
+        noiseReds[k] = static_cast<uint8_t>(k * 7919 % 251);
+        noiseGreens[k] = static_cast<uint8_t>(k * 91 % 256);
+        noiseBlues[k] = static_cast<uint8_t>(k * 13 % 256);
+    }
+    const Image noiseImage(noiseWidth, noiseHeight, noiseReds, noiseGreens, noiseBlues);
+
+    const std::unique_ptr<Image> fftConvolvedImage = ImageProcessing::fftConvolution(noiseImage, kernel);
+    const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(noiseImage, kernel);
+
+    EXPECT_EQ(fftConvolvedImage->getReds(), directImage->getReds());
+    EXPECT_EQ(fftConvolvedImage->getGreens(), directImage->getGreens());
+    EXPECT_EQ(fftConvolvedImage->getBlues(), directImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testIsFftFaster) {
+    EXPECT_FALSE(ImageProcessing::isFftFaster(3, 4000, 2000));
+    EXPECT_TRUE(ImageProcessing::isFftFaster(101, 4000, 2000));
+}
+
+TEST_F(ImageProcessingTest, testParallelConvolutionIsBitIdenticalToConvolution) {
+    constexpr unsigned int order = 5;
+    const std::vector<float> profile = {1, 4, 6, 4, 1};
+    std::vector<float> weights(order * order);
+    for (unsigned int j = 0; j < order; j++)
+        for (unsigned int i = 0; i < order; i++)
+            weights[j * order + i] = profile[j] * profile[i] / 256;
+    const Kernel gaussianKernel("gaussianKernel", order, weights);
+    const std::unique_ptr<Kernel> boxBlurKernel = KernelFactory::createBoxBlurKernel(order);
+    const std::unique_ptr<Kernel> edgeDetectionKernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    for (const unsigned int numThreads : {1, 3, 8}) {
+        ThreadPool threadPool(numThreads);
+        for (const Kernel* kernel : {&gaussianKernel, static_cast<const Kernel*>(boxBlurKernel.get()),
+            static_cast<const Kernel*>(edgeDetectionKernel.get())}) {
+            const std::unique_ptr<Image> parallelImage =
+                ImageProcessing::parallelConvolution(*largeImageToProcess, *kernel, threadPool);
+            const std::unique_ptr<Image> sequentialImage = ImageProcessing::convolution(*largeImageToProcess, *kernel);
+
+            EXPECT_EQ(parallelImage->getHeight(), sequentialImage->getHeight());
+            EXPECT_EQ(parallelImage->getWidth(), sequentialImage->getWidth());
+            EXPECT_EQ(parallelImage->getReds(), sequentialImage->getReds());
+            EXPECT_EQ(parallelImage->getGreens(), sequentialImage->getGreens());
+            EXPECT_EQ(parallelImage->getBlues(), sequentialImage->getBlues());
+        }
+    }
+
+    // large enough for the FFT engine, whose tiles straddle the bands
+    constexpr unsigned int fftOrder = 41;
+    std::vector<float> fftWeights(fftOrder * fftOrder);
+    float sum = 0;
+    for (unsigned int k = 0; k < fftOrder * fftOrder; k++) {
+        fftWeights[k] = static_cast<float>(1 + k * 31 % 17);
+        sum += fftWeights[k];
+    }
+    for (float& weight : fftWeights)
+        weight /= sum;
+    const Kernel fftKernel("fftKernel", fftOrder, fftWeights);
+    constexpr unsigned int fftHeight = 600;
+    constexpr unsigned int fftWidth = 700;
+    ASSERT_TRUE(ImageProcessing::isFftFaster(fftOrder, fftWidth - fftOrder + 1, fftHeight - fftOrder + 1));
+    std::vector<uint8_t> fftPlane(fftWidth * fftHeight);
+    for (unsigned int k = 0; k < fftWidth * fftHeight; k++)
+        fftPlane[k] = static_cast<uint8_t>(k * 7919 % 251);
+    const Image fftImage(fftWidth, fftHeight, fftPlane, fftPlane, fftPlane);
+
+    const std::unique_ptr<Image> sequentialImage = ImageProcessing::convolution(fftImage, fftKernel);
+    for (const unsigned int numThreads : {3, 8}) {
+        ThreadPool threadPool(numThreads);
+        const std::unique_ptr<Image> parallelImage = ImageProcessing::parallelConvolution(fftImage, fftKernel, threadPool);
+
+        EXPECT_EQ(parallelImage->getReds(), sequentialImage->getReds());
+        EXPECT_EQ(parallelImage->getGreens(), sequentialImage->getGreens());
+        EXPECT_EQ(parallelImage->getBlues(), sequentialImage->getBlues());
+    }
+}
+
+/**
+ * Builds the padded image that the given edge policy resolves virtually, by reflecting, wrapping
+ * or clamping each coordinate on its own.
+ */
+std::unique_ptr<Image> padImage(const Image& image, const unsigned int padding,
+    const ImageProcessing::EdgePolicy edgePolicy) {
+    const int width = static_cast<int>(image.getWidth());
+    const int height = static_cast<int>(image.getHeight());
+    const auto resolve = [edgePolicy](int coordinate, const int size) {
+        if (edgePolicy == ImageProcessing::EdgePolicy::extend)
+            return std::min(std::max(coordinate, 0), size - 1);
+        if (edgePolicy == ImageProcessing::EdgePolicy::wrap)
+            return ((coordinate % size) + size) % size;
+        if (edgePolicy == ImageProcessing::EdgePolicy::mirror) {
+            while (size > 1 && (coordinate < 0 || coordinate >= size))
+                coordinate = coordinate < 0 ? -coordinate : 2 * (size - 1) - coordinate;
+            return size > 1 ? coordinate : 0;
+        }
+        return coordinate >= 0 && coordinate < size ? coordinate : -1;
+    };
+
+    const unsigned int paddedWidth = width + 2 * padding;
+    const unsigned int paddedHeight = height + 2 * padding;
+    const std::vector<uint8_t> planes[3] = {image.getReds(), image.getGreens(), image.getBlues()};
+    std::vector<uint8_t> paddedPlanes[3];
+    for (unsigned int c = 0; c < 3; c++) {
+        paddedPlanes[c].resize(paddedWidth * paddedHeight);
+        for (unsigned int y = 0; y < paddedHeight; y++) {
+            for (unsigned int x = 0; x < paddedWidth; x++) {
+                const int row = resolve(static_cast<int>(y) - static_cast<int>(padding), height);
+                const int column = resolve(static_cast<int>(x) - static_cast<int>(padding), width);
+                paddedPlanes[c][y * paddedWidth + x] = row < 0 || column < 0 ? 0 : planes[c][row * width + column];
+            }
+        }
+    }
+    return std::make_unique<Image>(paddedWidth, paddedHeight, paddedPlanes[0], paddedPlanes[1], paddedPlanes[2]);
+}
+
+TEST_F(ImageProcessingTest, testConvolutionWithEdgePolicyMatchesPaddedConvolution) {
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::extend,
+        ImageProcessing::EdgePolicy::constant, ImageProcessing::EdgePolicy::wrap, ImageProcessing::EdgePolicy::mirror}) {
+        // the 5x3 image is smaller than the 5x5 kernels, so that it has no interior at all
+        for (const Image* image : {imageToProcess, largeImageToProcess}) {
+            for (const unsigned int order : {3, 5, 9}) {
+                const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+                const std::unique_ptr<Image> edgeImage = ImageProcessing::convolution(*image, *kernel, edgePolicy);
+                const std::unique_ptr<Image> paddedImage = padImage(*image, order / 2, edgePolicy);
+                const std::unique_ptr<Image> directImage = ImageProcessing::directConvolution(*paddedImage, *kernel);
+
+                EXPECT_EQ(edgeImage->getHeight(), image->getHeight());
+                EXPECT_EQ(edgeImage->getWidth(), image->getWidth());
+                ASSERT_EQ(edgeImage->getReds().size(), directImage->getReds().size());
+                for (unsigned int k = 0; k < directImage->getReds().size(); k++) {
+                    EXPECT_NEAR(edgeImage->getReds()[k], directImage->getReds()[k], 1);
+                    EXPECT_NEAR(edgeImage->getGreens()[k], directImage->getGreens()[k], 1);
+                    EXPECT_NEAR(edgeImage->getBlues()[k], directImage->getBlues()[k], 1);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testConvolutionWithExtendPolicyMatchesExtendEdge) {
+    constexpr unsigned int order = 7;
+    const auto kernel = KernelFactory::createSharpenKernel(order);
+
+    const std::unique_ptr<Image> edgeImage =
+        ImageProcessing::convolution(*largeImageToProcess, *kernel, ImageProcessing::EdgePolicy::extend);
+    const std::unique_ptr<Image> extendedImage = ImageProcessing::extendEdge(*largeImageToProcess, order / 2);
+    const std::unique_ptr<Image> paddedImage = ImageProcessing::convolution(*extendedImage, *kernel);
+
+    // integer weights and sums are exact in every engine
+    EXPECT_EQ(edgeImage->getReds(), paddedImage->getReds());
+    EXPECT_EQ(edgeImage->getGreens(), paddedImage->getGreens());
+    EXPECT_EQ(edgeImage->getBlues(), paddedImage->getBlues());
+}
+
+TEST_F(ImageProcessingTest, testConvolutionWithCropPolicy) {
+    constexpr unsigned int order = 3;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    const std::unique_ptr<Image> edgeImage =
+        ImageProcessing::convolution(*largeImageToProcess, *kernel, ImageProcessing::EdgePolicy::crop);
+    const std::unique_ptr<Image> croppedImage = ImageProcessing::convolution(*largeImageToProcess, *kernel);
+
+    EXPECT_EQ(edgeImage->getWidth(), croppedImage->getWidth());
+    EXPECT_EQ(edgeImage->getHeight(), croppedImage->getHeight());
+    EXPECT_EQ(edgeImage->getReds(), croppedImage->getReds());
+}
+
+TEST_F(ImageProcessingTest, testParallelConvolutionWithEdgePolicyIsBitIdenticalToConvolution) {
+    constexpr unsigned int order = 5;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    for (const unsigned int numThreads : {1, 3}) {
+        ThreadPool threadPool(numThreads);
+        const std::unique_ptr<Image> parallelImage = ImageProcessing::parallelConvolution(*largeImageToProcess,
+            *kernel, threadPool, ImageProcessing::EdgePolicy::mirror);
+        const std::unique_ptr<Image> sequentialImage =
+            ImageProcessing::convolution(*largeImageToProcess, *kernel, ImageProcessing::EdgePolicy::mirror);
+
+        EXPECT_EQ(parallelImage->getReds(), sequentialImage->getReds());
+        EXPECT_EQ(parallelImage->getGreens(), sequentialImage->getGreens());
+        EXPECT_EQ(parallelImage->getBlues(), sequentialImage->getBlues());
+    }
+}
+
+TEST_F(ImageProcessingTest, testPipelineConvolutionMatchesStagedConvolutions) {
+    const std::vector<std::vector<Kernel>> chains = {
+        {*KernelFactory::createBoxBlurKernel(3), *KernelFactory::createEdgeDetectionKernel(5)},
+        {*KernelFactory::createEdgeDetectionKernel(3), *KernelFactory::createSharpenKernel(5),
+            *KernelFactory::createBoxBlurKernel(7)}};
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::crop,
+        ImageProcessing::EdgePolicy::extend, ImageProcessing::EdgePolicy::constant,
+        ImageProcessing::EdgePolicy::mirror}) {
+        for (const std::vector<Kernel> &kernels : chains) {
+            const std::unique_ptr<Image> pipelineImage =
+                ImageProcessing::pipelineConvolution(*largeImageToProcess, kernels, edgePolicy);
+            std::unique_ptr<Image> stagedImage = std::make_unique<Image>(*largeImageToProcess);
+            for (const Kernel &kernel : kernels)
+                stagedImage = ImageProcessing::convolution(*stagedImage, kernel, edgePolicy);
+
+            EXPECT_EQ(pipelineImage->getWidth(), stagedImage->getWidth());
+            EXPECT_EQ(pipelineImage->getHeight(), stagedImage->getHeight());
+            EXPECT_EQ(pipelineImage->getReds(), stagedImage->getReds());
+            EXPECT_EQ(pipelineImage->getGreens(), stagedImage->getGreens());
+            EXPECT_EQ(pipelineImage->getBlues(), stagedImage->getBlues());
+        }
+    }
+
+    // the last kernel is large enough for convolution to pick the FFT engine, which stages replace by direct ones
+    constexpr unsigned int fftOrder = 41;
+    std::vector<float> fftWeights(fftOrder * fftOrder);
+    float sum = 0;
+    for (unsigned int k = 0; k < fftOrder * fftOrder; k++) {
+        fftWeights[k] = static_cast<float>(1 + k * 31 % 17);
+        sum += fftWeights[k];
+    }
+    for (float& weight : fftWeights)
+        weight /= sum;
+    const std::vector<Kernel> fftKernels = {*KernelFactory::createBoxBlurKernel(3),
+        Kernel("fftKernel", fftOrder, fftWeights)};
+    constexpr unsigned int fftHeight = 600;
+    constexpr unsigned int fftWidth = 700;
+    ASSERT_TRUE(ImageProcessing::isFftFaster(fftOrder, fftWidth - fftOrder - 1, fftHeight - fftOrder - 1));
+    std::vector<uint8_t> fftPlane(fftWidth * fftHeight);
+    for (unsigned int k = 0; k < fftWidth * fftHeight; k++)
+        fftPlane[k] = static_cast<uint8_t>(k * 7919 % 251);
+    const Image fftImage(fftWidth, fftHeight, fftPlane, fftPlane, fftPlane);
+
+    const std::unique_ptr<Image> pipelineImage = ImageProcessing::pipelineConvolution(fftImage, fftKernels);
+    const std::unique_ptr<Image> stagedImage =
+        ImageProcessing::convolution(*ImageProcessing::convolution(fftImage, fftKernels[0]), fftKernels[1]);
+
+    // planes are copied once, as they are large
+    const std::vector<uint8_t> pipelineReds = pipelineImage->getReds();
+    const std::vector<uint8_t> pipelineGreens = pipelineImage->getGreens();
+    const std::vector<uint8_t> pipelineBlues = pipelineImage->getBlues();
+    const std::vector<uint8_t> stagedReds = stagedImage->getReds();
+    const std::vector<uint8_t> stagedGreens = stagedImage->getGreens();
+    const std::vector<uint8_t> stagedBlues = stagedImage->getBlues();
+    ASSERT_EQ(pipelineReds.size(), stagedReds.size());
+    for (unsigned int k = 0; k < stagedReds.size(); k++) {
+        EXPECT_NEAR(pipelineReds[k], stagedReds[k], ImageProcessing::FFT_TOLERANCE);
+        EXPECT_NEAR(pipelineGreens[k], stagedGreens[k], ImageProcessing::FFT_TOLERANCE);
+        EXPECT_NEAR(pipelineBlues[k], stagedBlues[k], ImageProcessing::FFT_TOLERANCE);
+    }
+}
+
+TEST_F(ImageProcessingTest, testPipelineConvolutionWhenImageIsSmallerThanKernels) {
+    // the 5x3 image is smaller than the 5x5 kernel, so that every row is resolved by the policy
+    const std::vector<Kernel> kernels = {*KernelFactory::createEdgeDetectionKernel(5),
+        *KernelFactory::createBoxBlurKernel(3)};
+
+    const std::unique_ptr<Image> pipelineImage =
+        ImageProcessing::pipelineConvolution(*imageToProcess, kernels, ImageProcessing::EdgePolicy::mirror);
+    const std::unique_ptr<Image> stagedImage = ImageProcessing::convolution(
+        *ImageProcessing::convolution(*imageToProcess, kernels[0], ImageProcessing::EdgePolicy::mirror),
+        kernels[1], ImageProcessing::EdgePolicy::mirror);
+
+    EXPECT_EQ(pipelineImage->getReds(), stagedImage->getReds());
+    EXPECT_EQ(pipelineImage->getGreens(), stagedImage->getGreens());
+    EXPECT_EQ(pipelineImage->getBlues(), stagedImage->getBlues());
+    EXPECT_THROW(ImageProcessing::pipelineConvolution(*imageToProcess, kernels), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testPipelineConvolutionWhenArgumentsAreInvalid) {
+    const std::vector<Kernel> kernels = {*KernelFactory::createBoxBlurKernel(3)};
+
+    EXPECT_THROW(ImageProcessing::pipelineConvolution(*largeImageToProcess, std::vector<Kernel>()),
+        std::invalid_argument);
+    EXPECT_THROW(ImageProcessing::pipelineConvolution(*largeImageToProcess, kernels,
+        ImageProcessing::EdgePolicy::wrap), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testStreamConvolutionIsBitIdenticalToPipelineConvolution) {
+    const std::vector<std::vector<Kernel>> chains = {
+        {*KernelFactory::createBoxBlurKernel(3)},
+        {*KernelFactory::createEdgeDetectionKernel(3), *KernelFactory::createSharpenKernel(5),
+            *KernelFactory::createBoxBlurKernel(7)}};
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::crop,
+        ImageProcessing::EdgePolicy::extend, ImageProcessing::EdgePolicy::constant,
+        ImageProcessing::EdgePolicy::mirror}) {
+        for (const std::vector<Kernel> &kernels : chains) {
+            const std::unique_ptr<Image> pipelineImage =
+                ImageProcessing::pipelineConvolution(*largeImageToProcess, kernels, edgePolicy);
+            ImageRowReader reader(*largeImageToProcess);
+            BufferRowWriter writer(pipelineImage->getWidth(), pipelineImage->getHeight());
+
+            ImageProcessing::streamConvolution(reader, kernels, edgePolicy, writer);
+            const Image streamImage(std::move(writer.buffer));
+
+            // the image is taller than a strip, which bounds the rows read at once
+            EXPECT_EQ(reader.getNextRow(), largeHeight);
+            EXPECT_EQ(writer.getNextRow(), pipelineImage->getHeight());
+            EXPECT_LT(reader.maxStripHeight, largeHeight);
+            EXPECT_EQ(streamImage.getReds(), pipelineImage->getReds());
+            EXPECT_EQ(streamImage.getGreens(), pipelineImage->getGreens());
+            EXPECT_EQ(streamImage.getBlues(), pipelineImage->getBlues());
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testStreamConvolutionWhenArgumentsAreInvalid) {
+    const std::vector<Kernel> kernels = {*KernelFactory::createBoxBlurKernel(3)};
+    ImageRowReader reader(*largeImageToProcess);
+    BufferRowWriter writer(largeWidth, largeHeight);
+    BufferRowWriter croppedWriter(largeWidth - 2, largeHeight - 2);
+
+    EXPECT_THROW(ImageProcessing::streamConvolution(reader, std::vector<Kernel>(), ImageProcessing::EdgePolicy::extend,
+        writer), std::invalid_argument);
+    EXPECT_THROW(ImageProcessing::streamConvolution(reader, kernels, ImageProcessing::EdgePolicy::wrap, writer),
+        std::invalid_argument);
+    EXPECT_THROW(ImageProcessing::streamConvolution(reader, kernels, ImageProcessing::EdgePolicy::extend,
+        croppedWriter), std::invalid_argument);
+    EXPECT_EQ(reader.getNextRow(), 0);
+}
+
+TEST_F(ImageProcessingTest, testIsFusionFaster) {
+    const Kernel identity("identity", 1, std::vector<float>{1});
+    const auto boxBlur = KernelFactory::createBoxBlurKernel(25);
+
+    EXPECT_TRUE(ImageProcessing::isFusionFaster({identity, identity}, 1000, 1000));
+    EXPECT_FALSE(ImageProcessing::isFusionFaster({*boxBlur, *boxBlur}, 1000, 1000));
+    EXPECT_THROW(ImageProcessing::isFusionFaster({}, 1000, 1000), std::invalid_argument);
+    EXPECT_THROW(ImageProcessing::isFusionFaster({*boxBlur, *boxBlur}, 40, 1000), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testChainConvolutionFollowsCheaperPlan) {
+    const std::vector<std::vector<Kernel>> chains = {
+        {*KernelFactory::createBoxBlurKernel(3), *KernelFactory::createBoxBlurKernel(5)},
+        {*KernelFactory::createSharpenKernel(3), *KernelFactory::createEdgeDetectionKernel(3)}};
+
+    for (const std::vector<Kernel> &kernels : chains) {
+        const std::unique_ptr<Image> chainImage = ImageProcessing::chainConvolution(*largeImageToProcess, kernels);
+        const std::unique_ptr<Kernel> fusedKernel = KernelFactory::createComposedKernel(kernels[0], kernels[1]);
+        const std::unique_ptr<Image> expectedImage =
+            ImageProcessing::isFusionFaster(kernels, largeWidth, largeHeight) ?
+                ImageProcessing::convolution(*largeImageToProcess, *fusedKernel) :
+                ImageProcessing::pipelineConvolution(*largeImageToProcess, kernels);
+
+        EXPECT_EQ(chainImage->getWidth(), largeWidth - (fusedKernel->getOrder() - 1));
+        EXPECT_EQ(chainImage->getHeight(), largeHeight - (fusedKernel->getOrder() - 1));
+        EXPECT_EQ(chainImage->getReds(), expectedImage->getReds());
+        EXPECT_EQ(chainImage->getGreens(), expectedImage->getGreens());
+        EXPECT_EQ(chainImage->getBlues(), expectedImage->getBlues());
+    }
+}
+
+TEST_F(ImageProcessingTest, testFusedBlursMatchStagedBlurs) {
+    const std::vector<Kernel> kernels = {*KernelFactory::createBoxBlurKernel(3), *KernelFactory::createBoxBlurKernel(5)};
+
+    const std::unique_ptr<Kernel> fusedKernel = KernelFactory::createComposedKernel(kernels[0], kernels[1]);
+    const std::unique_ptr<Image> fusedImage = ImageProcessing::convolution(*largeImageToProcess, *fusedKernel);
+    const std::unique_ptr<Image> stagedImage = ImageProcessing::pipelineConvolution(*largeImageToProcess, kernels);
+
+    // only the truncation of the intermediate image differs
+    ASSERT_EQ(fusedImage->getReds().size(), stagedImage->getReds().size());
+    for (unsigned int k = 0; k < fusedImage->getReds().size(); k++) {
+        EXPECT_NEAR(fusedImage->getReds()[k], stagedImage->getReds()[k], 1);
+        EXPECT_NEAR(fusedImage->getGreens()[k], stagedImage->getGreens()[k], 1);
+        EXPECT_NEAR(fusedImage->getBlues()[k], stagedImage->getBlues()[k], 1);
+    }
+}
+TEST_F(ImageProcessingTest, testConvolutionIntoOutputViewIsBitIdenticalToConvolution) {
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(5);
+    std::vector<uint8_t> reds(largeWidth * largeHeight);
+    std::vector<uint8_t> greens(largeWidth * largeHeight);
+    std::vector<uint8_t> blues(largeWidth * largeHeight);
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::crop,
+        ImageProcessing::EdgePolicy::mirror}) {
+        const std::unique_ptr<Image> expectedImage =
+            ImageProcessing::convolution(*largeImageToProcess, *kernel, edgePolicy);
+        const unsigned int outputSize = expectedImage->getWidth() * expectedImage->getHeight();
+        const MutableImageView output = {expectedImage->getWidth(), expectedImage->getHeight(),
+            expectedImage->getWidth(), reds.data(), greens.data(), blues.data()};
+
+        // repeated convolutions overwrite the same planes
+        for (unsigned int rep = 0; rep < 2; rep++) {
+            ImageProcessing::convolution(*largeImageToProcess, *kernel, edgePolicy, output);
+
+            EXPECT_TRUE(std::equal(reds.begin(), reds.begin() + outputSize, expectedImage->getReds().begin()));
+            EXPECT_TRUE(std::equal(greens.begin(), greens.begin() + outputSize, expectedImage->getGreens().begin()));
+            EXPECT_TRUE(std::equal(blues.begin(), blues.begin() + outputSize, expectedImage->getBlues().begin()));
+        }
+
+        ThreadPool threadPool(3);
+        std::fill(reds.begin(), reds.end(), 0);
+        ImageProcessing::parallelConvolution(*largeImageToProcess, *kernel, threadPool, edgePolicy, output);
+        EXPECT_TRUE(std::equal(reds.begin(), reds.begin() + outputSize, expectedImage->getReds().begin()));
+    }
+}
+
+TEST_F(ImageProcessingTest, testConvolutionIntoOutputViewWhenSizesDiffer) {
+    const auto kernel = KernelFactory::createBoxBlurKernel(3);
+    std::vector<uint8_t> plane(largeWidth * largeHeight);
+    const MutableImageView output = {largeWidth, largeHeight, largeWidth, plane.data(), plane.data(), plane.data()};
+
+    EXPECT_THROW(ImageProcessing::convolution(*largeImageToProcess, *kernel, output), std::invalid_argument);
+    EXPECT_NO_THROW(ImageProcessing::convolution(*largeImageToProcess, *kernel, ImageProcessing::EdgePolicy::extend,
+        output));
+    const MutableImageView narrowOutput = {largeWidth, largeHeight, largeWidth - 1, plane.data(), plane.data(),
+        plane.data()};
+    EXPECT_THROW(ImageProcessing::convolution(*largeImageToProcess, *kernel, ImageProcessing::EdgePolicy::extend,
+        narrowOutput), std::invalid_argument);
+}
+
+TEST_F(ImageProcessingTest, testConvolutionWhenRowsArePadded) {
+    const std::unique_ptr<Kernel> edgeDetectionKernel = KernelFactory::createEdgeDetectionKernel(5);
+    const std::unique_ptr<Kernel> boxBlurKernel = KernelFactory::createBoxBlurKernel(3);
+    const std::unique_ptr<Kernel> sharpenKernel = KernelFactory::createSharpenKernel(3);
+    const std::vector<const Kernel*> kernels = {edgeDetectionKernel.get(), boxBlurKernel.get(), sharpenKernel.get()};
+
+    // unaligned and aligned strides, with planes allocated separately or together
+    for (const unsigned int stride : {largeWidth + 35, 3 * ImageBuffer::ALIGNMENT}) {
+        for (const bool isSingleAllocation : {false, true}) {
+            ImageBuffer buffer(largeWidth, largeHeight, stride, isSingleAllocation);
+            const MutableImageView planes = buffer.view();
+            const std::vector<uint8_t> originalPlanes[3] = {largeImageToProcess->getReds(),
+                largeImageToProcess->getGreens(), largeImageToProcess->getBlues()};
+            for (unsigned int y = 0; y < largeHeight; y++) {
+                std::copy_n(originalPlanes[0].data() + y * largeWidth, largeWidth, planes.reds + y * stride);
+                std::copy_n(originalPlanes[1].data() + y * largeWidth, largeWidth, planes.greens + y * stride);
+                std::copy_n(originalPlanes[2].data() + y * largeWidth, largeWidth, planes.blues + y * stride);
+            }
+            const Image paddedImage(std::move(buffer));
+            ASSERT_EQ(paddedImage.getStride(), stride);
+
+            for (const Kernel* kernel : kernels) {
+                for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::crop,
+                    ImageProcessing::EdgePolicy::mirror}) {
+                    const std::unique_ptr<Image> expectedImage =
+                        ImageProcessing::convolution(*largeImageToProcess, *kernel, edgePolicy);
+                    const std::unique_ptr<Image> paddedOutput =
+                        ImageProcessing::convolution(paddedImage, *kernel, edgePolicy);
+
+                    EXPECT_EQ(paddedOutput->getReds(), expectedImage->getReds());
+                    EXPECT_EQ(paddedOutput->getGreens(), expectedImage->getGreens());
+                    EXPECT_EQ(paddedOutput->getBlues(), expectedImage->getBlues());
+                }
+                const std::unique_ptr<Image> expectedImage =
+                    ImageProcessing::vectorizedConvolution(*largeImageToProcess, *kernel);
+                EXPECT_EQ(ImageProcessing::vectorizedConvolution(paddedImage, *kernel)->getReds(),
+                    expectedImage->getReds());
+                EXPECT_EQ(ImageProcessing::sparseConvolution(paddedImage, *kernel)->getReds(),
+                    ImageProcessing::sparseConvolution(*largeImageToProcess, *kernel)->getReds());
+                EXPECT_EQ(ImageProcessing::symmetricConvolution(paddedImage, *kernel)->getReds(),
+                    ImageProcessing::symmetricConvolution(*largeImageToProcess, *kernel)->getReds());
+                EXPECT_EQ(ImageProcessing::fixedPointConvolution(paddedImage, *kernel)->getReds(),
+                    ImageProcessing::fixedPointConvolution(*largeImageToProcess, *kernel)->getReds());
+                EXPECT_EQ(ImageProcessing::fftConvolution(paddedImage, *kernel)->getReds(),
+                    ImageProcessing::fftConvolution(*largeImageToProcess, *kernel)->getReds());
+            }
+        }
+    }
+}
+
+TEST_F(ImageProcessingTest, testConvolutionIntoOutputViewWhenRowsArePadded) {
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(3);
+    const unsigned int stride = largeWidth + 7;
+    std::vector<uint8_t> reds(stride * largeHeight, 1);
+    std::vector<uint8_t> greens(stride * largeHeight, 1);
+    std::vector<uint8_t> blues(stride * largeHeight, 1);
+    const MutableImageView output = {largeWidth, largeHeight, stride, reds.data(), greens.data(), blues.data()};
+
+    for (const ImageProcessing::EdgePolicy edgePolicy : {ImageProcessing::EdgePolicy::extend,
+        ImageProcessing::EdgePolicy::wrap}) {
+        const std::unique_ptr<Image> expectedImage =
+            ImageProcessing::convolution(*largeImageToProcess, *kernel, edgePolicy);
+        ImageProcessing::convolution(*largeImageToProcess, *kernel, edgePolicy, output);
+
+        const std::vector<uint8_t> expectedReds = expectedImage->getReds();
+        for (unsigned int y = 0; y < largeHeight; y++) {
+            EXPECT_TRUE(std::equal(reds.begin() + y * stride, reds.begin() + y * stride + largeWidth,
+                expectedReds.begin() + y * largeWidth)) << "row " << y;
+        }
+    }
+}
 
 TEST_F(ImageProcessingTest, testExtendEdgeWithPositivePadding) {
     constexpr unsigned int padding = 1;
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include "image/Image.h"
+#include "image/ImageBuffer.h"
+#include "image/ImageView.h"
 
 
 TEST(ImageTest, testConstructor) {
@@ -29,4 +31,56 @@ TEST(ImageTest, testConstructor) {
             EXPECT_EQ(image.getBlues()[y * width + x], blues[y * width + x]);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(ImageTest, testViews) {
+    constexpr unsigned int height = 2;
+    constexpr unsigned int width = 3;
+    const std::vector<uint8_t> reds = {120, 23, 44, 1, 19, 67};
+    const std::vector<uint8_t> greens = {0, 58, 30, 17, 89, 12};
+    const std::vector<uint8_t> blues = {130, 135, 20, 225, 139, 29};
+
+    const Image image(width, height, reds, greens, blues);
+
+    // views refer to the planes stored by the image, thus they are not copies
+    ImageBuffer buffer(width, height);
+    const MutableImageView planes = buffer.view();
+    const Image bufferImage(std::move(buffer));
+    EXPECT_EQ(bufferImage.viewReds().data(), planes.reds);
+    EXPECT_EQ(bufferImage.viewGreens().data(), planes.greens);
+    EXPECT_EQ(bufferImage.viewBlues().data(), planes.blues);
+    // views span the padded rows, which are a stride apart
+    const unsigned int stride = image.getStride();
+    ASSERT_GE(stride, width);
+    ASSERT_EQ(image.viewReds().size(), stride * height);
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            EXPECT_EQ(image.viewReds()[y * stride + x], reds[y * width + x]);
+            EXPECT_EQ(image.viewGreens()[y * stride + x], greens[y * width + x]);
+            EXPECT_EQ(image.viewBlues()[y * stride + x], blues[y * width + x]);
+        }
+    }
+}
+
+TEST(ImageTest, testConstructorWhenSizesDiffer) {
+    const std::vector<uint8_t> plane(6);
+    const std::vector<uint8_t> shorterPlane(5);
+
+    EXPECT_THROW(Image(3, 2, plane, plane, shorterPlane), std::invalid_argument);
+    EXPECT_THROW(Image(2, 2, plane, plane, plane), std::invalid_argument);
+}
+
+TEST(ImageTest, testConstructorWhenBufferIsGiven) {
+    ImageBuffer buffer(3, 2, 5, true);
+    for (unsigned int y = 0; y < 2; y++) {
+        for (unsigned int x = 0; x < 3; x++)
+            buffer.viewGreens()[y * 5 + x] = y * 3 + x;
+    }
+
+    const Image image(std::move(buffer));
+
+    EXPECT_EQ(image.getWidth(), 3);
+    EXPECT_EQ(image.getHeight(), 2);
+    EXPECT_EQ(image.getStride(), 5);
+    EXPECT_EQ(image.getGreens(), std::vector<uint8_t>({0, 1, 2, 3, 4, 5}));
+}
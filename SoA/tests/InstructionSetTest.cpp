@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+#include "processing/simd/InstructionSet.h"
+
+
+TEST(InstructionSetTest, testDetectIsSupported) {
+    const InstructionSet detected = InstructionSets::detect();
+
+    EXPECT_TRUE(InstructionSets::isSupported(detected));
+    EXPECT_TRUE(InstructionSets::isSupported(InstructionSet::scalar));
+    EXPECT_EQ(InstructionSets::detect(), detected);
+}
+
+TEST(InstructionSetTest, testGetName) {
+    EXPECT_EQ(InstructionSets::getName(InstructionSet::scalar), "scalar");
+    EXPECT_EQ(InstructionSets::getName(InstructionSet::sse42), "SSE4.2");
+    EXPECT_EQ(InstructionSets::getName(InstructionSet::avx2), "AVX2");
+    EXPECT_EQ(InstructionSets::getName(InstructionSet::avx512), "AVX-512");
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "image/ImageBuffer.h"
+#include "image/reader/JpegDecoder.h"
+#include "image/reader/JpegEncoder.h"
+#include "processing/parallel/ThreadPool.h"
+
+class JpegDecoderTest : public ::testing::Test {
+protected:
+    // odd sizes, so that subsampled components and leftover pixels of vector steps are included, and more rows
+    // of MCUs than the windows of streamed images hold
+    const unsigned int width = 53;
+    const unsigned int height = 75;
+
+    /**
+     * Writes a JPEG image of smooth gradients and noise with the given number of channels and quality; stb
+     * subsamples chroma for qualities up to 90.
+     */
+    std::string writeImage(const std::string& name, const int numChannels, const int quality) const {
+        std::vector<uint8_t> pixels(width * height * numChannels);
+        for (unsigned int k = 0; k < pixels.size(); k++)
+            pixels[k] = static_cast<uint8_t>(k % numChannels * 80 + k / numChannels % width * 3 + k * 7919 % 23);
+        std::stringstream filePathStream;
+        filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << name;
+        std::filesystem::create_directories(TEST_IMAGES_OUTPUT_DIRPATH);
+        EXPECT_NE(stbi_write_jpg(filePathStream.str().c_str(), static_cast<int>(width), static_cast<int>(height),
+            numChannels, pixels.data(), quality), 0);
+        return filePathStream.str();
+    }
+
+    /**
+     * Checks that the planes hold the same values as the interleaved pixels loaded by stb.
+     */
+    static void expectSameAsStb(const std::string& filePath, const ImageBuffer& buffer) {
+        int stbWidth, stbHeight, channels;
+        unsigned char* pixels = stbi_load(filePath.c_str(), &stbWidth, &stbHeight, &channels, 3);
+        ASSERT_NE(pixels, nullptr);
+        ASSERT_EQ(stbWidth, buffer.getWidth());
+        ASSERT_EQ(stbHeight, buffer.getHeight());
+        const unsigned int stride = buffer.getStride();
+        for (unsigned int y = 0; y < buffer.getHeight(); y++) {
+            for (unsigned int x = 0; x < buffer.getWidth(); x++) {
+                const unsigned int idx = (y * buffer.getWidth() + x) * 3;
+                EXPECT_EQ(buffer.viewReds()[y * stride + x], pixels[idx]) << filePath << " " << x << "," << y;
+                EXPECT_EQ(buffer.viewGreens()[y * stride + x], pixels[idx + 1]) << filePath << " " << x << "," << y;
+                EXPECT_EQ(buffer.viewBlues()[y * stride + x], pixels[idx + 2]) << filePath << " " << x << "," << y;
+            }
+        }
+        stbi_image_free(pixels);
+    }
+};
+
+
+TEST_F(JpegDecoderTest, testReadRowsIsIdenticalToStb) {
+    std::stringstream testImagePathStream;
+    testImagePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    const std::string filePaths[] = {
+        testImagePathStream.str(),
+        writeImage("decoderSubsampled.jpg", 3, 80),
+        writeImage("decoderFull.jpg", 3, 100),
+        writeImage("decoderGray.jpg", 1, 90)
+    };
+
+    for (const std::string& filePath : filePaths) {
+        ASSERT_TRUE(JpegDecoder::isJpeg(filePath));
+        JpegDecoder decoder(filePath);
+        ImageBuffer buffer(decoder.getWidth(), decoder.getHeight());
+
+        decoder.readRows(buffer.view());
+
+        EXPECT_TRUE(decoder.isStreamed());
+        EXPECT_EQ(decoder.getNextRow(), decoder.getHeight());
+        expectSameAsStb(filePath, buffer);
+    }
+}
+
+TEST_F(JpegDecoderTest, testReadRowsWhenReadInStrips) {
+    const std::string filePath = writeImage("decoderStrips.jpg", 3, 75);
+    JpegDecoder decoder(filePath);
+    ImageBuffer buffer(width, height);
+    const MutableImageView planes = buffer.view();
+
+    for (unsigned int row = 0; row < height; row += 4) {
+        const unsigned int numRows = std::min(4u, height - row);
+        const std::size_t pos = static_cast<std::size_t>(row) * planes.stride;
+        decoder.readRows({width, numRows, planes.stride, planes.reds + pos, planes.greens + pos, planes.blues + pos});
+
+        EXPECT_EQ(decoder.getNextRow(), row + numRows);
+    }
+
+    expectSameAsStb(filePath, buffer);
+}
+
+TEST_F(JpegDecoderTest, testReadRowsInParallelIsIdenticalToStb) {
+    std::stringstream testImagePathStream;
+    testImagePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    ThreadPool threadPool(3);
+    std::vector<std::string> filePaths = {
+        testImagePathStream.str(),
+        writeImage("decoderSubsampled.jpg", 3, 80),
+        writeImage("decoderFull.jpg", 3, 100),
+        writeImage("decoderGray.jpg", 1, 90)
+    };
+    // images with restart intervals, whose planes are the ones of the corresponding images without them
+    for (const std::string& filePath : {filePaths[1], filePaths[2]}) {
+        JpegDecoder decoder(filePath);
+        ImageBuffer buffer(width, height);
+        decoder.readRows(buffer.view());
+        const std::string restartFilePath = filePath.substr(0, filePath.size() - 4) + "Restarts.jpg";
+        JpegEncoder encoder(restartFilePath, width, height, filePath == filePaths[1] ? 80 : 100, threadPool);
+        const MutableImageView planes = buffer.view();
+        encoder.writeRows({width, height, planes.stride, planes.reds, planes.greens, planes.blues});
+        filePaths.push_back(restartFilePath);
+    }
+
+    for (const std::string& filePath : filePaths) {
+        JpegDecoder decoder(filePath, threadPool);
+        ImageBuffer buffer(decoder.getWidth(), decoder.getHeight());
+        const MutableImageView planes = buffer.view();
+
+        // a first strip of a single row, then the others in bands
+        for (unsigned int row = 0; row < decoder.getHeight(); row += row == 0 ? 1 : 30) {
+            const unsigned int numRows = std::min(row == 0 ? 1u : 30u, decoder.getHeight() - row);
+            const std::size_t pos = static_cast<std::size_t>(row) * planes.stride;
+            decoder.readRows({planes.width, numRows, planes.stride, planes.reds + pos, planes.greens + pos,
+                planes.blues + pos});
+        }
+
+        EXPECT_FALSE(decoder.isStreamed());
+        EXPECT_EQ(decoder.getNextRow(), decoder.getHeight());
+        expectSameAsStb(filePath, buffer);
+    }
+}
+
+TEST_F(JpegDecoderTest, testReadRowsWhenSizesDiffer) {
+    JpegDecoder decoder(writeImage("decoderSizes.jpg", 3, 90));
+    ImageBuffer narrowBuffer(width - 1, height);
+    ImageBuffer tallBuffer(width, height + 1);
+
+    EXPECT_THROW(decoder.readRows(narrowBuffer.view()), std::invalid_argument);
+    EXPECT_THROW(decoder.readRows(tallBuffer.view()), std::invalid_argument);
+}
+
+TEST_F(JpegDecoderTest, testConstructorWhenFileIsNotJpeg) {
+    std::stringstream filePathStream;
+    filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "decoderImage.png";
+    const std::vector<uint8_t> pixels(width * height * 3, 128);
+    ASSERT_NE(stbi_write_png(filePathStream.str().c_str(), static_cast<int>(width), static_cast<int>(height), 3,
+        pixels.data(), static_cast<int>(width) * 3), 0);
+    const std::string missingFilePath = "this/path/doesnt/exist/testImage.jpg";
+
+    EXPECT_FALSE(JpegDecoder::isJpeg(filePathStream.str()));
+    EXPECT_FALSE(JpegDecoder::isJpeg(missingFilePath));
+    EXPECT_THROW(JpegDecoder decoder(filePathStream.str()), std::runtime_error);
+    EXPECT_THROW(JpegDecoder decoder(missingFilePath), std::runtime_error);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "image/ImageBuffer.h"
+#include "image/reader/JpegEncoder.h"
+#include "processing/parallel/ThreadPool.h"
+
+class JpegEncoderTest : public ::testing::Test {
+protected:
+    // odd sizes, so that the last row and column of MCUs are replicated
+    const unsigned int width = 53;
+    const unsigned int height = 27;
+    ImageBuffer buffer{width, height};
+    std::vector<uint8_t> pixels;
+
+    void SetUp() override {
+        // smooth gradients and noise, stored both interleaved and planar
+        pixels.resize(width * height * 3);
+        const MutableImageView planes = buffer.view();
+        uint8_t* channels[3] = {planes.reds, planes.greens, planes.blues};
+        for (unsigned int k = 0; k < pixels.size(); k++) {
+            pixels[k] = static_cast<uint8_t>(k % 3 * 80 + k / 3 % width * 3 + k * 7919 % 23);
+            const unsigned int pixel = k / 3;
+            channels[k % 3][pixel / width * planes.stride + pixel % width] = pixels[k];
+        }
+    }
+
+    static std::string getFilePath(const std::string& name) {
+        std::stringstream filePathStream;
+        filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << name;
+        std::filesystem::create_directories(TEST_IMAGES_OUTPUT_DIRPATH);
+        return filePathStream.str();
+    }
+
+    static std::vector<char> readFile(const std::string& filePath) {
+        std::ifstream file(filePath, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /**
+     * Decodes the given file with stb into interleaved pixels.
+     */
+    static std::vector<uint8_t> decodeFile(const std::string& filePath) {
+        int w = 0, h = 0, channels = 0;
+        unsigned char* data = stbi_load(filePath.c_str(), &w, &h, &channels, 3);
+        if (!data)
+            return {};
+        std::vector<uint8_t> decodedPixels(data, data + static_cast<std::size_t>(w) * h * 3);
+        stbi_image_free(data);
+        return decodedPixels;
+    }
+
+    /**
+     * Writes the planes in strips of the given height.
+     */
+    void writeStrips(JpegEncoder& encoder, const unsigned int stripHeight) {
+        const MutableImageView planes = buffer.view();
+        for (unsigned int row = 0; row < height; row += stripHeight) {
+            const unsigned int numRows = std::min(stripHeight, height - row);
+            const std::size_t pos = static_cast<std::size_t>(row) * planes.stride;
+            encoder.writeRows({width, numRows, planes.stride, planes.reds + pos, planes.greens + pos,
+                planes.blues + pos});
+
+            EXPECT_EQ(encoder.getNextRow(), row + numRows);
+        }
+    }
+};
+
+
+TEST_F(JpegEncoderTest, testWriteRowsIsIdenticalToStb) {
+    // stb subsamples chroma for qualities up to 90
+    for (const int quality : {100, 90, 75}) {
+        const std::string stbFilePath = getFilePath("encoderStb" + std::to_string(quality) + ".jpg");
+        const std::string filePath = getFilePath("encoderStrips" + std::to_string(quality) + ".jpg");
+        ASSERT_NE(stbi_write_jpg(stbFilePath.c_str(), static_cast<int>(width), static_cast<int>(height), 3,
+            pixels.data(), quality), 0);
+
+        for (const unsigned int stripHeight : {1u, 5u, height}) {
+            {
+                JpegEncoder encoder(filePath, width, height, quality);
+                writeStrips(encoder, stripHeight);
+            }
+
+            EXPECT_EQ(readFile(filePath), readFile(stbFilePath)) << quality << " " << stripHeight;
+        }
+    }
+}
+
+TEST_F(JpegEncoderTest, testWriteRowsInParallelDecodesAsStb) {
+    ThreadPool threadPool(3);
+    for (const int quality : {100, 75}) {
+        const std::string stbFilePath = getFilePath("encoderStb" + std::to_string(quality) + ".jpg");
+        const std::string filePath = getFilePath("encoderParallel" + std::to_string(quality) + ".jpg");
+        ASSERT_NE(stbi_write_jpg(stbFilePath.c_str(), static_cast<int>(width), static_cast<int>(height), 3,
+            pixels.data(), quality), 0);
+        const std::vector<uint8_t> expectedPixels = decodeFile(stbFilePath);
+        ASSERT_FALSE(expectedPixels.empty());
+
+        for (const unsigned int stripHeight : {1u, 5u, height}) {
+            {
+                JpegEncoder encoder(filePath, width, height, quality, threadPool);
+                writeStrips(encoder, stripHeight);
+            }
+
+            // the rows of MCUs are restart intervals, separated by restart markers
+            const std::vector<char> data = readFile(filePath);
+            const std::vector<char> restartMarker = {static_cast<char>(0xFF), static_cast<char>(0xD0)};
+            EXPECT_NE(std::search(data.begin(), data.end(), restartMarker.begin(), restartMarker.end()), data.end());
+            EXPECT_EQ(decodeFile(filePath), expectedPixels) << quality << " " << stripHeight;
+        }
+    }
+}
+
+TEST_F(JpegEncoderTest, testWriteRowsWhenSizesDiffer) {
+    JpegEncoder encoder(getFilePath("encoderSizes.jpg"), width, height, 100);
+    ImageBuffer narrowBuffer(width - 1, height);
+    ImageBuffer tallBuffer(width, height + 1);
+    const MutableImageView narrowPlanes = narrowBuffer.view();
+    const MutableImageView tallPlanes = tallBuffer.view();
+
+    EXPECT_THROW(encoder.writeRows({narrowPlanes.width, narrowPlanes.height, narrowPlanes.stride, narrowPlanes.reds,
+        narrowPlanes.greens, narrowPlanes.blues}), std::invalid_argument);
+    EXPECT_THROW(encoder.writeRows({tallPlanes.width, tallPlanes.height, tallPlanes.stride, tallPlanes.reds,
+        tallPlanes.greens, tallPlanes.blues}), std::invalid_argument);
+    EXPECT_EQ(encoder.getNextRow(), 0);
+}
+
+TEST_F(JpegEncoderTest, testConstructorWhenArgumentsAreInvalid) {
+    const std::string filePath = getFilePath("encoderInvalid.jpg");
+    const std::string missingFilePath = "this/path/doesnt/exist/testImage.jpg";
+
+    EXPECT_THROW(JpegEncoder encoder(filePath, 0, height, 100), std::invalid_argument);
+    EXPECT_THROW(JpegEncoder encoder(filePath, width, 65536, 100), std::invalid_argument);
+    EXPECT_THROW(JpegEncoder encoder(missingFilePath, width, height, 100), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(missingFilePath));
+}
@@ -14,4 +14,18 @@ TEST(KernelTest, testConstructor) {
     EXPECT_EQ(kernel.getWeights().size(), order * order);
     for (auto weight : kernel.getWeights())
         EXPECT_EQ(weight, weightValue);
-}
\ No newline at end of file
+}
+
+TEST(KernelTest, testViewWeights) {
+    const std::vector<float> weights = {0, -1, 0, -1, 5, -1, 0, -1, 0};
+
+    const Kernel kernel("kernelTestViewWeights", 3, weights);
+    const Span<const float> view = kernel.viewWeights();
+
+    // the view refers to the weights stored by the kernel, thus it is not a copy
+    EXPECT_EQ(view.data(), kernel.viewWeights().data());
+    ASSERT_EQ(view.size(), weights.size());
+    EXPECT_FALSE(view.empty());
+    for (unsigned int k = 0; k < weights.size(); k++)
+        EXPECT_EQ(view[k], weights[k]);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "image/Image.h"
+#include "image/ImageBuffer.h"
+#include "image/PlanePool.h"
+
+
+TEST(PlanePoolTest, testGetSizeClass) {
+    EXPECT_EQ(PlanePool::getSizeClass(1), ImageBuffer::ALIGNMENT);
+    EXPECT_EQ(PlanePool::getSizeClass(64), 64);
+    EXPECT_EQ(PlanePool::getSizeClass(1000), 1024);
+    EXPECT_EQ(PlanePool::getSizeClass(1025), 1280);
+    EXPECT_EQ(PlanePool::getSizeClass(3 * 1024 * 1024 + 1), 3584 * 1024);
+    for (std::size_t size = 1; size < 1 << 20; size = size * 3 / 2 + 1) {
+        const std::size_t sizeClass = PlanePool::getSizeClass(size);
+
+        EXPECT_GE(sizeClass, size);
+        EXPECT_EQ(sizeClass % ImageBuffer::ALIGNMENT, 0);
+        // classes are at most a quarter of the size apart
+        EXPECT_LE(sizeClass, size + size / 4 + ImageBuffer::ALIGNMENT);
+    }
+}
+
+TEST(PlanePoolTest, testAcquireWhenBlockIsRecycled) {
+    PlanePool pool(1 << 20, false, false);
+
+    uint8_t* first;
+    {
+        const PlanePool::Block block = pool.acquire(1000);
+        first = block.get();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % ImageBuffer::ALIGNMENT, 0);
+    }
+    EXPECT_EQ(pool.getStatistics().cachedSize, 1024);
+
+    // a size of the same class recycles the block
+    const PlanePool::Block second = pool.acquire(1020);
+    const PlanePool::Block third = pool.acquire(1020);
+
+    EXPECT_EQ(second.get(), first);
+    EXPECT_NE(third.get(), first);
+    const PlanePool::Statistics statistics = pool.getStatistics();
+    EXPECT_EQ(statistics.numHits, 1);
+    EXPECT_EQ(statistics.numMisses, 2);
+    EXPECT_EQ(statistics.numEvictions, 0);
+    EXPECT_EQ(statistics.cachedSize, 0);
+}
+
+TEST(PlanePoolTest, testReleaseWhenCacheIsFull) {
+    PlanePool pool(1500, false, false);
+
+    {
+        PlanePool::Block first = pool.acquire(1024);
+        PlanePool::Block second = pool.acquire(1024);
+    }
+
+    const PlanePool::Statistics statistics = pool.getStatistics();
+    EXPECT_EQ(statistics.numEvictions, 1);
+    EXPECT_EQ(statistics.cachedSize, 1024);
+
+    pool.trim();
+
+    EXPECT_EQ(pool.getStatistics().cachedSize, 0);
+}
+
+TEST(PlanePoolTest, testAcquireWhenHugePagesAreUsed) {
+    PlanePool pool(1 << 30, true, true);
+
+    {
+        const PlanePool::Block block = pool.acquire(PlanePool::HUGE_PAGE_SIZE + 1);
+        const std::size_t sizeClass = PlanePool::getSizeClass(PlanePool::HUGE_PAGE_SIZE + 1);
+
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.get()) % PlanePool::HUGE_PAGE_SIZE, 0);
+        EXPECT_EQ(pool.getStatistics().hugePageSize, sizeClass);
+        block.get()[sizeClass - 1] = 1;
+    }
+    EXPECT_GT(pool.getStatistics().hugePageSize, 0);
+
+    pool.trim();
+
+    EXPECT_EQ(pool.getStatistics().hugePageSize, 0);
+}
+
+TEST(PlanePoolTest, testScope) {
+    PlanePool outerPool(1 << 24, false, false);
+    PlanePool innerPool(1 << 24, false, false);
+
+    EXPECT_EQ(PlanePool::getInstalled(), nullptr);
+    {
+        const PlanePool::Scope outerScope(outerPool);
+        {
+            const PlanePool::Scope innerScope(innerPool);
+
+            EXPECT_EQ(PlanePool::getInstalled(), &innerPool);
+            const ImageBuffer buffer(100, 10);
+        }
+
+        EXPECT_EQ(PlanePool::getInstalled(), &outerPool);
+    }
+    EXPECT_EQ(PlanePool::getInstalled(), nullptr);
+    EXPECT_EQ(innerPool.getStatistics().numMisses, 3);
+    EXPECT_EQ(outerPool.getStatistics().numMisses, 0);
+}
+
+TEST(PlanePoolTest, testImageBufferWhenPlanesAreRecycled) {
+    PlanePool pool(1 << 24, false, false);
+    const PlanePool::Scope scope(pool);
+
+    for (unsigned int rep = 0; rep < 4; rep++) {
+        ImageBuffer buffer(200, 50);
+        buffer.viewBlues()[0] = static_cast<uint8_t>(rep);
+    }
+    // planes of slightly different sizes share their size class
+    const ImageBuffer smallerBuffer(198, 49);
+
+    const PlanePool::Statistics statistics = pool.getStatistics();
+    EXPECT_EQ(statistics.numMisses, 3);
+    EXPECT_EQ(statistics.numHits, 12);
+}
+
+TEST(PlanePoolTest, testImageWhenPoolIsDestroyedFirst) {
+    std::unique_ptr<Image> image;
+    {
+        PlanePool pool;
+        const PlanePool::Scope scope(pool);
+        image = std::make_unique<Image>(ImageBuffer(10, 10));
+    }
+
+    // the planes are released to the system once the image is destroyed
+    EXPECT_EQ(image->getWidth(), 10);
+    EXPECT_EQ(image->getReds().size(), 100);
+    image.reset();
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "image/ImageBuffer.h"
+#include "image/reader/RawImageReader.h"
+#include "image/reader/STBImageReader.h"
+
+class RawImageReaderTest : public ::testing::Test {
+protected:
+    RawImageReader imageReader;
+
+    static std::string getFilePath(const std::string& name) {
+        std::stringstream filePathStream;
+        filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << name;
+        std::filesystem::create_directories(TEST_IMAGES_OUTPUT_DIRPATH);
+        return filePathStream.str();
+    }
+
+    /**
+     * Builds an image of the given size whose values depend on their channel and position.
+     */
+    static Image createImage(const unsigned int width, const unsigned int height) {
+        ImageBuffer buffer(width, height);
+        const MutableImageView planes = buffer.view();
+        uint8_t* channels[3] = {planes.reds, planes.greens, planes.blues};
+        for (unsigned int c = 0; c < 3; c++) {
+            for (unsigned int y = 0; y < height; y++) {
+                for (unsigned int x = 0; x < width; x++)
+                    channels[c][y * planes.stride + x] = static_cast<uint8_t>(c * 80 + x * 3 + y * 7);
+            }
+        }
+        return Image(std::move(buffer));
+    }
+};
+
+
+TEST_F(RawImageReaderTest, testLoadRGBImageReadsSavedImage) {
+    // a plane size multiple of the aliasing period, and an odd one
+    for (const unsigned int width : {53u, 100u}) {
+        const unsigned int height = width == 53 ? 27 : 64;
+        const Image img = createImage(width, height);
+        const std::string filePath = getFilePath("raw" + std::to_string(width) + ".kip");
+
+        imageReader.saveJPGImage(img, filePath);
+        const auto loadedImg = imageReader.loadRGBImage(filePath);
+
+        ASSERT_TRUE(RawImageReader::isRawImage(filePath));
+        ASSERT_EQ(loadedImg->getWidth(), width);
+        ASSERT_EQ(loadedImg->getHeight(), height);
+        EXPECT_EQ(loadedImg->getStride(), img.getStride());
+        EXPECT_EQ(loadedImg->getReds(), img.getReds());
+        EXPECT_EQ(loadedImg->getGreens(), img.getGreens());
+        EXPECT_EQ(loadedImg->getBlues(), img.getBlues());
+        // planes are viewed where they lie in the file, aligned as the ones of a buffer, with zeroed padding
+        for (const Span<const uint8_t> plane : {loadedImg->viewReds(), loadedImg->viewGreens(),
+            loadedImg->viewBlues()}) {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(plane.data()) % ImageBuffer::ALIGNMENT, 0);
+            for (unsigned int y = 0; y < height; y++) {
+                for (unsigned int x = width; x < loadedImg->getStride(); x++)
+                    EXPECT_EQ(plane[y * loadedImg->getStride() + x], 0);
+            }
+        }
+    }
+}
+
+TEST_F(RawImageReaderTest, testLoadRGBImageOutlivesReader) {
+    const Image img = createImage(53, 27);
+    const std::string filePath = getFilePath("rawOutlived.kip");
+    std::unique_ptr<Image> loadedImg;
+
+    {
+        RawImageReader reader;
+        reader.saveJPGImage(img, filePath);
+        loadedImg = reader.loadRGBImage(filePath);
+    }
+    const Image copiedImg(*loadedImg);
+    loadedImg.reset();
+
+    EXPECT_EQ(copiedImg.getReds(), img.getReds());
+    EXPECT_EQ(copiedImg.getBlues(), img.getBlues());
+}
+
+TEST_F(RawImageReaderTest, testLoadRGBImageWhenFileIsNotRaw) {
+    std::stringstream jpegPathStream;
+    jpegPathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    const std::string truncatedPath = getFilePath("rawTruncated.kip");
+    imageReader.saveJPGImage(createImage(53, 27), truncatedPath);
+    std::filesystem::resize_file(truncatedPath, std::filesystem::file_size(truncatedPath) - 1);
+    const std::string missingFilePath = "this/path/doesnt/exist/testImage.kip";
+
+    EXPECT_FALSE(RawImageReader::isRawImage(jpegPathStream.str()));
+    EXPECT_FALSE(RawImageReader::isRawImage(missingFilePath));
+    EXPECT_THROW(imageReader.loadRGBImage(jpegPathStream.str()), std::runtime_error);
+    EXPECT_THROW(imageReader.loadRGBImage(truncatedPath), std::runtime_error);
+    EXPECT_THROW(imageReader.loadRGBImage(missingFilePath), std::runtime_error);
+}
+
+TEST_F(RawImageReaderTest, testSaveJPGImageWhenPathIsIncorrect) {
+    const std::string outputFilePath = "this/path/doesnt/exist/testImage.kip";
+
+    EXPECT_THROW(imageReader.saveJPGImage(createImage(5, 3), outputFilePath), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(outputFilePath));
+}
+
+TEST_F(RawImageReaderTest, testLoadRGBImageMatchesDecodedImage) {
+    std::stringstream jpegPathStream;
+    jpegPathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    STBImageReader stbImageReader;
+    const auto decodedImg = stbImageReader.loadRGBImage(jpegPathStream.str());
+    const std::string filePath = getFilePath("rawTestImage.kip");
+
+    imageReader.saveJPGImage(*decodedImg, filePath);
+    const auto loadedImg = imageReader.loadRGBImage(filePath);
+
+    EXPECT_EQ(loadedImg->getReds(), decodedImg->getReds());
+    EXPECT_EQ(loadedImg->getGreens(), decodedImg->getGreens());
+    EXPECT_EQ(loadedImg->getBlues(), decodedImg->getBlues());
+}
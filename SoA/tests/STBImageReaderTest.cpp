@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "image/ImageBuffer.h"
 #include "image/reader/STBImageReader.h"
+#include "processing/parallel/ThreadPool.h"
 
 class STBImageReaderTest : public ::testing::Test {
 protected:
@@ -51,6 +55,24 @@ TEST_F(STBImageReaderTest, testLoadRGBImageWhenImageExists) {
     }
 }
 
+TEST_F(STBImageReaderTest, testLoadRGBImageInParallelWhenImageExists) {
+    std::stringstream inputFilePathStream;
+    inputFilePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    const std::string inputFilePath = inputFilePathStream.str();
+    ThreadPool threadPool(2);
+    STBImageReader parallelImageReader(threadPool);
+
+    const auto img = imageReader->loadRGBImage(inputFilePath);
+    const auto parallelImg = parallelImageReader.loadRGBImage(inputFilePath);
+
+    ASSERT_NE(parallelImg, nullptr);
+    EXPECT_EQ(parallelImg->getWidth(), img->getWidth());
+    EXPECT_EQ(parallelImg->getHeight(), img->getHeight());
+    EXPECT_EQ(parallelImg->getReds(), img->getReds());
+    EXPECT_EQ(parallelImg->getGreens(), img->getGreens());
+    EXPECT_EQ(parallelImg->getBlues(), img->getBlues());
+}
+
 TEST_F(STBImageReaderTest, testLoadRGBImageWhenImageDoesntExist) {
     const std::string inputFilePath = "this/path/doesnt/exist/testImage.jpg";
     std::filesystem::remove_all(inputFilePath);
@@ -92,4 +114,100 @@ TEST_F(STBImageReaderTest, testSaveJPGImageWhenPathDoesntExist) {
 
     EXPECT_THROW(imageReader->saveJPGImage(testImage, outputFilePath), std::runtime_error);
     EXPECT_FALSE(std::filesystem::exists(outputFilePath));
-}
\ No newline at end of file
+}
+
+TEST_F(STBImageReaderTest, testOpenRGBImageReadsSameRowsAsLoadRGBImage) {
+    std::stringstream inputFilePathStream;
+    inputFilePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    const std::string inputFilePath = inputFilePathStream.str();
+    const auto img = imageReader->loadRGBImage(inputFilePath);
+
+    const auto rowReader = imageReader->openRGBImage(inputFilePath);
+    ASSERT_EQ(rowReader->getWidth(), img->getWidth());
+    ASSERT_EQ(rowReader->getHeight(), img->getHeight());
+    ImageBuffer buffer(img->getWidth(), img->getHeight());
+    const MutableImageView planes = buffer.view();
+    for (unsigned int y = 0; y < img->getHeight(); y++) {
+        const std::size_t pos = static_cast<std::size_t>(y) * planes.stride;
+        rowReader->readRows({planes.width, 1, planes.stride, planes.reds + pos, planes.greens + pos,
+            planes.blues + pos});
+    }
+    const Image rowImage(std::move(buffer));
+
+    EXPECT_EQ(rowReader->getNextRow(), img->getHeight());
+    EXPECT_EQ(rowImage.getReds(), img->getReds());
+    EXPECT_EQ(rowImage.getGreens(), img->getGreens());
+    EXPECT_EQ(rowImage.getBlues(), img->getBlues());
+}
+
+TEST_F(STBImageReaderTest, testOpenRGBImageWhenImageDoesntExist) {
+    const std::string inputFilePath = "this/path/doesnt/exist/testImage.jpg";
+    std::filesystem::remove_all(inputFilePath);
+
+    EXPECT_THROW(imageReader->openRGBImage(inputFilePath), std::runtime_error);
+}
+
+TEST_F(STBImageReaderTest, testCreateJPGImageWritesSameFileAsSaveJPGImage) {
+    constexpr unsigned int height = 3;
+    constexpr unsigned int width = 5;
+    const std::vector<uint8_t> someReds = {120, 22, 45, 123, 1, 1, 18, 66, 89, 82, 42, 100, 215, 10, 90};
+    const std::vector<uint8_t> someGreens = {1, 58, 31, 15, 12, 17, 88, 12, 137, 4, 36, 10, 36, 4, 36};
+    const std::vector<uint8_t> someBlues = {131, 136, 22, 15, 68, 226, 140, 28, 213, 64, 106, 1, 118, 64, 217};
+    const Image testImage(width, height, someReds, someGreens, someBlues);
+
+    std::stringstream outputFilePathStream;
+    outputFilePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "testImageSaved.jpg";
+    const std::string savedFilePath = outputFilePathStream.str();
+    outputFilePathStream.str(std::string());
+    outputFilePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "testImageCreated.jpg";
+    const std::string createdFilePath = outputFilePathStream.str();
+    std::filesystem::create_directories(TEST_IMAGES_OUTPUT_DIRPATH);
+
+    imageReader->saveJPGImage(testImage, savedFilePath);
+    {
+        const auto rowWriter = imageReader->createJPGImage(createdFilePath, width, height);
+        for (unsigned int y = 0; y < height; y++) {
+            const std::size_t pos = static_cast<std::size_t>(y) * testImage.getStride();
+            rowWriter->writeRows({width, 1, testImage.getStride(), testImage.viewReds().data() + pos,
+                testImage.viewGreens().data() + pos, testImage.viewBlues().data() + pos});
+        }
+        EXPECT_EQ(rowWriter->getNextRow(), height);
+    }
+
+    std::ifstream savedFile(savedFilePath, std::ios::binary);
+    std::ifstream createdFile(createdFilePath, std::ios::binary);
+    const std::vector<char> savedBytes{std::istreambuf_iterator<char>(savedFile), std::istreambuf_iterator<char>()};
+    const std::vector<char> createdBytes{std::istreambuf_iterator<char>(createdFile),
+        std::istreambuf_iterator<char>()};
+    EXPECT_FALSE(savedBytes.empty());
+    EXPECT_EQ(createdBytes, savedBytes);
+}
+
+TEST_F(STBImageReaderTest, testSaveJPGImageInParallelLoadsSameImage) {
+    std::stringstream filePathStream;
+    filePathStream << TEST_IMAGES_INPUT_DIRPATH << "testImage.jpg";
+    const auto img = imageReader->loadRGBImage(filePathStream.str());
+    filePathStream.str(std::string());
+    filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "testImageSequential.jpg";
+    const std::string sequentialFilePath = filePathStream.str();
+    filePathStream.str(std::string());
+    filePathStream << TEST_IMAGES_OUTPUT_DIRPATH << "testImageParallel.jpg";
+    const std::string parallelFilePath = filePathStream.str();
+    std::filesystem::create_directories(TEST_IMAGES_OUTPUT_DIRPATH);
+    ThreadPool threadPool(2);
+    STBImageReader parallelImageReader(threadPool);
+
+    imageReader->saveJPGImage(*img, sequentialFilePath);
+    parallelImageReader.saveJPGImage(*img, parallelFilePath);
+    const auto sequentialImg = imageReader->loadRGBImage(sequentialFilePath);
+    const auto parallelImg = imageReader->loadRGBImage(parallelFilePath);
+    // decoded again by restart intervals
+    const auto parallelDecodedImg = parallelImageReader.loadRGBImage(parallelFilePath);
+
+    EXPECT_EQ(parallelImg->getReds(), sequentialImg->getReds());
+    EXPECT_EQ(parallelImg->getGreens(), sequentialImg->getGreens());
+    EXPECT_EQ(parallelImg->getBlues(), sequentialImg->getBlues());
+    EXPECT_EQ(parallelDecodedImg->getReds(), parallelImg->getReds());
+    EXPECT_EQ(parallelDecodedImg->getGreens(), parallelImg->getGreens());
+    EXPECT_EQ(parallelDecodedImg->getBlues(), parallelImg->getBlues());
+}
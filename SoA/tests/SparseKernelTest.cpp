@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "kernel/KernelFactory.h"
+#include "processing/sparse/SparseKernel.h"
+
+
+TEST(SparseKernelTest, testConstructorWhenKernelIsSharpen) {
+    constexpr unsigned int order = 3;
+    constexpr unsigned int inputWidth = 10;
+    const auto kernel = KernelFactory::createSharpenKernel(order);
+
+    const SparseKernel sparseKernel(*kernel, inputWidth);
+
+    EXPECT_EQ(sparseKernel.getOrder(), order);
+    const std::vector<SparseKernel::Tap>& taps = sparseKernel.getTaps();
+    ASSERT_EQ(taps.size(), 5);
+    const unsigned int offsets[] = {1, inputWidth, inputWidth + 1, inputWidth + 2, 2 * inputWidth + 1};
+    const float weights[] = {-1, -1, 5, -1, -1};
+    for (unsigned int t = 0; t < taps.size(); t++) {
+        EXPECT_EQ(taps[t].offset, offsets[t]);
+        EXPECT_EQ(taps[t].weight, weights[t]);
+    }
+}
+
+TEST(SparseKernelTest, testConstructorWhenKernelIsDense) {
+    constexpr unsigned int order = 5;
+    constexpr unsigned int inputWidth = 7;
+    const auto kernel = KernelFactory::createEdgeDetectionKernel(order);
+
+    const SparseKernel sparseKernel(*kernel, inputWidth);
+
+    const std::vector<SparseKernel::Tap>& taps = sparseKernel.getTaps();
+    ASSERT_EQ(taps.size(), order * order);
+    for (unsigned int j = 0; j < order; j++) {
+        for (unsigned int i = 0; i < order; i++) {
+            EXPECT_EQ(taps[j * order + i].offset, j * inputWidth + i);
+            EXPECT_EQ(taps[j * order + i].weight, kernel->getWeights()[j * order + i]);
+        }
+    }
+}
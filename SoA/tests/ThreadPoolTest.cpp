@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "processing/parallel/ThreadPool.h"
+
+
+TEST(ThreadPoolTest, testConstructor) {
+    constexpr unsigned int numThreads = 4;
+
+    const ThreadPool threadPool(numThreads);
+
+    EXPECT_EQ(threadPool.getNumThreads(), numThreads);
+}
+
+TEST(ThreadPoolTest, testConstructorWhenNumThreadsIsZero) {
+    EXPECT_THROW(ThreadPool(0), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, testParallelForExecutesEachTaskOnce) {
+    constexpr unsigned int numThreads = 4;
+    constexpr unsigned int numTasks = 1000;
+    ThreadPool threadPool(numThreads, true);
+    std::vector<std::atomic<unsigned int>> executions(numTasks);
+
+    // the same pool is reused by consecutive operations
+    for (unsigned int rep = 0; rep < 3; rep++)
+        threadPool.parallelFor(numTasks, [&executions](const unsigned int task) { executions[task]++; });
+
+    for (unsigned int task = 0; task < numTasks; task++)
+        EXPECT_EQ(executions[task], 3);
+}
+
+TEST(ThreadPoolTest, testParallelForWhenSingleThread) {
+    constexpr unsigned int numTasks = 10;
+    ThreadPool threadPool(1);
+    std::vector<unsigned int> tasks;
+
+    threadPool.parallelFor(numTasks, [&tasks](const unsigned int task) { tasks.push_back(task); });
+
+    EXPECT_THAT(tasks, testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(ThreadPoolTest, testParallelForWhenTaskThrows) {
+    constexpr unsigned int numThreads = 4;
+    constexpr unsigned int numTasks = 100;
+    ThreadPool threadPool(numThreads);
+    std::atomic<unsigned int> executions = 0;
+
+    EXPECT_THROW(threadPool.parallelFor(numTasks, [&executions](const unsigned int task) {
+        executions++;
+        if (task == numTasks / 2)
+            throw std::runtime_error("Task fails.");
+    }), std::runtime_error);
+    EXPECT_EQ(executions, numTasks);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include "kernel/KernelFactory.h"
+#include "processing/simd/InstructionSet.h"
+#include "processing/simd/PlaneConvolution.h"
+#include "processing/simd/UnrolledConvolution.h"
+
+
+TEST(UnrolledConvolutionTest, testDispatchTable) {
+#if !defined(__x86_64__) && !defined(_M_X64)
+    GTEST_SKIP() << "Microkernels are available on x86-64 only.";
+#endif
+    for (const InstructionSet instructionSet : {InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        for (unsigned int order = 1; order <= UnrolledConvolution::MAX_ORDER + 2; order++) {
+            const PlaneConvolution::Function microkernel = UnrolledConvolution::select(instructionSet, order);
+            const bool isSpecialized = order % 2 == 1 && order >= 3 && order <= UnrolledConvolution::MAX_ORDER;
+
+            EXPECT_NE(microkernel, nullptr);
+            EXPECT_EQ(microkernel != PlaneConvolution::select(instructionSet), isSpecialized);
+        }
+    }
+    EXPECT_EQ(UnrolledConvolution::select(InstructionSet::scalar, 3), PlaneConvolution::scalar);
+}
+
+TEST(UnrolledConvolutionTest, testMicrokernelsAreBitIdenticalToGenericEngines) {
+    // rows and columns left over by full blocks are included
+    constexpr unsigned int inputWidth = 70;
+    constexpr unsigned int inputHeight = 61;
+    std::vector<uint8_t> input(inputWidth * inputHeight);
+    for (unsigned int k = 0; k < inputWidth * inputHeight; k++)
+        input[k] = static_cast<uint8_t>(k * 37 % 256);
+
+    for (const InstructionSet instructionSet : {InstructionSet::sse42, InstructionSet::avx2, InstructionSet::avx512}) {
+        if (!InstructionSets::isSupported(instructionSet))
+            continue;
+        for (unsigned int order = 3; order <= UnrolledConvolution::MAX_ORDER; order += 2) {
+            // fractional weights, so that any change in the order of the sums would show up
+            std::vector<float> weights = KernelFactory::createEdgeDetectionKernel(order)->getWeights();
+            for (unsigned int k = 0; k < weights.size(); k++)
+                weights[k] *= 0.1f + static_cast<float>(k % 7) / 29;
+            const unsigned int outputWidth = inputWidth - (order - 1);
+            const unsigned int outputHeight = inputHeight - (order - 1);
+            std::vector<uint8_t> unrolledOutput(outputWidth * outputHeight);
+            std::vector<uint8_t> genericOutput(outputWidth * outputHeight);
+
+            UnrolledConvolution::select(instructionSet, order)(input.data(), inputWidth, unrolledOutput.data(),
+                outputWidth, outputWidth, 0, outputHeight, weights.data(), order);
+            PlaneConvolution::select(instructionSet)(input.data(), inputWidth, genericOutput.data(),
+                outputWidth, outputWidth, 0, outputHeight, weights.data(), order);
+
+            EXPECT_EQ(unrolledOutput, genericOutput) << InstructionSets::getName(instructionSet) << ", order " << order;
+        }
+    }
+}